@@ -0,0 +1,96 @@
+-- Month-end balances
+-- Closing balance, inflow and outflow of every account for every month with transactions.
+-- Void transactions count as zero, initial balances are not included.
+CREATE TABLE IF NOT EXISTS MONTHLYBALANCE_V1(
+MONTHLYBALANCEID integer primary key
+, ACCOUNTID integer NOT NULL
+, MONTH TEXT NOT NULL /* YYYY-MM */
+, BALANCE numeric NOT NULL
+, INFLOW numeric NOT NULL
+, OUTFLOW numeric NOT NULL
+, UNIQUE(ACCOUNTID, MONTH)
+);
+
+-- Fill from the ledger: the flows of every month, then the running balance
+DELETE FROM MONTHLYBALANCE_V1;
+INSERT INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW)
+SELECT ACCOUNTID, MONTH, 0, SUM(MAX(AMOUNT, 0)), SUM(MAX(-AMOUNT, 0)) FROM (
+    SELECT ACCOUNTID, substr(TRANSDATE, 1, 7) AS MONTH
+    , (CASE WHEN UPPER(STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(TRANSCODE) = 'DEPOSIT' THEN IFNULL(TRANSAMOUNT, 0) ELSE -IFNULL(TRANSAMOUNT, 0) END) AS AMOUNT
+    FROM CHECKINGACCOUNT_V1
+    UNION ALL
+    SELECT TOACCOUNTID, substr(TRANSDATE, 1, 7)
+    , (CASE WHEN UPPER(STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(TOTRANSAMOUNT, 0) END)
+    FROM CHECKINGACCOUNT_V1
+    WHERE UPPER(TRANSCODE) = 'TRANSFER' AND TOACCOUNTID > 0 AND TOACCOUNTID <> ACCOUNTID
+) GROUP BY ACCOUNTID, MONTH;
+UPDATE MONTHLYBALANCE_V1 SET BALANCE = (SELECT SUM(M.INFLOW - M.OUTFLOW) FROM MONTHLYBALANCE_V1 M
+    WHERE M.ACCOUNTID = MONTHLYBALANCE_V1.ACCOUNTID AND M.MONTH <= MONTHLYBALANCE_V1.MONTH);
+
+-- Keep the rows up to date whichever statement changes CHECKINGACCOUNT_V1:
+-- a new month row starts with the closing balance of the month before, the amount
+-- goes to the flows of its month and to the balance of that month and every later one.
+CREATE TRIGGER IF NOT EXISTS TRG_MONTHLYBALANCE_INSERT AFTER INSERT ON CHECKINGACCOUNT_V1
+BEGIN
+    INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW)
+    SELECT NEW.ACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1
+        WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0;
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7);
+    INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW)
+    SELECT NEW.TOACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1
+        WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0
+    WHERE UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID;
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7) AND UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID;
+END;
+
+CREATE TRIGGER IF NOT EXISTS TRG_MONTHLYBALANCE_UPDATE AFTER UPDATE OF ACCOUNTID, TOACCOUNTID, TRANSCODE, TRANSAMOUNT, TOTRANSAMOUNT, STATUS, TRANSDATE ON CHECKINGACCOUNT_V1
+WHEN OLD.ACCOUNTID IS NOT NEW.ACCOUNTID
+    OR OLD.TOACCOUNTID IS NOT NEW.TOACCOUNTID
+    OR OLD.TRANSCODE IS NOT NEW.TRANSCODE
+    OR OLD.TRANSAMOUNT IS NOT NEW.TRANSAMOUNT
+    OR OLD.TOTRANSAMOUNT IS NOT NEW.TOTRANSAMOUNT
+    OR OLD.STATUS IS NOT NEW.STATUS
+    OR OLD.TRANSDATE IS NOT NEW.TRANSDATE
+BEGIN
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = OLD.ACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7);
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = OLD.TOACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7) AND UPPER(OLD.TRANSCODE) = 'TRANSFER' AND OLD.TOACCOUNTID > 0 AND OLD.TOACCOUNTID <> OLD.ACCOUNTID;
+    INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW)
+    SELECT NEW.ACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1
+        WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0;
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7);
+    INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW)
+    SELECT NEW.TOACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1
+        WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0
+    WHERE UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID;
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7) AND UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID;
+END;
+
+CREATE TRIGGER IF NOT EXISTS TRG_MONTHLYBALANCE_DELETE AFTER DELETE ON CHECKINGACCOUNT_V1
+BEGIN
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = OLD.ACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7);
+    UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END)
+        , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+        , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END)
+    WHERE ACCOUNTID = OLD.TOACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7) AND UPPER(OLD.TRANSCODE) = 'TRANSFER' AND OLD.TOACCOUNTID > 0 AND OLD.TOACCOUNTID <> OLD.ACCOUNTID;
+END;
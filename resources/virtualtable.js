@@ -0,0 +1,143 @@
+/*
+   Virtual table body for the report pages served by the loopback report
+   server. The rows are fetched page by page from the url given in the
+   data-rows attribute of the tbody and only the rows around the visible
+   part of the page are kept in the document. Clicking a column header sorts
+   the rows on the server.
+*/
+var mmVirtualTable = (function () {
+    var PAGE_ROWS = 200;
+    var MARGIN_ROWS = 30;
+
+    function VirtualTable(tbody) {
+        this.tbody = tbody;
+        this.table = tbody.parentNode;
+        this.url = tbody.getAttribute('data-rows');
+        this.total = parseInt(tbody.getAttribute('data-total'), 10);
+        this.columns = this.table.tHead ? this.table.tHead.rows[0].cells.length : 1;
+        this.rowHeight = 0;
+        this.sortColumn = -1;
+        this.sortDesc = false;
+        this.generation = 0;
+        this.reset();
+
+        // the rows are sorted on the server, not by sorttable.js
+        this.table.className = this.table.className.replace(/\bsortable\b/, '');
+        if (this.table.tHead) this.bindHeader(this.table.tHead.rows[0]);
+
+        var self = this, pending = false;
+        var onScroll = function () {
+            if (pending) return;
+            pending = true;
+            window.setTimeout(function () { pending = false; self.update(); }, 50);
+        };
+        window.addEventListener('scroll', onScroll);
+        window.addEventListener('resize', onScroll);
+        this.update();
+    }
+
+    VirtualTable.prototype.reset = function () {
+        this.pages = {};
+        this.loading = {};
+        this.first = -1;
+        this.last = -1;
+        this.generation++;
+    };
+
+    VirtualTable.prototype.bindHeader = function (row) {
+        var self = this;
+        for (var i = 0; i < row.cells.length; i++) {
+            (function (cell, column) {
+                cell.style.cursor = 'pointer';
+                cell.addEventListener('click', function () { self.sort(column, cell); });
+            })(row.cells[i], i);
+        }
+    };
+
+    VirtualTable.prototype.sort = function (column, cell) {
+        this.sortDesc = column === this.sortColumn ? !this.sortDesc : false;
+        this.sortColumn = column;
+
+        var old = this.table.tHead.getElementsByClassName('vt-sortind');
+        while (old.length) old[0].parentNode.removeChild(old[0]);
+        var indicator = document.createElement('span');
+        indicator.className = 'vt-sortind';
+        indicator.innerHTML = this.sortDesc ? '&nbsp;&#x25B4;' : '&nbsp;&#x25BE;';
+        cell.appendChild(indicator);
+
+        this.reset();
+        this.update();
+    };
+
+    VirtualTable.prototype.load = function (page) {
+        if (this.loading[page]) return;
+        this.loading[page] = true;
+
+        var self = this, generation = this.generation;
+        var request = new XMLHttpRequest();
+        request.open('GET', this.url + '?offset=' + page * PAGE_ROWS + '&limit=' + PAGE_ROWS
+            + '&sort=' + this.sortColumn + '&desc=' + (this.sortDesc ? 1 : 0));
+        request.onload = function () {
+            if (generation !== self.generation || request.status !== 200) return;
+            var result = JSON.parse(request.responseText);
+            self.total = result.total;
+            self.pages[page] = result.rows;
+            self.update();
+        };
+        request.send();
+    };
+
+    VirtualTable.prototype.update = function () {
+        var height = this.rowHeight || 24;
+        var scrolled = Math.max(0, -this.tbody.getBoundingClientRect().top);
+        var view = window.innerHeight || document.documentElement.clientHeight;
+        var first = Math.max(0, Math.floor(scrolled / height) - MARGIN_ROWS);
+        var last = Math.min(this.total, Math.ceil((scrolled + view) / height) + MARGIN_ROWS);
+
+        var ready = true;
+        for (var p = Math.floor(first / PAGE_ROWS); p * PAGE_ROWS < last; p++) {
+            if (!this.pages[p]) {
+                this.load(p);
+                ready = false;
+            }
+        }
+        if (!ready || (first === this.first && last === this.last)) return;
+        this.first = first;
+        this.last = last;
+
+        var html = [this.spacer(first * height)];
+        for (var i = first; i < last; i++)
+            html.push(this.pages[Math.floor(i / PAGE_ROWS)][i % PAGE_ROWS]);
+        html.push(this.spacer((this.total - last) * height));
+        this.render(html.join(''));
+
+        if (!this.rowHeight && last > first) {
+            this.rowHeight = this.tbody.rows[1].offsetHeight || height;
+            if (this.rowHeight !== height) {
+                this.first = -1;
+                this.update();
+            }
+        }
+    };
+
+    VirtualTable.prototype.spacer = function (height) {
+        return '<tr class="vt-spacer" style="height:' + height + 'px"><td colspan="'
+            + this.columns + '" style="padding:0;border:0"></td></tr>';
+    };
+
+    // tbody.innerHTML is read only in Internet Explorer, the rows are parsed in a scratch table
+    VirtualTable.prototype.render = function (rows) {
+        var scratch = document.createElement('div');
+        scratch.innerHTML = '<table><tbody>' + rows + '</tbody></table>';
+        var source = scratch.firstChild.tBodies[0];
+        while (this.tbody.firstChild) this.tbody.removeChild(this.tbody.firstChild);
+        while (source.firstChild) this.tbody.appendChild(source.firstChild);
+    };
+
+    return {
+        attach: function (id) {
+            var tbody = document.getElementById(id);
+            if (tbody) new VirtualTable(tbody);
+        }
+    };
+})();
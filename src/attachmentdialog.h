@@ -20,6 +20,7 @@
 #define MM_EX_ATTACHMENTDIALOG_H_
 
 #include "defs.h"
+#include "mmattachment.h"
 #include <wx/dataview.h>
 #include <map>
 
@@ -81,20 +82,4 @@ private:
     bool debug_;
 };
 
-class mmAttachmentManage
-{
-public:
-    static wxString InfotablePathSetting();
-    static wxString GetAttachmentNoteSign();
-    static bool CreateReadmeFile(const wxString& FolderPath);
-    static bool CopyAttachment(const wxString& FileToImport, const wxString& ImportedFile);
-    static bool DeleteAttachment(const wxString& FileToDelete);
-    static bool OpenAttachment(const wxString& FileToOpen);
-    static bool DeleteAllAttachments(const wxString& RefType, int RefId);
-    static bool RelocateAllAttachments(const wxString& RefType, int OldRefId, int NewRefId);
-    static void OpenAttachmentFromPanelIcon(wxWindow* parent, const wxString& RefType, int RefId);
-private:
-    static wxString m_PathSep;
-};
-
 #endif // MM_EX_ATTACHMENTDIALOG_H_
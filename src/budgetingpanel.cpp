@@ -381,14 +381,10 @@ void mmBudgetingPanel::initVirtualListControl()
     Option::instance().setBudgetDateOffset(dtBegin);
     m_budget_offset_date = dtBegin.FormatISODate();
     Option::instance().setBudgetDateOffset(dtEnd); */
-    mmSpecifiedRange date_range(dtBegin, dtEnd);
 
-    //Get statistics
+    //Get statistics, kept up to date by the update hook instead of a scan of the period
     Model_Budget::instance().getBudgetEntry(budgetYearID_, budgetPeriod_, budgetAmt_);
-    Model_Category::instance().getCategoryStats(categoryStats_
-        , nullptr
-        , &date_range, Option::instance().getIgnoreFutureTransactions()
-        , false, (evaluateTransfer ? &budgetAmt_ : 0));
+    const Model_BudgetActual::Sums actuals = Model_BudgetActual::instance().totals(dtBegin, dtEnd);
 
     const Model_Subcategory::Data_Set& allSubcategories = Model_Subcategory::instance().all(Model_Subcategory::COL_SUBCATEGNAME);
     for (const auto& category : Model_Category::instance().all(Model_Category::COL_CATEGNAME))
@@ -399,6 +395,8 @@ void mmBudgetingPanel::initVirtualListControl()
         else
             estIncome += estimated;
 
+        categoryStats_[category.CATEGID][-1][0] = Model_BudgetActual::actual(actuals
+            , category.CATEGID, -1, evaluateTransfer, budgetAmt_[category.CATEGID][-1]);
         double actual = 0;
         if (currentView_ != VIEW_PLANNED || estimated != 0)
         {
@@ -428,6 +426,8 @@ void mmBudgetingPanel::initVirtualListControl()
             else
                 estIncome += estimated;
 
+            categoryStats_[category.CATEGID][subcategory.SUBCATEGID][0] = Model_BudgetActual::actual(actuals
+                , category.CATEGID, subcategory.SUBCATEGID, evaluateTransfer, budgetAmt_[category.CATEGID][subcategory.SUBCATEGID]);
             actual = 0;
             if (currentView_ != VIEW_PLANNED || estimated != 0)
             {
@@ -46,9 +46,13 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
-    typedef std::map<int, Self::Data*> Index_By_Id;
+    /** Cached records by id, with the small ids in a vector, see DB_Id_Index */
+    typedef DB_Id_Index<Self::Data> Index_By_Id;
     Cache cache_;
     Index_By_Id index_by_id_;
     Data* fake_; // in case the entity not found
@@ -402,6 +406,31 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
             MINIMUMPAYMENT = q.GetDouble(19); // MINIMUMPAYMENT
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            ACCOUNTID = q.GetInt(0); // ACCOUNTID
+            ACCOUNTNAME = q.GetString(1); // ACCOUNTNAME
+            ACCOUNTTYPE = q.GetString(2); // ACCOUNTTYPE
+            ACCOUNTNUM = q.GetString(3); // ACCOUNTNUM
+            STATUS = q.GetString(4); // STATUS
+            NOTES = q.GetString(5); // NOTES
+            HELDAT = q.GetString(6); // HELDAT
+            WEBSITE = q.GetString(7); // WEBSITE
+            CONTACTINFO = q.GetString(8); // CONTACTINFO
+            ACCESSINFO = q.GetString(9); // ACCESSINFO
+            INITIALBAL = q.GetDouble(10); // INITIALBAL
+            FAVORITEACCT = q.GetString(11); // FAVORITEACCT
+            CURRENCYID = q.GetInt(12); // CURRENCYID
+            STATEMENTLOCKED = q.GetInt(13); // STATEMENTLOCKED
+            STATEMENTDATE = q.GetString(14); // STATEMENTDATE
+            MINIMUMBALANCE = q.GetDouble(15); // MINIMUMBALANCE
+            CREDITLIMIT = q.GetDouble(16); // CREDITLIMIT
+            INTERESTRATE = q.GetDouble(17); // INTERESTRATE
+            PAYMENTDUEDATE = q.GetString(18); // PAYMENTDUEDATE
+            MINIMUMPAYMENT = q.GetDouble(19); // MINIMUMPAYMENT
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -535,6 +564,106 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
             return this->MINIMUMPAYMENT == in.v_;
         }
 
+        void set(const Self::ACCOUNTID &in)
+        {
+            this->ACCOUNTID = in.v_;
+        }
+
+        void set(const Self::ACCOUNTNAME &in)
+        {
+            this->ACCOUNTNAME = in.v_;
+        }
+
+        void set(const Self::ACCOUNTTYPE &in)
+        {
+            this->ACCOUNTTYPE = in.v_;
+        }
+
+        void set(const Self::ACCOUNTNUM &in)
+        {
+            this->ACCOUNTNUM = in.v_;
+        }
+
+        void set(const Self::STATUS &in)
+        {
+            this->STATUS = in.v_;
+        }
+
+        void set(const Self::NOTES &in)
+        {
+            this->NOTES = in.v_;
+        }
+
+        void set(const Self::HELDAT &in)
+        {
+            this->HELDAT = in.v_;
+        }
+
+        void set(const Self::WEBSITE &in)
+        {
+            this->WEBSITE = in.v_;
+        }
+
+        void set(const Self::CONTACTINFO &in)
+        {
+            this->CONTACTINFO = in.v_;
+        }
+
+        void set(const Self::ACCESSINFO &in)
+        {
+            this->ACCESSINFO = in.v_;
+        }
+
+        void set(const Self::INITIALBAL &in)
+        {
+            this->INITIALBAL = in.v_;
+        }
+
+        void set(const Self::FAVORITEACCT &in)
+        {
+            this->FAVORITEACCT = in.v_;
+        }
+
+        void set(const Self::CURRENCYID &in)
+        {
+            this->CURRENCYID = in.v_;
+        }
+
+        void set(const Self::STATEMENTLOCKED &in)
+        {
+            this->STATEMENTLOCKED = in.v_;
+        }
+
+        void set(const Self::STATEMENTDATE &in)
+        {
+            this->STATEMENTDATE = in.v_;
+        }
+
+        void set(const Self::MINIMUMBALANCE &in)
+        {
+            this->MINIMUMBALANCE = in.v_;
+        }
+
+        void set(const Self::CREDITLIMIT &in)
+        {
+            this->CREDITLIMIT = in.v_;
+        }
+
+        void set(const Self::INTERESTRATE &in)
+        {
+            this->INTERESTRATE = in.v_;
+        }
+
+        void set(const Self::PAYMENTDUEDATE &in)
+        {
+            this->PAYMENTDUEDATE = in.v_;
+        }
+
+        void set(const Self::MINIMUMPAYMENT &in)
+        {
+            this->MINIMUMPAYMENT = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -725,6 +854,7 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->ACCOUNTNAME);
@@ -749,7 +879,7 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(20, entity->ACCOUNTID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -776,6 +906,58 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO ACCOUNTLIST_V1(ACCOUNTNAME, ACCOUNTTYPE, ACCOUNTNUM, STATUS, NOTES, HELDAT, WEBSITE, CONTACTINFO, ACCESSINFO, INITIALBAL, FAVORITEACCT, CURRENCYID, STATEMENTLOCKED, STATEMENTDATE, MINIMUMBALANCE, CREDITLIMIT, INTERESTRATE, PAYMENTDUEDATE, MINIMUMPAYMENT) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->ACCOUNTNAME);
+                stmt.Bind(2, entity->ACCOUNTTYPE);
+                stmt.Bind(3, entity->ACCOUNTNUM);
+                stmt.Bind(4, entity->STATUS);
+                stmt.Bind(5, entity->NOTES);
+                stmt.Bind(6, entity->HELDAT);
+                stmt.Bind(7, entity->WEBSITE);
+                stmt.Bind(8, entity->CONTACTINFO);
+                stmt.Bind(9, entity->ACCESSINFO);
+                stmt.Bind(10, entity->INITIALBAL);
+                stmt.Bind(11, entity->FAVORITEACCT);
+                stmt.Bind(12, entity->CURRENCYID);
+                stmt.Bind(13, entity->STATEMENTLOCKED);
+                stmt.Bind(14, entity->STATEMENTDATE);
+                stmt.Bind(15, entity->MINIMUMBALANCE);
+                stmt.Bind(16, entity->CREDITLIMIT);
+                stmt.Bind(17, entity->INTERESTRATE);
+                stmt.Bind(18, entity->PAYMENTDUEDATE);
+                stmt.Bind(19, entity->MINIMUMPAYMENT);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("ACCOUNTLIST_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -783,9 +965,10 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM ACCOUNTLIST_V1 WHERE ACCOUNTID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -856,11 +1039,11 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -868,12 +1051,14 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -903,7 +1088,8 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -912,6 +1098,7 @@ struct DB_Table_ACCOUNTLIST_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -46,6 +46,9 @@ struct DB_Table_ASSETS_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -265,6 +268,19 @@ struct DB_Table_ASSETS_V1 : public DB_Table
             ASSETTYPE = q.GetString(7); // ASSETTYPE
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            ASSETID = q.GetInt(0); // ASSETID
+            STARTDATE = q.GetString(1); // STARTDATE
+            ASSETNAME = q.GetString(2); // ASSETNAME
+            VALUE = q.GetDouble(3); // VALUE
+            VALUECHANGE = q.GetString(4); // VALUECHANGE
+            NOTES = q.GetString(5); // NOTES
+            VALUECHANGERATE = q.GetDouble(6); // VALUECHANGERATE
+            ASSETTYPE = q.GetString(7); // ASSETTYPE
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -326,6 +342,46 @@ struct DB_Table_ASSETS_V1 : public DB_Table
             return this->ASSETTYPE.CmpNoCase(in.v_) == 0;
         }
 
+        void set(const Self::ASSETID &in)
+        {
+            this->ASSETID = in.v_;
+        }
+
+        void set(const Self::STARTDATE &in)
+        {
+            this->STARTDATE = in.v_;
+        }
+
+        void set(const Self::ASSETNAME &in)
+        {
+            this->ASSETNAME = in.v_;
+        }
+
+        void set(const Self::VALUE &in)
+        {
+            this->VALUE = in.v_;
+        }
+
+        void set(const Self::VALUECHANGE &in)
+        {
+            this->VALUECHANGE = in.v_;
+        }
+
+        void set(const Self::NOTES &in)
+        {
+            this->NOTES = in.v_;
+        }
+
+        void set(const Self::VALUECHANGERATE &in)
+        {
+            this->VALUECHANGERATE = in.v_;
+        }
+
+        void set(const Self::ASSETTYPE &in)
+        {
+            this->ASSETTYPE = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -468,6 +524,7 @@ struct DB_Table_ASSETS_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->STARTDATE);
@@ -480,7 +537,7 @@ struct DB_Table_ASSETS_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(8, entity->ASSETID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -507,6 +564,46 @@ struct DB_Table_ASSETS_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO ASSETS_V1(STARTDATE, ASSETNAME, VALUE, VALUECHANGE, NOTES, VALUECHANGERATE, ASSETTYPE) VALUES(?, ?, ?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->STARTDATE);
+                stmt.Bind(2, entity->ASSETNAME);
+                stmt.Bind(3, entity->VALUE);
+                stmt.Bind(4, entity->VALUECHANGE);
+                stmt.Bind(5, entity->NOTES);
+                stmt.Bind(6, entity->VALUECHANGERATE);
+                stmt.Bind(7, entity->ASSETTYPE);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("ASSETS_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -514,9 +611,10 @@ struct DB_Table_ASSETS_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM ASSETS_V1 WHERE ASSETID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -587,11 +685,11 @@ struct DB_Table_ASSETS_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -599,12 +697,14 @@ struct DB_Table_ASSETS_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -634,7 +734,8 @@ struct DB_Table_ASSETS_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -643,6 +744,7 @@ struct DB_Table_ASSETS_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
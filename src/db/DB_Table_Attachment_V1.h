@@ -46,6 +46,9 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -231,6 +234,16 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
             FILENAME = q.GetString(4); // FILENAME
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            ATTACHMENTID = q.GetInt(0); // ATTACHMENTID
+            REFTYPE = q.GetString(1); // REFTYPE
+            REFID = q.GetInt(2); // REFID
+            DESCRIPTION = q.GetString(3); // DESCRIPTION
+            FILENAME = q.GetString(4); // FILENAME
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -274,6 +287,31 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
             return this->FILENAME.CmpNoCase(in.v_) == 0;
         }
 
+        void set(const Self::ATTACHMENTID &in)
+        {
+            this->ATTACHMENTID = in.v_;
+        }
+
+        void set(const Self::REFTYPE &in)
+        {
+            this->REFTYPE = in.v_;
+        }
+
+        void set(const Self::REFID &in)
+        {
+            this->REFID = in.v_;
+        }
+
+        void set(const Self::DESCRIPTION &in)
+        {
+            this->DESCRIPTION = in.v_;
+        }
+
+        void set(const Self::FILENAME &in)
+        {
+            this->FILENAME = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -404,6 +442,7 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->REFTYPE);
@@ -413,7 +452,7 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(5, entity->ATTACHMENTID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -440,6 +479,43 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO ATTACHMENT_V1(REFTYPE, REFID, DESCRIPTION, FILENAME) VALUES(?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->REFTYPE);
+                stmt.Bind(2, entity->REFID);
+                stmt.Bind(3, entity->DESCRIPTION);
+                stmt.Bind(4, entity->FILENAME);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("ATTACHMENT_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -447,9 +523,10 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM ATTACHMENT_V1 WHERE ATTACHMENTID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -520,11 +597,11 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -532,12 +609,14 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -567,7 +646,8 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -576,6 +656,7 @@ struct DB_Table_ATTACHMENT_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -46,6 +46,9 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -372,6 +375,28 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
             NUMOCCURRENCES = q.GetInt(16); // NUMOCCURRENCES
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            BDID = q.GetInt(0); // BDID
+            ACCOUNTID = q.GetInt(1); // ACCOUNTID
+            TOACCOUNTID = q.GetInt(2); // TOACCOUNTID
+            PAYEEID = q.GetInt(3); // PAYEEID
+            TRANSCODE = q.GetString(4); // TRANSCODE
+            TRANSAMOUNT = q.GetDouble(5); // TRANSAMOUNT
+            STATUS = q.GetString(6); // STATUS
+            TRANSACTIONNUMBER = q.GetString(7); // TRANSACTIONNUMBER
+            NOTES = q.GetString(8); // NOTES
+            CATEGID = q.GetInt(9); // CATEGID
+            SUBCATEGID = q.GetInt(10); // SUBCATEGID
+            TRANSDATE = q.GetString(11); // TRANSDATE
+            FOLLOWUPID = q.GetInt(12); // FOLLOWUPID
+            TOTRANSAMOUNT = q.GetDouble(13); // TOTRANSAMOUNT
+            REPEATS = q.GetInt(14); // REPEATS
+            NEXTOCCURRENCEDATE = q.GetString(15); // NEXTOCCURRENCEDATE
+            NUMOCCURRENCES = q.GetInt(16); // NUMOCCURRENCES
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -487,6 +512,91 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
             return this->NUMOCCURRENCES == in.v_;
         }
 
+        void set(const Self::BDID &in)
+        {
+            this->BDID = in.v_;
+        }
+
+        void set(const Self::ACCOUNTID &in)
+        {
+            this->ACCOUNTID = in.v_;
+        }
+
+        void set(const Self::TOACCOUNTID &in)
+        {
+            this->TOACCOUNTID = in.v_;
+        }
+
+        void set(const Self::PAYEEID &in)
+        {
+            this->PAYEEID = in.v_;
+        }
+
+        void set(const Self::TRANSCODE &in)
+        {
+            this->TRANSCODE = in.v_;
+        }
+
+        void set(const Self::TRANSAMOUNT &in)
+        {
+            this->TRANSAMOUNT = in.v_;
+        }
+
+        void set(const Self::STATUS &in)
+        {
+            this->STATUS = in.v_;
+        }
+
+        void set(const Self::TRANSACTIONNUMBER &in)
+        {
+            this->TRANSACTIONNUMBER = in.v_;
+        }
+
+        void set(const Self::NOTES &in)
+        {
+            this->NOTES = in.v_;
+        }
+
+        void set(const Self::CATEGID &in)
+        {
+            this->CATEGID = in.v_;
+        }
+
+        void set(const Self::SUBCATEGID &in)
+        {
+            this->SUBCATEGID = in.v_;
+        }
+
+        void set(const Self::TRANSDATE &in)
+        {
+            this->TRANSDATE = in.v_;
+        }
+
+        void set(const Self::FOLLOWUPID &in)
+        {
+            this->FOLLOWUPID = in.v_;
+        }
+
+        void set(const Self::TOTRANSAMOUNT &in)
+        {
+            this->TOTRANSAMOUNT = in.v_;
+        }
+
+        void set(const Self::REPEATS &in)
+        {
+            this->REPEATS = in.v_;
+        }
+
+        void set(const Self::NEXTOCCURRENCEDATE &in)
+        {
+            this->NEXTOCCURRENCEDATE = in.v_;
+        }
+
+        void set(const Self::NUMOCCURRENCES &in)
+        {
+            this->NUMOCCURRENCES = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -665,6 +775,7 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->ACCOUNTID);
@@ -686,7 +797,7 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(17, entity->BDID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -713,6 +824,55 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO BILLSDEPOSITS_V1(ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, STATUS, TRANSACTIONNUMBER, NOTES, CATEGID, SUBCATEGID, TRANSDATE, FOLLOWUPID, TOTRANSAMOUNT, REPEATS, NEXTOCCURRENCEDATE, NUMOCCURRENCES) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->ACCOUNTID);
+                stmt.Bind(2, entity->TOACCOUNTID);
+                stmt.Bind(3, entity->PAYEEID);
+                stmt.Bind(4, entity->TRANSCODE);
+                stmt.Bind(5, entity->TRANSAMOUNT);
+                stmt.Bind(6, entity->STATUS);
+                stmt.Bind(7, entity->TRANSACTIONNUMBER);
+                stmt.Bind(8, entity->NOTES);
+                stmt.Bind(9, entity->CATEGID);
+                stmt.Bind(10, entity->SUBCATEGID);
+                stmt.Bind(11, entity->TRANSDATE);
+                stmt.Bind(12, entity->FOLLOWUPID);
+                stmt.Bind(13, entity->TOTRANSAMOUNT);
+                stmt.Bind(14, entity->REPEATS);
+                stmt.Bind(15, entity->NEXTOCCURRENCEDATE);
+                stmt.Bind(16, entity->NUMOCCURRENCES);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("BILLSDEPOSITS_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -720,9 +880,10 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM BILLSDEPOSITS_V1 WHERE BDID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -793,11 +954,11 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -805,12 +966,14 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -840,7 +1003,8 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -849,6 +1013,7 @@ struct DB_Table_BILLSDEPOSITS_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
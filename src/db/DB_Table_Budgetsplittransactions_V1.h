@@ -46,6 +46,9 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -234,6 +237,16 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
             SPLITTRANSAMOUNT = q.GetDouble(4); // SPLITTRANSAMOUNT
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            SPLITTRANSID = q.GetInt(0); // SPLITTRANSID
+            TRANSID = q.GetInt(1); // TRANSID
+            CATEGID = q.GetInt(2); // CATEGID
+            SUBCATEGID = q.GetInt(3); // SUBCATEGID
+            SPLITTRANSAMOUNT = q.GetDouble(4); // SPLITTRANSAMOUNT
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -277,6 +290,31 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
             return this->SPLITTRANSAMOUNT == in.v_;
         }
 
+        void set(const Self::SPLITTRANSID &in)
+        {
+            this->SPLITTRANSID = in.v_;
+        }
+
+        void set(const Self::TRANSID &in)
+        {
+            this->TRANSID = in.v_;
+        }
+
+        void set(const Self::CATEGID &in)
+        {
+            this->CATEGID = in.v_;
+        }
+
+        void set(const Self::SUBCATEGID &in)
+        {
+            this->SUBCATEGID = in.v_;
+        }
+
+        void set(const Self::SPLITTRANSAMOUNT &in)
+        {
+            this->SPLITTRANSAMOUNT = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -407,6 +445,7 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->TRANSID);
@@ -416,7 +455,7 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(5, entity->SPLITTRANSID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -443,6 +482,43 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO BUDGETSPLITTRANSACTIONS_V1(TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT) VALUES(?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->TRANSID);
+                stmt.Bind(2, entity->CATEGID);
+                stmt.Bind(3, entity->SUBCATEGID);
+                stmt.Bind(4, entity->SPLITTRANSAMOUNT);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("BUDGETSPLITTRANSACTIONS_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -450,9 +526,10 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM BUDGETSPLITTRANSACTIONS_V1 WHERE SPLITTRANSID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -523,11 +600,11 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -535,12 +612,14 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -570,7 +649,8 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -579,6 +659,7 @@ struct DB_Table_BUDGETSPLITTRANSACTIONS_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -46,6 +46,9 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -338,6 +341,25 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
             TOTRANSAMOUNT = q.GetDouble(13); // TOTRANSAMOUNT
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            TRANSID = q.GetInt(0); // TRANSID
+            ACCOUNTID = q.GetInt(1); // ACCOUNTID
+            TOACCOUNTID = q.GetInt(2); // TOACCOUNTID
+            PAYEEID = q.GetInt(3); // PAYEEID
+            TRANSCODE = q.GetString(4); // TRANSCODE
+            TRANSAMOUNT = q.GetDouble(5); // TRANSAMOUNT
+            STATUS = q.GetString(6); // STATUS
+            TRANSACTIONNUMBER = q.GetString(7); // TRANSACTIONNUMBER
+            NOTES = q.GetString(8); // NOTES
+            CATEGID = q.GetInt(9); // CATEGID
+            SUBCATEGID = q.GetInt(10); // SUBCATEGID
+            TRANSDATE = q.GetString(11); // TRANSDATE
+            FOLLOWUPID = q.GetInt(12); // FOLLOWUPID
+            TOTRANSAMOUNT = q.GetDouble(13); // TOTRANSAMOUNT
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -435,6 +457,76 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
             return this->TOTRANSAMOUNT == in.v_;
         }
 
+        void set(const Self::TRANSID &in)
+        {
+            this->TRANSID = in.v_;
+        }
+
+        void set(const Self::ACCOUNTID &in)
+        {
+            this->ACCOUNTID = in.v_;
+        }
+
+        void set(const Self::TOACCOUNTID &in)
+        {
+            this->TOACCOUNTID = in.v_;
+        }
+
+        void set(const Self::PAYEEID &in)
+        {
+            this->PAYEEID = in.v_;
+        }
+
+        void set(const Self::TRANSCODE &in)
+        {
+            this->TRANSCODE = in.v_;
+        }
+
+        void set(const Self::TRANSAMOUNT &in)
+        {
+            this->TRANSAMOUNT = in.v_;
+        }
+
+        void set(const Self::STATUS &in)
+        {
+            this->STATUS = in.v_;
+        }
+
+        void set(const Self::TRANSACTIONNUMBER &in)
+        {
+            this->TRANSACTIONNUMBER = in.v_;
+        }
+
+        void set(const Self::NOTES &in)
+        {
+            this->NOTES = in.v_;
+        }
+
+        void set(const Self::CATEGID &in)
+        {
+            this->CATEGID = in.v_;
+        }
+
+        void set(const Self::SUBCATEGID &in)
+        {
+            this->SUBCATEGID = in.v_;
+        }
+
+        void set(const Self::TRANSDATE &in)
+        {
+            this->TRANSDATE = in.v_;
+        }
+
+        void set(const Self::FOLLOWUPID &in)
+        {
+            this->FOLLOWUPID = in.v_;
+        }
+
+        void set(const Self::TOTRANSAMOUNT &in)
+        {
+            this->TOTRANSAMOUNT = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -550,6 +642,162 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         }
     };
 
+    /**
+    * Compact read only copy of many records. The records are fixed size PODs
+    * in one array, the TEXT columns are offsets of UTF-8 strings in a pool
+    * shared by the set and the columns with a few known values are enums.
+    * Iterating yields Data records built on the fly, so code written for a
+    * Data_Set compiles unchanged. row() converts only the columns it reads.
+    */
+    struct Compact_Set
+    {
+        enum TRANSCODE_CODE
+        {
+            TRANSCODE_WITHDRAWAL = 0, // "Withdrawal"
+            TRANSCODE_DEPOSIT, // "Deposit"
+            TRANSCODE_TRANSFER, // "Transfer"
+            TRANSCODE_KNOWN // first code of the other values
+        };
+        enum STATUS_CODE
+        {
+            STATUS_NONE = 0, // ""
+            STATUS_RECONCILED, // "R"
+            STATUS_VOID, // "V"
+            STATUS_FOLLOWUP, // "F"
+            STATUS_DUPLICATE, // "D"
+            STATUS_KNOWN // first code of the other values
+        };
+
+        struct Record
+        {
+            double TRANSAMOUNT;
+            double TOTRANSAMOUNT;
+            int TRANSID;
+            int ACCOUNTID;
+            int TOACCOUNTID;
+            int PAYEEID;
+            DB_String_Pool::Offset TRANSACTIONNUMBER;
+            DB_String_Pool::Offset NOTES;
+            int CATEGID;
+            int SUBCATEGID;
+            DB_String_Pool::Offset TRANSDATE;
+            int FOLLOWUPID;
+            unsigned char TRANSCODE;
+            unsigned char STATUS;
+        };
+
+        /** Lazy accessors of one record, a TEXT column is converted on each call */
+        struct Row
+        {
+            const Compact_Set* set_;
+            const Record* r_;
+
+            int TRANSID() const { return r_->TRANSID; }
+            int ACCOUNTID() const { return r_->ACCOUNTID; }
+            int TOACCOUNTID() const { return r_->TOACCOUNTID; }
+            int PAYEEID() const { return r_->PAYEEID; }
+            const wxString& TRANSCODE() const { return set_->TRANSCODE_.get(r_->TRANSCODE); }
+            TRANSCODE_CODE TRANSCODE_code() const { return static_cast<TRANSCODE_CODE>(r_->TRANSCODE); }
+            double TRANSAMOUNT() const { return r_->TRANSAMOUNT; }
+            const wxString& STATUS() const { return set_->STATUS_.get(r_->STATUS); }
+            STATUS_CODE STATUS_code() const { return static_cast<STATUS_CODE>(r_->STATUS); }
+            wxString TRANSACTIONNUMBER() const { return set_->pool_.get(r_->TRANSACTIONNUMBER); }
+            wxString NOTES() const { return set_->pool_.get(r_->NOTES); }
+            int CATEGID() const { return r_->CATEGID; }
+            int SUBCATEGID() const { return r_->SUBCATEGID; }
+            wxString TRANSDATE() const { return set_->pool_.get(r_->TRANSDATE); }
+            int FOLLOWUPID() const { return r_->FOLLOWUPID; }
+            double TOTRANSAMOUNT() const { return r_->TOTRANSAMOUNT; }
+        };
+
+        struct const_iterator
+        {
+            const Compact_Set* set_;
+            size_t i_;
+
+            Data operator*() const { return set_->data(i_); }
+            const_iterator& operator++() { ++i_; return *this; }
+            bool operator==(const const_iterator& other) const { return i_ == other.i_; }
+            bool operator!=(const const_iterator& other) const { return i_ != other.i_; }
+        };
+
+        Compact_Set()
+        {
+            TRANSCODE_.add("Withdrawal");
+            TRANSCODE_.add("Deposit");
+            TRANSCODE_.add("Transfer");
+            STATUS_.add("");
+            STATUS_.add("R");
+            STATUS_.add("V");
+            STATUS_.add("F");
+            STATUS_.add("D");
+        }
+
+        size_t size() const { return records_.size(); }
+        bool empty() const { return records_.empty(); }
+        void reserve(size_t n) { records_.reserve(n); }
+        const_iterator begin() const { const_iterator it = { this, 0 }; return it; }
+        const_iterator end() const { const_iterator it = { this, records_.size() }; return it; }
+        Data operator[](size_t i) const { return data(i); }
+        Row row(size_t i) const { Row r = { this, &records_[i] }; return r; }
+
+        /** Append the current row of the result set, as Data(q) would read it */
+        void push_back(wxSQLite3ResultSet& q)
+        {
+            Record r;
+            r.TRANSID = q.GetInt(0); // TRANSID
+            r.ACCOUNTID = q.GetInt(1); // ACCOUNTID
+            r.TOACCOUNTID = q.GetInt(2); // TOACCOUNTID
+            r.PAYEEID = q.GetInt(3); // PAYEEID
+            r.TRANSCODE = TRANSCODE_.add(q.GetString(4)); // TRANSCODE
+            r.TRANSAMOUNT = q.GetDouble(5); // TRANSAMOUNT
+            r.STATUS = STATUS_.add(q.GetString(6)); // STATUS
+            r.TRANSACTIONNUMBER = pool_.add(q.GetString(7)); // TRANSACTIONNUMBER
+            r.NOTES = pool_.add(q.GetString(8)); // NOTES
+            r.CATEGID = q.GetInt(9); // CATEGID
+            r.SUBCATEGID = q.GetInt(10); // SUBCATEGID
+            r.TRANSDATE = pool_.add(q.GetString(11)); // TRANSDATE
+            r.FOLLOWUPID = q.GetInt(12); // FOLLOWUPID
+            r.TOTRANSAMOUNT = q.GetDouble(13); // TOTRANSAMOUNT
+            records_.push_back(r);
+        }
+
+        /** Build the Data record, it does not belong to the table cache */
+        Data data(size_t i) const
+        {
+            const Record& r = records_[i];
+            Data d;
+            d.TRANSID = r.TRANSID;
+            d.ACCOUNTID = r.ACCOUNTID;
+            d.TOACCOUNTID = r.TOACCOUNTID;
+            d.PAYEEID = r.PAYEEID;
+            d.TRANSCODE = TRANSCODE_.get(r.TRANSCODE);
+            d.TRANSAMOUNT = r.TRANSAMOUNT;
+            d.STATUS = STATUS_.get(r.STATUS);
+            d.TRANSACTIONNUMBER = pool_.get(r.TRANSACTIONNUMBER);
+            d.NOTES = pool_.get(r.NOTES);
+            d.CATEGID = r.CATEGID;
+            d.SUBCATEGID = r.SUBCATEGID;
+            d.TRANSDATE = pool_.get(r.TRANSDATE);
+            d.FOLLOWUPID = r.FOLLOWUPID;
+            d.TOTRANSAMOUNT = r.TOTRANSAMOUNT;
+            return d;
+        }
+
+        /** Release the unused capacity once the set is complete */
+        void shrink()
+        {
+            records_.shrink_to_fit();
+            pool_.shrink();
+        }
+
+    private:
+        std::vector<Record> records_;
+        DB_String_Pool pool_;
+        DB_String_Dict TRANSCODE_;
+        DB_String_Dict STATUS_;
+    };
+
     enum
     {
         NUM_COLUMNS = 14
@@ -601,6 +849,7 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->ACCOUNTID);
@@ -619,7 +868,7 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(14, entity->TRANSID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -646,6 +895,52 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO CHECKINGACCOUNT_V1(ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, STATUS, TRANSACTIONNUMBER, NOTES, CATEGID, SUBCATEGID, TRANSDATE, FOLLOWUPID, TOTRANSAMOUNT) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->ACCOUNTID);
+                stmt.Bind(2, entity->TOACCOUNTID);
+                stmt.Bind(3, entity->PAYEEID);
+                stmt.Bind(4, entity->TRANSCODE);
+                stmt.Bind(5, entity->TRANSAMOUNT);
+                stmt.Bind(6, entity->STATUS);
+                stmt.Bind(7, entity->TRANSACTIONNUMBER);
+                stmt.Bind(8, entity->NOTES);
+                stmt.Bind(9, entity->CATEGID);
+                stmt.Bind(10, entity->SUBCATEGID);
+                stmt.Bind(11, entity->TRANSDATE);
+                stmt.Bind(12, entity->FOLLOWUPID);
+                stmt.Bind(13, entity->TOTRANSAMOUNT);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("CHECKINGACCOUNT_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -653,9 +948,10 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM CHECKINGACCOUNT_V1 WHERE TRANSID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -726,11 +1022,11 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -738,12 +1034,14 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -773,7 +1071,8 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -782,6 +1081,35 @@ struct DB_Table_CHECKINGACCOUNT_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return result;
+    }
+
+    /** Return all records in a Compact_Set, read directly from the database */
+    const Compact_Set all_compact(wxSQLite3Database* db)
+    {
+        Compact_Set result;
+        try
+        {
+            // the records are allocated once, at their final size
+            wxSQLite3ResultSet q = db->ExecuteQuery("SELECT COUNT(*) FROM " + this->name());
+            if (q.NextRow()) result.reserve(q.GetInt(0));
+            q.Finalize();
+
+            DB_Query_Timer timer(this->query(), db);
+            q = db->ExecuteQuery(timer.shape_);
+            while(q.NextRow())
+                result.push_back(q);
+
+            q.Finalize();
+            result.shrink();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -46,9 +46,13 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
-    typedef std::map<int, Self::Data*> Index_By_Id;
+    /** Cached records by id, with the small ids in a vector, see DB_Id_Index */
+    typedef DB_Id_Index<Self::Data> Index_By_Id;
     Cache cache_;
     Index_By_Id index_by_id_;
     Data* fake_; // in case the entity not found
@@ -451,6 +455,22 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
             CURRENCY_SYMBOL = q.GetString(10); // CURRENCY_SYMBOL
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            CURRENCYID = q.GetInt(0); // CURRENCYID
+            CURRENCYNAME = q.GetString(1); // CURRENCYNAME
+            PFX_SYMBOL = q.GetString(2); // PFX_SYMBOL
+            SFX_SYMBOL = q.GetString(3); // SFX_SYMBOL
+            DECIMAL_POINT = q.GetString(4); // DECIMAL_POINT
+            GROUP_SEPARATOR = q.GetString(5); // GROUP_SEPARATOR
+            UNIT_NAME = q.GetString(6); // UNIT_NAME
+            CENT_NAME = q.GetString(7); // CENT_NAME
+            SCALE = q.GetInt(8); // SCALE
+            BASECONVRATE = q.GetDouble(9); // BASECONVRATE
+            CURRENCY_SYMBOL = q.GetString(10); // CURRENCY_SYMBOL
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -530,6 +550,61 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
             return this->CURRENCY_SYMBOL.CmpNoCase(in.v_) == 0;
         }
 
+        void set(const Self::CURRENCYID &in)
+        {
+            this->CURRENCYID = in.v_;
+        }
+
+        void set(const Self::CURRENCYNAME &in)
+        {
+            this->CURRENCYNAME = in.v_;
+        }
+
+        void set(const Self::PFX_SYMBOL &in)
+        {
+            this->PFX_SYMBOL = in.v_;
+        }
+
+        void set(const Self::SFX_SYMBOL &in)
+        {
+            this->SFX_SYMBOL = in.v_;
+        }
+
+        void set(const Self::DECIMAL_POINT &in)
+        {
+            this->DECIMAL_POINT = in.v_;
+        }
+
+        void set(const Self::GROUP_SEPARATOR &in)
+        {
+            this->GROUP_SEPARATOR = in.v_;
+        }
+
+        void set(const Self::UNIT_NAME &in)
+        {
+            this->UNIT_NAME = in.v_;
+        }
+
+        void set(const Self::CENT_NAME &in)
+        {
+            this->CENT_NAME = in.v_;
+        }
+
+        void set(const Self::SCALE &in)
+        {
+            this->SCALE = in.v_;
+        }
+
+        void set(const Self::BASECONVRATE &in)
+        {
+            this->BASECONVRATE = in.v_;
+        }
+
+        void set(const Self::CURRENCY_SYMBOL &in)
+        {
+            this->CURRENCY_SYMBOL = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -684,6 +759,7 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->CURRENCYNAME);
@@ -699,7 +775,7 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(11, entity->CURRENCYID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -726,6 +802,49 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO CURRENCYFORMATS_V1(CURRENCYNAME, PFX_SYMBOL, SFX_SYMBOL, DECIMAL_POINT, GROUP_SEPARATOR, UNIT_NAME, CENT_NAME, SCALE, BASECONVRATE, CURRENCY_SYMBOL) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->CURRENCYNAME);
+                stmt.Bind(2, entity->PFX_SYMBOL);
+                stmt.Bind(3, entity->SFX_SYMBOL);
+                stmt.Bind(4, entity->DECIMAL_POINT);
+                stmt.Bind(5, entity->GROUP_SEPARATOR);
+                stmt.Bind(6, entity->UNIT_NAME);
+                stmt.Bind(7, entity->CENT_NAME);
+                stmt.Bind(8, entity->SCALE);
+                stmt.Bind(9, entity->BASECONVRATE);
+                stmt.Bind(10, entity->CURRENCY_SYMBOL);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("CURRENCYFORMATS_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -733,9 +852,10 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM CURRENCYFORMATS_V1 WHERE CURRENCYID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -806,11 +926,11 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -818,12 +938,14 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -853,7 +975,8 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -862,6 +985,7 @@ struct DB_Table_CURRENCYFORMATS_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
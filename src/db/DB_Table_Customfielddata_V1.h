@@ -46,6 +46,9 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -221,6 +224,15 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
             CONTENT = q.GetString(3); // CONTENT
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            FIELDATADID = q.GetInt(0); // FIELDATADID
+            FIELDID = q.GetInt(1); // FIELDID
+            REFID = q.GetInt(2); // REFID
+            CONTENT = q.GetString(3); // CONTENT
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -258,6 +270,26 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
             return this->CONTENT.CmpNoCase(in.v_) == 0;
         }
 
+        void set(const Self::FIELDATADID &in)
+        {
+            this->FIELDATADID = in.v_;
+        }
+
+        void set(const Self::FIELDID &in)
+        {
+            this->FIELDID = in.v_;
+        }
+
+        void set(const Self::REFID &in)
+        {
+            this->REFID = in.v_;
+        }
+
+        void set(const Self::CONTENT &in)
+        {
+            this->CONTENT = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -384,6 +416,7 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->FIELDID);
@@ -392,7 +425,7 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(4, entity->FIELDATADID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -419,6 +452,42 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO CUSTOMFIELDDATA_V1(FIELDID, REFID, CONTENT) VALUES(?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->FIELDID);
+                stmt.Bind(2, entity->REFID);
+                stmt.Bind(3, entity->CONTENT);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("CUSTOMFIELDDATA_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -426,9 +495,10 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM CUSTOMFIELDDATA_V1 WHERE FIELDATADID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -499,11 +569,11 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -511,12 +581,14 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -546,7 +618,8 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -555,6 +628,7 @@ struct DB_Table_CUSTOMFIELDDATA_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
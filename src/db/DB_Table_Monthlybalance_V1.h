@@ -0,0 +1,718 @@
+﻿// -*- C++ -*-
+//=============================================================================
+/**
+ *      Copyright: (c) 2013 - 2020 Guan Lisheng (guanlisheng@gmail.com)
+ *      Copyright: (c) 2017 - 2018 Stefano Giorgio (stef145g)
+ *
+ *      @file
+ *
+ *      @author [sqlite2cpp.py]
+ *
+ *      @brief
+ *
+ *      Revision History:
+ *          AUTO GENERATED at 2026-10-19 15:56:43.671091.
+ *          DO NOT EDIT!
+ */
+//=============================================================================
+#pragma once
+
+#include "DB_Table.h"
+
+struct DB_Table_MONTHLYBALANCE_V1 : public DB_Table
+{
+    struct Data;
+    typedef DB_Table_MONTHLYBALANCE_V1 Self;
+
+    /** A container to hold list of Data records for the table*/
+    struct Data_Set : public std::vector<Self::Data>
+    {
+        /**Return the data records as a json array string */
+        wxString to_json() const
+        {
+            StringBuffer json_buffer;
+            PrettyWriter<StringBuffer> json_writer(json_buffer);
+
+            json_writer.StartArray();
+            for (const auto & item: *this)
+            {
+                json_writer.StartObject();
+                item.as_json(json_writer);
+                json_writer.EndObject();
+            }
+            json_writer.EndArray();
+
+            return json_buffer.GetString();
+        }
+    };
+
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
+    /** A container to hold a list of Data record pointers for the table in memory*/
+    typedef std::vector<Self::Data*> Cache;
+    typedef std::map<int, Self::Data*> Index_By_Id;
+    Cache cache_;
+    Index_By_Id index_by_id_;
+    Data* fake_; // in case the entity not found
+
+    /** Destructor: clears any data records stored in memory */
+    ~DB_Table_MONTHLYBALANCE_V1() 
+    {
+        delete this->fake_;
+        destroy_cache();
+    }
+     
+    /** Removes all records stored in memory (cache) for the table*/ 
+    void destroy_cache()
+    {
+        std::for_each(cache_.begin(), cache_.end(), std::mem_fun(&Data::destroy));
+        cache_.clear();
+        index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache
+    }
+
+    /** Creates the database table if the table does not exist*/
+    bool ensure(wxSQLite3Database* db)
+    {
+        if (!exists(db))
+        {
+            try
+            {
+                db->ExecuteUpdate("CREATE TABLE MONTHLYBALANCE_V1(MONTHLYBALANCEID integer primary key, ACCOUNTID integer NOT NULL, MONTH TEXT NOT NULL /* YYYY-MM */, BALANCE numeric NOT NULL, INFLOW numeric NOT NULL, OUTFLOW numeric NOT NULL, UNIQUE(ACCOUNTID, MONTH))");
+                this->ensure_data(db);
+            }
+            catch(const wxSQLite3Exception &e) 
+            { 
+                wxLogError("MONTHLYBALANCE_V1: Exception %s", e.GetMessage().utf8_str());
+                return false;
+            }
+        }
+
+        this->ensure_index(db);
+        this->ensure_trigger(db);
+
+        return true;
+    }
+
+    bool ensure_index(wxSQLite3Database* db)
+    {
+        try
+        {
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("MONTHLYBALANCE_V1: Exception %s", e.GetMessage().utf8_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ensure_trigger(wxSQLite3Database* db)
+    {
+        try
+        {
+            db->ExecuteUpdate("CREATE TRIGGER IF NOT EXISTS TRG_MONTHLYBALANCE_DELETE AFTER DELETE ON CHECKINGACCOUNT_V1 BEGIN UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END) , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = OLD.ACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7); UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END) , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = OLD.TOACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7) AND UPPER(OLD.TRANSCODE) = 'TRANSFER' AND OLD.TOACCOUNTID > 0 AND OLD.TOACCOUNTID <> OLD.ACCOUNTID; END");
+            db->ExecuteUpdate("CREATE TRIGGER IF NOT EXISTS TRG_MONTHLYBALANCE_INSERT AFTER INSERT ON CHECKINGACCOUNT_V1 BEGIN INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW) SELECT NEW.ACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1 WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0; UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END) , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7); INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW) SELECT NEW.TOACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1 WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0 WHERE UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID; UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END) , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7) AND UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID; END");
+            db->ExecuteUpdate("CREATE TRIGGER IF NOT EXISTS TRG_MONTHLYBALANCE_UPDATE AFTER UPDATE OF ACCOUNTID, TOACCOUNTID, TRANSCODE, TRANSAMOUNT, TOTRANSAMOUNT, STATUS, TRANSDATE ON CHECKINGACCOUNT_V1 WHEN OLD.ACCOUNTID IS NOT NEW.ACCOUNTID OR OLD.TOACCOUNTID IS NOT NEW.TOACCOUNTID OR OLD.TRANSCODE IS NOT NEW.TRANSCODE OR OLD.TRANSAMOUNT IS NOT NEW.TRANSAMOUNT OR OLD.TOTRANSAMOUNT IS NOT NEW.TOTRANSAMOUNT OR OLD.STATUS IS NOT NEW.STATUS OR OLD.TRANSDATE IS NOT NEW.TRANSDATE BEGIN UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END) , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(OLD.TRANSCODE) = 'DEPOSIT' THEN IFNULL(OLD.TRANSAMOUNT, 0) ELSE -IFNULL(OLD.TRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = OLD.ACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7); UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE - (CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END) , INFLOW = INFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW - (CASE WHEN MONTH = substr(OLD.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(OLD.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(OLD.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = OLD.TOACCOUNTID AND MONTH >= substr(OLD.TRANSDATE, 1, 7) AND UPPER(OLD.TRANSCODE) = 'TRANSFER' AND OLD.TOACCOUNTID > 0 AND OLD.TOACCOUNTID <> OLD.ACCOUNTID; INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW) SELECT NEW.ACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1 WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0; UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END) , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 WHEN UPPER(NEW.TRANSCODE) = 'DEPOSIT' THEN IFNULL(NEW.TRANSAMOUNT, 0) ELSE -IFNULL(NEW.TRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = NEW.ACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7); INSERT OR IGNORE INTO MONTHLYBALANCE_V1 (ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW) SELECT NEW.TOACCOUNTID, substr(NEW.TRANSDATE, 1, 7), IFNULL((SELECT BALANCE FROM MONTHLYBALANCE_V1 WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH < substr(NEW.TRANSDATE, 1, 7) ORDER BY MONTH DESC LIMIT 1), 0), 0, 0 WHERE UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID; UPDATE MONTHLYBALANCE_V1 SET BALANCE = BALANCE + (CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END) , INFLOW = INFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX((CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) , OUTFLOW = OUTFLOW + (CASE WHEN MONTH = substr(NEW.TRANSDATE, 1, 7) THEN MAX(-(CASE WHEN UPPER(NEW.STATUS) IN ('V', 'VOID') THEN 0 ELSE IFNULL(NEW.TOTRANSAMOUNT, 0) END), 0) ELSE 0 END) WHERE ACCOUNTID = NEW.TOACCOUNTID AND MONTH >= substr(NEW.TRANSDATE, 1, 7) AND UPPER(NEW.TRANSCODE) = 'TRANSFER' AND NEW.TOACCOUNTID > 0 AND NEW.TOACCOUNTID <> NEW.ACCOUNTID; END");
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("MONTHLYBALANCE_V1: Exception %s", e.GetMessage().utf8_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    void ensure_data(wxSQLite3Database* db)
+    {
+        db->Begin();
+        db->Commit();
+    }
+    
+    struct MONTHLYBALANCEID : public DB_Column<int>
+    { 
+        static wxString name() { return "MONTHLYBALANCEID"; } 
+        explicit MONTHLYBALANCEID(const int &v, OP op = EQUAL): DB_Column<int>(v, op) {}
+    };
+    
+    struct ACCOUNTID : public DB_Column<int>
+    { 
+        static wxString name() { return "ACCOUNTID"; } 
+        explicit ACCOUNTID(const int &v, OP op = EQUAL): DB_Column<int>(v, op) {}
+    };
+    
+    struct MONTH : public DB_Column<wxString>
+    { 
+        static wxString name() { return "MONTH"; } 
+        explicit MONTH(const wxString &v, OP op = EQUAL): DB_Column<wxString>(v, op) {}
+    };
+    
+    struct BALANCE : public DB_Column<double>
+    { 
+        static wxString name() { return "BALANCE"; } 
+        explicit BALANCE(const double &v, OP op = EQUAL): DB_Column<double>(v, op) {}
+    };
+    
+    struct INFLOW : public DB_Column<double>
+    { 
+        static wxString name() { return "INFLOW"; } 
+        explicit INFLOW(const double &v, OP op = EQUAL): DB_Column<double>(v, op) {}
+    };
+    
+    struct OUTFLOW : public DB_Column<double>
+    { 
+        static wxString name() { return "OUTFLOW"; } 
+        explicit OUTFLOW(const double &v, OP op = EQUAL): DB_Column<double>(v, op) {}
+    };
+    
+    typedef MONTHLYBALANCEID PRIMARY;
+    enum COLUMN
+    {
+        COL_MONTHLYBALANCEID = 0
+        , COL_ACCOUNTID = 1
+        , COL_MONTH = 2
+        , COL_BALANCE = 3
+        , COL_INFLOW = 4
+        , COL_OUTFLOW = 5
+    };
+
+    /** Returns the column name as a string*/
+    static wxString column_to_name(COLUMN col)
+    {
+        switch(col)
+        {
+            case COL_MONTHLYBALANCEID: return "MONTHLYBALANCEID";
+            case COL_ACCOUNTID: return "ACCOUNTID";
+            case COL_MONTH: return "MONTH";
+            case COL_BALANCE: return "BALANCE";
+            case COL_INFLOW: return "INFLOW";
+            case COL_OUTFLOW: return "OUTFLOW";
+            default: break;
+        }
+        
+        return "UNKNOWN";
+    }
+
+    /** Returns the column number from the given column name*/
+    static COLUMN name_to_column(const wxString& name)
+    {
+        if ("MONTHLYBALANCEID" == name) return COL_MONTHLYBALANCEID;
+        else if ("ACCOUNTID" == name) return COL_ACCOUNTID;
+        else if ("MONTH" == name) return COL_MONTH;
+        else if ("BALANCE" == name) return COL_BALANCE;
+        else if ("INFLOW" == name) return COL_INFLOW;
+        else if ("OUTFLOW" == name) return COL_OUTFLOW;
+
+        return COLUMN(-1);
+    }
+    
+    /** Data is a single record in the database table*/
+    struct Data
+    {
+        friend struct DB_Table_MONTHLYBALANCE_V1;
+        /** This is a instance pointer to itself in memory. */
+        Self* table_;
+    
+        int MONTHLYBALANCEID;//  primary key
+        int ACCOUNTID;
+        wxString MONTH;
+        double BALANCE;
+        double INFLOW;
+        double OUTFLOW;
+
+        int id() const
+        {
+            return MONTHLYBALANCEID;
+        }
+
+        void id(int id)
+        {
+            MONTHLYBALANCEID = id;
+        }
+
+        bool operator < (const Data& r) const
+        {
+            return this->id() < r.id();
+        }
+        
+        bool operator < (const Data* r) const
+        {
+            return this->id() < r->id();
+        }
+
+        explicit Data(Self* table = 0) 
+        {
+            table_ = table;
+        
+            MONTHLYBALANCEID = -1;
+            ACCOUNTID = -1;
+            BALANCE = 0.0;
+            INFLOW = 0.0;
+            OUTFLOW = 0.0;
+        }
+
+        explicit Data(wxSQLite3ResultSet& q, Self* table = 0)
+        {
+            table_ = table;
+        
+            MONTHLYBALANCEID = q.GetInt(0); // MONTHLYBALANCEID
+            ACCOUNTID = q.GetInt(1); // ACCOUNTID
+            MONTH = q.GetString(2); // MONTH
+            BALANCE = q.GetDouble(3); // BALANCE
+            INFLOW = q.GetDouble(4); // INFLOW
+            OUTFLOW = q.GetDouble(5); // OUTFLOW
+        }
+
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            MONTHLYBALANCEID = q.GetInt(0); // MONTHLYBALANCEID
+            ACCOUNTID = q.GetInt(1); // ACCOUNTID
+            MONTH = q.GetString(2); // MONTH
+            BALANCE = q.GetDouble(3); // BALANCE
+            INFLOW = q.GetDouble(4); // INFLOW
+            OUTFLOW = q.GetDouble(5); // OUTFLOW
+        }
+
+        Data& operator=(const Data& other)
+        {
+            if (this == &other) return *this;
+
+            MONTHLYBALANCEID = other.MONTHLYBALANCEID;
+            ACCOUNTID = other.ACCOUNTID;
+            MONTH = other.MONTH;
+            BALANCE = other.BALANCE;
+            INFLOW = other.INFLOW;
+            OUTFLOW = other.OUTFLOW;
+            return *this;
+        }
+
+        template<typename C>
+        bool match(const C &c) const
+        {
+            return false;
+        }
+
+        bool match(const Self::MONTHLYBALANCEID &in) const
+        {
+            return this->MONTHLYBALANCEID == in.v_;
+        }
+
+        bool match(const Self::ACCOUNTID &in) const
+        {
+            return this->ACCOUNTID == in.v_;
+        }
+
+        bool match(const Self::MONTH &in) const
+        {
+            return this->MONTH.CmpNoCase(in.v_) == 0;
+        }
+
+        bool match(const Self::BALANCE &in) const
+        {
+            return this->BALANCE == in.v_;
+        }
+
+        bool match(const Self::INFLOW &in) const
+        {
+            return this->INFLOW == in.v_;
+        }
+
+        bool match(const Self::OUTFLOW &in) const
+        {
+            return this->OUTFLOW == in.v_;
+        }
+
+        void set(const Self::MONTHLYBALANCEID &in)
+        {
+            this->MONTHLYBALANCEID = in.v_;
+        }
+
+        void set(const Self::ACCOUNTID &in)
+        {
+            this->ACCOUNTID = in.v_;
+        }
+
+        void set(const Self::MONTH &in)
+        {
+            this->MONTH = in.v_;
+        }
+
+        void set(const Self::BALANCE &in)
+        {
+            this->BALANCE = in.v_;
+        }
+
+        void set(const Self::INFLOW &in)
+        {
+            this->INFLOW = in.v_;
+        }
+
+        void set(const Self::OUTFLOW &in)
+        {
+            this->OUTFLOW = in.v_;
+        }
+
+        // Return the data record as a json string
+        wxString to_json() const
+        {
+            StringBuffer json_buffer;
+            PrettyWriter<StringBuffer> json_writer(json_buffer);
+
+			json_writer.StartObject();			
+			this->as_json(json_writer);
+            json_writer.EndObject();
+
+            return json_buffer.GetString();
+        }
+
+        // Add the field data as json key:value pairs
+        void as_json(PrettyWriter<StringBuffer>& json_writer) const
+        {
+            json_writer.Key("MONTHLYBALANCEID");
+            json_writer.Int(this->MONTHLYBALANCEID);
+            json_writer.Key("ACCOUNTID");
+            json_writer.Int(this->ACCOUNTID);
+            json_writer.Key("MONTH");
+            json_writer.String(this->MONTH.utf8_str());
+            json_writer.Key("BALANCE");
+            json_writer.Double(this->BALANCE);
+            json_writer.Key("INFLOW");
+            json_writer.Double(this->INFLOW);
+            json_writer.Key("OUTFLOW");
+            json_writer.Double(this->OUTFLOW);
+        }
+
+        row_t to_row_t() const
+        {
+            row_t row;
+            row(L"MONTHLYBALANCEID") = MONTHLYBALANCEID;
+            row(L"ACCOUNTID") = ACCOUNTID;
+            row(L"MONTH") = MONTH;
+            row(L"BALANCE") = BALANCE;
+            row(L"INFLOW") = INFLOW;
+            row(L"OUTFLOW") = OUTFLOW;
+            return row;
+        }
+
+        void to_template(html_template& t) const
+        {
+            t(L"MONTHLYBALANCEID") = MONTHLYBALANCEID;
+            t(L"ACCOUNTID") = ACCOUNTID;
+            t(L"MONTH") = MONTH;
+            t(L"BALANCE") = BALANCE;
+            t(L"INFLOW") = INFLOW;
+            t(L"OUTFLOW") = OUTFLOW;
+        }
+
+        /** Save the record instance in memory to the database. */
+        bool save(wxSQLite3Database* db)
+        {
+            if (db && db->IsReadOnly()) return false;
+            if (!table_ || !db) 
+            {
+                wxLogError("can not save MONTHLYBALANCE_V1");
+                return false;
+            }
+
+            return table_->save(this, db);
+        }
+
+        /** Remove the record instance from memory and the database. */
+        bool remove(wxSQLite3Database* db)
+        {
+            if (!table_ || !db) 
+            {
+                wxLogError("can not remove MONTHLYBALANCE_V1");
+                return false;
+            }
+            
+            return table_->remove(this, db);
+        }
+
+        void destroy()
+        {
+            delete this;
+        }
+    };
+
+    enum
+    {
+        NUM_COLUMNS = 6
+    };
+
+    size_t num_columns() const { return NUM_COLUMNS; }
+
+    /** Name of the table*/    
+    wxString name() const { return "MONTHLYBALANCE_V1"; }
+
+    DB_Table_MONTHLYBALANCE_V1() : fake_(new Data())
+    {
+        query_ = "SELECT MONTHLYBALANCEID, ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW FROM MONTHLYBALANCE_V1 ";
+    }
+
+    /** Create a new Data record and add to memory table (cache)*/
+    Self::Data* create()
+    {
+        Self::Data* entity = new Self::Data(this);
+        cache_.push_back(entity);
+        return entity;
+    }
+    
+    /** Create a copy of the Data record and add to memory table (cache)*/
+    Self::Data* clone(const Data* e)
+    {
+        Self::Data* entity = create();
+        *entity = *e;
+        entity->id(-1);
+        return entity;
+    }
+
+    /**
+    * Saves the Data record to the database table.
+    * Either create a new record or update the existing record.
+    * Remove old record from the memory table (cache)
+    */
+    bool save(Self::Data* entity, wxSQLite3Database* db)
+    {
+        wxString sql = wxEmptyString;
+        if (entity->id() <= 0) //  new & insert
+        {
+            sql = "INSERT INTO MONTHLYBALANCE_V1(ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW) VALUES(?, ?, ?, ?, ?)";
+        }
+        else
+        {
+            sql = "UPDATE MONTHLYBALANCE_V1 SET ACCOUNTID = ?, MONTH = ?, BALANCE = ?, INFLOW = ?, OUTFLOW = ? WHERE MONTHLYBALANCEID = ?";
+        }
+
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+
+            stmt.Bind(1, entity->ACCOUNTID);
+            stmt.Bind(2, entity->MONTH);
+            stmt.Bind(3, entity->BALANCE);
+            stmt.Bind(4, entity->INFLOW);
+            stmt.Bind(5, entity->OUTFLOW);
+            if (entity->id() > 0)
+                stmt.Bind(6, entity->MONTHLYBALANCEID);
+
+            timer.rows_ = stmt.ExecuteUpdate();
+            stmt.Finalize();
+
+            if (entity->id() > 0) // existent
+            {
+                for(Cache::iterator it = cache_.begin(); it != cache_.end(); ++ it)
+                {
+                    Self::Data* e = *it;
+                    if (e->id() == entity->id()) 
+                        *e = *entity;  // in-place update
+                }
+            }
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("MONTHLYBALANCE_V1: Exception %s, %s", e.GetMessage().utf8_str(), entity->to_json());
+            return false;
+        }
+
+        if (entity->id() <= 0)
+        {
+            entity->id((db->GetLastRowId()).ToLong());
+            index_by_id_.insert(std::make_pair(entity->id(), entity));
+        }
+        return true;
+    }
+
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO MONTHLYBALANCE_V1(ACCOUNTID, MONTH, BALANCE, INFLOW, OUTFLOW) VALUES(?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->ACCOUNTID);
+                stmt.Bind(2, entity->MONTH);
+                stmt.Bind(3, entity->BALANCE);
+                stmt.Bind(4, entity->INFLOW);
+                stmt.Bind(5, entity->OUTFLOW);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("MONTHLYBALANCE_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
+    /** Remove the Data record from the database and the memory table (cache) */
+    bool remove(int id, wxSQLite3Database* db)
+    {
+        if (id <= 0) return false;
+        try
+        {
+            wxString sql = "DELETE FROM MONTHLYBALANCE_V1 WHERE MONTHLYBALANCEID = ?";
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            stmt.Bind(1, id);
+            timer.rows_ = stmt.ExecuteUpdate();
+            stmt.Finalize();
+
+            Cache c;
+            for(Cache::iterator it = cache_.begin(); it != cache_.end(); ++ it)
+            {
+                Self::Data* entity = *it;
+                if (entity->id() == id) 
+                {
+                    index_by_id_.erase(entity->id());
+                    delete entity;
+                }
+                else 
+                {
+                    c.push_back(entity);
+                }
+            }
+            cache_.clear();
+            cache_.swap(c);
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("MONTHLYBALANCE_V1: Exception %s", e.GetMessage().utf8_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    /** Remove the Data record from the database and the memory table (cache) */
+    bool remove(Self::Data* entity, wxSQLite3Database* db)
+    {
+        if (remove(entity->id(), db))
+        {
+            entity->id(-1);
+            return true;
+        }
+
+        return false;
+    }
+
+    template<typename... Args>
+    Self::Data* get_one(const Args& ... args)
+    {
+        for (Index_By_Id::iterator it = index_by_id_.begin(); it != index_by_id_.end(); ++ it)
+        {
+            Self::Data* item = it->second;
+            if (item->id() > 0 && match(item, args...)) 
+            {
+                ++ hit_;
+                return item;
+            }
+        }
+
+        ++ miss_;
+
+        return 0;
+    }
+    
+    /**
+    * Search the memory table (Cache) for the data record.
+    * If not found in memory, search the database and update the cache.
+    */
+    Self::Data* get(int id, wxSQLite3Database* db)
+    {
+        if (id <= 0) 
+        {
+            ++ skip_;
+            return 0;
+        }
+
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
+        {
+            ++ hit_;
+            return cached;
+        }
+        
+        ++ miss_;
+        Self::Data* entity = 0;
+        wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
+        try
+        {
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
+            stmt.Bind(1, id);
+
+            wxSQLite3ResultSet q = stmt.ExecuteQuery();
+            if(q.NextRow())
+            {
+                timer.rows_ = 1;
+                entity = new Self::Data(q, this);
+                cache_.push_back(entity);
+                index_by_id_.insert(std::make_pair(id, entity));
+            }
+            stmt.Finalize();
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+        
+        if (!entity) 
+        {
+            entity = this->fake_;
+            // wxLogError("%s: %d not found", this->name().utf8_str(), id);
+        }
+ 
+        return entity;
+    }
+
+    /**
+    * Return a list of Data records (Data_Set) derived directly from the database.
+    * The Data_Set is sorted based on the column number.
+    */
+    const Data_Set all(wxSQLite3Database* db, COLUMN col = COLUMN(0), bool asc = true)
+    {
+        Data_Set result;
+        try
+        {
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
+
+            while(q.NextRow())
+            {
+                Self::Data entity(q, this);
+                result.push_back(std::move(entity));
+            }
+
+            q.Finalize();
+            timer.rows_ = result.size();
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return result;
+    }
+};
+
@@ -46,6 +46,9 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -245,6 +248,17 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
             SHARELOT = q.GetString(5); // SHARELOT
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            SHAREINFOID = q.GetInt(0); // SHAREINFOID
+            CHECKINGACCOUNTID = q.GetInt(1); // CHECKINGACCOUNTID
+            SHARENUMBER = q.GetDouble(2); // SHARENUMBER
+            SHAREPRICE = q.GetDouble(3); // SHAREPRICE
+            SHARECOMMISSION = q.GetDouble(4); // SHARECOMMISSION
+            SHARELOT = q.GetString(5); // SHARELOT
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -294,6 +308,36 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
             return this->SHARELOT.CmpNoCase(in.v_) == 0;
         }
 
+        void set(const Self::SHAREINFOID &in)
+        {
+            this->SHAREINFOID = in.v_;
+        }
+
+        void set(const Self::CHECKINGACCOUNTID &in)
+        {
+            this->CHECKINGACCOUNTID = in.v_;
+        }
+
+        void set(const Self::SHARENUMBER &in)
+        {
+            this->SHARENUMBER = in.v_;
+        }
+
+        void set(const Self::SHAREPRICE &in)
+        {
+            this->SHAREPRICE = in.v_;
+        }
+
+        void set(const Self::SHARECOMMISSION &in)
+        {
+            this->SHARECOMMISSION = in.v_;
+        }
+
+        void set(const Self::SHARELOT &in)
+        {
+            this->SHARELOT = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -428,6 +472,7 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->CHECKINGACCOUNTID);
@@ -438,7 +483,7 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(6, entity->SHAREINFOID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -465,6 +510,44 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO SHAREINFO_V1(CHECKINGACCOUNTID, SHARENUMBER, SHAREPRICE, SHARECOMMISSION, SHARELOT) VALUES(?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->CHECKINGACCOUNTID);
+                stmt.Bind(2, entity->SHARENUMBER);
+                stmt.Bind(3, entity->SHAREPRICE);
+                stmt.Bind(4, entity->SHARECOMMISSION);
+                stmt.Bind(5, entity->SHARELOT);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("SHAREINFO_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -472,9 +555,10 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM SHAREINFO_V1 WHERE SHAREINFOID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -545,11 +629,11 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -557,12 +641,14 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -592,7 +678,8 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -601,6 +688,7 @@ struct DB_Table_SHAREINFO_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
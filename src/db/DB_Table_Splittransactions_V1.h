@@ -46,6 +46,9 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -234,6 +237,16 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
             SPLITTRANSAMOUNT = q.GetDouble(4); // SPLITTRANSAMOUNT
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            SPLITTRANSID = q.GetInt(0); // SPLITTRANSID
+            TRANSID = q.GetInt(1); // TRANSID
+            CATEGID = q.GetInt(2); // CATEGID
+            SUBCATEGID = q.GetInt(3); // SUBCATEGID
+            SPLITTRANSAMOUNT = q.GetDouble(4); // SPLITTRANSAMOUNT
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -277,6 +290,31 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
             return this->SPLITTRANSAMOUNT == in.v_;
         }
 
+        void set(const Self::SPLITTRANSID &in)
+        {
+            this->SPLITTRANSID = in.v_;
+        }
+
+        void set(const Self::TRANSID &in)
+        {
+            this->TRANSID = in.v_;
+        }
+
+        void set(const Self::CATEGID &in)
+        {
+            this->CATEGID = in.v_;
+        }
+
+        void set(const Self::SUBCATEGID &in)
+        {
+            this->SUBCATEGID = in.v_;
+        }
+
+        void set(const Self::SPLITTRANSAMOUNT &in)
+        {
+            this->SPLITTRANSAMOUNT = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -356,6 +394,98 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
         }
     };
 
+    /**
+    * Compact read only copy of many records. The records are fixed size PODs
+    * in one array, the TEXT columns are offsets of UTF-8 strings in a pool
+    * shared by the set and the columns with a few known values are enums.
+    * Iterating yields Data records built on the fly, so code written for a
+    * Data_Set compiles unchanged. row() converts only the columns it reads.
+    */
+    struct Compact_Set
+    {
+
+        struct Record
+        {
+            double SPLITTRANSAMOUNT;
+            int SPLITTRANSID;
+            int TRANSID;
+            int CATEGID;
+            int SUBCATEGID;
+        };
+
+        /** Lazy accessors of one record, a TEXT column is converted on each call */
+        struct Row
+        {
+            const Compact_Set* set_;
+            const Record* r_;
+
+            int SPLITTRANSID() const { return r_->SPLITTRANSID; }
+            int TRANSID() const { return r_->TRANSID; }
+            int CATEGID() const { return r_->CATEGID; }
+            int SUBCATEGID() const { return r_->SUBCATEGID; }
+            double SPLITTRANSAMOUNT() const { return r_->SPLITTRANSAMOUNT; }
+        };
+
+        struct const_iterator
+        {
+            const Compact_Set* set_;
+            size_t i_;
+
+            Data operator*() const { return set_->data(i_); }
+            const_iterator& operator++() { ++i_; return *this; }
+            bool operator==(const const_iterator& other) const { return i_ == other.i_; }
+            bool operator!=(const const_iterator& other) const { return i_ != other.i_; }
+        };
+
+        Compact_Set()
+        {
+        }
+
+        size_t size() const { return records_.size(); }
+        bool empty() const { return records_.empty(); }
+        void reserve(size_t n) { records_.reserve(n); }
+        const_iterator begin() const { const_iterator it = { this, 0 }; return it; }
+        const_iterator end() const { const_iterator it = { this, records_.size() }; return it; }
+        Data operator[](size_t i) const { return data(i); }
+        Row row(size_t i) const { Row r = { this, &records_[i] }; return r; }
+
+        /** Append the current row of the result set, as Data(q) would read it */
+        void push_back(wxSQLite3ResultSet& q)
+        {
+            Record r;
+            r.SPLITTRANSID = q.GetInt(0); // SPLITTRANSID
+            r.TRANSID = q.GetInt(1); // TRANSID
+            r.CATEGID = q.GetInt(2); // CATEGID
+            r.SUBCATEGID = q.GetInt(3); // SUBCATEGID
+            r.SPLITTRANSAMOUNT = q.GetDouble(4); // SPLITTRANSAMOUNT
+            records_.push_back(r);
+        }
+
+        /** Build the Data record, it does not belong to the table cache */
+        Data data(size_t i) const
+        {
+            const Record& r = records_[i];
+            Data d;
+            d.SPLITTRANSID = r.SPLITTRANSID;
+            d.TRANSID = r.TRANSID;
+            d.CATEGID = r.CATEGID;
+            d.SUBCATEGID = r.SUBCATEGID;
+            d.SPLITTRANSAMOUNT = r.SPLITTRANSAMOUNT;
+            return d;
+        }
+
+        /** Release the unused capacity once the set is complete */
+        void shrink()
+        {
+            records_.shrink_to_fit();
+            pool_.shrink();
+        }
+
+    private:
+        std::vector<Record> records_;
+        DB_String_Pool pool_;
+    };
+
     enum
     {
         NUM_COLUMNS = 5
@@ -407,6 +537,7 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->TRANSID);
@@ -416,7 +547,7 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(5, entity->SPLITTRANSID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -443,6 +574,43 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO SPLITTRANSACTIONS_V1(TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT) VALUES(?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->TRANSID);
+                stmt.Bind(2, entity->CATEGID);
+                stmt.Bind(3, entity->SUBCATEGID);
+                stmt.Bind(4, entity->SPLITTRANSAMOUNT);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("SPLITTRANSACTIONS_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -450,9 +618,10 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM SPLITTRANSACTIONS_V1 WHERE SPLITTRANSID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -523,11 +692,11 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -535,12 +704,14 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -570,7 +741,8 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -579,6 +751,35 @@ struct DB_Table_SPLITTRANSACTIONS_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return result;
+    }
+
+    /** Return all records in a Compact_Set, read directly from the database */
+    const Compact_Set all_compact(wxSQLite3Database* db)
+    {
+        Compact_Set result;
+        try
+        {
+            // the records are allocated once, at their final size
+            wxSQLite3ResultSet q = db->ExecuteQuery("SELECT COUNT(*) FROM " + this->name());
+            if (q.NextRow()) result.reserve(q.GetInt(0));
+            q.Finalize();
+
+            DB_Query_Timer timer(this->query(), db);
+            q = db->ExecuteQuery(timer.shape_);
+            while(q.NextRow())
+                result.push_back(q);
+
+            q.Finalize();
+            result.shrink();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -46,6 +46,9 @@ struct DB_Table_STOCK_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -302,6 +305,22 @@ struct DB_Table_STOCK_V1 : public DB_Table
             COMMISSION = q.GetDouble(10); // COMMISSION
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            STOCKID = q.GetInt(0); // STOCKID
+            HELDAT = q.GetInt(1); // HELDAT
+            PURCHASEDATE = q.GetString(2); // PURCHASEDATE
+            STOCKNAME = q.GetString(3); // STOCKNAME
+            SYMBOL = q.GetString(4); // SYMBOL
+            NUMSHARES = q.GetDouble(5); // NUMSHARES
+            PURCHASEPRICE = q.GetDouble(6); // PURCHASEPRICE
+            NOTES = q.GetString(7); // NOTES
+            CURRENTPRICE = q.GetDouble(8); // CURRENTPRICE
+            VALUE = q.GetDouble(9); // VALUE
+            COMMISSION = q.GetDouble(10); // COMMISSION
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -381,6 +400,61 @@ struct DB_Table_STOCK_V1 : public DB_Table
             return this->COMMISSION == in.v_;
         }
 
+        void set(const Self::STOCKID &in)
+        {
+            this->STOCKID = in.v_;
+        }
+
+        void set(const Self::HELDAT &in)
+        {
+            this->HELDAT = in.v_;
+        }
+
+        void set(const Self::PURCHASEDATE &in)
+        {
+            this->PURCHASEDATE = in.v_;
+        }
+
+        void set(const Self::STOCKNAME &in)
+        {
+            this->STOCKNAME = in.v_;
+        }
+
+        void set(const Self::SYMBOL &in)
+        {
+            this->SYMBOL = in.v_;
+        }
+
+        void set(const Self::NUMSHARES &in)
+        {
+            this->NUMSHARES = in.v_;
+        }
+
+        void set(const Self::PURCHASEPRICE &in)
+        {
+            this->PURCHASEPRICE = in.v_;
+        }
+
+        void set(const Self::NOTES &in)
+        {
+            this->NOTES = in.v_;
+        }
+
+        void set(const Self::CURRENTPRICE &in)
+        {
+            this->CURRENTPRICE = in.v_;
+        }
+
+        void set(const Self::VALUE &in)
+        {
+            this->VALUE = in.v_;
+        }
+
+        void set(const Self::COMMISSION &in)
+        {
+            this->COMMISSION = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -535,6 +609,7 @@ struct DB_Table_STOCK_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->HELDAT);
@@ -550,7 +625,7 @@ struct DB_Table_STOCK_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(11, entity->STOCKID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -577,6 +652,49 @@ struct DB_Table_STOCK_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO STOCK_V1(HELDAT, PURCHASEDATE, STOCKNAME, SYMBOL, NUMSHARES, PURCHASEPRICE, NOTES, CURRENTPRICE, VALUE, COMMISSION) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->HELDAT);
+                stmt.Bind(2, entity->PURCHASEDATE);
+                stmt.Bind(3, entity->STOCKNAME);
+                stmt.Bind(4, entity->SYMBOL);
+                stmt.Bind(5, entity->NUMSHARES);
+                stmt.Bind(6, entity->PURCHASEPRICE);
+                stmt.Bind(7, entity->NOTES);
+                stmt.Bind(8, entity->CURRENTPRICE);
+                stmt.Bind(9, entity->VALUE);
+                stmt.Bind(10, entity->COMMISSION);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("STOCK_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -584,9 +702,10 @@ struct DB_Table_STOCK_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM STOCK_V1 WHERE STOCKID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -657,11 +776,11 @@ struct DB_Table_STOCK_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -669,12 +788,14 @@ struct DB_Table_STOCK_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -704,7 +825,8 @@ struct DB_Table_STOCK_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -713,6 +835,7 @@ struct DB_Table_STOCK_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -46,6 +46,9 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -232,6 +235,16 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
             UPDTYPE = q.GetInt(4); // UPDTYPE
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {
+            HISTID = q.GetInt(0); // HISTID
+            SYMBOL = q.GetString(1); // SYMBOL
+            DATE = q.GetString(2); // DATE
+            VALUE = q.GetDouble(3); // VALUE
+            UPDTYPE = q.GetInt(4); // UPDTYPE
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -275,6 +288,31 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
             return this->UPDTYPE == in.v_;
         }
 
+        void set(const Self::HISTID &in)
+        {
+            this->HISTID = in.v_;
+        }
+
+        void set(const Self::SYMBOL &in)
+        {
+            this->SYMBOL = in.v_;
+        }
+
+        void set(const Self::DATE &in)
+        {
+            this->DATE = in.v_;
+        }
+
+        void set(const Self::VALUE &in)
+        {
+            this->VALUE = in.v_;
+        }
+
+        void set(const Self::UPDTYPE &in)
+        {
+            this->UPDTYPE = in.v_;
+        }
+
         // Return the data record as a json string
         wxString to_json() const
         {
@@ -354,6 +392,98 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         }
     };
 
+    /**
+    * Compact read only copy of many records. The records are fixed size PODs
+    * in one array, the TEXT columns are offsets of UTF-8 strings in a pool
+    * shared by the set and the columns with a few known values are enums.
+    * Iterating yields Data records built on the fly, so code written for a
+    * Data_Set compiles unchanged. row() converts only the columns it reads.
+    */
+    struct Compact_Set
+    {
+
+        struct Record
+        {
+            double VALUE;
+            int HISTID;
+            DB_String_Pool::Offset SYMBOL;
+            DB_String_Pool::Offset DATE;
+            int UPDTYPE;
+        };
+
+        /** Lazy accessors of one record, a TEXT column is converted on each call */
+        struct Row
+        {
+            const Compact_Set* set_;
+            const Record* r_;
+
+            int HISTID() const { return r_->HISTID; }
+            wxString SYMBOL() const { return set_->pool_.get(r_->SYMBOL); }
+            wxString DATE() const { return set_->pool_.get(r_->DATE); }
+            double VALUE() const { return r_->VALUE; }
+            int UPDTYPE() const { return r_->UPDTYPE; }
+        };
+
+        struct const_iterator
+        {
+            const Compact_Set* set_;
+            size_t i_;
+
+            Data operator*() const { return set_->data(i_); }
+            const_iterator& operator++() { ++i_; return *this; }
+            bool operator==(const const_iterator& other) const { return i_ == other.i_; }
+            bool operator!=(const const_iterator& other) const { return i_ != other.i_; }
+        };
+
+        Compact_Set()
+        {
+        }
+
+        size_t size() const { return records_.size(); }
+        bool empty() const { return records_.empty(); }
+        void reserve(size_t n) { records_.reserve(n); }
+        const_iterator begin() const { const_iterator it = { this, 0 }; return it; }
+        const_iterator end() const { const_iterator it = { this, records_.size() }; return it; }
+        Data operator[](size_t i) const { return data(i); }
+        Row row(size_t i) const { Row r = { this, &records_[i] }; return r; }
+
+        /** Append the current row of the result set, as Data(q) would read it */
+        void push_back(wxSQLite3ResultSet& q)
+        {
+            Record r;
+            r.HISTID = q.GetInt(0); // HISTID
+            r.SYMBOL = pool_.add(q.GetString(1)); // SYMBOL
+            r.DATE = pool_.add(q.GetString(2)); // DATE
+            r.VALUE = q.GetDouble(3); // VALUE
+            r.UPDTYPE = q.GetInt(4); // UPDTYPE
+            records_.push_back(r);
+        }
+
+        /** Build the Data record, it does not belong to the table cache */
+        Data data(size_t i) const
+        {
+            const Record& r = records_[i];
+            Data d;
+            d.HISTID = r.HISTID;
+            d.SYMBOL = pool_.get(r.SYMBOL);
+            d.DATE = pool_.get(r.DATE);
+            d.VALUE = r.VALUE;
+            d.UPDTYPE = r.UPDTYPE;
+            return d;
+        }
+
+        /** Release the unused capacity once the set is complete */
+        void shrink()
+        {
+            records_.shrink_to_fit();
+            pool_.shrink();
+        }
+
+    private:
+        std::vector<Record> records_;
+        DB_String_Pool pool_;
+    };
+
     enum
     {
         NUM_COLUMNS = 5
@@ -405,6 +535,7 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 
             stmt.Bind(1, entity->SYMBOL);
@@ -414,7 +545,7 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(5, entity->HISTID);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -441,6 +572,43 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         return true;
     }
 
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO STOCKHISTORY_V1(SYMBOL, DATE, VALUE, UPDTYPE) VALUES(?, ?, ?, ?)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {
+                stmt.Bind(1, entity->SYMBOL);
+                stmt.Bind(2, entity->DATE);
+                stmt.Bind(3, entity->VALUE);
+                stmt.Bind(4, entity->UPDTYPE);
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("STOCKHISTORY_V1: Exception %s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -448,9 +616,10 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         try
         {
             wxString sql = "DELETE FROM STOCKHISTORY_V1 WHERE HISTID = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -521,11 +690,11 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -533,12 +702,14 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -568,7 +739,8 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -577,6 +749,35 @@ struct DB_Table_STOCKHISTORY_V1 : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return result;
+    }
+
+    /** Return all records in a Compact_Set, read directly from the database */
+    const Compact_Set all_compact(wxSQLite3Database* db)
+    {
+        Compact_Set result;
+        try
+        {
+            // the records are allocated once, at their final size
+            wxSQLite3ResultSet q = db->ExecuteQuery("SELECT COUNT(*) FROM " + this->name());
+            if (q.NextRow()) result.reserve(q.GetInt(0));
+            q.Finalize();
+
+            DB_Query_Timer timer(this->query(), db);
+            q = db->ExecuteQuery(timer.shape_);
+            while(q.NextRow())
+                result.push_back(q);
+
+            q.Finalize();
+            result.shrink();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -19,94 +19,189 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "dbcheck.h"
 
-#include "model/Model_Account.h"
+#include "mmHook.h"
+#include "db/DB_Table.h"
 #include "model/Model_Attachment.h"
 #include "model/Model_Billsdeposits.h"
-#include "model/Model_Category.h"
-#include "model/Model_Payee.h"
-#include "model/Model_Stock.h"
-#include "model/Model_Subcategory.h"
-
-bool dbCheck::checkDB()
+#include "model/Model_Budgetsplittransaction.h"
+#include "model/Model_Checking.h"
+#include "model/Model_Splittransaction.h"
+#include "model/Model_Translink.h"
+#include <wx/intl.h>
+#include <wx/log.h>
+#include <wx/time.h>
+
+namespace
 {
-    bool result = true;
-    result = checkAccounts();
-    
-    return result;
+    struct Rule
+    {
+        const char* name;
+        const char* table;
+        const char* id;
+        const char* where;  // the broken rows, an anti-join on the referenced table
+        const char* fix;    // "DELETE", the SET clause of an UPDATE or nullptr if it needs a decision
+    };
+
+    const Rule RULES[] =
+    {
+        { wxTRANSLATE("Transactions of a missing account"), "CHECKINGACCOUNT_V1", "TRANSID"
+            , "NOT EXISTS (SELECT 1 FROM ACCOUNTLIST_V1 a WHERE a.ACCOUNTID = CHECKINGACCOUNT_V1.ACCOUNTID)"
+            , "DELETE" },
+        { wxTRANSLATE("Transfers to a missing account"), "CHECKINGACCOUNT_V1", "TRANSID"
+            , "TRANSCODE = 'Transfer' AND NOT EXISTS (SELECT 1 FROM ACCOUNTLIST_V1 a WHERE a.ACCOUNTID = CHECKINGACCOUNT_V1.TOACCOUNTID)"
+            , nullptr },
+        { wxTRANSLATE("Transactions with a missing payee"), "CHECKINGACCOUNT_V1", "TRANSID"
+            , "TRANSCODE <> 'Transfer' AND PAYEEID > 0 AND NOT EXISTS (SELECT 1 FROM PAYEE_V1 p WHERE p.PAYEEID = CHECKINGACCOUNT_V1.PAYEEID)"
+            , "PAYEEID = -1" },
+        { wxTRANSLATE("Transactions with a missing category"), "CHECKINGACCOUNT_V1", "TRANSID"
+            , "CATEGID > 0 AND NOT EXISTS (SELECT 1 FROM CATEGORY_V1 c WHERE c.CATEGID = CHECKINGACCOUNT_V1.CATEGID)"
+            , "CATEGID = -1, SUBCATEGID = -1" },
+        { wxTRANSLATE("Transactions with a missing subcategory"), "CHECKINGACCOUNT_V1", "TRANSID"
+            , "SUBCATEGID > 0 AND NOT EXISTS (SELECT 1 FROM SUBCATEGORY_V1 s WHERE s.SUBCATEGID = CHECKINGACCOUNT_V1.SUBCATEGID AND s.CATEGID = CHECKINGACCOUNT_V1.CATEGID)"
+            , "SUBCATEGID = -1" },
+        { wxTRANSLATE("Split rows of a missing transaction"), "SPLITTRANSACTIONS_V1", "SPLITTRANSID"
+            , "NOT EXISTS (SELECT 1 FROM CHECKINGACCOUNT_V1 c WHERE c.TRANSID = SPLITTRANSACTIONS_V1.TRANSID)"
+            , "DELETE" },
+        { wxTRANSLATE("Split rows with a missing category"), "SPLITTRANSACTIONS_V1", "SPLITTRANSID"
+            , "CATEGID > 0 AND NOT EXISTS (SELECT 1 FROM CATEGORY_V1 c WHERE c.CATEGID = SPLITTRANSACTIONS_V1.CATEGID)"
+            , "CATEGID = -1, SUBCATEGID = -1" },
+        { wxTRANSLATE("Recurring transactions of a missing account"), "BILLSDEPOSITS_V1", "BDID"
+            , "NOT EXISTS (SELECT 1 FROM ACCOUNTLIST_V1 a WHERE a.ACCOUNTID = BILLSDEPOSITS_V1.ACCOUNTID)"
+            , "DELETE" },
+        { wxTRANSLATE("Recurring transfers to a missing account"), "BILLSDEPOSITS_V1", "BDID"
+            , "TRANSCODE = 'Transfer' AND NOT EXISTS (SELECT 1 FROM ACCOUNTLIST_V1 a WHERE a.ACCOUNTID = BILLSDEPOSITS_V1.TOACCOUNTID)"
+            , nullptr },
+        { wxTRANSLATE("Split rows of a missing recurring transaction"), "BUDGETSPLITTRANSACTIONS_V1", "SPLITTRANSID"
+            , "NOT EXISTS (SELECT 1 FROM BILLSDEPOSITS_V1 b WHERE b.BDID = BUDGETSPLITTRANSACTIONS_V1.TRANSID)"
+            , "DELETE" },
+        { wxTRANSLATE("Stocks not held in an investment account"), "STOCK_V1", "STOCKID"
+            , "NOT EXISTS (SELECT 1 FROM ACCOUNTLIST_V1 a WHERE a.ACCOUNTID = STOCK_V1.HELDAT AND a.ACCOUNTTYPE = 'Investment')"
+            , nullptr },
+        { wxTRANSLATE("Links of a missing transaction"), "TRANSLINK_V1", "TRANSLINKID"
+            , "NOT EXISTS (SELECT 1 FROM CHECKINGACCOUNT_V1 c WHERE c.TRANSID = TRANSLINK_V1.CHECKINGACCOUNTID)"
+            , "DELETE" },
+        { wxTRANSLATE("Links to a missing asset"), "TRANSLINK_V1", "TRANSLINKID"
+            , "LINKTYPE = 'Asset' AND NOT EXISTS (SELECT 1 FROM ASSETS_V1 a WHERE a.ASSETID = TRANSLINK_V1.LINKRECORDID)"
+            , "DELETE" },
+        { wxTRANSLATE("Links to a missing stock"), "TRANSLINK_V1", "TRANSLINKID"
+            , "LINKTYPE = 'Stock' AND NOT EXISTS (SELECT 1 FROM STOCK_V1 s WHERE s.STOCKID = TRANSLINK_V1.LINKRECORDID)"
+            , "DELETE" },
+        { wxTRANSLATE("Attachments of a missing record"), "ATTACHMENT_V1", "ATTACHMENTID"
+            , "REFTYPE IN ('Transaction', 'Stock', 'Asset', 'BankAccount', 'RecurringTransaction', 'Payee') AND NOT EXISTS ("
+              "SELECT 1 FROM CHECKINGACCOUNT_V1 r WHERE ATTACHMENT_V1.REFTYPE = 'Transaction' AND r.TRANSID = ATTACHMENT_V1.REFID "
+              "UNION ALL SELECT 1 FROM STOCK_V1 r WHERE ATTACHMENT_V1.REFTYPE = 'Stock' AND r.STOCKID = ATTACHMENT_V1.REFID "
+              "UNION ALL SELECT 1 FROM ASSETS_V1 r WHERE ATTACHMENT_V1.REFTYPE = 'Asset' AND r.ASSETID = ATTACHMENT_V1.REFID "
+              "UNION ALL SELECT 1 FROM ACCOUNTLIST_V1 r WHERE ATTACHMENT_V1.REFTYPE = 'BankAccount' AND r.ACCOUNTID = ATTACHMENT_V1.REFID "
+              "UNION ALL SELECT 1 FROM BILLSDEPOSITS_V1 r WHERE ATTACHMENT_V1.REFTYPE = 'RecurringTransaction' AND r.BDID = ATTACHMENT_V1.REFID "
+              "UNION ALL SELECT 1 FROM PAYEE_V1 r WHERE ATTACHMENT_V1.REFTYPE = 'Payee' AND r.PAYEEID = ATTACHMENT_V1.REFID)"
+            , "DELETE" },
+    };
+
+    const size_t RULE_COUNT = sizeof(RULES) / sizeof(RULES[0]);
+
+    void destroy_caches()
+    {
+        Model_Checking::instance().destroy_cache();
+        Model_Splittransaction::instance().destroy_cache();
+        Model_Billsdeposits::instance().destroy_cache();
+        Model_Budgetsplittransaction::instance().destroy_cache();
+        Model_Translink::instance().destroy_cache();
+        Model_Attachment::instance().destroy_cache();
+    }
 }
 
-bool dbCheck::checkAccounts()
+dbCheck::Results dbCheck::run(wxSQLite3Database* db, bool fix, size_t samples)
 {
-    bool result = true;
-
-    // Transactions
-    const auto &transactions = Model_Checking::instance().all();
-    for (const auto& trx : transactions)
-        if (!Model_Account::instance().get(trx.ACCOUNTID) || (Model_Checking::type(trx) == Model_Checking::TRANSFER && !Model_Account::instance().get(trx.TOACCOUNTID)))
+    Results results;
+    bool failed = false;
+
+    // all fixes are applied or none
+    if (fix) db->Savepoint("MMEX_DBCHECK");
+    for (const auto& rule : RULES)
+    {
+        Result result;
+        result.name = wxGetTranslation(rule.name);
+        result.count = 0;
+        result.fixable = rule.fix != nullptr;
+        result.fixed = 0;
+
+        const wxLongLong start = wxGetUTCTimeMillis();
+        try
         {
-            result = false;
+            const wxString sql = wxString::Format("SELECT %s FROM %s WHERE %s ORDER BY %s", rule.id, rule.table, rule.where, rule.id);
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(sql);
+            while (q.NextRow())
+            {
+                if (result.samples.size() < samples) result.samples.push_back(q.GetInt(0));
+                result.count++;
+            }
+            q.Finalize();
+            timer.rows_ = result.count;
+
+            if (fix && result.fixable && result.count > 0)
+            {
+                const wxString fix_sql = wxString(rule.fix) == "DELETE"
+                    ? wxString::Format("DELETE FROM %s WHERE %s", rule.table, rule.where)
+                    : wxString::Format("UPDATE %s SET %s WHERE %s", rule.table, rule.fix, rule.where);
+                DB_Query_Timer fix_timer(fix_sql, db);
+                result.fixed = db->ExecuteUpdate(fix_sql);
+                fix_timer.rows_ = result.fixed;
+            }
         }
-
-    // BillsDeposits
-    const auto &bills = Model_Billsdeposits::instance().all();
-    for (const auto& bill : bills)
-        if (!Model_Account::instance().get(bill.ACCOUNTID) || (Model_Billsdeposits::type(bill) == Model_Billsdeposits::TRANSFER && !Model_Account::instance().get(bill.TOACCOUNTID)))
+        catch (const wxSQLite3Exception& e)
         {
-            result = false;
+            wxLogError("dbCheck %s: Exception %s", rule.table, e.GetMessage().utf8_str());
+            failed = true;
         }
+        result.ms = wxGetUTCTimeMillis() - start;
+        results.push_back(result);
+    }
 
-    // Stocks
-    const auto &stocks = Model_Stock::instance().all();
-    for (const auto& stock : stocks)
-        if (!Model_Account::instance().get(stock.HELDAT) || (Model_Account::type(Model_Account::instance().get(stock.HELDAT)) != Model_Account::INVESTMENT))
+    if (fix)
+    {
+        if (failed)
         {
-            result = false;
+            db->Rollback("MMEX_DBCHECK");
+            UpdateCallbackHook::ResetCaches();
+            for (auto& result : results) result.fixed = 0;
         }
-
-    return result;
-}
-
-bool dbCheck::checkAttachments()
-{
-    return true;
-}
-
-bool dbCheck::checkBudgets()
-{
-    return true;
-}
-
-bool dbCheck::checkBudgetYears()
-{
-    return true;
-}
-
-bool dbCheck::checkCategories()
-{
-    return true;
+        db->ReleaseSavepoint("MMEX_DBCHECK");
+        destroy_caches();
+    }
+    return results;
 }
 
-bool dbCheck::checkCurrencies()
+bool dbCheck::clean(const Results& results)
 {
+    for (const auto& result : results)
+        if (result.count > 0) return false;
     return true;
 }
 
-bool dbCheck::checkPayees()
+const wxString dbCheck::report(const Results& results)
 {
-    return true;
-}
-
-bool dbCheck::checkStocks()
-{
-    return true;
-}
-
-bool dbCheck::checkSubcategories()
-{
-    return true;
-}
+    wxLongLong total = 0;
+    wxString details;
+    for (const auto& result : results)
+    {
+        total += result.ms;
+        details << wxString::Format("%s: %zu (%s ms)", result.name, result.count, result.ms.ToString());
+        if (result.count > 0)
+        {
+            wxString ids;
+            for (const auto id : result.samples)
+                ids << (ids.empty() ? "" : ", ") << id;
+            if (result.samples.size() < result.count) ids << ", ...";
+            details << "\n    " << wxString::Format(_("IDs: %s"), ids);
+            if (result.fixed > 0)
+                details << "\n    " << wxString::Format(_("Fixed: %i"), result.fixed);
+            else if (!result.fixable)
+                details << "\n    " << _("Not fixed automatically");
+        }
+        details << "\n";
+    }
 
-bool dbCheck::checkTransactions()
-{
-    return true;
+    return wxString::Format(_("Integrity check: %zu rules in %s ms"), results.size(), total.ToString())
+        + "\n\n" + details;
 }
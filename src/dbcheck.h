@@ -19,21 +19,38 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #ifndef MM_EX_DBCHECK_H_
 #define MM_EX_DBCHECK_H_
 
+#include <vector>
+#include <wx/longlong.h>
+#include <wx/string.h>
+
+class wxSQLite3Database;
+
+/**
+* Integrity rules of the database. Each rule finds the rows referring to a
+* missing row with one anti-join in SQL, nothing is loaded into the models.
+* The fix mode repairs every rule that can be repaired with one UPDATE or
+* DELETE statement, in rule order, so the rows orphaned by an earlier fix
+* are removed by a later rule.
+*/
 class dbCheck
 {
-    static bool  checkAccounts();
-    static bool  checkAttachments();
-    static bool  checkBudgets();
-    static bool  checkBudgetYears();
-    static bool  checkCategories();
-    static bool  checkCurrencies();
-    static bool  checkPayees();
-    static bool  checkStocks();
-    static bool  checkSubcategories();
-    static bool  checkTransactions();
-
 public:
-    static bool checkDB();
+    struct Result
+    {
+        wxString name;
+        size_t count;               // broken rows found
+        std::vector<int> samples;   // their first IDs
+        wxLongLong ms;
+        bool fixable;
+        int fixed;                  // rows changed in fix mode
+    };
+    typedef std::vector<Result> Results;
+
+    /** Run every rule, and repair the broken rows if fix is true */
+    static Results run(wxSQLite3Database* db, bool fix = false, size_t samples = 10);
+    /** True if no rule found a broken row */
+    static bool clean(const Results& results);
+    static const wxString report(const Results& results);
 };
 
-#endif // MM_EX_DBCHECK_H_
\ No newline at end of file
+#endif // MM_EX_DBCHECK_H_
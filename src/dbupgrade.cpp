@@ -46,11 +46,21 @@ std::vector<wxString> dbUpgrade::SplitQueries(const wxString & statement)
 {
     std::vector<wxString> queries;
     wxStringTokenizer tokenizer(statement, ";");
+    wxString token;
     while (tokenizer.HasMoreTokens())
     {
-        wxString token = tokenizer.GetNextToken().Trim().Trim(false);
+        token += tokenizer.GetNextToken();
+        token.Trim().Trim(false);
+        // The statements of a trigger body end with ';' too, the trigger goes up to its END
+        const wxString upper = token.Upper();
+        if (upper.Contains("CREATE TRIGGER") && !(upper.EndsWith(" END") || upper.EndsWith("\nEND") || upper.EndsWith(";END")))
+        {
+            token += ";";
+            continue;
+        }
         if (token != "" && !(token.StartsWith("--") && !token.Contains("\n"))) // Remove queries with comments only
             queries.push_back(token);
+        token.clear();
     }
     return queries;
 }
@@ -20,6 +20,14 @@
 #include "util.h"
 #include "paths.h"
 #include "constants.h"
+#include "option.h"
+#include "singleton.h"
+#include "model/allmodel.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <wx/thread.h>
 //----------------------------------------------------------------------------
 #include "sqlite3.h"
 //----------------------------------------------------------------------------
@@ -61,6 +69,7 @@ wxSharedPtr<wxSQLite3Database> mmDBWrapper::Open(const wxString &dbpath, const w
     {
         //timeout 2 sec
         db->SetBusyTimeout(2000);
+        RegisterFunctions(db.get());
 
         return (db);
     }
@@ -90,3 +99,374 @@ wxSharedPtr<wxSQLite3Database> mmDBWrapper::Open(const wxString &dbpath, const w
 
 //----------------------------------------------------------------------------
 
+std::vector<const ModelBase*> mmDBWrapper::InitializeModels(wxSQLite3Database* db)
+{
+    Model_Balance::instance(db);
+    Model_BudgetActual::instance(db);
+    Model_Completion::instance(db);
+
+    std::vector<const ModelBase*> models;
+    models.push_back(&Model_Infotable::instance(db));
+    models.push_back(&Model_Asset::instance(db));
+    models.push_back(&Model_Stock::instance(db));
+    models.push_back(&Model_StockHistory::instance(db));
+    models.push_back(&Model_Account::instance(db));
+    models.push_back(&Model_Payee::instance(db));
+    models.push_back(&Model_Checking::instance(db));
+    models.push_back(&Model_MonthlyBalance::instance(db)); // after checking, its triggers are on CHECKINGACCOUNT_V1
+    models.push_back(&Model_Currency::instance(db));
+    models.push_back(&Model_CurrencyHistory::instance(db));
+    models.push_back(&Model_Budgetyear::instance(db));
+    models.push_back(&Model_Subcategory::instance(db)); // subcategory must be initialized before category
+    models.push_back(&Model_Category::instance(db));
+    models.push_back(&Model_Billsdeposits::instance(db));
+    models.push_back(&Model_Splittransaction::instance(db));
+    models.push_back(&Model_Budgetsplittransaction::instance(db));
+    models.push_back(&Model_Budget::instance(db));
+    models.push_back(&Model_Report::instance(db));
+    models.push_back(&Model_Attachment::instance(db));
+    models.push_back(&Model_CustomFieldData::instance(db));
+    models.push_back(&Model_CustomField::instance(db));
+    models.push_back(&Model_Translink::instance(db));
+    models.push_back(&Model_Shareinfo::instance(db));
+    return models;
+}
+
+//----------------------------------------------------------------------------
+
+bool mmDBWrapper::SetWAL(wxSQLite3Database* db, bool wal)
+{
+    wxString mode;
+    try
+    {
+        wxSQLite3ResultSet q = db->ExecuteQuery(wal ? "PRAGMA journal_mode=WAL" : "PRAGMA journal_mode=DELETE");
+        if (q.NextRow()) mode = q.GetString(0);
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogDebug("journal_mode: %s", e.GetMessage());
+        return false;
+    }
+
+    wxLogDebug("journal_mode: %s", mode);
+    return mode.Lower() == (wal ? "wal" : "delete");
+}
+
+//----------------------------------------------------------------------------
+
+namespace
+{
+    /** Rate timeline of one currency */
+    struct Timeline
+    {
+        Timeline() : base_rate(1) {}
+        double base_rate;                               // BASECONVRATE
+        std::vector<std::pair<int, double> > rates;     // CURRENCYHISTORY_V1 by day
+    };
+
+    /**
+    * Rates, account currencies and category names read by the SQL functions.
+    * Shared by all connections, loaded on the first call after a change
+    * through the connection that runs the query.
+    */
+    class FunctionData
+    {
+    public:
+        FunctionData() : m_loaded(false), m_history(false), m_base_currency(-1), m_loads(0) {}
+
+        void invalidate()
+        {
+            wxCriticalSectionLocker lock(m_lock);
+            m_loaded = false;
+        }
+
+        size_t loads() const
+        {
+            return m_loads;
+        }
+
+        bool rate(wxSQLite3Database* db, int currency_id, const wxString& date, double& rate)
+        {
+            wxCriticalSectionLocker lock(m_lock);
+            load(db);
+            return rate_of(currency_id, date, rate);
+        }
+
+        bool to_base(wxSQLite3Database* db, int account_id, const wxString& date, double& rate)
+        {
+            wxCriticalSectionLocker lock(m_lock);
+            load(db);
+            const auto it = m_accounts.find(account_id);
+            return it != m_accounts.end() && rate_of(it->second, date, rate);
+        }
+
+        const wxString catpath(wxSQLite3Database* db, int categ_id, int subcateg_id)
+        {
+            wxCriticalSectionLocker lock(m_lock);
+            load(db);
+            const auto categ = m_categories.find(categ_id);
+            if (categ == m_categories.end()) return "";
+            const auto subcateg = m_subcategories.find(subcateg_id);
+            if (subcateg == m_subcategories.end()) return categ->second;
+            return categ->second + ":" + subcateg->second;
+        }
+
+    private:
+        void load(wxSQLite3Database* db)
+        {
+            if (m_loaded) return;
+            m_loaded = true;
+            m_loads++;
+            m_history = Option::instance().getCurrencyHistoryEnabled();
+            m_base_currency = Option::instance().getBaseCurrencyID();
+            m_currencies.clear();
+            m_accounts.clear();
+            m_categories.clear();
+            m_subcategories.clear();
+
+            wxSQLite3ResultSet q = db->ExecuteQuery("SELECT CURRENCYID, BASECONVRATE FROM CURRENCYFORMATS_V1");
+            while (q.NextRow())
+                m_currencies[q.GetInt(0)].base_rate = q.GetDouble(1);
+            q = db->ExecuteQuery("SELECT CURRENCYID, CURRDATE, CURRVALUE FROM CURRENCYHISTORY_V1 ORDER BY CURRENCYID, CURRDATE");
+            while (q.NextRow())
+            {
+                const auto it = m_currencies.find(q.GetInt(0));
+                if (it != m_currencies.end())
+                    it->second.rates.push_back(std::make_pair(Model_Billsdeposits::Recurrence::to_day(q.GetString(1)), q.GetDouble(2)));
+            }
+            q = db->ExecuteQuery("SELECT ACCOUNTID, CURRENCYID FROM ACCOUNTLIST_V1");
+            while (q.NextRow())
+                m_accounts[q.GetInt(0)] = q.GetInt(1);
+            q = db->ExecuteQuery("SELECT CATEGID, CATEGNAME FROM CATEGORY_V1");
+            while (q.NextRow())
+                m_categories[q.GetInt(0)] = q.GetString(1);
+            q = db->ExecuteQuery("SELECT SUBCATEGID, SUBCATEGNAME FROM SUBCATEGORY_V1");
+            while (q.NextRow())
+                m_subcategories[q.GetInt(0)] = q.GetString(1);
+            q.Finalize();
+        }
+
+        /** Same rules as Model_CurrencyHistory::getDayRate(currencyID, DateISO) */
+        bool rate_of(int currency_id, const wxString& date, double& rate) const
+        {
+            const auto it = m_currencies.find(currency_id);
+            if (!m_history)
+            {
+                if (it == m_currencies.end()) return false;
+                rate = it->second.base_rate;
+                return true;
+            }
+            if (currency_id == m_base_currency || currency_id == -1)
+            {
+                rate = 1;
+                return true;
+            }
+            if (it == m_currencies.end()) return false;
+
+            const auto& rates = it->second.rates;
+            if (rates.empty())
+            {
+                rate = it->second.base_rate;
+                return true;
+            }
+
+            // the rate of the day, else the nearest one before or after it, the earlier on a tie
+            const int day = Model_Billsdeposits::Recurrence::to_day(date);
+            const auto next = std::lower_bound(rates.begin(), rates.end(), day
+                , [](const std::pair<int, double>& r, int d) { return r.first < d; });
+            if (next == rates.end())
+                rate = rates.back().second;
+            else if (next->first == day || next == rates.begin())
+                rate = next->second;
+            else
+            {
+                const auto prev = next - 1;
+                rate = day - prev->first <= next->first - day ? prev->second : next->second;
+            }
+            return true;
+        }
+
+    private:
+        wxCriticalSection m_lock;
+        bool m_loaded;
+        bool m_history;
+        int m_base_currency;
+        size_t m_loads;
+        std::unordered_map<int, Timeline> m_currencies;
+        std::unordered_map<int, int> m_accounts;
+        std::unordered_map<int, wxString> m_categories;
+        std::unordered_map<int, wxString> m_subcategories;
+    };
+
+    /** mmex_rate(currencyid, date), the date defaults to today */
+    class RateFunction : public wxSQLite3ScalarFunction
+    {
+    public:
+        explicit RateFunction(wxSQLite3Database* db) : m_db(db) {}
+        virtual void Execute(wxSQLite3FunctionContext& ctx)
+        {
+            double rate = 0;
+            const wxString date = ctx.IsNull(1) ? wxDate::Today().FormatISODate() : ctx.GetString(1);
+            if (!ctx.IsNull(0) && Singleton<FunctionData>::instance().rate(m_db, ctx.GetInt(0), date, rate))
+                ctx.SetResult(rate);
+            else
+                ctx.SetResultNull();
+        }
+    private:
+        wxSQLite3Database* m_db;
+    };
+
+    /** mmex_to_base(amount, accountid, date), the amount times the rate of the account currency */
+    class ToBaseFunction : public wxSQLite3ScalarFunction
+    {
+    public:
+        explicit ToBaseFunction(wxSQLite3Database* db) : m_db(db) {}
+        virtual void Execute(wxSQLite3FunctionContext& ctx)
+        {
+            double rate = 0;
+            const wxString date = ctx.IsNull(2) ? wxDate::Today().FormatISODate() : ctx.GetString(2);
+            if (!ctx.IsNull(0) && !ctx.IsNull(1) && Singleton<FunctionData>::instance().to_base(m_db, ctx.GetInt(1), date, rate))
+                ctx.SetResult(ctx.GetDouble(0) * rate);
+            else
+                ctx.SetResultNull();
+        }
+    private:
+        wxSQLite3Database* m_db;
+    };
+
+    /** mmex_catpath(categid, subcategid), "Category:Subcategory" */
+    class CatPathFunction : public wxSQLite3ScalarFunction
+    {
+    public:
+        explicit CatPathFunction(wxSQLite3Database* db) : m_db(db) {}
+        virtual void Execute(wxSQLite3FunctionContext& ctx)
+        {
+            ctx.SetResult(Singleton<FunctionData>::instance().catpath(m_db, ctx.GetInt(0, -1), ctx.GetInt(1, -1)));
+        }
+    private:
+        wxSQLite3Database* m_db;
+    };
+
+    /** The function objects must live as long as the connection they are registered on */
+    struct Functions
+    {
+        explicit Functions(wxSQLite3Database* db) : rate(db), to_base(db), catpath(db) {}
+        RateFunction rate;
+        ToBaseFunction to_base;
+        CatPathFunction catpath;
+    };
+}
+
+void mmDBWrapper::RegisterFunctions(wxSQLite3Database* db)
+{
+    static wxCriticalSection lock;
+    static std::map<wxSQLite3Database*, std::unique_ptr<Functions> > registered;
+
+    wxCriticalSectionLocker locker(lock);
+    std::unique_ptr<Functions>& functions = registered[db];
+    functions.reset(new Functions(db));
+    try
+    {
+        db->CreateFunction("mmex_rate", 2, functions->rate, true);
+        db->CreateFunction("mmex_to_base", 3, functions->to_base, true);
+        db->CreateFunction("mmex_catpath", 2, functions->catpath, true);
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("SQL functions: %s", e.GetMessage());
+    }
+}
+
+void mmDBWrapper::InvalidateFunctions(const wxString& table)
+{
+    if (table == "CURRENCYFORMATS_V1" || table == "CURRENCYHISTORY_V1" || table == "ACCOUNTLIST_V1"
+        || table == "CATEGORY_V1" || table == "SUBCATEGORY_V1" || table == "INFOTABLE_V1")
+        Singleton<FunctionData>::instance().invalidate();
+}
+
+//----------------------------------------------------------------------------
+
+mmDBReaderPool::mmDBReaderPool()
+    : m_released(m_mutex)
+    , m_size(0)
+{
+}
+
+mmDBReaderPool& mmDBReaderPool::instance()
+{
+    return Singleton<mmDBReaderPool>::instance();
+}
+
+void mmDBReaderPool::Open(const wxString& dbpath, const wxString& key, size_t size)
+{
+    Close();
+    wxMutexLocker lock(m_mutex);
+    m_path = dbpath;
+    m_key = key;
+    m_size = size;
+}
+
+/* New leases are refused, waits until the workers returned theirs */
+void mmDBReaderPool::Close()
+{
+    wxMutexLocker lock(m_mutex);
+    m_path.clear();
+    m_key.clear();
+    m_released.Broadcast();
+    while (m_free.size() < m_all.size())
+        m_released.Wait();
+    for (auto& db : m_all)
+        db->Close();
+    m_all.clear();
+    m_free.clear();
+}
+
+bool mmDBReaderPool::IsOpen()
+{
+    wxMutexLocker lock(m_mutex);
+    return !m_path.empty();
+}
+
+mmDBReaderPool::Lease mmDBReaderPool::Acquire()
+{
+    wxMutexLocker lock(m_mutex);
+    while (!m_path.empty())
+    {
+        if (!m_free.empty())
+        {
+            wxSQLite3Database* db = m_free.back();
+            m_free.pop_back();
+            return Lease(this, db);
+        }
+
+        if (m_all.size() < m_size)
+        {
+            wxSharedPtr<wxSQLite3Database> db(new wxSQLite3Database);
+            try
+            {
+                db->Open(m_path, m_key, WXSQLITE_OPEN_READONLY | WXSQLITE_OPEN_FULLMUTEX);
+                db->SetBusyTimeout(2000);
+                mmDBWrapper::RegisterFunctions(db.get());
+            }
+            catch (const wxSQLite3Exception& e)
+            {
+                wxLogError("Reader connection: %s", e.GetMessage());
+                break;
+            }
+            m_all.push_back(db);
+            return Lease(this, db.get());
+        }
+
+        m_released.Wait();
+    }
+
+    return Lease(this, nullptr);
+}
+
+void mmDBReaderPool::Release(wxSQLite3Database* db)
+{
+    wxMutexLocker lock(m_mutex);
+    m_free.push_back(db);
+    m_released.Broadcast();
+}
@@ -20,18 +20,84 @@
 #ifndef MM_EX_DBWRAPPER_H_
 #define MM_EX_DBWRAPPER_H_
 //----------------------------------------------------------------------------
+#include <vector>
 #include <wx/arrstr.h>
 #include <wx/sharedptr.h>
+#include <wx/thread.h>
 
 class wxSQLite3Database;
+class ModelBase;
 
 namespace mmDBWrapper
 {
 
     wxSharedPtr<wxSQLite3Database> Open(const wxString &dbpath, const wxString &key = "");
 
+    /* Bind every model and the caches over them to the database, return the models */
+    std::vector<const ModelBase*> InitializeModels(wxSQLite3Database* db);
+
+    /* Switch the journal to WAL so readers and the writer do not block each other */
+    bool SetWAL(wxSQLite3Database* db, bool wal);
+
+    /* Register the SQL functions on the connection:
+       mmex_rate(currencyid, date) the rate to the base currency on the date, as Model_CurrencyHistory::getDayRate
+       mmex_to_base(amount, accountid, date) the amount in the base currency
+       mmex_catpath(categid, subcategid) the category name, as Model_Category::full_name */
+    void RegisterFunctions(wxSQLite3Database* db);
+
+    /* Drop the rates, accounts and categories kept by the SQL functions when the table changed */
+    void InvalidateFunctions(const wxString& table);
+
 } // namespace mmDBWrapper
 
+/*
+   Read-only connections to the open database for worker threads.
+   The main connection stays the only writer. Readers are opened on demand
+   with the same password, up to the pool size, and are handed out with a
+   Lease which returns the connection to the pool when it goes out of scope.
+   Queries on a reader must not use the model caches, see Model<>::find_on.
+*/
+class mmDBReaderPool
+{
+public:
+    class Lease
+    {
+    public:
+        Lease(mmDBReaderPool* pool, wxSQLite3Database* db) : m_pool(pool), m_db(db) {}
+        Lease(Lease&& other) : m_pool(other.m_pool), m_db(other.m_db) { other.m_db = nullptr; }
+        ~Lease() { if (m_db) m_pool->Release(m_db); }
+        wxSQLite3Database* get() const { return m_db; }
+        wxSQLite3Database* operator->() const { return m_db; }
+        explicit operator bool() const { return m_db != nullptr; }
+    private:
+        Lease(const Lease&);
+        Lease& operator=(const Lease&);
+        mmDBReaderPool* m_pool;
+        wxSQLite3Database* m_db;
+    };
+
+public:
+    mmDBReaderPool();
+    static mmDBReaderPool& instance();
+
+    void Open(const wxString& dbpath, const wxString& key, size_t size = 4);
+    void Close();
+    bool IsOpen();
+
+    /* Borrow a reader, waits while all are in use. Empty when no database is open */
+    Lease Acquire();
+
+private:
+    void Release(wxSQLite3Database* db);
+
+    wxMutex m_mutex;
+    wxCondition m_released;
+    wxString m_path, m_key;
+    size_t m_size;
+    std::vector<wxSharedPtr<wxSQLite3Database> > m_all;
+    std::vector<wxSQLite3Database*> m_free;
+};
+
 //----------------------------------------------------------------------------
 
 #endif // MM_EX_DBWRAPPER_H_
@@ -808,6 +808,132 @@ bool mmFilterTransactionsDialog::checkAll(const Model_Billsdeposits::Data &tran,
     return ok;
 }
 
+const wxString mmFilterTransactionsDialog::getSqlCondition(int accountID, std::vector<wxVariant>& params, bool& exact)
+{
+    wxArrayString where;
+    exact = true;
+
+    if (getAccountCheckBox())
+    {
+        where.Add("(ACCOUNTID = ? OR TOACCOUNTID = ?)");
+        params.push_back(static_cast<long>(getAccountID()));
+        params.push_back(static_cast<long>(getAccountID()));
+    }
+    if (getDateRangeCheckBox())
+    {
+        where.Add("TRANSDATE >= ? AND TRANSDATE <= ?");
+        params.push_back(m_begin_date);
+        params.push_back(m_end_date);
+    }
+    if (getPayeeCheckBox())
+    {
+        // compare the names as checkPayee does, SQLite lower() only knows ASCII
+        wxString ids;
+        const wxString name = cbPayee_->GetValue().Lower();
+        for (const auto& payee : Model_Payee::instance().all())
+        {
+            if (payee.PAYEENAME.Lower() == name)
+                ids << (ids.empty() ? "" : ",") << payee.PAYEEID;
+        }
+        where.Add(ids.empty() ? "0" : "PAYEEID IN (" + ids + ")");
+    }
+    if (getCategoryCheckBox())
+    {
+        const wxString split = "SELECT 1 FROM SPLITTRANSACTIONS_V1 S WHERE S.TRANSID = CHECKINGACCOUNT_V1.TRANSID";
+        const wxString sub = bSimilarCategoryStatus_ ? "" : " AND SUBCATEGID = ?";
+        where.Add("((NOT EXISTS (" + split + ") AND CATEGID = ?" + sub + ")"
+            + " OR EXISTS (" + split + " AND S.CATEGID = ?" + (bSimilarCategoryStatus_ ? "" : " AND S.SUBCATEGID = ?") + "))");
+        params.push_back(static_cast<long>(categID_));
+        if (!bSimilarCategoryStatus_) params.push_back(static_cast<long>(subcategID_));
+        params.push_back(static_cast<long>(categID_));
+        if (!bSimilarCategoryStatus_) params.push_back(static_cast<long>(subcategID_));
+    }
+    if (getStatusCheckBox())
+    {
+        const wxString status = getStatus();
+        wxString other;
+        if ("U" == status) // Un-Reconciled
+            other = " OR coalesce(STATUS, '') IN ('', 'F')";
+        else if ("A" == status) // All Except Reconciled
+            other = " OR coalesce(STATUS, '') != 'R'";
+        where.Add("(coalesce(STATUS, '') = ?" + other + ")");
+        params.push_back(status);
+    }
+    if (getTypeCheckBox())
+    {
+        wxArrayString types;
+        const wxString transfer = Model_Checking::all_type()[Model_Checking::TRANSFER];
+        if (cbTypeTransferTo_->GetValue())
+        {
+            types.Add("(TRANSCODE = ? AND ACCOUNTID = ?)");
+            params.push_back(transfer);
+            params.push_back(static_cast<long>(accountID));
+        }
+        if (cbTypeTransferFrom_->GetValue())
+        {
+            types.Add("(TRANSCODE = ? AND ACCOUNTID != ?)");
+            params.push_back(transfer);
+            params.push_back(static_cast<long>(accountID));
+        }
+        if (cbTypeWithdrawal_->GetValue())
+        {
+            types.Add("TRANSCODE = ?");
+            params.push_back(Model_Checking::all_type()[Model_Checking::WITHDRAWAL]);
+        }
+        if (cbTypeDeposit_->GetValue())
+        {
+            types.Add("TRANSCODE = ?");
+            params.push_back(Model_Checking::all_type()[Model_Checking::DEPOSIT]);
+        }
+        wxString any;
+        for (const auto& item : types)
+            any << (any.empty() ? "" : " OR ") << item;
+        where.Add(any.empty() ? "0" : "(" + any + ")");
+    }
+    if (getAmountRangeCheckBoxMin())
+    {
+        where.Add("TRANSAMOUNT >= ?");
+        params.push_back(getAmountMin());
+    }
+    if (getAmountRangeCheckBoxMax())
+    {
+        where.Add("TRANSAMOUNT <= ?");
+        params.push_back(getAmountMax());
+    }
+    if (getNumberCheckBox())
+        where.Add(Model_Checking::text_condition("TRANSACTIONNUMBER", getNumber().Lower(), params, exact));
+    if (getNotesCheckBox())
+        where.Add(Model_Checking::text_condition("NOTES", getNotes().Lower(), params, exact));
+
+    wxString condition;
+    for (const auto& item : where)
+        condition << (condition.empty() ? "" : " AND ") << item;
+    return condition.empty() ? "1" : condition;
+}
+
+const Model_Checking::Data_Set mmFilterTransactionsDialog::findMatching(int accountID, bool in_account)
+{
+    std::vector<wxVariant> params;
+    bool exact = true;
+    wxString where = getSqlCondition(accountID, params, exact);
+    if (in_account)
+    {
+        where = "(ACCOUNTID = ? OR TOACCOUNTID = ?) AND (" + where + ")";
+        params.insert(params.begin(), 2, wxVariant(static_cast<long>(accountID)));
+    }
+    Model_Checking::Data_Set result = Model_Checking::instance().find_where(where, params);
+
+    if (!exact)
+    {
+        const auto splits = Model_Splittransaction::instance().get_all(where, params);
+        result.erase(std::remove_if(result.begin(), result.end()
+            , [&](const Model_Checking::Data& tran) { return !checkAll(tran, accountID, splits); })
+            , result.end());
+    }
+
+    return result;
+}
+
 void mmFilterTransactionsDialog::OnTextEntered(wxCommandEvent& event)
 {
     if (event.GetId() == amountMinEdit_->GetId())
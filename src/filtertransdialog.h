@@ -46,6 +46,15 @@ public:
         , const std::map<int, Model_Splittransaction::Data_Set>& split);
     bool checkAll(const Model_Billsdeposits::Data &tran
         , const std::map<int, Model_Budgetsplittransaction::Data_Set>& split);
+
+    /**
+    Load only the transactions matching the checked criteria, compiled to a SQL condition.
+    accountID is the account the list is viewed from, as in checkAll() which stays the reference.
+    With in_account only the transactions from or to that account are loaded.
+    */
+    const Model_Checking::Data_Set findMatching(int accountID, bool in_account = false);
+    /** Return the SQL condition on CHECKINGACCOUNT_V1, the placeholder values are appended to params */
+    const wxString getSqlCondition(int accountID, std::vector<wxVariant>& params, bool& exact);
     const wxString getDescriptionToolTip();
     void getDescription(mmHTMLBuilder &hb);
     void ResetFilterStatus();
@@ -312,7 +312,9 @@ void mmExportTransaction::getTransactionJSON(PrettyWriter<StringBuffer>& json_wr
     }
 
     const wxString RefType = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
-    Model_Attachment::Data_Set attachments = Model_Attachment::instance().FilterAttachments(RefType, full_tran.id());
+    Model_Attachment::Data_Set attachments;
+    if (Model_Attachment::NrAttachments(RefType, full_tran.id()))
+        attachments = Model_Attachment::instance().FilterAttachments(RefType, full_tran.id());
 
     if (!attachments.empty())
     {
@@ -325,8 +327,9 @@ void mmExportTransaction::getTransactionJSON(PrettyWriter<StringBuffer>& json_wr
         json_writer.EndArray();
     }
 
-    auto data = Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(full_tran.id()));
-    auto f = Model_CustomField::instance().find(Model_CustomField::REFTYPE(RefType));
+    Model_CustomFieldData::Data_Set data;
+    if (Model_CustomFieldData::instance().NrData(RefType, full_tran.id()))
+        data = Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(full_tran.id()));
     if (!data.empty())
     {
         json_writer.Key("CUSTOM_FIELDS");
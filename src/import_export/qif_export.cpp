@@ -431,10 +431,7 @@ void mmQIFExportDialog::mmExportQIF()
     wxArrayInt allAttachments4Export;
     wxArrayInt allCustomFields4Export;
 
-    const auto transactions = Model_Checking::instance().find(
-        Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL));
-
-    if (exp_transactions && !transactions.empty())
+    if (exp_transactions)
     {
         json_writer.Key("transactions");
         json_writer.StartArray();
@@ -450,25 +447,26 @@ void mmQIFExportDialog::mmExportQIF()
         const wxString begin_date = fromDateCtrl_->GetValue().FormatISODate();
         const wxString end_date = toDateCtrl_->GetValue().FormatISODate();
 
-        for (const auto& transaction : transactions)
+        // The transactions are read one by one, the cancel button stops the scan
+        Model_Checking::instance().for_each([&](const Model_Checking::Data& transaction) -> bool
         {
             //Filtering
             if (dateFromCheckBox_->IsChecked() && transaction.TRANSDATE < begin_date)
-                continue;
+                return true;
             if (dateToCheckBox_->IsChecked() && transaction.TRANSDATE > end_date)
-                continue;
+                return true;
             if (!Model_Checking::is_transfer(transaction.TRANSCODE)
                 && (selected_accounts_id_.Index(transaction.ACCOUNTID) == wxNOT_FOUND))
-                continue;
+                return true;
             if (Model_Checking::is_transfer(transaction.TRANSCODE)
                 && (selected_accounts_id_.Index(transaction.ACCOUNTID) == wxNOT_FOUND)
                 && (selected_accounts_id_.Index(transaction.TOACCOUNTID) == wxNOT_FOUND))
-                continue;
+                return true;
             //
 
             // if Cancel clicked
             if (!progressDlg.Pulse(wxString::Format(_("Exporting transaction %zu"), ++numRecords)))
-                break; // abort processing
+                return false; // abort processing
 
             wxString trx_str;
             Model_Checking::Full_Data full_tran(transaction, splits);
@@ -482,14 +480,17 @@ void mmQIFExportDialog::mmExportQIF()
                 if (allPayees4Export.Index(full_tran.PAYEEID) == wxNOT_FOUND && full_tran.TRANSCODE != Model_Checking::all_type()[Model_Checking::TRANSFER])
                     allPayees4Export.Add(full_tran.PAYEEID);
 
-                if (!Model_Attachment::instance().FilterAttachments(RefType, full_tran.id()).empty()
+                if (Model_Attachment::NrAttachments(RefType, full_tran.id())
                     && allAttachments4Export.Index(full_tran.TRANSID) == wxNOT_FOUND) {
                     allAttachments4Export.Add(full_tran.TRANSID);
                 }
-                for (const auto & entry : Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(full_tran.id())))
+                if (Model_CustomFieldData::instance().NrData(RefType, full_tran.id()))
                 {
-                    if (allCustomFields4Export.Index(entry.FIELDATADID) == wxNOT_FOUND) {
-                        allCustomFields4Export.Add(entry.FIELDATADID);
+                    for (const auto & entry : Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(full_tran.id())))
+                    {
+                        if (allCustomFields4Export.Index(entry.FIELDATADID) == wxNOT_FOUND) {
+                            allCustomFields4Export.Add(entry.FIELDATADID);
+                        }
                     }
                 }
                 
@@ -516,7 +517,8 @@ void mmQIFExportDialog::mmExportQIF()
                 trx_str = mmExportTransaction::getTransactionQIF(full_tran, dateMask, reverce);
                 allAccounts4Export[accID] += trx_str;
             }
-        }
+            return true;
+        }, Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL));
         json_writer.EndArray();
 
         switch (m_type)
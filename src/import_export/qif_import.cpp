@@ -17,8 +17,149 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 ********************************************************/
 
 #include "qif_import.h"
+#include "export.h"
+#include "util.h"
+
+#include "model/Model_Account.h"
+#include "model/Model_Category.h"
+#include "model/Model_Checking.h"
+#include "model/Model_Currency.h"
+#include "model/Model_Payee.h"
+#include "model/Model_Splittransaction.h"
+#include "model/Model_Subcategory.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
 #include <vector>
 
+namespace
+{
+    void append(wxString& field, const wxString& data)
+    {
+        if (!field.empty()) field += "\n";
+        field += data;
+    }
+
+    void append(wxString& field, const wxString& separator, const wxString& data)
+    {
+        if (!field.empty()) field += separator;
+        field += data;
+    }
+
+    /** Amount in 1/QIF_AMOUNT_SCALE, the characters other than digits, '-' and the decimal separator are ignored */
+    bool parse_amount(const wxString& text, wxUniChar decimal, int64_t& amount)
+    {
+        int64_t units = 0, fraction = 0, scale = QIF_AMOUNT_SCALE;
+        bool digits = false, negative = false, in_fraction = false;
+        for (const auto& c : text)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                digits = true;
+                if (!in_fraction)
+                    units = units * 10 + (c.GetValue() - '0');
+                else if (scale > 1)
+                {
+                    scale /= 10;
+                    fraction += (c.GetValue() - '0') * scale;
+                }
+            }
+            else if (c == '-')
+                negative = true;
+            else if (c == decimal)
+                in_fraction = true;
+        }
+        amount = units * QIF_AMOUNT_SCALE + fraction;
+        if (negative) amount = -amount;
+        return digits;
+    }
+
+    const wxString iso_date(int date)
+    {
+        return wxString::Format("%04i-%02i-%02i", date / 10000, date / 100 % 100, date % 100);
+    }
+}
+
+QIF_Strings::QIF_Strings()
+{
+    clear();
+}
+
+int QIF_Strings::add(const wxString& text, bool* added)
+{
+    const auto it = index_.find(text);
+    if (added) *added = it == index_.end();
+    if (it != index_.end()) return it->second;
+
+    const int id = static_cast<int>(texts_.size());
+    texts_.push_back(text);
+    index_[text] = id;
+    return id;
+}
+
+void QIF_Strings::clear()
+{
+    texts_.clear();
+    index_.clear();
+    add(wxEmptyString);
+}
+
+/** The lines of the transaction being read */
+struct mmQIFImport::Pending
+{
+    wxString type;
+    wxString date;
+    wxString amount;
+    wxString number;
+    wxString payee;
+    wxString memo;
+    wxString category;
+    wxString status;
+    std::vector<wxString> split_categories;
+    std::vector<wxString> split_amounts;
+    bool has_date;
+
+    Pending() : has_date(false) {}
+    void clear()
+    {
+        type.clear();
+        date.clear();
+        amount.clear();
+        number.clear();
+        payee.clear();
+        memo.clear();
+        category.clear();
+        status.clear();
+        split_categories.clear();
+        split_amounts.clear();
+        has_date = false;
+    }
+};
+
+mmQIFImport::Target::Target()
+    : force_account(false)
+    , by_number(false)
+    , from_date(0)
+    , to_date(0)
+    , decimal(".")
+{
+}
+
+mmQIFImport::Result::Result()
+    : accounts(0)
+    , imported(0)
+    , splits(0)
+    , skipped(0)
+    , errors(0)
+    , ms(0)
+{
+}
+
+mmQIFImport::mmQIFImport()
+{
+    clear();
+}
+
 bool mmQIFImport::isLineOK(const wxString& line)
 {
     return wxString("!DNPAT^MLSE$C/UI").Contains(line.Left(1));
@@ -118,81 +259,585 @@ qifLineType mmQIFImport::lineType(const wxString& line)
     }
 }
 
-bool mmQIFImport::handle_file(wxFileInputStream& input)
+void mmQIFImport::clear()
+{
+    strings_.clear();
+    entries_.clear();
+    splits_.clear();
+    accounts_.clear();
+    payees_.clear();
+    payee_index_.clear();
+    categories_.clear();
+    is_category_.clear();
+    account_.clear();
+    decoded_format_.clear();
+    decoded_decimal_.clear();
+
+    add_payee(_("Unknown"));
+    add_category(_("Unknown"));
+}
+
+int mmQIFImport::add_payee(const wxString& name)
+{
+    const wxString key = name.Lower();
+    const auto it = payee_index_.find(key);
+    if (it != payee_index_.end()) return it->second;
+
+    const int id = strings_.add(name);
+    payees_.push_back(id);
+    payee_index_[key] = id;
+    return id;
+}
+
+int mmQIFImport::add_category(const wxString& name)
+{
+    const int id = strings_.add(name);
+    if (static_cast<size_t>(id) >= is_category_.size())
+        is_category_.resize(strings_.size(), false);
+    if (!is_category_[id])
+    {
+        is_category_[id] = true;
+        categories_.push_back(id);
+    }
+    return id;
+}
+
+size_t mmQIFImport::read(wxInputStream& input, const wxMBConv& conv, const wxString& account
+    , bool payee_is_notes, mmDates* dates, const Line_Callback& on_line)
 {
-    wxTextInputStream text(input, "\x09", wxConvUTF8);
+    clear();
+    account_ = account;
 
-    bool qif_record_end = false;
-    std::vector<QIF_Line> qif_record;  // each qif_record may contains mult lines
+    wxTextInputStream text(input, "\x09", conv);
+    Pending trx;
+    size_t lines = 0;
     while (input.IsOk() && !input.Eof())
     {
-        wxString line = text.ReadLine();
-        QIF_Line qif_line;
-        if (this->handle_line(line, qif_line))
+        ++lines;
+        const wxString line = text.ReadLine();
+        if (line.empty())
+            continue;
+        if (on_line && !on_line(lines, line))
+            break;
+
+        const wxString data = getLineData(line);
+        switch (lineType(line))
+        {
+        case EOTLT:
+            complete(trx, payee_is_notes, dates);
+            trx.clear();
+            break;
+        case AcctType:
+            trx.type = data;
+            break;
+        case Date:
+            append(trx.date, data);
+            trx.has_date = true;
+            break;
+        case Amount:
+            append(trx.amount, data);
+            break;
+        case TransNumber:
+            append(trx.number, data);
+            break;
+        case Payee:
+            append(trx.payee, data);
+            break;
+        case Memo:
+            append(trx.memo, data);
+            break;
+        case Category:
+            append(trx.category, data);
+            break;
+        case Status:
+            append(trx.status, data);
+            break;
+        case CategorySplit:
+            if (!data.empty()) trx.split_categories.push_back(data);
+            break;
+        case AmountSplit:
+            if (!data.empty()) trx.split_amounts.push_back(data);
+            break;
+        default:
+            break;
+        }
+    }
+    return lines;
+}
+
+bool mmQIFImport::complete(Pending& trx, bool payee_is_notes, mmDates* dates)
+{
+    // An account record: N is the name, T the type and D the currency
+    if (trx.type == "Account")
+    {
+        QIF_Account& a = accounts_[trx.number];
+        a.N = trx.number;
+        a.T = trx.amount;
+        a.D = trx.date;
+        account_ = trx.number;
+        return false;
+    }
+
+    if (!trx.has_date || trx.amount.empty())
+        return false;
+
+    QIF_Entry entry;
+    entry.account = strings_.add(account_);
+    entry.to_account = 0;
+    entry.date = 0;
+    entry.amount = 0;
+    entry.has_amount = false;
+    entry.split_begin = static_cast<int>(splits_.size());
+    entry.split_count = 0;
+
+    for (size_t i = 0; i < trx.split_categories.size(); i++)
+    {
+        wxString c = trx.split_categories[i];
+        const wxString project = getFinancistoProject(c);
+        if (!project.empty())
+            trx.number += project + "\n"; //TODO: trx number or notes
+
+        QIF_Split split;
+        split.category = add_category(c);
+        split.amount_text = strings_.add(i < trx.split_amounts.size() ? trx.split_amounts[i] : "");
+        split.amount = 0;
+        splits_.push_back(split);
+        entry.split_count++;
+    }
+
+    if (trx.payee == "Opening Balance")
+    {
+        append(trx.memo, trx.payee);
+        trx.category = trx.payee;
+    }
+
+    bool transfer = false;
+    if (!trx.category.empty())
+    {
+        if (trx.category[0] == '[' && trx.category.Last() == ']')
         {
-            qif_record_end = (qif_line.first == EOTLT);
-            if (qif_line.first == EOTLT)
+            const wxString to_account = trx.category.SubString(1, trx.category.length() - 2);
+            if (to_account == account_)
             {
-                QIF_Transaction tran;
-                // process qif_record
-                this->handle_qif_record(qif_record, tran);
-                // release qif_record
-                qif_record.clear();
+                trx.category = trx.payee;
+                trx.payee = to_account;
             }
             else
             {
-                qif_record.push_back(qif_line);
+                transfer = true;
+                trx.category = "Transfer";
+                entry.to_account = strings_.add(to_account);
+                append(trx.memo, trx.payee);
+                if (accounts_.find(to_account) == accounts_.end())
+                {
+                    QIF_Account& a = accounts_[to_account];
+                    a.N = to_account;
+                    a.D = "[" + Model_Currency::GetBaseCurrency()->CURRENCY_SYMBOL + "]";
+                }
             }
         }
-        else
-        {
-            // TODO
-        }
+
+        //Cut non standard info after /
+        const wxString categ_suffix = getFinancistoProject(trx.category);
+        if (!categ_suffix.empty())
+            append(trx.memo, "/n", categ_suffix);
     }
+    entry.category = trx.category.empty() ? 0 : add_category(trx.category);
 
-    if (!qif_record_end)
+    if (!transfer)
     {
-        // TODO incomplete file ?
+        if (trx.payee.empty())
+            trx.payee = account_.empty() ? _("Unknown") : account_;
+        entry.payee = add_payee(trx.payee);
     }
+    else
+        entry.payee = strings_.add(trx.payee);
+
+    if (payee_is_notes)
+        append(trx.memo, text(entry.payee));
+
+    trx.date.Replace(" ", "");
+    bool added = false;
+    entry.date_text = strings_.add(trx.date, &added);
+    // the date mask is guessed from each distinct date once
+    if (added && dates && !trx.date.StartsWith("["))
+        dates->doHandleStatistics(trx.date);
 
+    entry.amount_text = strings_.add(trx.amount);
+    entry.number = strings_.add(trx.number);
+    entry.memo = strings_.add(trx.memo);
+    entry.reconciled = trx.status == "X" || trx.status == "R";
+    if (transfer)
+        entry.type = Model_Checking::TRANSFER;
+    else
+        entry.type = trx.amount[0] == '-' ? Model_Checking::WITHDRAWAL : Model_Checking::DEPOSIT;
+
+    entries_.push_back(entry);
     return true;
 }
 
-bool mmQIFImport::handle_file(const wxString& input_file)
+void mmQIFImport::decode(const wxString& date_format, const wxString& decimal)
 {
-    wxFileInputStream input(input_file);
-    return this->handle_file(input);
-}
+    if (!decoded_format_.empty() && date_format == decoded_format_ && decimal == decoded_decimal_)
+        return;
+    decoded_format_ = date_format;
+    decoded_decimal_ = decimal;
 
-bool mmQIFImport::handle_line(const wxString& line, QIF_Line& qif_line)
-{
-    qif_line.first = lineType(line);
-    qif_line.second = getLineData(line);
+    const wxUniChar separator = decimal.empty() ? wxUniChar('.') : decimal[0];
+    std::vector<int> dates(strings_.size(), -1);
+    for (auto& entry : entries_)
+    {
+        int& date = dates[entry.date_text];
+        if (date < 0)
+        {
+            wxDateTime dt;
+            wxString::const_iterator end;
+            date = dt.ParseFormat(text(entry.date_text), date_format, &end)
+                ? dt.GetYear() * 10000 + (dt.GetMonth() + 1) * 100 + dt.GetDay() : 0;
+        }
+        entry.date = date;
+        entry.has_amount = parse_amount(text(entry.amount_text), separator, entry.amount);
+    }
 
-    return qif_line.first != UnknownType;
+    for (auto& split : splits_)
+    {
+        if (!parse_amount(text(split.amount_text), separator, split.amount))
+            split.amount = 0;
+    }
 }
 
-bool mmQIFImport::handle_qif_record(const QIF_Record& qif_record, QIF_Transaction& tran)
+const wxString mmQIFImport::raw(const QIF_Entry& entry) const
 {
-    for (const auto& line : qif_record)
+    wxString t;
+    for (const int id : { entry.account, entry.to_account, entry.date_text, entry.amount_text
+        , entry.payee, entry.category, entry.number, entry.memo })
     {
-        this->handle_qif_line(line, tran);
+        if (id) t << text(id) << "|";
     }
-    return true;
+    t.RemoveLast(1);
+    return t;
 }
 
-bool mmQIFImport::handle_qif_line(const QIF_Line& qif_line, QIF_Transaction& tran)
+mmQIFImport::Result mmQIFImport::write(const Target& target, const Progress_Callback& progress)
 {
-    switch (qif_line.first)
+    Result result;
+    const wxLongLong start = wxGetUTCTimeMillis();
+    wxASSERT_MSG(decoded_format_ == target.date_format && decoded_decimal_ == target.decimal
+        , "decode() the entries with the date mask and the decimal of the target before write()");
+
+    Model_Checking::instance().Savepoint();
+
+    // Accounts
+    std::unordered_map<wxString, int> account_ids;
+    for (const auto& item : accounts_)
     {
-    case Date:
-        tran.D = qif_line.second;
-        break;
-    case Memo:
-        tran.M = qif_line.second;
-        break;
-    default:
-        return false;
+        Model_Account::Data* acc = target.by_number
+            ? Model_Account::instance().getByAccNum(item.first)
+            : Model_Account::instance().get(item.first);
+        if (!acc)
+        {
+            acc = Model_Account::instance().create();
+            acc->FAVORITEACCT = "TRUE";
+            acc->STATUS = Model_Account::all_status()[Model_Account::OPEN];
+            acc->ACCOUNTTYPE = mmExportTransaction::mm_acc_type(item.second.T);
+            acc->ACCOUNTNAME = item.first;
+            acc->INITIALBAL = 0;
+            acc->CURRENCYID = Model_Currency::GetBaseCurrency()->CURRENCYID;
+            for (const auto& curr : Model_Currency::instance().all())
+            {
+                if (wxString::Format("[%s]", curr.CURRENCY_SYMBOL) == item.second.D)
+                {
+                    acc->CURRENCYID = curr.CURRENCYID;
+                    break;
+                }
+            }
+            Model_Account::instance().save(acc);
+            result.log << wxString::Format(_("Added account: %s"), item.first) << "\n";
+        }
+        account_ids[item.first] = acc->ACCOUNTID;
     }
-    return true;
+    Model_Account::Data* target_account = Model_Account::instance().get(target.account);
+    if (target_account)
+        account_ids[target.account] = target_account->ACCOUNTID;
+
+    result.accounts = account_ids.size();
+    if (result.accounts == 0 && !target.force_account)
+    {
+        Model_Checking::instance().ReleaseSavepoint();
+        return result;
+    }
+
+    // Payees, matched ignoring case as PAYEENAME
+    std::vector<int> payee_ids(strings_.size(), -1);
+    {
+        std::unordered_map<wxString, int> known;
+        for (const auto& p : Model_Payee::instance().all())
+            known[p.PAYEENAME.Lower()] = p.PAYEEID;
+
+        Model_Payee::Cache added;
+        std::vector<int> added_texts;
+        for (const int id : payees_)
+        {
+            const auto it = known.find(text(id).Lower());
+            if (it != known.end())
+            {
+                payee_ids[id] = it->second;
+                continue;
+            }
+            Model_Payee::Data* p = Model_Payee::instance().create();
+            p->PAYEENAME = text(id);
+            p->CATEGID = -1;
+            p->SUBCATEGID = -1;
+            added.push_back(p);
+            added_texts.push_back(id);
+            result.log << wxString::Format(_("Added payee: %s"), text(id)) << "\n";
+        }
+        Model_Payee::instance().insert(added);
+        for (size_t i = 0; i < added.size(); i++)
+            payee_ids[added_texts[i]] = added[i]->PAYEEID;
+    }
+
+    // Categories as Category:Subcategory
+    std::vector<std::pair<int, int> > category_ids(strings_.size(), std::make_pair(-1, -1));
+    {
+        std::vector<std::pair<wxString, wxString> > names;
+        for (const int id : categories_)
+        {
+            wxStringTokenizer token(text(id), ":");
+            const wxString categ = token.GetNextToken();
+            names.push_back(std::make_pair(categ, token.GetNextToken()));
+        }
+
+        std::unordered_map<wxString, int> known;
+        for (const auto& c : Model_Category::instance().all())
+            known[c.CATEGNAME] = c.CATEGID;
+
+        Model_Category::Cache added;
+        for (const auto& name : names)
+        {
+            if (name.first.empty() || known.find(name.first) != known.end()) continue;
+            Model_Category::Data* c = Model_Category::instance().create();
+            c->CATEGNAME = name.first;
+            added.push_back(c);
+            known[name.first] = -1;
+        }
+        Model_Category::instance().insert(added);
+        for (const auto& c : added)
+            known[c->CATEGNAME] = c->CATEGID;
+
+        // SUBCATEGNAME is case insensitive
+        std::unordered_map<wxString, int> known_sub;
+        for (const auto& s : Model_Subcategory::instance().all())
+            known_sub[wxString::Format("%i:%s", s.CATEGID, s.SUBCATEGNAME.Lower())] = s.SUBCATEGID;
+
+        Model_Subcategory::Cache added_sub;
+        for (const auto& name : names)
+        {
+            if (name.first.empty() || name.second.empty()) continue;
+            const wxString key = wxString::Format("%i:%s", known[name.first], name.second.Lower());
+            if (known_sub.find(key) != known_sub.end()) continue;
+            Model_Subcategory::Data* s = Model_Subcategory::instance().create();
+            s->SUBCATEGNAME = name.second;
+            s->CATEGID = known[name.first];
+            added_sub.push_back(s);
+            known_sub[key] = -1;
+        }
+        Model_Subcategory::instance().insert(added_sub);
+        for (const auto& s : added_sub)
+            known_sub[wxString::Format("%i:%s", s->CATEGID, s->SUBCATEGNAME.Lower())] = s->SUBCATEGID;
+
+        for (size_t i = 0; i < categories_.size(); i++)
+        {
+            const auto& name = names[i];
+            if (name.first.empty()) continue;
+            const int categ_id = known[name.first];
+            const auto sub = name.second.empty() ? known_sub.end()
+                : known_sub.find(wxString::Format("%i:%s", categ_id, name.second.Lower()));
+            category_ids[categories_[i]] = std::make_pair(categ_id, sub == known_sub.end() ? -1 : sub->second);
+        }
+    }
+
+    // Transactions
+    const std::pair<int, int> unknown = category_ids[strings_.add(_("Unknown"))];
+    std::unordered_map<int, std::pair<int, int> > payee_categories;
+    Model_Checking::Cache rows, transfers_to, transfers_from;
+    std::vector<std::pair<Model_Checking::Data*, Model_Splittransaction::Data*> > split_rows;
+    std::vector<std::pair<std::pair<int, int>, int64_t> > entry_splits;
+    for (size_t i = 0; i < entries_.size(); i++)
+    {
+        if (i % 1000 == 0 && progress && !progress(i, entries_.size()))
+            break;
+
+        const QIF_Entry& entry = entries_[i];
+        const bool transfer = entry.type == Model_Checking::TRANSFER;
+        wxString msg;
+
+        const int payee_id = transfer ? -1 : payee_ids[entry.payee];
+        wxString account_name = text(entry.account);
+        if (account_name.empty() || target.force_account)
+            account_name = target.account;
+        const auto account = account_ids.find(account_name);
+        const auto to_account = entry.to_account ? account_ids.find(text(entry.to_account)) : account_ids.end();
+        const int account_id = account == account_ids.end() ? -1 : account->second;
+        const int to_account_id = to_account == account_ids.end() ? -1 : to_account->second;
+
+        entry_splits.clear();
+        for (int s = entry.split_begin; s < entry.split_begin + entry.split_count; s++)
+            entry_splits.push_back(std::make_pair(category_ids[splits_[s].category], splits_[s].amount));
+
+        if (payee_id == -1 && !transfer)
+            msg = _("Transaction Payee is missing or incorrect");
+        else if (entry.date == 0)
+            msg = _("Date format or date mask is incorrect");
+        else if (account_id < 1)
+            msg = _("Transaction Account is incorrect");
+        else if (account_id == to_account_id && transfer)
+            msg = _("Transaction Account for transfer is incorrect");
+        else if (!entry.has_amount)
+            msg = _("Transaction Amount is incorrect");
+        else
+        {
+            for (const auto& split : entry_splits)
+            {
+                if (split.first.first <= 0)
+                    msg = _("Transaction Category is incorrect");
+            }
+        }
+
+        if (!msg.empty())
+        {
+            result.errors++;
+            result.log << wxString::Format(_("Error: %s"), msg)
+                << wxString::Format("\n( %s )\n", raw(entry));
+            continue;
+        }
+
+        if ((target.from_date && entry.date < target.from_date) || (target.to_date && entry.date > target.to_date))
+        {
+            result.skipped++;
+            continue;
+        }
+
+        Model_Checking::Data* trx = Model_Checking::instance().create();
+        trx->TRANSCODE = Model_Checking::all_type()[entry.type];
+        trx->PAYEEID = payee_id;
+        trx->TRANSDATE = iso_date(entry.date);
+        trx->ACCOUNTID = account_id;
+        trx->TOACCOUNTID = to_account_id;
+        trx->TRANSACTIONNUMBER = text(entry.number);
+        trx->NOTES = text(entry.memo);
+        trx->STATUS = entry.reconciled ? "R" : "";
+        trx->FOLLOWUPID = -1;
+
+        const double amount = static_cast<double>(entry.amount) / QIF_AMOUNT_SCALE;
+        trx->TRANSAMOUNT = fabs(amount);
+        trx->TOTRANSAMOUNT = transfer ? amount : trx->TRANSAMOUNT;
+
+        if (!entry_splits.empty())
+        {
+            trx->CATEGID = -1;
+            trx->SUBCATEGID = -1;
+            for (const auto& split : entry_splits)
+            {
+                const double split_amount = static_cast<double>(split.second) / QIF_AMOUNT_SCALE;
+                Model_Splittransaction::Data* s = Model_Splittransaction::instance().create();
+                s->CATEGID = split.first.first;
+                s->SUBCATEGID = split.first.second;
+                s->SPLITTRANSAMOUNT = entry.type == Model_Checking::DEPOSIT ? split_amount : -split_amount;
+                split_rows.push_back(std::make_pair(trx, s));
+            }
+        }
+        else if (entry.category == 0)
+        {
+            auto it = payee_categories.find(payee_id);
+            if (it == payee_categories.end())
+            {
+                std::pair<int, int> categ = unknown;
+                const Model_Payee::Data* payee = Model_Payee::instance().get(payee_id);
+                if (payee && !Model_Category::full_name(payee->CATEGID, payee->SUBCATEGID).empty())
+                    categ = std::make_pair(payee->CATEGID, payee->SUBCATEGID);
+                it = payee_categories.insert(std::make_pair(payee_id, categ)).first;
+            }
+            trx->CATEGID = it->second.first;
+            trx->SUBCATEGID = it->second.second;
+        }
+        else
+        {
+            trx->CATEGID = category_ids[entry.category].first;
+            trx->SUBCATEGID = category_ids[entry.category].second;
+        }
+
+        if (transfer && trx->TOTRANSAMOUNT > 0.0)
+            transfers_from.push_back(trx);
+        else if (transfer)
+            transfers_to.push_back(trx);
+        else
+            rows.push_back(trx);
+    }
+
+    // Both sides of a transfer may be in the file, the pair is joined
+    if (!transfers_to.empty() || !transfers_from.empty())
+    {
+        const auto key = [](const Model_Checking::Data* trx, bool from) {
+            return wxString::Format("%i\x1f%i\x1f%s\x1f%s\x1f%s"
+                , from ? trx->TOACCOUNTID : trx->ACCOUNTID, from ? trx->ACCOUNTID : trx->TOACCOUNTID
+                , trx->TRANSACTIONNUMBER, trx->NOTES, trx->TRANSDATE);
+        };
+
+        std::unordered_map<wxString, std::vector<size_t> > pending;
+        for (size_t i = transfers_from.size(); i-- > 0;)
+            pending[key(transfers_from[i], true)].push_back(i);
+
+        std::vector<bool> paired(transfers_from.size(), false);
+        for (auto& to : transfers_to)
+        {
+            auto it = pending.find(key(to, false));
+            if (it == pending.end() || it->second.empty())
+            {
+                to->TOTRANSAMOUNT = to->TRANSAMOUNT;
+                continue;
+            }
+            const size_t from = it->second.back();
+            it->second.pop_back();
+            paired[from] = true;
+            to->TOTRANSAMOUNT = transfers_from[from]->TRANSAMOUNT;
+        }
+
+        for (size_t i = 0; i < transfers_from.size(); i++)
+        {
+            if (paired[i]) continue;
+            std::swap(transfers_from[i]->ACCOUNTID, transfers_from[i]->TOACCOUNTID);
+            transfers_to.push_back(transfers_from[i]);
+        }
+
+        // Transfers already in the database are marked as duplicates
+        const auto existing_key = [](const Model_Checking::Data& trx) {
+            return wxString::Format("%s\x1f%i\x1f%i\x1f%s\x1f%s\x1f%.8f", trx.TRANSDATE
+                , trx.ACCOUNTID, trx.TOACCOUNTID, trx.NOTES, trx.TRANSACTIONNUMBER, trx.TRANSAMOUNT);
+        };
+        std::unordered_set<wxString> existing;
+        for (const auto& trx : Model_Checking::instance().find_arena(Model_Checking::TRANSCODE(Model_Checking::TRANSFER)))
+            existing.insert(existing_key(trx));
+        for (auto& trx : transfers_to)
+        {
+            if (existing.find(existing_key(*trx)) != existing.end())
+                trx->STATUS = "D";
+            rows.push_back(trx);
+        }
+    }
+
+    result.imported = Model_Checking::instance().insert(rows);
+
+    Model_Splittransaction::Cache splits;
+    for (auto& split : split_rows)
+    {
+        if (split.first->TRANSID < 1) continue;
+        split.second->TRANSID = split.first->TRANSID;
+        splits.push_back(split.second);
+    }
+    result.splits = Model_Splittransaction::instance().insert(splits);
+
+    Model_Checking::instance().ReleaseSavepoint();
+    result.ms = wxGetUTCTimeMillis() - start;
+    return result;
 }
@@ -20,6 +20,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #define QIF_IMPORT_H
 
 #include "defs.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 // http://en.wikipedia.org/wiki/QIF
@@ -31,6 +35,7 @@ struct QIF_Account
 {
     wxString N; // Account name
     wxString T; // Account type
+    wxString D; // Description, the currency symbol in brackets
 };
 
 struct QIF_Transaction
@@ -111,14 +116,102 @@ enum qifAccountInfoType
     UnknownInfo = 8
 };
 
-class mmQIFImport
+/** The texts of a QIF file, each kept once and referred to by index */
+class QIF_Strings
+{
+public:
+    QIF_Strings();
+
+    /** Index of the text, added if new. The empty text has the index 0 */
+    int add(const wxString& text, bool* added = nullptr);
+    const wxString& get(int id) const;
+    size_t size() const;
+    void clear();
+
+private:
+    std::vector<wxString> texts_;
+    std::unordered_map<wxString, int> index_;
+};
+
+inline const wxString& QIF_Strings::get(int id) const { return texts_[id]; }
+inline size_t QIF_Strings::size() const { return texts_.size(); }
+
+struct QIF_Split
+{
+    int category;       // text index
+    int amount_text;    // text index
+    int64_t amount;     // in 1/QIF_AMOUNT_SCALE, as signed in the file
+};
+
+/**
+* A transaction of a QIF file, the texts are indexes in QIF_Strings.
+* The date and the amounts are decoded by mmQIFImport::decode() once the
+* date mask and the decimal separator are known.
+*/
+struct QIF_Entry
 {
+    int account;
+    int to_account;     // 0 unless a transfer
+    int payee;
+    int category;
+    int number;
+    int memo;
+    int date_text;
+    int amount_text;
+    int split_begin;    // in mmQIFImport::splits()
+    int split_count;
+    int date;           // yyyymmdd, 0 if the date text does not match the mask
+    int type;           // Model_Checking::TYPE
+    bool reconciled;
+    bool has_amount;    // the amount text has digits
+    int64_t amount;     // in 1/QIF_AMOUNT_SCALE, as signed in the file
+};
 
+const int64_t QIF_AMOUNT_SCALE = 100000000;
+
+class mmDates;
+class wxSQLite3Database;
+
+/**
+* QIF import in three stages: read() tokenizes the file line by line and
+* keeps each transaction as a QIF_Entry, decode() parses the dates and the
+* amounts, and write() creates the missing accounts, payees and categories
+* and inserts the transactions in one savepoint.
+*/
+class mmQIFImport
+{
 public:
-    typedef std::pair<qifLineType, wxString> QIF_Line;
-    typedef std::vector<QIF_Line> QIF_Record;
+    /** Called for each line with its number, reading stops on false */
+    typedef std::function<bool(size_t, const wxString&)> Line_Callback;
+    /** Called with the entries written and their count, writing stops on false */
+    typedef std::function<bool(size_t, size_t)> Progress_Callback;
+
+    struct Target
+    {
+        Target();
+        wxString account;       // the account of entries without one
+        bool force_account;     // import all entries into the account
+        bool by_number;         // the account names of the file are account numbers
+        int from_date;          // yyyymmdd, 0 for no limit
+        int to_date;
+        wxString date_format;
+        wxString decimal;
+    };
+
+    struct Result
+    {
+        Result();
+        size_t accounts;
+        size_t imported;
+        size_t splits;
+        size_t skipped;         // outside the dates
+        size_t errors;
+        wxString log;
+        wxLongLong ms;
+    };
+
 public:
-    mmQIFImport() {}
+    mmQIFImport();
 
     static bool isLineOK(const wxString& line);
     static wxString getLineData(const wxString& line);
@@ -129,10 +222,58 @@ public:
     static qifLineType lineType(const wxString& line);
 
 public:
-    bool handle_file(wxFileInputStream& input);
-    bool handle_file(const wxString& input_file);
-    bool handle_line(const wxString& line, QIF_Line& qif_line);
-    bool handle_qif_record(const QIF_Record & qif_record, QIF_Transaction& tran);
-    bool handle_qif_line(const QIF_Line& qif_line, QIF_Transaction& tran);
+    /**
+    * Read the transactions of a QIF file. account is the account of the
+    * transactions until the file names one, the date texts are handed to
+    * dates if not null to guess the date mask. Returns the lines read.
+    */
+    size_t read(wxInputStream& input, const wxMBConv& conv, const wxString& account
+        , bool payee_is_notes, mmDates* dates, const Line_Callback& on_line);
+    /** Parse the dates and the amounts of the entries, once per distinct text */
+    void decode(const wxString& date_format, const wxString& decimal);
+    /** Insert the decoded entries, decode() must have run with the mask and decimal of target */
+    Result write(const Target& target, const Progress_Callback& progress);
+    void clear();
+
+    const wxString& text(int id) const;
+    const std::vector<QIF_Entry>& entries() const;
+    const std::vector<QIF_Split>& splits() const;
+    /** The accounts named in the file, with their QIF type and currency */
+    const std::map<wxString, QIF_Account>& accounts() const;
+    /** Text indexes of the payees, unique ignoring case */
+    const std::vector<int>& payees() const;
+    /** Text indexes of the categories, as Category:Subcategory */
+    const std::vector<int>& categories() const;
+    /** The account named last in the file, or the one given to read() */
+    const wxString& account() const;
+
+private:
+    struct Pending;
+    bool complete(Pending& trx, bool payee_is_notes, mmDates* dates);
+    int add_payee(const wxString& name);
+    int add_category(const wxString& name);
+    const wxString raw(const QIF_Entry& entry) const;
+
+private:
+    QIF_Strings strings_;
+    std::vector<QIF_Entry> entries_;
+    std::vector<QIF_Split> splits_;
+    std::map<wxString, QIF_Account> accounts_;
+    std::vector<int> payees_;
+    std::unordered_map<wxString, int> payee_index_;
+    std::vector<int> categories_;
+    std::vector<bool> is_category_;
+    wxString account_;
+
+    wxString decoded_format_;
+    wxString decoded_decimal_;
 };
+
+inline const wxString& mmQIFImport::text(int id) const { return strings_.get(id); }
+inline const std::vector<QIF_Entry>& mmQIFImport::entries() const { return entries_; }
+inline const std::vector<QIF_Split>& mmQIFImport::splits() const { return splits_; }
+inline const std::map<wxString, QIF_Account>& mmQIFImport::accounts() const { return accounts_; }
+inline const std::vector<int>& mmQIFImport::payees() const { return payees_; }
+inline const std::vector<int>& mmQIFImport::categories() const { return categories_; }
+inline const wxString& mmQIFImport::account() const { return account_; }
 #endif
@@ -86,7 +86,7 @@ mmQIFImportDialog::mmQIFImportDialog(wxWindow* parent, int account_id)
 
 wxString mmQIFImportDialog::OnGetItemText(long item, long column) const
 {
-    return vQIF_trxs_.at(item).at(column);
+    return dataListBox_->GetTextValue(static_cast<unsigned int>(item), static_cast<unsigned int>(column));
 }
 
 bool mmQIFImportDialog::Create(wxWindow* parent, wxWindowID id, const wxString& caption
@@ -342,18 +342,8 @@ void mmQIFImportDialog::fillControls()
 
 bool mmQIFImportDialog::mmReadQIFFile()
 {
-    size_t numLines = 0;
-    vQIF_trxs_.clear();
-    m_QIFaccounts.clear();
-    m_QIFcategoryNames.clear();
-    m_QIFcategoryNames[_("Unknown")] = std::make_pair(-1, -1);
-    m_QIFpayeeNames.clear();
-    m_payee_names.clear();
-    m_payee_names.Add(_("Unknown"));
-
     wxFileInputStream input(m_FileNameStr);
     wxConvAuto conv = g_encoding.at(m_choiceEncoding->GetSelection()).first;
-    wxTextInputStream text(input, "\x09", conv);
 
     wxProgressDialog progressDlg(_("Please wait"), _("Scanning")
         , 0, this, wxPD_APP_MODAL | wxPD_CAN_ABORT);
@@ -361,102 +351,46 @@ bool mmQIFImportDialog::mmReadQIFFile()
     wxLongLong start = wxGetUTCTimeMillis();
     wxLongLong interval = wxGetUTCTimeMillis() - start;
 
-    wxString accName = "";
     if (accountCheckBox_->IsChecked()) {
-        accName = accountDropDown_->GetStringSelection();
-        Model_Account::Data* acc = Model_Account::instance().get(accName);
+        Model_Account::Data* acc = Model_Account::instance().get(accountDropDown_->GetStringSelection());
         if (acc) {
             m_accountNameStr = acc->ACCOUNTNAME;
         }
     }
 
-    std::unordered_map <int, wxString> trx;
-
-    mmDates* dParser = new mmDates;
-    while (input.IsOk() && !input.Eof())
+    mmDates dParser;
+    const size_t numLines = qif_api.read(input, conv, m_accountNameStr, payeeIsNotes_
+        , m_userDefinedDateMask ? nullptr : &dParser
+        , [&](size_t line, const wxString& lineStr)
     {
-        ++numLines;
-        const wxString lineStr = text.ReadLine();
-        if (lineStr.IsEmpty())
-            continue;
-
-        if (numLines % 100 == 0)
+        if (line % 100 == 0)
         {
             interval = wxGetUTCTimeMillis() - start;
             if (!progressDlg.Pulse(wxString::Format(_("Reading line %zu, %lld ms")
-                , numLines, interval)))
-                break;
+                , line, interval)))
+                return false;
         }
-        if (numLines <= 50)
+        if (line <= 50)
         {
-            *log_field_ << wxString::Format(_("Line %zu \t %s\n"), numLines, lineStr);
-            if (numLines == 50)
+            *log_field_ << wxString::Format(_("Line %zu \t %s\n"), line, lineStr);
+            if (line == 50)
                 *log_field_ << "-------------------------------------- 8< --------------------------------------\n";
         }
-
-        const qifLineType lineType = mmQIFImport::lineType(lineStr);
-        const auto data = mmQIFImport::getLineData(lineStr);
-        if (lineType == EOTLT)
-        {
-            if (trx.find(AcctType) != trx.end())
-            {
-                if (trx[AcctType] == "Account") {
-                    accName = (trx.find(TransNumber) == trx.end() ? "" : trx[TransNumber]);
-                    std::unordered_map <int, wxString> a;
-                    a[AccountType] = (trx.find(Description) != trx.end() ? trx.at(Description) : "");
-                    a[Description] = (trx.find(AccountType) != trx.end() ? trx.at(AccountType) : "");
-                    m_QIFaccounts[accName] = a;
-                    m_accountNameStr = accName;
-                }
-            }
-
-            if (completeTransaction(trx, m_accountNameStr)) {
-                vQIF_trxs_.push_back(trx);
-            }
-            trx.clear();
-            continue;
-        }
-        //Parse Categories
-        const wxString& s = trx.find(CategorySplit) != trx.end() ? trx[CategorySplit] : "";
-        if (!s.empty())
-        {
-            wxStringTokenizer token(s, "\n");
-            while (token.HasMoreTokens())
-            {
-                wxString c = token.GetNextToken();
-                qif_api->getFinancistoProject(c);
-                if (m_QIFcategoryNames.find(c) == m_QIFcategoryNames.end())
-                    m_QIFcategoryNames[c] = std::make_pair(-1, -1);
-            }
-        }
-
-        //Parse date format
-        if (!m_userDefinedDateMask && lineType == Date && (data.Mid(0, 1) != "["))
-        {
-            dParser->doHandleStatistics(data);
-        }
-
-        if (trx[lineType].empty() || lineType == AcctType)
-            trx[lineType] = data;
-        else
-            trx[lineType] += "\n" + data;
-
-    }
+        return true;
+    });
+    m_accountNameStr = qif_api.account();
     log_field_->ScrollLines(log_field_->GetNumberOfLines());
 
-
     if (!m_userDefinedDateMask)
     {
-        dParser->doFinalizeStatistics();
-        if (dParser->isDateFormatFound()) {
-            m_dateFormatStr = dParser->getDateFormat();
-            const wxString date_mask = dParser->getDateMask();
+        dParser.doFinalizeStatistics();
+        if (dParser.isDateFormatFound()) {
+            m_dateFormatStr = dParser.getDateFormat();
+            const wxString date_mask = dParser.getDateMask();
             choiceDateFormat_->SetStringSelection(date_mask);
         }
     }
 
-    delete dParser;
-
     fillControls();
 
     progressDlg.Destroy();
@@ -471,165 +405,52 @@ bool mmQIFImportDialog::mmReadQIFFile()
     return true;
 }
 
-bool mmQIFImportDialog::completeTransaction(std::unordered_map <int, wxString> &trx, const wxString &accName)
-{
-    if (trx.find(Date) == trx.end())
-        return false;
-
-    bool isTransfer = false;
-
-    if (accName.empty()) {
-        trx[AccountName] = m_accountNameStr;
-    }
-    else {
-        trx[AccountName] = accName;
-    }
-
-
-    if (trx.find(CategorySplit) != trx.end())
-    {
-        //TODO:Dublicate code
-        wxStringTokenizer token(trx[CategorySplit], "\n");
-        while (token.HasMoreTokens())
-        {
-            wxString c = token.GetNextToken();
-            const wxString project = qif_api->getFinancistoProject(c);
-            if (m_QIFcategoryNames.find(c) == m_QIFcategoryNames.end())
-                m_QIFcategoryNames[c] = std::make_pair(-1, -1);
-            if (!project.empty())
-                trx[TransNumber] += project + "\n"; //TODO: trx number or notes
-        }
-    }
-
-    if (trx[Payee] == "Opening Balance") {
-        trx[Memo] += (trx[Memo].empty() ? "" : "\n") + trx[Payee];
-        trx[Category] = trx[Payee];
-    }
-
-    if (trx.find(Category) != trx.end())
-    {
-        if (trx[Category].Mid(0, 1) == "[" && trx[Category].Last() == ']')
-        {
-            wxString toAccName = trx[Category].SubString(1, trx[Category].length() - 2);
-
-            if (toAccName == m_accountNameStr)
-            {
-                trx[Category] = trx[Payee];
-                trx[Payee] = toAccName;
-            }
-            else
-            {
-                isTransfer = true;
-                trx[Category] = "Transfer";
-                trx[TrxType] = Model_Checking::all_type()[Model_Checking::TRANSFER];
-                trx[ToAccountName] = toAccName;
-                trx[Memo] += (trx[Memo].empty() ? "" : "\n") + trx[Payee];
-                if (m_QIFaccounts.find(toAccName) == m_QIFaccounts.end())
-                {
-                    std::unordered_map <int, wxString> a;
-                    a[Description] = "[" + Model_Currency::GetBaseCurrency()->CURRENCY_SYMBOL + "]";
-                    a[AccountType] = (trx.find(Description) != trx.end() ? trx.at(Description) : "");
-                    m_QIFaccounts[toAccName] = a;
-                }
-            }
-        }
-
-        //Cut non standard info after /
-        const wxString categ_suffix = qif_api->getFinancistoProject(trx[Category]);
-        if (!categ_suffix.empty()) trx[Memo] += (trx[Memo].empty() ? "" : "/n") + categ_suffix;
-
-        //Add the full Category name if missing to the map with undefind category ID and Subcategory ID
-        if (m_QIFcategoryNames.find(trx[Category]) == m_QIFcategoryNames.end())
-            m_QIFcategoryNames[trx[Category]] = std::make_pair(-1, -1);
-    }
-
-    if (!isTransfer)
-    {
-        wxString payee_name = trx.find(Payee) != trx.end() ? trx[Payee] : "";
-        if (payee_name.empty()) {
-            payee_name = trx.find(AccountName) != trx.end() ? trx[AccountName] : _("Unknown");
-            trx[Payee] = payee_name;
-        }
-
-        int i = m_payee_names.Index(payee_name, false);
-        if (i == wxNOT_FOUND) {
-            m_payee_names.Add(payee_name);
-        }
-        else
-            trx[Payee] = m_payee_names.Item(i);
-    }
-
-    if (payeeIsNotes_) {
-        trx[Memo] += (trx[Memo].empty() ? "" : "\n") + trx[Payee];
-    }
-
-    wxString amtStr = (trx.find(Amount) == trx.end() ? "" : trx[Amount]);
-    if (!isTransfer) {
-        if (amtStr.Mid(0, 1) == "-")
-            trx[TrxType] = Model_Checking::all_type()[Model_Checking::WITHDRAWAL];
-        else if (!amtStr.empty())
-            trx[TrxType] = Model_Checking::all_type()[Model_Checking::DEPOSIT];
-    }
-
-    return !amtStr.empty();
-}
-
 void mmQIFImportDialog::refreshTabs(int tabs)
 {
     int num = 0;
     if (tabs & LOG_TAB)
     {
-        wxString acc;
+        qif_api.decode(m_dateFormatStr, decimal_);
+        std::unordered_map<int, wxString> account_names;
         dataListBox_->DeleteAllItems();
-        for (const auto& trx : vQIF_trxs_)
+        for (const auto& trx : qif_api.entries())
         {
             wxVector<wxVariant> data;
-            Model_Account::Data* account = Model_Account::instance().getByAccNum(trx.at(AccountName));
             data.push_back(wxVariant(wxString::Format("%i", num + 1)));
-            data.push_back(
-                wxVariant(
-                    trx.find(AccountName) != trx.end()
-                    && (trx.at(AccountName).empty() || accountCheckBox_->IsChecked())
-                    ? m_accountNameStr
-                    : ((accountNumberCheckBox_->IsChecked() && account)
-                        ? account->ACCOUNTNAME : trx.at(AccountName)
-                        )
-                )
-            );
-
-            wxString dateStr = "";
-            if (trx.find(Date) != trx.end())
+
+            auto account = account_names.find(trx.account);
+            if (account == account_names.end())
             {
-                dateStr = trx.at(Date);
-                dateStr.Replace(" ", "");
-                wxDateTime dtdt;
-                wxString::const_iterator end;
-                if (dtdt.ParseFormat(dateStr, m_dateFormatStr, &end))
-                    dateStr = mmGetDateForDisplay(dtdt.FormatISODate());
-                else
-                    dateStr.Prepend("!");
+                const wxString& name = qif_api.text(trx.account);
+                Model_Account::Data* acc = Model_Account::instance().getByAccNum(name);
+                account = account_names.insert(std::make_pair(trx.account
+                    , (accountNumberCheckBox_->IsChecked() && acc) ? acc->ACCOUNTNAME : name)).first;
             }
+            data.push_back(wxVariant(qif_api.text(trx.account).empty() || accountCheckBox_->IsChecked()
+                ? m_accountNameStr : account->second));
 
+            const wxString dateStr = trx.date
+                ? mmGetDateForDisplay(wxString::Format("%04i-%02i-%02i", trx.date / 10000, trx.date / 100 % 100, trx.date % 100))
+                : "!" + qif_api.text(trx.date_text);
             data.push_back(wxVariant(dateStr));
-            data.push_back(wxVariant(trx.find(TransNumber) != trx.end() ? trx.at(TransNumber) : ""));
-            const wxString type = (trx.find(TrxType) != trx.end() ? trx.at(TrxType) : "");
-            if (type == Model_Checking::all_type()[Model_Checking::TRANSFER])
-                data.push_back(wxVariant(trx.find(ToAccountName) != trx.end() ? trx.at(ToAccountName) : ""));
+            data.push_back(wxVariant(qif_api.text(trx.number)));
+            if (trx.type == Model_Checking::TRANSFER)
+                data.push_back(wxVariant(qif_api.text(trx.to_account)));
             else
-                data.push_back(wxVariant(trx.find(Payee) != trx.end() ? trx.at(Payee) : ""));
-            data.push_back(wxVariant(trx.find(TrxType) != trx.end() ? trx.at(TrxType) : ""));
+                data.push_back(wxVariant(qif_api.text(trx.payee)));
+            data.push_back(wxVariant(Model_Checking::all_type()[trx.type]));
 
             wxString category;
-            if (trx.find(CategorySplit) != trx.end()) {
-                category = trx.at(CategorySplit);
-                category.Prepend("*").Replace("\n", "|");
+            if (trx.split_count > 0) {
+                for (int i = trx.split_begin; i < trx.split_begin + trx.split_count; i++)
+                    category << (category.empty() ? "*" : "|") << qif_api.text(qif_api.splits()[i].category);
             }
             else
-                category = (trx.find(Category) != trx.end() ? trx.at(Category) : "");
+                category = qif_api.text(trx.category);
             data.push_back(wxVariant(category));
 
-            data.push_back(wxVariant(trx.find(Amount) != trx.end() ? trx.at(Amount) : ""));
-            data.push_back(wxVariant(trx.find(Memo) != trx.end() ? trx.at(Memo) : ""));
+            data.push_back(wxVariant(qif_api.text(trx.amount_text)));
+            data.push_back(wxVariant(qif_api.text(trx.memo)));
 
             dataListBox_->AppendItem(data, static_cast<wxUIntPtr>(num++));
         }
@@ -639,12 +460,11 @@ void mmQIFImportDialog::refreshTabs(int tabs)
     {
         num = 0;
         accListBox_->DeleteAllItems();
-        for (const auto& acc : m_QIFaccounts)
+        for (const auto& acc : qif_api.accounts())
         {
             wxVector<wxVariant> data;
-            const auto &a = acc.second;
 
-            wxString currencySymbol = a.find(Description) == a.end() ? "" : a.at(Description);
+            wxString currencySymbol = acc.second.D;
             currencySymbol = currencySymbol.SubString(1, currencySymbol.length() - 2);
 
             Model_Account::Data* account = (accountNumberCheckBox_->IsChecked())
@@ -652,8 +472,7 @@ void mmQIFImportDialog::refreshTabs(int tabs)
                 : Model_Account::instance().get(acc.first);
 
             wxString status;
-            const wxString type = acc.second.find(AccountType) != acc.second.end()
-                ? acc.second.at(AccountType) : "";
+            const wxString& type = acc.second.T;
 
             if (account)
             {
@@ -683,8 +502,9 @@ void mmQIFImportDialog::refreshTabs(int tabs)
     if (tabs & PAYEE_TAB)
     {
         payeeListBox_->DeleteAllItems();
-        for (const auto& payee : m_payee_names)
+        for (const auto& id : qif_api.payees())
         {
+            const wxString& payee = qif_api.text(id);
             wxVector<wxVariant> data;
             data.push_back(wxVariant(payee));
             Model_Payee::Data* p = Model_Payee::instance().get(payee);
@@ -698,11 +518,12 @@ void mmQIFImportDialog::refreshTabs(int tabs)
         num = 0;
         const auto &c(Model_Category::all_categories());
         categoryListBox_->DeleteAllItems();
-        for (const auto& categ : m_QIFcategoryNames)
+        for (const auto& id : qif_api.categories())
         {
+            const wxString& categ = qif_api.text(id);
             wxVector<wxVariant> data;
-            data.push_back(wxVariant(categ.first));
-            if (c.find(categ.first) == c.end())
+            data.push_back(wxVariant(categ));
+            if (c.find(categ) == c.end())
                 data.push_back(wxVariant("Missing"));
             else
                 data.push_back(wxVariant(_("OK")));
@@ -800,101 +621,40 @@ void mmQIFImportDialog::OnOk(wxCommandEvent& WXUNUSED(event))
         , wxYES_NO | wxNO_DEFAULT | wxICON_QUESTION);
     if (msgDlg.ShowModal() == wxID_YES)
     {
-        int nTransactions = vQIF_trxs_.size();
+        const int nTransactions = qif_api.entries().size();
         wxProgressDialog progressDlg(_("Please wait"), _("Importing")
             , nTransactions + 1, this, wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_AUTO_HIDE);
-        progressDlg.Update(1, _("Importing Accounts"));
-        if (getOrCreateAccounts() == 0 && !accountCheckBox_->GetValue())
+
+        mmQIFImport::Target target;
+        target.account = m_accountNameStr;
+        target.force_account = accountCheckBox_->IsChecked();
+        target.by_number = accountNumberCheckBox_->IsChecked();
+        target.date_format = m_dateFormatStr;
+        target.decimal = decimal_;
+        if (dateFromCheckBox_->IsChecked())
+            target.from_date = wxAtoi(fromDateCtrl_->GetValue().Format("%Y%m%d"));
+        if (dateToCheckBox_->IsChecked())
+            target.to_date = wxAtoi(toDateCtrl_->GetValue().Format("%Y%m%d"));
+
+        qif_api.decode(target.date_format, target.decimal);
+        const mmQIFImport::Result result = qif_api.write(target, [&](size_t count, size_t total)
+        {
+            return progressDlg.Update(static_cast<int>(count)
+                , wxString::Format(_("Importing transaction %zu of %zu"), count, total)); // false if cancel clicked
+        });
+        *log_field_ << result.log;
+
+        if (result.accounts == 0 && !target.force_account)
         {
             progressDlg.Update(nTransactions + 1);
             return mmErrorDialogs::MessageInvalid(this, _("Account"));
         }
         mmWebApp::MMEX_WebApp_UpdateAccount();
-        progressDlg.Update(1, _("Importing Payees"));
-        getOrCreatePayees();
         mmWebApp::MMEX_WebApp_UpdatePayee();
-        progressDlg.Update(1, _("Importing Categories"));
-        getOrCreateCategories();
         mmWebApp::MMEX_WebApp_UpdateCategory();
 
-        Model_Checking::Cache trx_data_set;
-        Model_Checking::Cache transfer_to_data_set;
-        Model_Checking::Cache transfer_from_data_set;
-        int count = 0;
-        const wxString transferStr = Model_Checking::all_type()[Model_Checking::TRANSFER];
-
-        const auto begin_date = toDateCtrl_->GetValue().FormatISODate();
-        const auto end_date = fromDateCtrl_->GetValue().FormatISODate();
-        for (const auto& entry : vQIF_trxs_)
-        {
-            if (count % 100 == 0 || count == nTransactions)
-            {
-                if (!progressDlg.Update(count
-                    , wxString::Format(_("Importing transaction %i of %i"), count, nTransactions))) // if cancel clicked
-                    break; // abort processing
-            }
-            //
-            Model_Checking::Data *trx = Model_Checking::instance().create();
-            wxString msg;
-            if (completeTransaction(entry, trx, msg))
-            {
-                if (dateFromCheckBox_->IsChecked() && trx->TRANSDATE < begin_date)
-                    continue;
-                if (dateToCheckBox_->IsChecked() && trx->TRANSDATE > end_date)
-                    continue;
-
-                if (trx->TRANSCODE == transferStr && trx->TOTRANSAMOUNT > 0.0)
-                    transfer_from_data_set.push_back(trx);
-                else if (trx->TRANSCODE == transferStr && trx->TOTRANSAMOUNT <= 0.0)
-                    transfer_to_data_set.push_back(trx);
-                else
-                    trx_data_set.push_back(trx);
-            }
-            else
-            {
-                *log_field_ << wxString::Format(_("Error: %s"), msg);
-
-                wxString t = "";
-                for (const auto&i : entry)
-                    t << i.second << "|";
-                t.RemoveLast(1);
-                *log_field_ << wxString::Format("\n( %s )\n", t);
-            }
-            ++count;
-        }
-
-        progressDlg.Update(count, _("Importing Transfers"));
-        mergeTransferPair(transfer_to_data_set, transfer_from_data_set);
-        appendTransfers(trx_data_set, transfer_to_data_set);
-
-        //Search for duplicates for transfers
-        for (auto &trx : trx_data_set)
-        {
-            if (!Model_Checking::is_transfer(trx))
-                continue;
-            wxDate dt;
-            dt.ParseISODate(trx->TRANSDATE);
-            const auto data = Model_Checking::instance().find(
-                Model_Checking::TRANSDATE(dt)
-                , Model_Checking::ACCOUNTID(trx->ACCOUNTID)
-                , Model_Checking::TOACCOUNTID(trx->TOACCOUNTID)
-                , Model_Checking::NOTES(trx->NOTES)
-                , Model_Checking::TRANSACTIONNUMBER(trx->TRANSACTIONNUMBER)
-                , Model_Checking::TRANSCODE(Model_Checking::TRANSFER)
-                , Model_Checking::TRANSAMOUNT(trx->TRANSAMOUNT)
-            );
-            if (data.size() > 0)
-                trx->STATUS = "D";
-        }
-
-        Model_Checking::instance().save(trx_data_set);
-        progressDlg.Update(count, _("Importing Split transactions"));
-        joinSplit(trx_data_set, m_splitDataSets);
-        saveSplit();
-
-        sMsg = _("Import finished successfully") + "\n" + wxString::Format(_("Total Imported: %zu"), trx_data_set.size());
-        trx_data_set.clear();
-        vQIF_trxs_.clear();
+        sMsg = _("Import finished successfully") + "\n" + wxString::Format(_("Total Imported: %zu"), result.imported);
+        qif_api.clear();
         btnOK_->Enable(false);
         progressDlg.Destroy();
     }
@@ -908,217 +668,6 @@ void mmQIFImportDialog::OnOk(wxCommandEvent& WXUNUSED(event))
     refreshTabs(ACC_TAB | PAYEE_TAB | CAT_TAB);
 }
 
-void mmQIFImportDialog::saveSplit()
-{
-    if (m_splitDataSets.empty()) return;
-
-    Model_Splittransaction::instance().Savepoint();
-    while (!m_splitDataSets.empty()) {
-        Model_Splittransaction::instance().save(m_splitDataSets.back());
-        m_splitDataSets.pop_back();
-    }
-    Model_Splittransaction::instance().ReleaseSavepoint();
-}
-void mmQIFImportDialog::joinSplit(Model_Checking::Cache &destination
-    , std::vector<Model_Splittransaction::Cache> &target)
-{
-    for (auto &item : destination)
-    {
-        if (item->CATEGID != -1) continue;
-        if (item->SUBCATEGID == -1) continue;
-        for (auto &split_item : target.at(item->SUBCATEGID))
-            split_item->TRANSID = item->TRANSID;
-        item->SUBCATEGID = -1;
-    }
-}
-
-void mmQIFImportDialog::appendTransfers(Model_Checking::Cache &destination, Model_Checking::Cache &target)
-{
-    while (!target.empty()) {
-        destination.push_back(target.back());
-        target.pop_back();
-    }
-}
-
-bool mmQIFImportDialog::mergeTransferPair(Model_Checking::Cache& to, Model_Checking::Cache& from)
-{
-    if (to.empty() && from.empty()) return false; //Nothing to merge
-
-    for (auto& refTrxTo : to)
-    {
-        int i = -1;
-        bool pair_found = false;
-        for (auto& refTrxFrom : from)
-        {
-            ++i;
-            if (refTrxTo->ACCOUNTID != refTrxFrom->TOACCOUNTID) continue;
-            if (refTrxTo->TOACCOUNTID != refTrxFrom->ACCOUNTID) continue;
-            if (refTrxTo->TRANSACTIONNUMBER != refTrxFrom->TRANSACTIONNUMBER) continue;
-            if (refTrxTo->NOTES != refTrxFrom->NOTES) continue;
-            if (refTrxTo->TRANSDATE != refTrxFrom->TRANSDATE) continue;
-            refTrxTo->TOTRANSAMOUNT = refTrxFrom->TRANSAMOUNT;
-            from.erase(from.begin() + i);
-            pair_found = true;
-            break;
-        }
-
-        if (!pair_found)
-            refTrxTo->TOTRANSAMOUNT = refTrxTo->TRANSAMOUNT;
-    }
-
-    while (!from.empty()) {
-        std::swap(from.back()->ACCOUNTID, from.back()->TOACCOUNTID);
-        to.push_back(from.back());
-        from.pop_back();
-    }
-
-    return true;
-}
-
-bool mmQIFImportDialog::completeTransaction(/*in*/ const std::unordered_map <int, wxString> &i
-    , /*out*/ Model_Checking::Data* trx, wxString& msg)
-{
-    auto t = i;
-    trx->TRANSCODE = (t.find(TrxType) != t.end() ? t[TrxType] : "");
-    if (trx->TRANSCODE.empty())
-    {
-        msg = _("Transaction code is missing");
-        return false;
-    }
-    bool transfer = Model_Checking::is_transfer(trx->TRANSCODE);
-
-    if (!transfer)
-        trx->PAYEEID = (t.find(Payee) != t.end() ? m_QIFpayeeNames[t.at(Payee)] : -1);
-    if (trx->PAYEEID == -1 && !transfer)
-    {
-        msg = _("Transaction Payee is missing or incorrect");
-        return false;
-    }
-
-    wxString dateStr = (t.find(Date) != t.end() ? t[Date] : "");
-    dateStr.Replace(" ", "");
-    wxDateTime dtdt;
-    wxString::const_iterator end;
-    if (dtdt.ParseFormat(dateStr, m_dateFormatStr, &end))
-        trx->TRANSDATE = dtdt.FormatISODate();
-    else
-    {
-        *log_field_ << _("Date format or date mask is incorrect") << "\n";
-        return false;
-    }
-
-    int accountID = -1;
-    wxString accountName = (t.find(AccountName) != t.end() ? t[AccountName] : "");
-    if ((accountName.empty() || accountCheckBox_->IsChecked()) /*&& !transfer*/) {
-        accountName = m_accountNameStr;
-    }
-    accountID = (m_QIFaccountsID.find(accountName) != m_QIFaccountsID.end() ? m_QIFaccountsID.at(accountName) : -1);
-    if (accountID < 1)
-    {
-        msg = _("Transaction Account is incorrect");
-        return false;
-    }
-    trx->ACCOUNTID = accountID;
-    trx->TOACCOUNTID = (t.find(ToAccountName) != t.end()
-        ? (m_QIFaccountsID.find(t[ToAccountName]) != m_QIFaccountsID.end()
-            ? m_QIFaccountsID[t[ToAccountName]] : -1) : -1);
-    if (trx->ACCOUNTID == trx->TOACCOUNTID && transfer)
-    {
-        msg = _("Transaction Account for transfer is incorrect");
-        return false;
-    }
-
-    trx->TRANSACTIONNUMBER = (t.find(TransNumber) != t.end() ? t[TransNumber] : "");
-    trx->NOTES = (t.find(Memo) != t.end() ? t[Memo] : "");
-
-    wxString status = "";
-    if (t.find(Status) != t.end())
-    {
-        wxString s = t[Status];
-        if (s == "X" || s == "R")
-            status = "R";
-        /*else if (s == "*" || s == "c")
-        {
-            TODO: What does 'cleared' status mean?
-            status = "c";
-        }*/
-
-    }
-    trx->STATUS = status;
-
-    trx->FOLLOWUPID = -1;
-    const wxString value = mmTrimAmount(t.find(Amount) != t.end() ? t[Amount] : "", decimal_, ".");
-    if (value.empty())
-    {
-        msg = _("Transaction Amount is incorrect");
-        return false;
-    }
-
-    double amt;
-    value.ToCDouble(&amt);
-
-    trx->TRANSAMOUNT = fabs(amt);
-    trx->TOTRANSAMOUNT = transfer ? amt : trx->TRANSAMOUNT;
-
-    if (t.find(CategorySplit) != t.end())
-    {
-        Model_Splittransaction::Cache split;
-        wxStringTokenizer token(t[CategorySplit], "\n");
-        wxStringTokenizer amtToken(t.find(AmountSplit) != t.end() ? t[AmountSplit] : "", "\n");
-        while (token.HasMoreTokens())
-        {
-            const wxString c = token.GetNextToken();
-            if (m_QIFcategoryNames.find(c) == m_QIFcategoryNames.end()) return false;
-            int categID = m_QIFcategoryNames[c].first;
-            if (categID <= 0)
-            {
-                msg = _("Transaction Category is incorrect");
-                return false;
-            }
-            Model_Splittransaction::Data* s = Model_Splittransaction::instance().create();
-            s->CATEGID = categID;
-            s->SUBCATEGID = m_QIFcategoryNames[c].second;
-
-            wxString amtSplit = amtToken.GetNextToken();
-            amtSplit = mmTrimAmount(amtSplit, decimal_, ".");
-            double amount;
-            amtSplit.ToCDouble(&amount);
-            s->SPLITTRANSAMOUNT = (Model_Checking::is_deposit(trx) ? amount : -amount);
-            s->TRANSID = trx->TRANSID;
-            split.push_back(s);
-        }
-        trx->SUBCATEGID = m_splitDataSets.size();
-        m_splitDataSets.push_back(split);
-    }
-    else
-    {
-        wxString categStr = (t.find(Category) != t.end() ? t.at(Category) : "");
-        if (categStr.empty())
-        {
-            Model_Payee::Data* payee = Model_Payee::instance().get(trx->PAYEEID);
-            if (payee)
-            {
-                trx->CATEGID = payee->CATEGID;
-                trx->SUBCATEGID = payee->SUBCATEGID;
-            }
-            categStr = Model_Category::full_name(trx->CATEGID, trx->SUBCATEGID);
-
-            if (categStr.empty())
-            {
-                trx->CATEGID = (m_QIFcategoryNames[_("Unknown")].first);
-                trx->SUBCATEGID = -1;
-            }
-        }
-        else
-        {
-            trx->CATEGID = (m_QIFcategoryNames[categStr].first);
-            trx->SUBCATEGID = (m_QIFcategoryNames[categStr].second);
-        }
-
-    }
-    return true;
-}
-
 void mmQIFImportDialog::OnCancel(wxCommandEvent& WXUNUSED(event))
 {
     EndModal(wxID_CANCEL);
@@ -1129,149 +678,6 @@ void mmQIFImportDialog::OnQuit(wxCloseEvent& WXUNUSED(event))
     EndModal(wxID_CANCEL);
 }
 
-int mmQIFImportDialog::getOrCreateAccounts()
-{
-    m_QIFaccountsID.clear();
-
-    for (auto &item : m_QIFaccounts)
-    {
-        int accountID = -1;
-        Model_Account::Data* acc = (accountNumberCheckBox_->IsChecked())
-            ? Model_Account::instance().getByAccNum(item.first)
-            : Model_Account::instance().get(item.first);
-
-        if (!acc)
-        {
-            Model_Account::Data *account = Model_Account::instance().create();
-
-            account->FAVORITEACCT = "TRUE";
-            account->STATUS = Model_Account::all_status()[Model_Account::OPEN];
-
-            const auto type = item.second.find(AccountType) != item.second.end() ? item.second.at(AccountType) : "";
-            account->ACCOUNTTYPE = mmExportTransaction::mm_acc_type(type);
-            //Model_Account::all_type()[Model_Account::CHECKING];
-            account->ACCOUNTNAME = item.first;
-            account->INITIALBAL = 0;
-
-            account->CURRENCYID = Model_Currency::GetBaseCurrency()->CURRENCYID;
-            const wxString c = (item.second.find(Description) == item.second.end() ? "" : item.second.at(Description));
-            for (const auto& curr : Model_Currency::instance().all())
-            {
-                if (wxString::Format("[%s]", curr.CURRENCY_SYMBOL) == c) {
-                    account->CURRENCYID = curr.CURRENCYID;
-                    break;
-                }
-            }
-
-            accountID = Model_Account::instance().save(account);
-            wxString sMsg = wxString::Format(_("Added account: %s"), item.first);
-            *log_field_ << sMsg << "\n";
-        }
-        else
-            accountID = acc->ACCOUNTID;
-
-        m_QIFaccountsID[item.first] = accountID;
-    }
-
-    Model_Account::Data* acc = Model_Account::instance().get(m_accountNameStr);
-    if (acc) {
-        m_QIFaccountsID[m_accountNameStr] = acc->ACCOUNTID;
-    }
-
-    return m_QIFaccountsID.size();
-}
-
-void mmQIFImportDialog::getOrCreatePayees()
-{
-    Model_Payee::Cache data_set;
-    for (const auto &item : m_payee_names)
-    {
-        Model_Payee::Data* p = Model_Payee::instance().get(item);
-        if (!p)
-        {
-            p = Model_Payee::instance().create();
-            p->PAYEENAME = item;
-            p->CATEGID = -1;
-            p->SUBCATEGID = -1;
-            wxString sMsg = wxString::Format(_("Added payee: %s"), item);
-            log_field_->AppendText(wxString() << sMsg << "\n");
-        }
-
-        data_set.push_back(p);
-    }
-
-    Model_Payee::instance().save(data_set);
-    for (const auto& entry : data_set) {
-        m_QIFpayeeNames[entry->PAYEENAME] = entry->PAYEEID;
-    }
-}
-
-void mmQIFImportDialog::getOrCreateCategories()
-{
-    Model_Category::Cache data_set;
-    wxArrayString temp;
-    for (const auto &item : m_QIFcategoryNames)
-    {
-        wxStringTokenizer token(item.first, ":");
-        const wxString categStr = token.GetNextToken();
-        Model_Category::Data *c = Model_Category::instance().get(categStr);
-        //if (c && std::find(data_set.begin(), data_set.end(), c) != data_set.end()) continue;
-        if (temp.Index(categStr) != wxNOT_FOUND) continue;
-
-        if (!c)
-        {
-            c = Model_Category::instance().create();
-            c->CATEGNAME = categStr;
-            c->CATEGID = -1;
-        }
-        data_set.push_back(c);
-        temp.Add(categStr);
-    }
-    Model_Category::instance().save(data_set);
-
-    Model_Subcategory::Cache sub_data_set;
-    for (const auto &item : m_QIFcategoryNames)
-    {
-        wxStringTokenizer token(item.first, ":");
-        const wxString categStr = token.GetNextToken();
-        wxString subcategStr = token.GetNextToken();
-        if (subcategStr.empty()) {
-            continue;
-        }
-
-        if (subcategStr.Contains(":")) {
-            subcategStr.Replace(":", "|");
-        }
-
-        Model_Category::Data *c = Model_Category::instance().get(categStr);
-        wxASSERT(c);
-
-        Model_Subcategory::Data *sc = Model_Subcategory::instance().get(subcategStr, c->CATEGID);
-        if (!sc)
-        {
-            sc = Model_Subcategory::instance().create();
-            sc->SUBCATEGNAME = subcategStr;
-            sc->CATEGID = c->CATEGID;
-        }
-        sub_data_set.push_back(sc);
-    }
-    Model_Subcategory::instance().save(sub_data_set);
-
-    for (const auto &item : m_QIFcategoryNames) {
-        int subcategID = -1, categID = -1;
-        wxStringTokenizer token(item.first, ":");
-        const wxString categStr = token.GetNextToken();
-        const wxString subcategStr = token.GetNextToken();
-        const auto c = Model_Category::instance().get(categStr);
-        if (c) {
-            categID = c->CATEGID;
-            const auto s = Model_Subcategory::instance().get(subcategStr, categID);
-            if (s) subcategID = s->SUBCATEGID;
-        }
-        m_QIFcategoryNames[item.first] = std::make_pair(categID, subcategID);
-    }
-}
-
 int mmQIFImportDialog::get_last_imported_acc()
 {
     int accID = -1;
@@ -21,10 +21,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include <wx/dialog.h>
 #include "Model_Checking.h"
 #include "mmSimpleDialogs.h"
+#include "qif_import.h"
 
 class wxDatePickerCtrl;
 class wxDataViewListCtrl;
-class mmQIFImport;
 class wxButton;
 class wxTextCtrl;
 class wxChoice;
@@ -50,7 +50,7 @@ public:
     int get_last_imported_acc();
 
 private:
-    mmQIFImport* qif_api;
+    mmQIFImport qif_api;
     void CreateControls();
     void fillControls();
     void OnFileSearch(wxCommandEvent& event);
@@ -62,27 +62,8 @@ private:
     void OnOk(wxCommandEvent& WXUNUSED(event));
     void OnDecimalChange(wxCommandEvent& event);
     bool mmReadQIFFile();
-    int getOrCreateAccounts();
-    void getOrCreatePayees();
-    void getOrCreateCategories();
-    bool completeTransaction(std::unordered_map <int, wxString> &trx, const wxString &accName);
-    bool completeTransaction(/*in*/ const std::unordered_map <int, wxString> &i
-        , /*out*/ Model_Checking::Data* trx, wxString& msg);
-    bool mergeTransferPair(Model_Checking::Cache& to, Model_Checking::Cache& from);
-    void appendTransfers(Model_Checking::Cache &destination, Model_Checking::Cache &target);
-    void joinSplit(Model_Checking::Cache &destination, std::vector <Model_Splittransaction::Cache> &target);
-    void saveSplit();
     void refreshTabs(int tabs);
 
-    //QIF paragraphs represented like maps type = data
-    std::vector <std::unordered_map <int, wxString> > vQIF_trxs_;
-    std::unordered_map <wxString, std::unordered_map <int, wxString> > m_QIFaccounts;
-    std::unordered_map <wxString, int> m_QIFaccountsID;
-    std::unordered_map <wxString, int> m_QIFpayeeNames;
-    wxArrayString m_payee_names;
-    std::unordered_map <wxString, std::pair<int, int> > m_QIFcategoryNames;
-    std::vector <Model_Splittransaction::Cache> m_splitDataSets;
-
     wxString m_accountNameStr;
     wxString m_dateFormatStr;
     wxString decimal_;
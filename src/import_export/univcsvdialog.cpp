@@ -28,6 +28,7 @@
 #include "platfdep.h"
 #include "util.h"
 #include "option.h"
+#include "mmHook.h"
 #include "webapp.h"
 #include "parsers.h"
 
@@ -1075,6 +1076,7 @@ void mmUnivCSVDialog::OnImport(wxCommandEvent& WXUNUSED(event))
     {
         // and discard the database changes.
         Model_Checking::instance().Rollback();
+        UpdateCallbackHook::ResetCaches();
         if (canceledbyuser) msg << _("Imported transactions discarded by user!");
         else msg << _("No imported transactions!");
         msg << "\n\n";
@@ -1122,8 +1124,9 @@ void mmUnivCSVDialog::OnExport(wxCommandEvent& WXUNUSED(event))
     if (!from_account)
         return;
 
-    const auto split = Model_Splittransaction::instance().get_all();
     int fromAccountID = from_account->ACCOUNTID;
+    const std::vector<wxVariant> params(2, wxVariant(static_cast<long>(fromAccountID)));
+    const auto split = Model_Splittransaction::instance().get_all("ACCOUNTID = ? OR TOACCOUNTID = ?", params);
 
     wxDateTime trx_date;
 
@@ -1324,8 +1327,9 @@ void mmUnivCSVDialog::update_preview()
 
         if (from_account)
         {
-            const auto split = Model_Splittransaction::instance().get_all();
             int fromAccountID = from_account->ACCOUNTID;
+            const std::vector<wxVariant> params(2, wxVariant(static_cast<long>(fromAccountID)));
+            const auto split = Model_Splittransaction::instance().get_all("ACCOUNTID = ? OR TOACCOUNTID = ?", params);
             size_t count = 0;
             int row = 0;
             const wxString& delimit = this->delimit_;
@@ -17,6 +17,14 @@
  ********************************************************/
 #pragma once
 #include "option.h"
+#include "dbwrapper.h"
+#include "mmhomepage.h"
+#include "model/Model_Attachment.h"
+#include "model/Model_Balance.h"
+#include "model/Model_BudgetActual.h"
+#include "model/Model_Completion.h"
+#include "model/Model_CustomFieldData.h"
+#include "model/Model_NameTable.h"
 
 class CommitCallbackHook : public wxSQLite3Hook
 {
@@ -50,6 +58,47 @@ public:
         }
         wxLogDebug("database: %s, table: %s, rowid: %lld", database, table, rowid);
 
+        // keep interned display names in sync with renames
+        Model_NameTable::instance().invalidate(table);
+        // reload the rates and names used by the SQL functions
+        mmDBWrapper::InvalidateFunctions(table);
+        // record changed transactions for the incremental balance snapshot
+        Model_Balance::instance().touch(table, rowid);
+        // and the budget actuals
+        Model_BudgetActual::instance().touch(table, rowid);
+        // count new transactions and payee changes for the autocompletion
+        Model_Completion::instance().touch(table, rowid);
+        // keep the attachment and custom field presence indexes current
+        Model_Attachment::instance().touch(table, rowid);
+        Model_CustomFieldData::instance().touch(table, rowid);
+        // collect the home page data again on the next visit
+        mmHomePageCollector::instance().touch(table);
+
         // TODO sync search index from full text search
     }
+
+    /**
+    * The caches above were told about rows a rollback undoes, they are loaded
+    * again. SQLite calls the hook when a whole transaction is rolled back, the
+    * code rolling back to a savepoint calls ResetCaches() itself.
+    */
+    virtual void RollbackCallback()
+    {
+        ResetCaches();
+    }
+
+    static void ResetCaches()
+    {
+        // mark the names and the SQL function data stale, drop the rest
+        Model_NameTable::instance().invalidate("ACCOUNTLIST_V1");
+        Model_NameTable::instance().invalidate("PAYEE_V1");
+        Model_NameTable::instance().invalidate("CATEGORY_V1");
+        mmDBWrapper::InvalidateFunctions("INFOTABLE_V1");
+        Model_Balance::instance().reset();
+        Model_BudgetActual::instance().reset();
+        Model_Completion::instance().reset();
+        Model_Attachment::instance().reset();
+        Model_CustomFieldData::instance().reset();
+        mmHomePageCollector::instance().reset();
+    }
 };
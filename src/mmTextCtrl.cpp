@@ -18,10 +18,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include "mmTextCtrl.h"
 #include "mmSimpleDialogs.h"
+#include "validators.h"
 #include <wx/log.h>
 #include <wx/richtooltip.h>
 #include <LuaGlue/LuaGlue.h>
 
+IMPLEMENT_DYNAMIC_CLASS(mmCalcValidator, wxTextValidator)
+BEGIN_EVENT_TABLE(mmCalcValidator, wxTextValidator)
+EVT_CHAR(mmCalcValidator::OnChar)
+END_EVENT_TABLE()
+
 void mmTextCtrl::SetValue(double value)
 {
     this->SetValue(Model_Currency::toString(value, m_currency));
@@ -0,0 +1,207 @@
+/*******************************************************
+Copyright (C) 2014 Gabriele-V
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmattachment.h"
+#include "paths.h"
+#include "util.h"
+#include "model/Model_Attachment.h"
+#include "model/Model_Infotable.h"
+
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+#include <wx/utils.h>
+
+/***********************
+** mmAttachmentManage **
+************************/
+wxString mmAttachmentManage::m_PathSep = wxFileName::GetPathSeparator();
+
+wxString mmAttachmentManage::InfotablePathSetting()
+{
+    return Model_Infotable::instance().GetStringInfo("ATTACHMENTSFOLDER:" + mmPlatformType(), "");
+}
+
+wxString mmAttachmentManage::GetAttachmentNoteSign()
+{
+    return wxString::Format("[%s] ",_("Att."));
+}
+
+bool mmAttachmentManage::CreateReadmeFile(const wxString& FolderPath)
+{
+    wxString ReadmeFilePath = FolderPath + m_PathSep + "readme.txt";
+    wxString ReadmeText;
+    ReadmeText << _("This directory and its files are automatically managed by Money Manager EX software.") << wxTextFile::GetEOL();
+    ReadmeText << wxTextFile::GetEOL();
+    ReadmeText << _("Please do not remove, rename or modify manually directories and files.") << wxTextFile::GetEOL();
+
+    if (wxFileExists(ReadmeFilePath))
+    {
+        return true;
+    }
+    else
+    {
+        try
+        {
+            wxFile file(ReadmeFilePath, wxFile::write);
+
+            if (file.IsOpened())
+            {
+                file.Write(ReadmeText);
+                file.Close();
+                return true;
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool mmAttachmentManage::CopyAttachment(const wxString& FileToImport, const wxString& ImportedFile)
+{
+    wxString destinationFolder = wxPathOnly(ImportedFile);
+
+    if (!wxDirExists(destinationFolder))
+    {
+        if (wxMkdir(destinationFolder))
+            mmAttachmentManage::CreateReadmeFile(destinationFolder);
+        else
+            return false;
+    }
+
+    if (wxFileExists(ImportedFile))
+    {
+        const auto &attachments = Model_Attachment::instance().find(Model_Attachment::FILENAME(wxFileNameFromPath(ImportedFile)));
+        if (attachments.empty())
+        {
+            wxString msgStr = wxString() << _("Destination file already exist:") << "\n"
+                << "'" << ImportedFile << "'" << "\n"
+                << "\n"
+                << _("File not found in attachments. Please delete or rename it.") << "\n";
+            wxMessageBox(msgStr, _("Destination file already exist"), wxICON_ERROR);
+        }
+        else
+        {
+            wxString msgStr = wxString() << _("Destination file already exist:") << "\n"
+                << "'" << ImportedFile << "'" << "\n"
+                << "\n"
+                << _("File already found in attachments") << "\n";
+            wxMessageBox(msgStr, _("Destination file already exist"), wxICON_ERROR);
+        }
+        return false;
+    }
+    else if (wxCopyFile(FileToImport, ImportedFile))
+    {
+        if (Model_Infotable::instance().GetBoolInfo("ATTACHMENTSDELETE", false))
+            wxRemoveFile(FileToImport);
+    }
+    else
+        return false;
+
+    return true;
+}
+
+bool mmAttachmentManage::DeleteAttachment(const wxString& FileToDelete)
+{
+    if (wxFileExists(FileToDelete))
+    {
+        if (Model_Infotable::instance().GetBoolInfo("ATTACHMENTSTRASH", false))
+        {
+            wxString DeletedAttachmentFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + m_PathSep + "Deleted";
+
+            if (!wxDirExists(DeletedAttachmentFolder))
+            {
+                if (wxMkdir(DeletedAttachmentFolder))
+                    mmAttachmentManage::CreateReadmeFile(DeletedAttachmentFolder);
+                else
+                    return false;
+            }
+
+            wxString FileToTrash = DeletedAttachmentFolder + m_PathSep
+                + wxDateTime::Now().FormatISODate() + "_" + wxFileNameFromPath(FileToDelete);
+
+            if (!wxRenameFile(FileToDelete, FileToTrash))
+                return false;
+        }
+        else if (!wxRemoveFile(FileToDelete))
+            return false;
+    }
+    else
+    {
+        wxString msgStr = wxString() << _("Attachment not found:") << "\n"
+            << "'" << FileToDelete << "'" << "\n"
+            << "\n"
+            << _("Do you want to continue and delete attachment on database?") << "\n";
+        int DeleteResponse = wxMessageBox(msgStr, _("Delete attachment failed"), wxYES_NO | wxNO_DEFAULT | wxICON_ERROR);
+        if (DeleteResponse == wxYES)
+            return true;
+        else
+            return false;
+    }
+    return true;
+}
+
+bool mmAttachmentManage::OpenAttachment(const wxString& FileToOpen)
+{
+    if (!wxFileExists(FileToOpen))
+    {
+        wxString msgStr = wxString() << _("Unable to open file:") << "\n"
+            << "'" << FileToOpen << "'" << "\n"
+            << "\n"
+            << _("Please verify that file exists and user has rights to read it.") << "\n";
+        wxMessageBox(msgStr, _("Open attachment failed"), wxICON_ERROR);
+        return false;
+    }
+
+    return wxLaunchDefaultApplication(FileToOpen);;
+}
+
+bool mmAttachmentManage::DeleteAllAttachments(const wxString& RefType, int RefId)
+{
+    Model_Attachment::Data_Set attachments = Model_Attachment::instance().FilterAttachments(RefType, RefId);
+    wxString AttachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + m_PathSep + RefType;
+
+    for (const auto &entry : attachments)
+    {
+        mmAttachmentManage::DeleteAttachment(AttachmentsFolder + m_PathSep + entry.FILENAME);
+        Model_Attachment::instance().remove(entry.ATTACHMENTID);
+    }
+    return true;
+}
+
+bool mmAttachmentManage::RelocateAllAttachments(const wxString& RefType, int OldRefId, int NewRefId)
+{
+    auto attachments = Model_Attachment::instance().find(Model_Attachment::DB_Table_ATTACHMENT_V1::REFTYPE(RefType), Model_Attachment::REFID(OldRefId));
+    wxString AttachmentsFolder = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + m_PathSep + RefType + m_PathSep;
+
+    for (auto &entry : attachments)
+    {
+        wxString NewFileName = entry.FILENAME;
+        NewFileName.Replace(entry.REFTYPE + "_" + wxString::Format("%i", entry.REFID), entry.REFTYPE + "_" + wxString::Format("%i", NewRefId));
+        wxRenameFile(AttachmentsFolder + entry.FILENAME, AttachmentsFolder + NewFileName);
+        entry.REFID = NewRefId;
+        entry.FILENAME = NewFileName;
+    }
+    Model_Attachment::instance().save(attachments);
+
+    return true;
+}
@@ -0,0 +1,47 @@
+/*******************************************************
+Copyright (C) 2014 Gabriele-V
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_MMATTACHMENT_H_
+#define MM_EX_MMATTACHMENT_H_
+
+#include <wx/string.h>
+
+class wxWindow;
+
+/**
+* The attachment folder: copy, trash and relocate the files of the
+* ATTACHMENT_V1 rows. OpenAttachmentFromPanelIcon() shows the attachment
+* dialog and is defined with it.
+*/
+class mmAttachmentManage
+{
+public:
+    static wxString InfotablePathSetting();
+    static wxString GetAttachmentNoteSign();
+    static bool CreateReadmeFile(const wxString& FolderPath);
+    static bool CopyAttachment(const wxString& FileToImport, const wxString& ImportedFile);
+    static bool DeleteAttachment(const wxString& FileToDelete);
+    static bool OpenAttachment(const wxString& FileToOpen);
+    static bool DeleteAllAttachments(const wxString& RefType, int RefId);
+    static bool RelocateAllAttachments(const wxString& RefType, int OldRefId, int NewRefId);
+    static void OpenAttachmentFromPanelIcon(wxWindow* parent, const wxString& RefType, int RefId);
+private:
+    static wxString m_PathSep;
+};
+
+#endif // MM_EX_MMATTACHMENT_H_
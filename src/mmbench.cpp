@@ -0,0 +1,671 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmbench.h"
+#include "constants.h"
+#include "dbupgrade.h"
+#include "dbwrapper.h"
+#include "mmHook.h"
+#include "option.h"
+#include "platfdep.h"
+#include "util.h"
+
+#include "import_export/export.h"
+#include "import_export/qif_import.h"
+#include "model/allmodel.h"
+#include "reports/cashflow.h"
+#include "reports/categexp.h"
+#include "reports/forecast.h"
+#include "reports/incexpenses.h"
+#include "reports/mmDateRange.h"
+#include "reports/payee.h"
+#include "reports/summary.h"
+#include "reports/summarystocks.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <wx/stopwatch.h>
+#include <wx/txtstrm.h>
+#include <wx/wfstream.h>
+
+namespace
+{
+    const char* QIF_DATE_MASK = "%m/%d/%Y";
+
+    /** Integer in [0, n) from the raw sequence, the same with every standard library */
+    int pick(std::mt19937& rng, int n)
+    {
+        return n > 0 ? static_cast<int>(rng() % static_cast<unsigned int>(n)) : 0;
+    }
+
+    int last_id(wxSQLite3Database* db)
+    {
+        return static_cast<int>(db->GetLastRowId().GetLo());
+    }
+
+    struct Step
+    {
+        Step(const wxString& name, long ms, size_t items)
+            : name(name), ms(ms), items(items) {}
+        wxString name;
+        long ms;
+        size_t items;   // rows, records or bytes handled by the step
+    };
+
+    /** The models do not see a rollback, their cached rows are dropped */
+    void destroy_caches()
+    {
+        Model_Account::instance().destroy_cache();
+        Model_Attachment::instance().destroy_cache();
+        Model_Category::instance().destroy_cache();
+        Model_Checking::instance().destroy_cache();
+        Model_Currency::instance().destroy_cache();
+        Model_CurrencyHistory::instance().destroy_cache();
+        Model_MonthlyBalance::instance().destroy_cache();
+        Model_Payee::instance().destroy_cache();
+        Model_Splittransaction::instance().destroy_cache();
+        Model_Stock::instance().destroy_cache();
+        Model_StockHistory::instance().destroy_cache();
+        Model_Subcategory::instance().destroy_cache();
+        Model_Balance::instance().reset();
+        Model_BudgetActual::instance().reset();
+        Model_Completion::instance().reset();
+        Model_NameTable::instance().reset();
+        for (const auto& table : { "ACCOUNTLIST_V1", "CATEGORY_V1", "SUBCATEGORY_V1", "CURRENCYFORMATS_V1", "CURRENCYHISTORY_V1" })
+            mmDBWrapper::InvalidateFunctions(table);
+    }
+}
+
+mmBench::Params::Params()
+    : accounts(20)
+    , years(10)
+    , per_day(30)
+    , split_percent(10)
+    , currencies(3)
+    , stocks(10)
+    , attachment_percent(5)
+    , qif_lines(200000)
+    , seed(5489u)
+{
+}
+
+const wxString mmBench::Params::to_json() const
+{
+    StringBuffer json_buffer;
+    Writer<StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    json_writer.Key("accounts");
+    json_writer.Int(accounts);
+    json_writer.Key("years");
+    json_writer.Int(years);
+    json_writer.Key("per_day");
+    json_writer.Int(per_day);
+    json_writer.Key("split_percent");
+    json_writer.Int(split_percent);
+    json_writer.Key("currencies");
+    json_writer.Int(currencies);
+    json_writer.Key("stocks");
+    json_writer.Int(stocks);
+    json_writer.Key("attachment_percent");
+    json_writer.Int(attachment_percent);
+    json_writer.Key("qif_lines");
+    json_writer.Int(qif_lines);
+    json_writer.Key("seed");
+    json_writer.Uint(seed);
+    json_writer.EndObject();
+    return wxString::FromUTF8(json_buffer.GetString());
+}
+
+mmBench::Database::Database(const wxString& path)
+    : m_settings(new wxSQLite3Database())
+    , m_commit_hook(new CommitCallbackHook())
+    , m_update_hook(new UpdateCallbackHook())
+{
+    try
+    {
+        m_settings->Open(":memory:");
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("mmBench: Exception %s", e.GetMessage().utf8_str());
+        return;
+    }
+    Model_Setting::instance(m_settings);
+    Model_Usage::instance(m_settings);
+    Option::instance().LoadOptions(false);
+
+    if (path != ":memory:" && wxFileName::FileExists(path))
+        wxRemoveFile(path);
+    m_db = mmDBWrapper::Open(path);
+    if (!m_db) return;
+    m_db->SetCommitHook(m_commit_hook);
+    m_db->SetUpdateHook(m_update_hook);
+    m_db->SetRollbackHook(m_update_hook);
+
+    dbUpgrade::InitializeVersion(m_db.get());
+    Model_NameTable::instance().reset();
+    mmDBWrapper::InitializeModels(m_db.get());
+    // the first currency of a new database, the wizard would ask for it
+    Option::instance().BaseCurrency(1);
+    Option::instance().LoadOptions();
+}
+
+mmBench::Database::~Database()
+{
+    if (m_db)
+    {
+        m_db->SetCommitHook(nullptr);
+        m_db->SetUpdateHook(nullptr);
+        m_db->SetRollbackHook(nullptr);
+        m_db->Close();
+        m_db.reset();
+    }
+    delete m_commit_hook;
+    delete m_update_hook;
+    if (m_settings->IsOpen())
+        m_settings->Close();
+    delete m_settings;
+}
+
+wxSQLite3Database* mmBench::Database::get() const
+{
+    return m_db.get();
+}
+
+bool mmBench::Database::IsOpen() const
+{
+    return m_db && m_db->IsOpen();
+}
+
+size_t mmBench::generate(wxSQLite3Database* db, const Params& p)
+{
+    std::mt19937 rng(p.seed);
+    // a fixed last day, the rows do not depend on the day of the run
+    const wxDate last(31, wxDateTime::Dec, 2019);
+    const wxDate first = last - wxDateSpan::Years(std::max(1, p.years));
+    std::vector<wxString> dates;
+    for (wxDate date = first; date <= last; date.Add(wxDateSpan::Day()))
+        dates.push_back(date.FormatISODate());
+    const size_t recent = dates.size() > 30 ? dates.size() - 30 : 0;
+
+    size_t transactions = 0;
+    try
+    {
+        // the base currency and the generated ones, with a random walk of daily rates
+        std::vector<int> currency_ids;
+        const Model_Currency::Data* base = Model_Currency::GetBaseCurrency();
+        currency_ids.push_back(base ? base->CURRENCYID : 1);
+
+        wxSQLite3Statement currency = db->PrepareStatement("INSERT INTO CURRENCYFORMATS_V1 (CURRENCYNAME, PFX_SYMBOL, SFX_SYMBOL"
+            ", DECIMAL_POINT, GROUP_SEPARATOR, UNIT_NAME, CENT_NAME, SCALE, BASECONVRATE, CURRENCY_SYMBOL)"
+            " VALUES (?, '', ' B', '.', ',', '', '', 100, ?, ?)");
+        wxSQLite3Statement rate = db->PrepareStatement("INSERT INTO CURRENCYHISTORY_V1 (CURRENCYID, CURRDATE, CURRVALUE, CURRUPDTYPE)"
+            " VALUES (?, ?, ?, 1)");
+        for (int i = 0; i < p.currencies; i++)
+        {
+            double value = 0.2 + pick(rng, 500) / 100.0;
+            currency.Bind(1, wxString::Format("Bench Currency %i", i));
+            currency.Bind(2, value);
+            currency.Bind(3, wxString::Format("BN%i", i));
+            currency.ExecuteUpdate();
+            const int id = last_id(db);
+            currency_ids.push_back(id);
+            for (const auto& date : dates)
+            {
+                value *= 1.0 + (pick(rng, 2001) - 1000) / 100000.0;
+                rate.Bind(1, id);
+                rate.Bind(2, date);
+                rate.Bind(3, value);
+                rate.ExecuteUpdate();
+            }
+        }
+
+        // 20 categories of 5 subcategories, a transaction uses either level
+        std::vector<std::pair<int, int> > categories;
+        wxSQLite3Statement category = db->PrepareStatement("INSERT INTO CATEGORY_V1 (CATEGNAME) VALUES (?)");
+        wxSQLite3Statement subcategory = db->PrepareStatement("INSERT INTO SUBCATEGORY_V1 (SUBCATEGNAME, CATEGID) VALUES (?, ?)");
+        for (int i = 0; i < 20; i++)
+        {
+            category.Bind(1, wxString::Format("Bench Category %i", i));
+            category.ExecuteUpdate();
+            const int categ_id = last_id(db);
+            categories.push_back(std::make_pair(categ_id, -1));
+            for (int j = 0; j < 5; j++)
+            {
+                subcategory.Bind(1, wxString::Format("Sub %i", j));
+                subcategory.Bind(2, categ_id);
+                subcategory.ExecuteUpdate();
+                categories.push_back(std::make_pair(categ_id, last_id(db)));
+            }
+        }
+
+        std::vector<int> payees;
+        wxSQLite3Statement payee = db->PrepareStatement("INSERT INTO PAYEE_V1 (PAYEENAME, CATEGID, SUBCATEGID) VALUES (?, ?, ?)");
+        for (int i = 0; i < 200; i++)
+        {
+            const auto& c = categories[pick(rng, static_cast<int>(categories.size()))];
+            payee.Bind(1, wxString::Format("Bench Payee %i", i));
+            payee.Bind(2, c.first);
+            payee.Bind(3, c.second);
+            payee.ExecuteUpdate();
+            payees.push_back(last_id(db));
+        }
+
+        std::vector<std::pair<int, int> > accounts; // id, currency id
+        wxSQLite3Statement account = db->PrepareStatement("INSERT INTO ACCOUNTLIST_V1 (ACCOUNTNAME, ACCOUNTTYPE, ACCOUNTNUM, STATUS"
+            ", NOTES, HELDAT, WEBSITE, CONTACTINFO, ACCESSINFO, INITIALBAL, FAVORITEACCT, CURRENCYID, STATEMENTLOCKED, STATEMENTDATE"
+            ", MINIMUMBALANCE, CREDITLIMIT, INTERESTRATE, PAYMENTDUEDATE, MINIMUMPAYMENT)"
+            " VALUES (?, ?, '', 'Open', '', '', '', '', '', ?, 'TRUE', ?, 0, '', 0, 0, 0, '', 0)");
+        for (int i = 0; i < std::max(1, p.accounts); i++)
+        {
+            const int currency_id = currency_ids[i % currency_ids.size()];
+            account.Bind(1, wxString::Format("Bench Account %i", i));
+            account.Bind(2, Model_Account::all_type()[Model_Account::CHECKING]);
+            account.Bind(3, pick(rng, 1000000) / 100.0);
+            account.Bind(4, currency_id);
+            account.ExecuteUpdate();
+            accounts.push_back(std::make_pair(last_id(db), currency_id));
+        }
+
+        if (p.stocks > 0)
+        {
+            account.Bind(1, wxString("Bench Investments"));
+            account.Bind(2, Model_Account::all_type()[Model_Account::INVESTMENT]);
+            account.Bind(3, 0.0);
+            account.Bind(4, currency_ids[0]);
+            account.ExecuteUpdate();
+            const int held_at = last_id(db);
+
+            wxSQLite3Statement stock = db->PrepareStatement("INSERT INTO STOCK_V1 (HELDAT, PURCHASEDATE, STOCKNAME, SYMBOL, NUMSHARES"
+                ", PURCHASEPRICE, NOTES, CURRENTPRICE, VALUE, COMMISSION) VALUES (?, ?, ?, ?, ?, ?, '', ?, ?, 0)");
+            wxSQLite3Statement price = db->PrepareStatement("INSERT INTO STOCKHISTORY_V1 (SYMBOL, DATE, VALUE, UPDTYPE) VALUES (?, ?, ?, 1)");
+            for (int i = 0; i < p.stocks; i++)
+            {
+                const wxString symbol = wxString::Format("BENCH%i", i);
+                const double purchase = 5.0 + pick(rng, 20000) / 100.0;
+                double value = purchase;
+                for (const auto& date : dates)
+                {
+                    value = std::max(0.01, value * (1.0 + (pick(rng, 4001) - 2000) / 100000.0));
+                    price.Bind(1, symbol);
+                    price.Bind(2, date);
+                    price.Bind(3, value);
+                    price.ExecuteUpdate();
+                }
+                const double shares = 1 + pick(rng, 500);
+                stock.Bind(1, held_at);
+                stock.Bind(2, dates.front());
+                stock.Bind(3, wxString::Format("Bench Stock %i", i));
+                stock.Bind(4, symbol);
+                stock.Bind(5, shares);
+                stock.Bind(6, purchase);
+                stock.Bind(7, value);
+                stock.Bind(8, shares * value);
+                stock.ExecuteUpdate();
+            }
+        }
+
+        wxSQLite3Statement trans = db->PrepareStatement("INSERT INTO CHECKINGACCOUNT_V1 (ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE"
+            ", TRANSAMOUNT, STATUS, TRANSACTIONNUMBER, NOTES, CATEGID, SUBCATEGID, TRANSDATE, FOLLOWUPID, TOTRANSAMOUNT)"
+            " VALUES (?, ?, ?, ?, ?, ?, '', ?, ?, ?, ?, -1, ?)");
+        wxSQLite3Statement split = db->PrepareStatement("INSERT INTO SPLITTRANSACTIONS_V1 (TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT)"
+            " VALUES (?, ?, ?, ?)");
+        wxSQLite3Statement attachment = db->PrepareStatement("INSERT INTO ATTACHMENT_V1 (REFTYPE, REFID, DESCRIPTION, FILENAME)"
+            " VALUES (?, ?, 'Bench', ?)");
+        const wxString& ref_type = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
+        const int account_count = static_cast<int>(accounts.size());
+        const int categ_count = static_cast<int>(categories.size());
+
+        for (size_t day = 0; day < dates.size(); day++)
+        {
+            for (int n = 0; n < p.per_day; n++)
+            {
+                const auto& from = accounts[pick(rng, account_count)];
+                const int kind = pick(rng, 100);
+                const bool transfer = kind < 10 && account_count > 1;
+                const bool deposit = !transfer && kind < 35;
+                const int cents = 100 + pick(rng, deposit ? 300000 : 50000);
+                const double amount = cents / 100.0;
+
+                const int status = pick(rng, 100);
+                const wxString status_code = status < 1 ? "V" : status < 4 ? "F" : day < recent ? "R" : "";
+
+                int to_account = -1, payee_id = -1, categ_id = -1, subcateg_id = -1;
+                double to_amount = amount;
+                const bool is_split = !transfer && pick(rng, 100) < p.split_percent;
+                if (transfer)
+                {
+                    auto to = accounts[pick(rng, account_count - 1)];
+                    if (to.first == from.first) to = accounts.back();
+                    to_account = to.first;
+                    if (to.second != from.second)
+                        to_amount = std::round(amount * (50 + pick(rng, 150))) / 100.0;
+                }
+                else
+                {
+                    payee_id = payees[pick(rng, static_cast<int>(payees.size()))];
+                    if (!is_split)
+                    {
+                        const auto& c = categories[pick(rng, categ_count)];
+                        categ_id = c.first;
+                        subcateg_id = c.second;
+                    }
+                }
+
+                trans.Bind(1, from.first);
+                trans.Bind(2, to_account);
+                trans.Bind(3, payee_id);
+                trans.Bind(4, Model_Checking::all_type()[transfer ? Model_Checking::TRANSFER
+                    : deposit ? Model_Checking::DEPOSIT : Model_Checking::WITHDRAWAL]);
+                trans.Bind(5, amount);
+                trans.Bind(6, status_code);
+                trans.Bind(7, n % 4 == 0 ? wxString::Format("Bench note %zu", transactions) : wxString());
+                trans.Bind(8, categ_id);
+                trans.Bind(9, subcateg_id);
+                trans.Bind(10, dates[day]);
+                trans.Bind(11, to_amount);
+                trans.ExecuteUpdate();
+                const int trans_id = last_id(db);
+                transactions++;
+
+                if (is_split)
+                {
+                    // 2 to 4 parts adding up to the amount
+                    int left = cents;
+                    for (int parts = 2 + pick(rng, 3); parts > 0; parts--)
+                    {
+                        const int part = parts == 1 ? left : std::max(1, left / parts + pick(rng, left / parts + 1) - left / (2 * parts));
+                        const auto& c = categories[pick(rng, categ_count)];
+                        split.Bind(1, trans_id);
+                        split.Bind(2, c.first);
+                        split.Bind(3, c.second);
+                        split.Bind(4, part / 100.0);
+                        split.ExecuteUpdate();
+                        left -= part;
+                    }
+                }
+
+                if (pick(rng, 100) < p.attachment_percent)
+                {
+                    attachment.Bind(1, ref_type);
+                    attachment.Bind(2, trans_id);
+                    attachment.Bind(3, wxString::Format("%s_%i_bench.pdf", ref_type, trans_id));
+                    attachment.ExecuteUpdate();
+                }
+            }
+        }
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("mmBench: Exception %s", e.GetMessage().utf8_str());
+    }
+    return transactions;
+}
+
+size_t mmBench::write_qif(const wxString& path, size_t lines, const wxString& account, const wxString& to_account)
+{
+    size_t written = 0;
+    wxFileOutputStream output(path);
+    wxTextOutputStream file(output);
+    const auto line = [&](const wxString& text) { file << text << "\n"; written++; };
+
+    line("!Account");
+    line("N" + account);
+    line("TBank");
+    line("^");
+    line("!Type:Bank");
+    wxDateTime date(1, wxDateTime::Jan, 2015);
+    for (int i = 0; written < lines; i++)
+    {
+        if (i % 20 == 0) date.Add(wxDateSpan::Day());
+        const int cents = 100 + (i * 7919) % 250000;
+        line("D" + date.Format(QIF_DATE_MASK));
+        line(wxString::Format("T%s%i.%02i", i % 3 ? "-" : "", cents / 100, cents % 100));
+        if (i % 25 == 0)
+        {
+            line("L[" + to_account + "]");
+        }
+        else if (i % 10 == 0)
+        {
+            line(wxString::Format("PPayee %i", i % 500));
+            line(wxString::Format("SCategory %i:Sub %i", i % 40, i % 7));
+            line(wxString::Format("$%s%i.%02i", i % 3 ? "-" : "", cents / 200, 0));
+            line(wxString::Format("SCategory %i", (i + 1) % 40));
+            line(wxString::Format("$%s%i.%02i", i % 3 ? "-" : "", cents / 100 - cents / 200, cents % 100));
+        }
+        else
+        {
+            line(wxString::Format("PPayee %i", i % 500));
+            line(wxString::Format("LCategory %i:Sub %i", i % 40, i % 7));
+        }
+        if (i % 4 == 0) line(wxString::Format("MMemo %i", i));
+        line("^");
+    }
+    return written;
+}
+
+const wxString mmBench::run(wxSQLite3Database* db, const Params& params)
+{
+    std::vector<Step> steps;
+    const bool updated = Option::instance().DatabaseUpdated();
+    db->Savepoint("MMEX_CHECK");
+
+    wxStopWatch sw;
+    const size_t transactions = generate(db, params);
+    steps.push_back(Step("generate", sw.Time(), transactions));
+    destroy_caches();
+
+    // every table the home page and the reports read, from an empty cache
+    sw.Start();
+    size_t rows = Model_Account::instance().all().size();
+    rows += Model_Checking::instance().all().size();
+    rows += Model_Splittransaction::instance().all().size();
+    rows += Model_Payee::instance().all().size();
+    rows += Model_Category::instance().all().size();
+    rows += Model_Subcategory::instance().all().size();
+    rows += Model_Currency::instance().all().size();
+    rows += Model_CurrencyHistory::instance().all().size();
+    rows += Model_Stock::instance().all().size();
+    rows += Model_StockHistory::instance().all().size();
+    rows += Model_Attachment::instance().all().size();
+    steps.push_back(Step("model_load", sw.Time(), rows));
+
+    const auto all_accounts = Model_Account::instance().all();
+    double total = 0.0;
+    Model_Balance::instance().reset();
+    sw.Start();
+    for (const auto& account : all_accounts)
+        total += Model_Account::balance(account);
+    steps.push_back(Step("account_balance_cold", sw.Time(), all_accounts.size()));
+    sw.Start();
+    for (const auto& account : all_accounts)
+        total -= Model_Account::balance(account);
+    steps.push_back(Step("account_balance_warm", sw.Time(), all_accounts.size()));
+    wxLogDebug("mmBench: balance difference %f", total);
+
+    mmAllTime all_time;
+    {
+        std::map<int, std::map<int, std::map<int, double> > > stats;
+        sw.Start();
+        Model_Category::getCategoryStats(stats, nullptr, &all_time, false);
+        steps.push_back(Step("category_stats", sw.Time(), stats.size()));
+    }
+
+    // the budget reports need a budget and the usage report the settings database, they are left out
+    std::vector<std::pair<wxString, std::unique_ptr<mmPrintableBase> > > reports;
+    reports.emplace_back("report_summary_monthly", std::unique_ptr<mmPrintableBase>(new mmReportSummaryByDateMontly()));
+    reports.emplace_back("report_summary_yearly", std::unique_ptr<mmPrintableBase>(new mmReportSummaryByDateYearly()));
+    reports.emplace_back("report_where_goes", std::unique_ptr<mmPrintableBase>(new mmReportCategoryExpensesGoes()));
+    reports.emplace_back("report_where_comes", std::unique_ptr<mmPrintableBase>(new mmReportCategoryExpensesComes()));
+    reports.emplace_back("report_categories", std::unique_ptr<mmPrintableBase>(new mmReportCategoryExpensesCategories()));
+    reports.emplace_back("report_categories_monthly", std::unique_ptr<mmPrintableBase>(new mmReportCategoryOverTimePerformance()));
+    reports.emplace_back("report_payees", std::unique_ptr<mmPrintableBase>(new mmReportPayeeExpenses()));
+    reports.emplace_back("report_income_expenses", std::unique_ptr<mmPrintableBase>(new mmReportIncomeExpenses()));
+    reports.emplace_back("report_income_expenses_monthly", std::unique_ptr<mmPrintableBase>(new mmReportIncomeExpensesMonthly()));
+    reports.emplace_back("report_cash_flow_monthly", std::unique_ptr<mmPrintableBase>(new mmReportCashFlowMonthly()));
+    reports.emplace_back("report_cash_flow_daily", std::unique_ptr<mmPrintableBase>(new mmReportCashFlowDaily()));
+    reports.emplace_back("report_stocks", std::unique_ptr<mmPrintableBase>(new mmReportChartStocks()));
+    reports.emplace_back("report_stocks_summary", std::unique_ptr<mmPrintableBase>(new mmReportSummaryStocks()));
+    reports.emplace_back("report_forecast", std::unique_ptr<mmPrintableBase>(new mmReportForecast()));
+    for (auto& report : reports)
+    {
+        if (report.second->report_parameters() & mmPrintableBase::DATE_RANGE)
+            report.second->date_range(&all_time, 0);
+        sw.Start();
+        const wxString html = report.second->getHTMLText();
+        steps.push_back(Step(report.first, sw.Time(), html.size()));
+    }
+
+    // QIF and JSON export of all transactions, as the export dialog does
+    wxString qif;
+    {
+        sw.Start();
+        const auto splits = Model_Splittransaction::instance().get_all();
+        std::map<int, wxString> by_account;
+        Model_Checking::instance().for_each([&](const Model_Checking::Data& tran)
+        {
+            Model_Checking::Full_Data full_tran(tran, splits);
+            by_account[tran.ACCOUNTID] += mmExportTransaction::getTransactionQIF(full_tran, QIF_DATE_MASK);
+        }, Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL));
+        for (const auto& entry : by_account)
+            qif << mmExportTransaction::getAccountHeaderQIF(entry.first) << entry.second;
+        steps.push_back(Step("export_qif", sw.Time(), qif.size()));
+    }
+    {
+        sw.Start();
+        const auto splits = Model_Splittransaction::instance().get_all();
+        StringBuffer json_buffer;
+        PrettyWriter<StringBuffer> json_writer(json_buffer);
+        json_writer.StartObject();
+        json_writer.Key("TRANSACTIONS");
+        json_writer.StartArray();
+        Model_Checking::instance().for_each([&](const Model_Checking::Data& tran)
+        {
+            Model_Checking::Full_Data full_tran(tran, splits);
+            mmExportTransaction::getTransactionJSON(json_writer, full_tran);
+        }, Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL));
+        json_writer.EndArray();
+        json_writer.EndObject();
+        steps.push_back(Step("export_json", sw.Time(), json_buffer.GetSize()));
+    }
+
+    // QIF import of the export into the accounts it names
+    const wxString path = wxFileName::CreateTempFileName("mmex_bench");
+    {
+        wxFileOutputStream output(path);
+        const wxScopedCharBuffer utf8 = qif.utf8_str();
+        output.Write(utf8.data(), utf8.length());
+    }
+    qif.clear();
+    {
+        mmQIFImport import;
+        mmDates dates;
+        mmQIFImport::Target target;
+        target.account = wxString::Format("Bench Account %i", 0);
+        target.date_format = QIF_DATE_MASK;
+
+        sw.Start();
+        size_t lines = 0;
+        {
+            wxFileInputStream input(path);
+            lines = import.read(input, wxConvUTF8, target.account, false, &dates, mmQIFImport::Line_Callback());
+        }
+        steps.push_back(Step("import_qif_read", sw.Time(), lines));
+        sw.Start();
+        import.decode(target.date_format, target.decimal);
+        steps.push_back(Step("import_qif_decode", sw.Time(), import.entries().size()));
+        const mmQIFImport::Result result = import.write(target, mmQIFImport::Progress_Callback());
+        steps.push_back(Step("import_qif_write", result.ms.ToLong(), result.imported + result.splits));
+    }
+    wxRemoveFile(path);
+
+    // a large QIF file into new accounts, payees and categories
+    const size_t qif_peak_before_kb = mmex::GetPeakMemoryKB();
+    if (params.qif_lines > 0)
+    {
+        const wxString account = "Bench QIF Checking";
+        write_qif(path, static_cast<size_t>(params.qif_lines), account, "Bench QIF Savings");
+        mmQIFImport import;
+        mmDates dates;
+        mmQIFImport::Target target;
+        target.account = account;
+        target.date_format = QIF_DATE_MASK;
+
+        sw.Start();
+        size_t lines = 0;
+        {
+            wxFileInputStream input(path);
+            lines = import.read(input, wxConvUTF8, target.account, false, &dates, mmQIFImport::Line_Callback());
+        }
+        steps.push_back(Step("import_generated_qif_read", sw.Time(), lines));
+        sw.Start();
+        import.decode(target.date_format, target.decimal);
+        steps.push_back(Step("import_generated_qif_decode", sw.Time(), import.entries().size()));
+        const mmQIFImport::Result result = import.write(target, mmQIFImport::Progress_Callback());
+        steps.push_back(Step("import_generated_qif_write", result.ms.ToLong(), result.imported + result.splits));
+        wxRemoveFile(path);
+    }
+    const size_t qif_peak_after_kb = mmex::GetPeakMemoryKB();
+
+    const size_t peak_kb = mmex::GetPeakMemoryKB();
+    db->Rollback("MMEX_CHECK");
+    db->ReleaseSavepoint("MMEX_CHECK");
+    UpdateCallbackHook::ResetCaches();
+    Option::instance().DatabaseUpdated(updated);
+    destroy_caches();
+
+    StringBuffer json_buffer;
+    PrettyWriter<StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    json_writer.Key("version");
+    json_writer.String(mmex::version::string.utf8_str());
+    json_writer.Key("params");
+    const wxScopedCharBuffer params_json = params.to_json().utf8_str();
+    json_writer.RawValue(params_json.data(), params_json.length(), kObjectType);
+    json_writer.Key("transactions");
+    json_writer.Uint64(transactions);
+    json_writer.Key("peak_memory_kb");
+    json_writer.Uint64(peak_kb);
+    json_writer.Key("generated_qif_peak_memory_kb");
+    json_writer.StartArray();
+    json_writer.Uint64(qif_peak_before_kb);
+    json_writer.Uint64(qif_peak_after_kb);
+    json_writer.EndArray();
+    json_writer.Key("steps");
+    json_writer.StartArray();
+    for (const auto& step : steps)
+    {
+        json_writer.StartObject();
+        json_writer.Key("name");
+        json_writer.String(step.name.utf8_str());
+        json_writer.Key("ms");
+        json_writer.Int64(step.ms);
+        json_writer.Key("items");
+        json_writer.Uint64(step.items);
+        json_writer.EndObject();
+    }
+    json_writer.EndArray();
+    json_writer.EndObject();
+    return wxString::FromUTF8(json_buffer.GetString());
+}
@@ -0,0 +1,95 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_MMBENCH_H_
+#define MM_EX_MMBENCH_H_
+
+#include <wx/sharedptr.h>
+#include <wx/string.h>
+
+class wxSQLite3Database;
+class wxSQLite3Hook;
+
+/**
+* Benchmark of the hot paths on a generated database. The generator writes
+* accounts, payees, categories, transactions with splits and transfers,
+* currencies with daily rates, stocks with daily prices and attachment rows
+* in SQL, from a seeded random sequence, so the same parameters always give
+* the same rows. run() times the model load, the account balances, the
+* category statistics, every report, the QIF/JSON export and QIF import
+* on them and the import of a generated QIF file, then rolls everything back. The result is JSON, to compare runs
+* across builds. The mmex_bench tool runs it on a new temporary database.
+*/
+class mmBench
+{
+public:
+    struct Params
+    {
+        Params();
+        int accounts;
+        int years;              // of history up to 2019-12-31
+        int per_day;            // transactions per day over all accounts
+        int split_percent;      // transactions with 2 to 4 splits
+        int currencies;         // besides the base currency, with a rate for every day
+        int stocks;             // with a price for every day
+        int attachment_percent; // transactions with an attachment row, no file is written
+        int qif_lines;          // of the generated QIF file imported on its own
+        unsigned int seed;
+
+        const wxString to_json() const;
+    };
+
+    /**
+    * A new database with the latest schema and every model bound to it, with
+    * the settings in memory, for the mmex_bench tool and the tests, which run
+    * without the main frame. The file is replaced, ":memory:" keeps no file.
+    */
+    class Database
+    {
+    public:
+        explicit Database(const wxString& path);
+        ~Database();
+
+        wxSQLite3Database* get() const;
+        bool IsOpen() const;
+
+    private:
+        wxSQLite3Database* m_settings;
+        wxSharedPtr<wxSQLite3Database> m_db;
+        wxSQLite3Hook* m_commit_hook;
+        wxSQLite3Hook* m_update_hook;
+
+        Database(const Database&);
+        Database& operator=(const Database&);
+    };
+
+    /** Insert the rows described by params, return the number of transactions */
+    static size_t generate(wxSQLite3Database* db, const Params& params);
+
+    /**
+    * Write a QIF file of about lines lines into account: withdrawals and
+    * deposits with payees, categories and memos, every 10th one split and
+    * every 25th one a transfer to to_account. Returns the lines written.
+    */
+    static size_t write_qif(const wxString& path, size_t lines, const wxString& account, const wxString& to_account);
+
+    /** Generate, time the hot paths and roll back. Returns the timings in JSON */
+    static const wxString run(wxSQLite3Database* db, const Params& params);
+};
+
+#endif // MM_EX_MMBENCH_H_
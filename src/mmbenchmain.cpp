@@ -0,0 +1,103 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmbench.h"
+#include <wx/cmdline.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+#include <wx/log.h>
+
+//----------------------------------------------------------------------------
+// mmex_bench: generate a database, time the hot paths on it and write the
+// timings in JSON, see mmBench
+//----------------------------------------------------------------------------
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] =
+{
+    { wxCMD_LINE_SWITCH, "h", "help", "", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "b", "bench", "where <str> is the file to write the timings to, in JSON", wxCMD_LINE_VAL_STRING, wxCMD_LINE_OPTION_MANDATORY },
+    { wxCMD_LINE_OPTION, "d", "db", "where <str> is the database file to generate, a temporary file is used and removed otherwise" },
+    { wxCMD_LINE_OPTION, nullptr, "accounts", "number of accounts (20)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "years", "years of history up to 2019-12-31 (10)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "per-day", "transactions per day over all accounts (30)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "splits", "percent of the transactions with splits (10)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "currencies", "currencies besides the base currency (3)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "stocks", "number of stocks (10)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "attachments", "percent of the transactions with an attachment (5)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "qif-lines", "lines of the generated QIF file to import, 0 for none (200000)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, nullptr, "seed", "seed of the random sequence (5489)", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+int main(int argc, char** argv)
+{
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+        return 1;
+
+    wxCmdLineParser parser(g_cmdLineDesc, argc, argv);
+    if (parser.Parse() != 0)
+        return 1;
+
+    mmBench::Params params;
+    auto number = [&parser](const char* name, int& param)
+    {
+        long value;
+        if (parser.Found(name, &value))
+            param = static_cast<int>(value);
+    };
+    number("accounts", params.accounts);
+    number("years", params.years);
+    number("per-day", params.per_day);
+    number("splits", params.split_percent);
+    number("currencies", params.currencies);
+    number("stocks", params.stocks);
+    number("attachments", params.attachment_percent);
+    number("qif-lines", params.qif_lines);
+    long seed;
+    if (parser.Found("seed", &seed))
+        params.seed = static_cast<unsigned int>(seed);
+
+    wxString bench_file;
+    parser.Found("bench", &bench_file);
+    wxString db_file;
+    const bool temporary = !parser.Found("db", &db_file);
+    if (temporary)
+        db_file = wxFileName::CreateTempFileName("mmex_bench");
+
+    wxString json;
+    {
+        mmBench::Database db(db_file);
+        if (!db.IsOpen())
+            return 1;
+        json = mmBench::run(db.get(), params);
+    }
+    if (temporary)
+        wxRemoveFile(db_file);
+
+    wxFile file(bench_file, wxFile::write);
+    if (!file.IsOpened())
+    {
+        wxLogError("Could not write %s", bench_file);
+        return 1;
+    }
+    file.Write(json);
+    file.Close();
+    return 0;
+}
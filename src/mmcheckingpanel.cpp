@@ -41,6 +41,7 @@
 
 #include <wx/srchctrl.h>
 #include <algorithm>
+#include <set>
 #include <wx/sound.h>
 //----------------------------------------------------------------------------
 
@@ -143,22 +144,28 @@ bool mmCheckingPanel::Create(
 
 void mmCheckingPanel::sortTable()
 {
+    typedef Model_Checking::Row_View View;
     switch (m_listCtrlAccount->g_sortcol)
     {
     case TransactionListCtrl::COL_ID:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(),SorterByTRANSID());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return x->TRANSID < y->TRANSID; });
         break;
     case TransactionListCtrl::COL_NUMBER:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByNUMBER());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return Model_Checking::SorterByNUMBER()(*x, *y); });
         break;
     case TransactionListCtrl::COL_PAYEE_STR:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByPAYEENAME());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return x.PAYEENAME() < y.PAYEENAME(); });
         break;
     case TransactionListCtrl::COL_STATUS:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterBySTATUS());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return x->STATUS < y->STATUS; });
         break;
     case TransactionListCtrl::COL_CATEGORY:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByCATEGNAME());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return x.CATEGNAME() < y.CATEGNAME(); });
         break;
     case TransactionListCtrl::COL_WITHDRAWAL:
         std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByWITHDRAWAL());
@@ -170,10 +177,12 @@ void mmCheckingPanel::sortTable()
         std::stable_sort(this->m_trans.begin(), this->m_trans.end(), Model_Checking::SorterByBALANCE());
         break;
     case TransactionListCtrl::COL_NOTES:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByNOTES());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return x->NOTES < y->NOTES; });
         break;
     case TransactionListCtrl::COL_DATE:
-        std::stable_sort(this->m_trans.begin(), this->m_trans.end(), SorterByTRANSDATE());
+        std::stable_sort(this->m_trans.begin(), this->m_trans.end()
+            , [](const View& x, const View& y) { return x->TRANSDATE < y->TRANSDATE; });
         break;
     default:
         break;
@@ -193,9 +202,18 @@ void mmCheckingPanel::filterTable()
     bool ignore_future = Option::instance().getIgnoreFutureTransactions();
     const wxString today_date_string = wxDate::Today().FormatISODate();
 
-    const auto splits = Model_Splittransaction::instance().get_all();
-    const auto attachments = Model_Attachment::instance().get_all(Model_Attachment::TRANSACTION);
-    for (const auto& tran : Model_Account::transaction(this->m_account))
+    // the splits of the transactions of the account only
+    const std::vector<wxVariant> params(2, wxVariant(static_cast<long>(m_AccountID)));
+    m_splits = Model_Splittransaction::instance().get_all("ACCOUNTID = ? OR TOACCOUNTID = ?", params);
+    const auto& splits = m_splits;
+    m_account_trans = Model_Account::transaction(this->m_account);
+    std::set<int> matching;
+    if (m_transFilterActive)
+    {
+        for (const auto& tran : m_trans_filter_dlg->findMatching(m_AccountID, true))
+            matching.insert(tran.TRANSID);
+    }
+    for (auto& tran : m_account_trans)
     {
         double transaction_amount = Model_Checking::amount(tran, m_AccountID);
         if (Model_Checking::status(tran.STATUS) != Model_Checking::VOID_)
@@ -210,7 +228,7 @@ void mmCheckingPanel::filterTable()
 
         if (m_transFilterActive)
         {
-            if (!m_trans_filter_dlg->checkAll(tran, m_AccountID, splits))
+            if (matching.find(tran.TRANSID) == matching.end())
                 continue;
         }
         else
@@ -222,16 +240,14 @@ void mmCheckingPanel::filterTable()
             }
         }
 
-        Model_Checking::Full_Data full_tran(tran, splits);
-        full_tran.PAYEENAME = full_tran.real_payee_name(m_AccountID);
-        full_tran.BALANCE = m_account_balance;
-        full_tran.AMOUNT = transaction_amount;
+        const auto it = splits.find(tran.TRANSID);
+        Model_Checking::Row_View view(&tran, m_AccountID, it != splits.end() ? &it->second : nullptr);
+        view.BALANCE = m_account_balance;
+        view.AMOUNT = transaction_amount;
+        view.m_has_attachment = Model_Attachment::instance().has_attachment(Model_Attachment::TRANSACTION, tran.TRANSID);
         m_filteredBalance += transaction_amount;
 
-        if (attachments.count(full_tran.TRANSID))
-            full_tran.NOTES.Prepend(mmAttachmentManage::GetAttachmentNoteSign());
-
-        this->m_trans.push_back(full_tran);
+        this->m_trans.push_back(view);
     }
 }
 
@@ -254,7 +270,7 @@ void mmCheckingPanel::updateTable()
     m_filteredBalance = 0.0;
     for (const auto & tran : m_trans)
     {
-        m_filteredBalance += Model_Checking::amount(tran, m_AccountID);
+        m_filteredBalance += Model_Checking::amount(*tran, m_AccountID);
     }
 
     setAccountSummary();
@@ -281,7 +297,7 @@ void mmCheckingPanel::markSelectedTransaction(int trans_id)
                 m_listCtrlAccount->SetItemState(i, 0, wxLIST_STATE_SELECTED);
             }
             // discover where the transaction has ended up in the list
-            if (trans_id == tran.TRANSID)
+            if (trans_id == tran->TRANSID)
             {
                 m_listCtrlAccount->m_selectedIndex = i;
                 // set the selected ID to this transaction.
@@ -298,7 +314,7 @@ void mmCheckingPanel::markSelectedTransaction(int trans_id)
             i =0;
         m_listCtrlAccount->EnsureVisible(i);
         m_listCtrlAccount->m_selectedIndex = i;
-        m_listCtrlAccount->m_selectedID = m_trans[i].TRANSID;
+        m_listCtrlAccount->m_selectedID = m_trans[i]->TRANSID;
     }
     else
     {
@@ -543,8 +559,8 @@ void mmCheckingPanel::updateExtraTransactionData(int selIndex)
     if (selIndex > -1)
     {
         enableEditDeleteButtons(true);
-        const Model_Checking::Data& tran = this->m_trans.at(selIndex);
-        Model_Checking::Full_Data full_tran(tran);
+        const Model_Checking::Data& tran = *this->m_trans.at(selIndex);
+        Model_Checking::Full_Data full_tran(tran, m_splits);
         m_info_panel->SetLabelText(tran.NOTES);
         wxString miniStr = full_tran.info();
 
@@ -726,8 +742,9 @@ void mmCheckingPanel::OnViewPopupSelected(wxCommandEvent& event)
 void mmCheckingPanel::DeleteViewedTransactions()
 {
     Model_Checking::instance().Savepoint();
-    for (const auto& tran: this->m_trans)
+    for (const auto& view: this->m_trans)
     {
+        const Model_Checking::Data& tran = *view;
         if (Model_Checking::foreignTransaction(tran))
         {
             Model_Translink::RemoveTranslinkEntry(tran.TRANSID);
@@ -743,17 +760,23 @@ void mmCheckingPanel::DeleteViewedTransactions()
 
 void mmCheckingPanel::DeleteFlaggedTransactions(const wxString& status)
 {
+    const wxString RefType = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
+    std::vector<int> ids;
     Model_Checking::instance().Savepoint();
-    for (const auto& tran: this->m_trans)
+    for (const auto& view: this->m_trans)
     {
+        const Model_Checking::Data& tran = *view;
         if (tran.STATUS == status)
         {
-            // remove also removes any split transactions
-            Model_Checking::instance().remove(tran.TRANSID);
-            mmAttachmentManage::DeleteAllAttachments(Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION), tran.TRANSID);
+            ids.push_back(tran.TRANSID);
+            if (Model_Attachment::NrAttachments(RefType, tran.TRANSID))
+                mmAttachmentManage::DeleteAllAttachments(RefType, tran.TRANSID);
             if (m_listCtrlAccount->m_selectedForCopy == tran.TRANSID) m_listCtrlAccount->m_selectedForCopy = -1;
         }
     }
+    // remove the split transactions with the transactions
+    Model_Splittransaction::instance().remove_in<Model_Splittransaction::TRANSID>(ids);
+    Model_Checking::instance().remove_in<Model_Checking::TRANSID>(ids);
     Model_Checking::instance().ReleaseSavepoint();
 }
 
@@ -761,21 +784,21 @@ const wxString mmCheckingPanel::getItem(long item, long column)
 {
     if (item < 0 || item >= static_cast<int>(m_trans.size())) return "";
 
-    const Model_Checking::Full_Data& tran = this->m_trans.at(item);
+    const Model_Checking::Row_View& tran = this->m_trans.at(item);
     switch (column)
     {
     case TransactionListCtrl::COL_ID:
-        return wxString::Format("%i", tran.TRANSID).Trim();
+        return wxString::Format("%i", tran->TRANSID).Trim();
     case TransactionListCtrl::COL_DATE:
-        return mmGetDateForDisplay(tran.TRANSDATE);
+        return mmGetDateForDisplay(tran->TRANSDATE);
     case TransactionListCtrl::COL_NUMBER:
-        return tran.TRANSACTIONNUMBER;
+        return tran->TRANSACTIONNUMBER;
     case TransactionListCtrl::COL_CATEGORY:
-        return tran.CATEGNAME;
+        return tran.CATEGNAME();
     case TransactionListCtrl::COL_PAYEE_STR:
-        return tran.is_foreign_transfer() ? "< " + tran.PAYEENAME : tran.PAYEENAME;
+        return tran.is_foreign_transfer() ? "< " + tran.PAYEENAME() : tran.PAYEENAME();
     case TransactionListCtrl::COL_STATUS:
-        return tran.is_foreign() ? "< " + tran.STATUS : tran.STATUS;
+        return tran.is_foreign() ? "< " + tran->STATUS : tran->STATUS;
     case TransactionListCtrl::COL_WITHDRAWAL:
         return tran.AMOUNT <= 0 ? Model_Currency::toString(std::fabs(tran.AMOUNT), this->m_currency) : "";
     case TransactionListCtrl::COL_DEPOSIT:
@@ -783,7 +806,7 @@ const wxString mmCheckingPanel::getItem(long item, long column)
     case TransactionListCtrl::COL_BALANCE:
         return Model_Currency::toString(tran.BALANCE, this->m_currency);
     case TransactionListCtrl::COL_NOTES:
-        return tran.NOTES;
+        return tran.m_has_attachment ? mmAttachmentManage::GetAttachmentNoteSign() + tran->NOTES : tran->NOTES;
     default:
         return wxEmptyString;
     }
@@ -992,7 +1015,7 @@ void TransactionListCtrl::OnListItemSelected(wxListEvent& event)
     if (GetSelectedItemCount() > 1)
         m_cp->enableEditDeleteButtons(true);
 
-    m_selectedID = m_cp->m_trans[m_selectedIndex].TRANSID;
+    m_selectedID = m_cp->m_trans[m_selectedIndex]->TRANSID;
 }
 //----------------------------------------------------------------------------
 
@@ -1037,8 +1060,8 @@ void TransactionListCtrl::OnMouseRightClick(wxMouseEvent& event)
     bool is_foreign = false;
     if (m_selectedIndex > -1)
     {
-        const Model_Checking::Full_Data& tran = m_cp->m_trans.at(m_selectedIndex);
-        if (Model_Checking::type(tran.TRANSCODE) == Model_Checking::TRANSFER)
+        const Model_Checking::Row_View& tran = m_cp->m_trans.at(m_selectedIndex);
+        if (Model_Checking::type(tran->TRANSCODE) == Model_Checking::TRANSFER)
         {
             type_transfer = true;
         }
@@ -1046,7 +1069,7 @@ void TransactionListCtrl::OnMouseRightClick(wxMouseEvent& event)
         {
             have_category = true;
         }
-        if (Model_Checking::foreignTransaction(tran))
+        if (tran.is_foreign())
         {
             is_foreign = true;
         }
@@ -1149,11 +1172,11 @@ void TransactionListCtrl::OnMarkTransaction(wxCommandEvent& event)
     else if (evt == MENU_TREEPOPUP_MARKDUPLICATE)          status = "D";
     else wxASSERT(false);
 
-    Model_Checking::Data *trx = Model_Checking::instance().get(m_cp->m_trans[m_selectedIndex].TRANSID);
+    Model_Checking::Data *trx = Model_Checking::instance().get(m_cp->m_trans[m_selectedIndex]->TRANSID);
     if (trx)
     {
         org_status = trx->STATUS;
-        m_cp->m_trans[m_selectedIndex].STATUS = status;
+        m_cp->m_trans[m_selectedIndex]->STATUS = status;
         trx->STATUS = status;
         Model_Checking::instance().save(trx);
     }
@@ -1163,7 +1186,7 @@ void TransactionListCtrl::OnMarkTransaction(wxCommandEvent& event)
     if ((m_cp->m_transFilterActive && m_cp->m_trans_filter_dlg->getStatusCheckBox()) 
         || bRefreshRequired)
     {
-        refreshVisualList(m_cp->m_trans[m_selectedIndex].TRANSID);
+        refreshVisualList(m_cp->m_trans[m_selectedIndex]->TRANSID);
     }
     else
     {
@@ -1213,12 +1236,14 @@ void TransactionListCtrl::OnMarkAllTransactions(wxCommandEvent& event)
     }
     else
     {
+        std::vector<int> ids;
         for (auto& tran : m_cp->m_trans)
         {
-            tran.NOTES.Replace(mmAttachmentManage::GetAttachmentNoteSign(), wxEmptyString, true);
-            tran.STATUS = status;
+            tran->STATUS = status;
+            ids.push_back(tran->TRANSID);
         }
-        Model_Checking::instance().save(m_cp->m_trans);
+        Model_Checking::instance().update_in<Model_Checking::TRANSID>(
+            Model_Checking::assign(DB_Table_CHECKINGACCOUNT_V1::STATUS(status)), ids);
     }
 
     refreshVisualList();
@@ -1309,11 +1334,11 @@ wxListItemAttr* TransactionListCtrl::OnGetItemAttr(long item) const
 {
     if (item < 0 || item >= static_cast<int>(m_cp->m_trans.size())) return 0;
 
-    const Model_Checking::Full_Data& tran = m_cp->m_trans[item];
-    bool in_the_future = (tran.TRANSDATE > m_today);
+    const Model_Checking::Row_View& tran = m_cp->m_trans[item];
+    bool in_the_future = (tran->TRANSDATE > m_today);
 
     // apply alternating background pattern
-    int user_colour_id = tran.FOLLOWUPID;
+    int user_colour_id = tran->FOLLOWUPID;
     if (user_colour_id < 0 ) user_colour_id = 0;
     else if (user_colour_id > 7) user_colour_id = 0;
 
@@ -1388,7 +1413,7 @@ void TransactionListCtrl::OnCopy(wxCommandEvent& WXUNUSED(event))
     if (GetSelectedItemCount() > 1)
         m_selectedForCopy = -1;
     else
-        m_selectedForCopy = m_cp->m_trans[m_selectedIndex].TRANSID;
+        m_selectedForCopy = m_cp->m_trans[m_selectedIndex]->TRANSID;
 
     if (wxTheClipboard->Open())
     {
@@ -1427,7 +1452,7 @@ void TransactionListCtrl::OnDuplicateTransaction(wxCommandEvent& WXUNUSED(event)
 {
     if ((m_selectedIndex < 0) || (GetSelectedItemCount() > 1)) return;
 
-    int transaction_id = m_cp->m_trans[m_selectedIndex].TRANSID;
+    int transaction_id = m_cp->m_trans[m_selectedIndex]->TRANSID;
     mmTransDialog dlg(this, m_cp->m_AccountID, transaction_id, m_cp->m_account_balance, true);
     if (dlg.ShowModal() == wxID_OK)
     {
@@ -1481,7 +1506,7 @@ int TransactionListCtrl::OnPaste(Model_Checking::Data* tran)
 void TransactionListCtrl::OnOpenAttachment(wxCommandEvent& WXUNUSED(event))
 {
     if ((m_selectedIndex < 0) || (GetSelectedItemCount() > 1)) return;
-    int transaction_id = m_cp->m_trans[m_selectedIndex].TRANSID;
+    int transaction_id = m_cp->m_trans[m_selectedIndex]->TRANSID;
     wxString RefType = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
 
     mmAttachmentManage::OpenAttachmentFromPanelIcon(this, RefType, transaction_id);
@@ -1501,7 +1526,7 @@ void TransactionListCtrl::OnListKeyDown(wxListEvent& event)
     m_topItemIndex = GetTopItem() + GetCountPerPage() - 1;
 
     //Read status of the selected transaction
-    wxString status = m_cp->m_trans[m_selectedIndex].STATUS;
+    wxString status = m_cp->m_trans[m_selectedIndex]->STATUS;
 
     if (wxGetKeyState(wxKeyCode('R')) && status != "R") {
         wxCommandEvent evt(wxEVT_COMMAND_MENU_SELECTED, MENU_TREEPOPUP_MARKRECONCILED);
@@ -1547,7 +1572,7 @@ void TransactionListCtrl::OnDeleteTransaction(wxCommandEvent& /*event*/)
 
     m_topItemIndex = GetTopItem() + GetCountPerPage() - 1;
 
-    Model_Checking::Data checking_entry = m_cp->m_trans[m_selectedIndex];
+    Model_Checking::Data checking_entry = *m_cp->m_trans[m_selectedIndex];
     if (TransactionLocked(checking_entry.TRANSDATE))
     {
         return;
@@ -1564,12 +1589,12 @@ void TransactionListCtrl::OnDeleteTransaction(wxCommandEvent& /*event*/)
         long x = 0;
         for (const auto& i : m_cp->m_trans)
         {
-            long transID = i.TRANSID;
+            long transID = i->TRANSID;
             if (GetItemState(x, wxLIST_STATE_SELECTED) == wxLIST_STATE_SELECTED)
             {
                 SetItemState(x, 0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
 
-                if (Model_Checking::foreignTransaction(i))
+                if (i.is_foreign())
                 {
                     Model_Translink::RemoveTranslinkEntry(transID);
                     m_cp->m_frame->RefreshNavigationTree();
@@ -1613,7 +1638,7 @@ bool TransactionListCtrl::TransactionLocked(const wxString& transdate)
 void TransactionListCtrl::OnEditTransaction(wxCommandEvent& /*event*/)
 {
     if ((m_selectedIndex < 0) || (GetSelectedItemCount() > 1)) return;
-    Model_Checking::Data checking_entry = m_cp->m_trans[m_selectedIndex];
+    Model_Checking::Data checking_entry = *m_cp->m_trans[m_selectedIndex];
     int transaction_id = checking_entry.TRANSID;
 
     if (TransactionLocked(checking_entry.TRANSDATE))
@@ -1687,7 +1712,7 @@ void TransactionListCtrl::OnSetUserColour(wxCommandEvent& event)
     {
         transaction->FOLLOWUPID = user_colour_id;
         Model_Checking::instance().save(transaction);
-        m_cp->m_trans[m_selectedIndex].FOLLOWUPID = user_colour_id;
+        m_cp->m_trans[m_selectedIndex]->FOLLOWUPID = user_colour_id;
         RefreshItems(m_selectedIndex, m_selectedIndex);
     }
 }
@@ -1735,7 +1760,7 @@ void TransactionListCtrl::OnMoveTransaction(wxCommandEvent& /*event*/)
 {
     if ((m_selectedIndex < 0) || (GetSelectedItemCount() > 1)) return;
 
-    Model_Checking::Data checking_entry = m_cp->m_trans[m_selectedIndex];
+    Model_Checking::Data checking_entry = *m_cp->m_trans[m_selectedIndex];
     if (TransactionLocked(checking_entry.TRANSDATE))
     {
         return;
@@ -1760,9 +1785,9 @@ void TransactionListCtrl::OnMoveTransaction(wxCommandEvent& /*event*/)
         else
             return;
 
-        Model_Checking::Full_Data& tran = m_cp->m_trans[m_selectedIndex];
-        tran.ACCOUNTID = dest_account_id;
-        Model_Checking::instance().save(&tran);
+        Model_Checking::Data* tran = m_cp->m_trans[m_selectedIndex].m_data;
+        tran->ACCOUNTID = dest_account_id;
+        Model_Checking::instance().save(tran);
         refreshVisualList();
     }
 }
@@ -1771,9 +1796,9 @@ void TransactionListCtrl::OnMoveTransaction(wxCommandEvent& /*event*/)
 void TransactionListCtrl::OnViewSplitTransaction(wxCommandEvent& /*event*/)
 {
     if ((m_selectedIndex > -1) && (GetSelectedItemCount() == 1)) {
-        const Model_Checking::Full_Data& tran = m_cp->m_trans.at(m_selectedIndex);
+        const Model_Checking::Row_View& tran = m_cp->m_trans.at(m_selectedIndex);
         if (tran.has_split())
-            m_cp->DisplaySplitCategories(tran.TRANSID);
+            m_cp->DisplaySplitCategories(tran->TRANSID);
     }
 }
 
@@ -1783,7 +1808,7 @@ void TransactionListCtrl::OnOrganizeAttachments(wxCommandEvent& /*event*/)
     if ((m_selectedIndex < 0) || (GetSelectedItemCount() > 1)) return;
 
     wxString RefType = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION);
-    int RefId = m_cp->m_trans[m_selectedIndex].TRANSID;
+    int RefId = m_cp->m_trans[m_selectedIndex]->TRANSID;
 
     mmAttachmentDialog dlg(this, RefType, RefId);
     dlg.ShowModal();
@@ -1797,7 +1822,7 @@ void TransactionListCtrl::OnCreateReoccurance(wxCommandEvent& /*event*/)
     if ((m_selectedIndex < 0) || (GetSelectedItemCount() > 1)) return;
 
     mmBDDialog dlg(this, 0, false, false);
-    dlg.SetDialogParameters(m_cp->m_trans[m_selectedIndex]);
+    dlg.SetDialogParameters(Model_Checking::Full_Data(*m_cp->m_trans[m_selectedIndex], m_cp->m_splits));
     if (dlg.ShowModal() == wxID_OK)
     {
         wxMessageBox(_("Reoccuring Transaction saved."));
@@ -309,7 +309,9 @@ private:
     Model_Account::Data* m_account;
     Model_Currency::Data* m_currency;
     wxScopedPtr<wxImageList> m_imageList;
-    Model_Checking::Full_Data_Set m_trans;
+    Model_Checking::Data_Arena m_account_trans; // rows referred to by m_trans
+    std::map<int, Model_Checking::Split_Data_Set> m_splits;
+    Model_Checking::Row_View_Set m_trans;
 
     void initViewTransactionsHeader();
     void initFilterSettings();
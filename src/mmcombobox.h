@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include <wx/string.h>
 #include "mmSimpleDialogs.h"
 #include "model/Model_Account.h"
+#include "model/Model_Completion.h"
 #include "model/Model_Payee.h"
 #include <wx/richtooltip.h>
 
@@ -45,7 +46,7 @@ public:
         , m_payee(payee)
     {
         if (m_payee)
-            this->AutoComplete(Model_Payee::instance().all_payee_names());
+            this->AutoComplete(new Model_Completion::PayeeCompleter());
         else
             this->AutoComplete(Model_Account::instance().all_checking_account_names());
 
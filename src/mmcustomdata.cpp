@@ -350,8 +350,7 @@ void mmCustomData::OnMultiChoice(wxCommandEvent& event)
 
 size_t mmCustomData::GetActiveCustomFieldsCount() const
 {
-    const auto& data_set = Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(m_ref_id));
-    return data_set.size();
+    return Model_CustomFieldData::instance().NrData(m_ref_type, m_ref_id);
 }
 
 std::map<wxString, wxString> mmCustomData::GetActiveCustomFields() const
@@ -641,6 +640,9 @@ void mmCustomData::SetWidgetChanged(wxWindowID id, const wxString& data)
 
 bool mmCustomData::IsDataFound(const Model_Checking::Full_Data &tran)
 {
+    if (!Model_CustomFieldData::instance().NrData(m_ref_type, tran.TRANSID))
+        return false;
+
     const auto& data_set = Model_CustomFieldData::instance().find(Model_CustomFieldData::REFID(tran.TRANSID));
     for (const auto& filter : m_data_changed)
     {
@@ -20,12 +20,14 @@
 #include "constants.h"
 #include "mmframe.h"
 #include "mmSimpleDialogs.h"
+#include "mmstartuptrace.h"
 #include "paths.h"
 #include "platfdep.h"
 #include "util.h"
 
 #include "model/Model_Setting.h"
 #include "model/Model_Usage.h"
+#include "reports/reportserver.h"
 
 #include <wx/cmdline.h>
 #include <wx/fs_arc.h>
@@ -33,14 +35,13 @@
 #include <wx/fs_mem.h>
 #include <wx/mstream.h>
 #include "../resources/money.xpm"
- //----------------------------------------------------------------------------
-wxIMPLEMENT_APP(mmGUIApp);
 //----------------------------------------------------------------------------
 
 static const wxCmdLineEntryDesc g_cmdLineDesc[] =
 {
     { wxCMD_LINE_SWITCH, "h", "help", "", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
     { wxCMD_LINE_SWITCH, "s", "silent", "Do not show warning messages at startup.", wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_SWITCH, "t", "trace", "Write the startup timings to startup_trace.json next to mmexini.db3 (open in chrome://tracing).", wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
     { wxCMD_LINE_OPTION, "i", "mmexini",   "where <str> is a path to mmexini.db3"
         "\n\nTo open a determined database(.mmb) file from a shortcut or command line, set the path to the database file as a parameter."
         "\n\nThe file with the application settings mmexini.db3 can be used separately."
@@ -56,6 +57,7 @@ mmGUIApp::mmGUIApp() : m_frame(nullptr)
 , m_optParam1(wxEmptyString)
 , m_optParam2(wxEmptyString)
 , m_optParamSilent(false)
+, m_optParamTrace(false)
 , m_lang(wxLANGUAGE_UNKNOWN)
 , m_locale(wxLANGUAGE_DEFAULT)
 {
@@ -161,6 +163,10 @@ bool mmGUIApp::OnCmdLineParsed(wxCmdLineParser& parser)
         m_optParamSilent = true;
     }
 
+    if (parser.FoundSwitch("t")) {
+        m_optParamTrace = true;
+    }
+
     return true;
 }
 
@@ -233,6 +239,7 @@ void mmGUIApp::OnFatalException()
 
 bool OnInitImpl(mmGUIApp* app)
 {
+    mmStartupTrace::Scope trace_init("Initialize application");
     app->SetAppName(mmex::GetAppName());
 
     app->SetSettingDB(new wxSQLite3Database());
@@ -243,14 +250,24 @@ bool OnInitImpl(mmGUIApp* app)
             file_path = app->GetIniParam();
         }
     }
-    app->GetSettingDB()->Open(file_path);
-    Model_Setting::instance(app->GetSettingDB());
+    if (app->GetTraceParam())
+    {
+        wxFileName trace_file(file_path);
+        trace_file.SetFullName("startup_trace.json");
+        mmStartupTrace::instance().setOutput(trace_file.GetFullPath());
+    }
+
+    {
+        mmStartupTrace::Scope trace("Load settings");
+        app->GetSettingDB()->Open(file_path);
+        Model_Setting::instance(app->GetSettingDB());
 
-    Model_Setting::instance().ShrinkUsageTable();
-    Model_Usage::instance(app->GetSettingDB());
+        Model_Setting::instance().ShrinkUsageTable();
+        Model_Usage::instance(app->GetSettingDB());
 
-    /* Load general MMEX Custom Settings */
-    Option::instance().LoadOptions(false);
+        /* Load general MMEX Custom Settings */
+        Option::instance().LoadOptions(false);
+    }
 
     /* initialize GUI with best language */
     wxTranslations *trans = new wxTranslations;
@@ -349,8 +366,12 @@ bool OnInitImpl(mmGUIApp* app)
     if (valx >= sys_screen_x) valx = sys_screen_x - valw;
     if (valy >= sys_screen_y) valy = sys_screen_y - valh;
 
-    app->m_frame = new mmGUIFrame(app, mmex::getProgramName(), wxPoint(valx, valy), wxSize(valw, valh));
+    {
+        mmStartupTrace::Scope trace("Create main frame");
+        app->m_frame = new mmGUIFrame(app, mmex::getProgramName(), wxPoint(valx, valy), wxSize(valw, valh));
+    }
 
+    mmStartupTrace::Scope trace_show("Show main frame");
     bool ok = app->m_frame->Show();
 
     /* Was App Maximized? */
@@ -410,6 +431,8 @@ int mmGUIApp::OnExit()
         delete m_setting_db;
     }
 
+    mmReportServer::instance().stop();
+
     /* CURL Cleanup */
     curl_global_cleanup();
 
@@ -44,6 +44,7 @@ public:
     const wxString GetOptParam() const;
     const wxString GetIniParam() const;
     bool GetSilentParam() const;
+    bool GetTraceParam() const;
     wxSQLite3Database* GetSettingDB() const;
     void SetSettingDB(wxSQLite3Database* db);
 
@@ -51,6 +52,7 @@ private:
     wxString m_optParam1;
     wxString m_optParam2;
     bool m_optParamSilent;
+    bool m_optParamTrace;
     wxSQLite3Database* m_setting_db;
     void ReportFatalException(wxDebugReport::Context);
     bool OnInit();
@@ -66,6 +68,7 @@ inline wxSQLite3Database* mmGUIApp::GetSettingDB() const { return m_setting_db;
 inline const wxString mmGUIApp::GetOptParam() const { return m_optParam1; }
 inline const wxString mmGUIApp::GetIniParam() const { return m_optParam2; }
 inline bool mmGUIApp::GetSilentParam() const { return m_optParamSilent; }
+inline bool mmGUIApp::GetTraceParam() const { return m_optParamTrace; }
 inline void mmGUIApp::SetSettingDB(wxSQLite3Database* db) { m_setting_db = db; }
 
 //----------------------------------------------------------------------------
@@ -47,6 +47,7 @@
 #include "mmhomepagepanel.h"
 #include "mmreportspanel.h"
 #include "mmSimpleDialogs.h"
+#include "mmstartuptrace.h"
 #include "mmHook.h"
 #include "optiondialog.h"
 #include "payeedialog.h"
@@ -73,6 +74,8 @@
 
 #include <wx/fs_mem.h>
 #include <wx/busyinfo.h>
+#include <wx/file.h>
+#include <memory>
 #include <stack>
 
  //----------------------------------------------------------------------------
@@ -169,6 +172,7 @@ EVT_MENU_RANGE(MENU_LANG + 1, MENU_LANG_MAX, mmGUIFrame::OnChangeGUILanguage)
 
 /*Automatic processing of repeat transactions*/
 EVT_TIMER(AUTO_REPEAT_TRANSACTIONS_TIMER_ID, mmGUIFrame::OnAutoRepeatTransactionsTimer)
+wx__DECLARE_EVT0(mmEVT_WEBAPP_SYNC, wxThreadEventHandler(mmGUIFrame::OnWebAppSync))
 
 /* Recent Files */
 EVT_MENU_RANGE(wxID_FILE1, wxID_FILE9, mmGUIFrame::OnRecentFiles)
@@ -229,9 +233,12 @@ mmGUIFrame::mmGUIFrame(mmGUIApp* app, const wxString& title
     getNewsRSS(websiteNewsArray_);
 
     /* Create the Controls for the frame */
-    createMenu();
-    CreateToolBar();
-    createControls();
+    {
+        mmStartupTrace::Scope trace("Create controls");
+        createMenu();
+        CreateToolBar();
+        createControls();
+    }
 
 #if wxUSE_STATUSBAR
     CreateStatusBar();
@@ -282,9 +289,9 @@ mmGUIFrame::mmGUIFrame(mmGUIApp* app, const wxString& title
         if (openFile(dbpath.GetFullPath(), false))
         {
             updateNavTreeControl();
-            //setHomePageActive(false);
-            createHomePage();
             mmLoadColorsFromDatabase();
+            // render the home page once the frame is on screen
+            CallAfter(&mmGUIFrame::createHomePage);
         }
         else
         {
@@ -302,6 +309,9 @@ mmGUIFrame::mmGUIFrame(mmGUIApp* app, const wxString& title
 
     wxAcceleratorTable tab(sizeof(entries) / sizeof(*entries), entries);
     SetAcceleratorTable(tab);
+
+    // queued after the home page, closes the startup trace
+    CallAfter([]() { mmStartupTrace::instance().finish(); });
 }
 //----------------------------------------------------------------------------
 
@@ -320,12 +330,14 @@ mmGUIFrame::~mmGUIFrame()
         model->show_statistics();
         Model_Usage::instance().AppendToCache(model->GetTableStatsAsJson());
     }
+    Model_Usage::instance().AppendToCache(Model_Balance::instance().GetStatsAsJson());
 }
 //----------------------------------------------------------------------------
 
 void mmGUIFrame::cleanup()
 {
     autoRepeatTransactionsTimer_.Stop();
+    mmWebApp::WebApp_StopSync();
     delete m_recentFiles;
     if (!m_filename.IsEmpty()) // Exiting before file is opened
         saveSettings();
@@ -351,7 +363,11 @@ void mmGUIFrame::ShutdownDatabase()
     {
         if (!Model_Infotable::instance().cache_.empty()) //Cache empty on InfoTable means instance never initialized
             Model_Infotable::instance().Set("ISUSED", false);
+        // leave a single file behind for backups and file sync tools
+        mmDBReaderPool::instance().Close();
+        mmDBWrapper::SetWAL(m_db.get(), false);
         m_db->SetCommitHook(nullptr);
+        m_db->SetRollbackHook(nullptr);
         m_db->Close();
         delete m_commit_callback_hook;
         delete m_update_callback_hook;
@@ -465,77 +481,47 @@ void mmGUIFrame::setAccountNavTreeSection(const wxString& accountName)
 //----------------------------------------------------------------------------
 void mmGUIFrame::OnAutoRepeatTransactionsTimer(wxTimerEvent& /*event*/)
 {
-    //WebApp check
+    //WebApp check, the dialog opens from OnWebAppSync() if there is something to import
     if (mmWebApp::WebApp_CheckEnabled())
-    {
-        mmWebAppDialog dlg(this, true);
-        dlg.ShowModal();
-        if (dlg.getRefreshRequested())
-            refreshPanelData();
-    }
+        mmWebApp::WebApp_StartSync(this);
 
     //Auto recurring transaction
     bool continueExecution = false;
 
-    Model_Billsdeposits::AccountBalance bal;
+    // all due occurrences of the silent schedules at once, then refresh once
     Model_Billsdeposits& bills = Model_Billsdeposits::instance();
+    const Model_Billsdeposits::CatchUp_Stats caught_up = bills.catch_up(wxDate::Today(), [](const Model_Billsdeposits::Data&)
+    {
+        return wxMessageBox(_(
+            "A recurring transaction will exceed your account limit.\n\n"
+            "Do you wish to continue?")
+            , _("MMEX Recurring Transaction Check"), wxYES_NO | wxICON_WARNING) == wxYES;
+    });
+    if (caught_up.schedules > 0)
+    {
+        wxLogDebug("Auto Repeat Transactions\n%s", caught_up.summary());
+        createHomePage();
+    }
+
+    Model_Billsdeposits::AccountBalance bal;
     for (const auto& q1 : bills.all())
     {
         bills.decode_fields(q1);
-        bool allow_transaction = bills.AllowTransaction(q1, bal);
-        const wxDateTime payment_date = bills.TRANSDATE(q1);
-        if (bills.autoExecuteManual() && bills.requireExecution())
-        {
-            if (allow_transaction && bills.allowExecution())
-            {
-                continueExecution = true;
-                mmBDDialog repeatTransactionsDlg(this, q1.BDID, false, true);
-                repeatTransactionsDlg.SetDialogHeader(_("Auto Repeat Transactions"));
-                if (repeatTransactionsDlg.ShowModal() == wxID_OK)
-                {
-                    refreshPanelData();
-                }
-                else // stop repeat executions from occuring
-                    continueExecution = false;
-            }
-        }
+        if (!bills.autoExecuteManual() || !bills.requireExecution())
+            continue;
 
-        if (allow_transaction && bills.autoExecuteSilent() && bills.requireExecution())
+        bool allow_transaction = bills.AllowTransaction(q1, bal);
+        if (allow_transaction && bills.allowExecution())
         {
-            if (bills.allowExecution())
+            continueExecution = true;
+            mmBDDialog repeatTransactionsDlg(this, q1.BDID, false, true);
+            repeatTransactionsDlg.SetDialogHeader(_("Auto Repeat Transactions"));
+            if (repeatTransactionsDlg.ShowModal() == wxID_OK)
             {
-                continueExecution = true;
-                Model_Checking::Data* tran = Model_Checking::instance().create();
-
-                tran->ACCOUNTID = q1.ACCOUNTID;
-                tran->TOACCOUNTID = q1.TOACCOUNTID;
-                tran->PAYEEID = q1.PAYEEID;
-                tran->TRANSCODE = q1.TRANSCODE;
-                tran->TRANSAMOUNT = q1.TRANSAMOUNT;
-                tran->TOTRANSAMOUNT = q1.TOTRANSAMOUNT;
-                tran->STATUS = q1.STATUS;
-                tran->TRANSACTIONNUMBER = q1.TRANSACTIONNUMBER;
-                tran->NOTES = q1.NOTES;
-                tran->CATEGID = q1.CATEGID;
-                tran->SUBCATEGID = q1.SUBCATEGID;
-                tran->TRANSDATE = payment_date.FormatISODate();
-
-                int transID = Model_Checking::instance().save(tran);
-
-                Model_Splittransaction::Cache checking_splits;
-                for (const auto &item : Model_Billsdeposits::splittransaction(q1))
-                {
-                    Model_Splittransaction::Data *split = Model_Splittransaction::instance().create();
-                    split->TRANSID = transID;
-                    split->CATEGID = item.CATEGID;
-                    split->SUBCATEGID = item.SUBCATEGID;
-                    split->SPLITTRANSAMOUNT = item.SPLITTRANSAMOUNT;
-                    checking_splits.push_back(split);
-                }
-                Model_Splittransaction::instance().save(checking_splits);
+                refreshPanelData();
             }
-            Model_Billsdeposits::instance().completeBDInSeries(q1.BDID);
-            createHomePage();
+            else // stop repeat executions from occuring
+                continueExecution = false;
         }
     }
 
@@ -666,6 +652,7 @@ void mmGUIFrame::createControls()
 
 void mmGUIFrame::updateNavTreeControl()
 {
+    mmStartupTrace::Scope trace("Update navigation tree");
     windowsFreezeThaw(m_nav_tree_ctrl);
     m_nav_tree_ctrl->SetEvtHandlerEnabled(false);
     wxTreeItemId root = m_nav_tree_ctrl->GetRootItem();
@@ -1725,28 +1712,10 @@ void mmGUIFrame::CreateToolBar()
 
 void mmGUIFrame::InitializeModelTables()
 {
-    m_all_models.push_back(&Model_Infotable::instance(m_db.get()));
-    m_all_models.push_back(&Model_Asset::instance(m_db.get()));
-    m_all_models.push_back(&Model_Stock::instance(m_db.get()));
-    m_all_models.push_back(&Model_StockHistory::instance(m_db.get()));
-    m_all_models.push_back(&Model_Account::instance(m_db.get()));
-    m_all_models.push_back(&Model_Payee::instance(m_db.get()));
-    m_all_models.push_back(&Model_Checking::instance(m_db.get()));
-    m_all_models.push_back(&Model_Currency::instance(m_db.get()));
-    m_all_models.push_back(&Model_CurrencyHistory::instance(m_db.get()));
-    m_all_models.push_back(&Model_Budgetyear::instance(m_db.get()));
-    m_all_models.push_back(&Model_Subcategory::instance(m_db.get())); // subcategory must be initialized before category
-    m_all_models.push_back(&Model_Category::instance(m_db.get()));
-    m_all_models.push_back(&Model_Billsdeposits::instance(m_db.get()));
-    m_all_models.push_back(&Model_Splittransaction::instance(m_db.get()));
-    m_all_models.push_back(&Model_Budgetsplittransaction::instance(m_db.get()));
-    m_all_models.push_back(&Model_Budget::instance(m_db.get()));
-    m_all_models.push_back(&Model_Report::instance(m_db.get()));
-    m_all_models.push_back(&Model_Attachment::instance(m_db.get()));
-    m_all_models.push_back(&Model_CustomFieldData::instance(m_db.get()));
-    m_all_models.push_back(&Model_CustomField::instance(m_db.get()));
-    m_all_models.push_back(&Model_Translink::instance(m_db.get()));
-    m_all_models.push_back(&Model_Shareinfo::instance(m_db.get()));
+    mmStartupTrace::Scope trace("Initialize model tables");
+    Model_NameTable::instance().reset();
+    m_all_models = mmDBWrapper::InitializeModels(m_db.get());
+    mmHomePageCollector::instance(m_db.get());
 }
 
 bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd, bool openingNew)
@@ -1796,6 +1765,7 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
         m_db->SetCommitHook(m_commit_callback_hook);
         m_update_callback_hook = new UpdateCallbackHook();
         m_db->SetUpdateHook(m_update_callback_hook);
+        m_db->SetRollbackHook(m_update_callback_hook);
 
         //Check if DB upgrade needed
         if (dbUpgrade::isUpgradeDBrequired(m_db.get()))
@@ -1848,6 +1818,7 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
         m_db->SetCommitHook(m_commit_callback_hook);
         m_update_callback_hook = new UpdateCallbackHook();
         m_db->SetUpdateHook(m_update_callback_hook);
+        m_db->SetRollbackHook(m_update_callback_hook);
 
         m_password = password;
         dbUpgrade::InitializeVersion(m_db.get());
@@ -1860,6 +1831,7 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
         if (next) next->SetLabel(_("&Next ->"));
 
         SetDataBaseParameters(fileName);
+        EnableReaders(fileName);
         /* Jump to new account creation screen */
         wxCommandEvent evt;
         OnNewAccount(evt);
@@ -1881,11 +1853,21 @@ bool mmGUIFrame::createDataStore(const wxString& fileName, const wxString& pwd,
     }
 
     SetDataBaseParameters(fileName);
+    EnableReaders(fileName);
 
     return true;
 }
 //----------------------------------------------------------------------------
 
+void mmGUIFrame::EnableReaders(const wxString& fileName)
+{
+    // readers still work without WAL, they wait for the writer instead
+    if (!mmDBWrapper::SetWAL(m_db.get(), true))
+        wxLogDebug("WAL journal not available for %s", fileName);
+    mmDBReaderPool::instance().Open(fileName, m_password);
+}
+//----------------------------------------------------------------------------
+
 void mmGUIFrame::SetDataBaseParameters(const wxString& fileName)
 {
     wxString title = wxString::Format("%s - %s", mmex::getProgramName(), fileName);
@@ -1897,6 +1879,17 @@ void mmGUIFrame::SetDataBaseParameters(const wxString& fileName)
     if (m_db)
     {
         m_filename = fileName;
+        // Ensure that base currency is set for the database.
+        int base_currency_id = Model_Infotable::instance().GetIntInfo("BASECURRENCYID", -1);
+        while (base_currency_id < 1)
+        {
+            if (mmMainCurrencyDialog::Execute(base_currency_id))
+            {
+                Option::instance().BaseCurrency(base_currency_id);
+                Model_CurrencyHistory::ResetCurrencyHistory();
+                Model_Currency::ResetBaseConversionRates();
+            }
+        }
         /* Set InfoTable Options into memory */
         Option::instance().LoadOptions();
     }
@@ -1910,6 +1903,7 @@ void mmGUIFrame::SetDataBaseParameters(const wxString& fileName)
 
 bool mmGUIFrame::openFile(const wxString& fileName, bool openingNew, const wxString &password)
 {
+    mmStartupTrace::Scope trace("Open database");
     menuBar_->FindItem(MENU_CHANGE_ENCRYPT_PASSWORD)->Enable(false);
     if (createDataStore(fileName, password, openingNew))
     {
@@ -1937,6 +1931,7 @@ bool mmGUIFrame::openFile(const wxString& fileName, bool openingNew, const wxStr
         }
 
         Model_Infotable::instance().Set("ISUSED", true);
+
         autoRepeatTransactionsTimer_.Start(REPEAT_TRANS_DELAY_TIME, wxTIMER_ONE_SHOT);
     }
     else return false;
@@ -2077,12 +2072,106 @@ void mmGUIFrame::OnVacuumDB(wxCommandEvent& /*event*/)
 
 void mmGUIFrame::OnDebugDB(wxCommandEvent& /*event*/)
 {
-    wxMessageDialog msgDlg(this
-        , wxString::Format("%s\n\n%s", _("Please use this function only if explicitly requested by MMEX support"), _("Do you want to proceed?"))
-        , _("DB Debug"), wxYES_NO | wxNO_DEFAULT | wxICON_WARNING);
-    if (msgDlg.ShowModal() == wxID_YES)
+    enum { DEBUG_FILE = 0, QUERY_STATS, QUERY_PLANS, QUERY_RESET, INTEGRITY_CHECK, MONTHLY_BALANCE_CHECK };
+    wxArrayString items;
+    items.Add(_("Run a debug file provided by MMEX support"));
+    items.Add(_("Show SQL statement statistics"));
+    items.Add(_("Capture query plans of slow statements"));
+    items.Add(_("Reset SQL statement statistics"));
+    items.Add(_("Check the integrity of the database"));
+    items.Add(_("Check the month-end balances against the transactions"));
+
+    switch (wxGetSingleChoiceIndex(_("Select the debug function"), _("DB Debug"), items, this))
+    {
+    case DEBUG_FILE:
+    {
+        wxMessageDialog msgDlg(this
+            , wxString::Format("%s\n\n%s", _("Please use this function only if explicitly requested by MMEX support"), _("Do you want to proceed?"))
+            , _("DB Debug"), wxYES_NO | wxNO_DEFAULT | wxICON_WARNING);
+        if (msgDlg.ShowModal() == wxID_YES)
+        {
+            dbUpgrade::SqlFileDebug(m_db.get());
+        }
+        break;
+    }
+    case QUERY_STATS:
     {
-        dbUpgrade::SqlFileDebug(m_db.get());
+        const wxString json = DB_Profiler::instance().to_json();
+        wxTextEntryDialog dlg(this, _("SQL statements sorted by total time:\npress OK to save to file or Cancel to exit")
+            , _("DB Debug"), json, wxOK | wxCANCEL | wxCENTRE | wxTE_MULTILINE);
+        if (dlg.ShowModal() != wxID_OK) break;
+
+        wxFileDialog fileDlgSave(this, _("Save statistics"), "", "query_stats.json", "*.json", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+        if (fileDlgSave.ShowModal() == wxID_OK)
+        {
+            wxFile file(fileDlgSave.GetPath(), wxFile::write);
+            if (file.IsOpened())
+            {
+                file.Write(json);
+                file.Close();
+            }
+        }
+        break;
+    }
+    case QUERY_PLANS:
+        DB_Profiler::instance().explain_slow(50);
+        wxMessageBox(_("The query plan of statements slower than 50 ms will be shown in the statistics."), _("DB Debug"));
+        break;
+    case QUERY_RESET:
+        DB_Profiler::instance().reset();
+        break;
+    case INTEGRITY_CHECK:
+    {
+        dbCheck::Results results;
+        {
+            wxBusyCursor wait;
+            results = dbCheck::run(m_db.get());
+        }
+        if (dbCheck::clean(results))
+        {
+            wxMessageBox(dbCheck::report(results), _("DB Debug"));
+            break;
+        }
+
+        wxMessageDialog msgDlg(this
+            , wxString::Format("%s\n%s", dbCheck::report(results), _("Do you want to fix the rows that can be fixed automatically?"))
+            , _("DB Debug"), wxYES_NO | wxNO_DEFAULT | wxICON_WARNING);
+        if (msgDlg.ShowModal() != wxID_YES) break;
+        {
+            wxBusyCursor wait;
+            results = dbCheck::run(m_db.get(), true);
+        }
+        wxMessageBox(dbCheck::report(results), _("DB Debug"));
+        refreshPanelData();
+        break;
+    }
+    case MONTHLY_BALANCE_CHECK:
+    {
+        Model_MonthlyBalance::Check check;
+        {
+            wxBusyCursor wait;
+            check = Model_MonthlyBalance::instance().verify();
+        }
+        if (check.ok())
+        {
+            wxMessageBox(check.summary(), _("DB Debug"));
+            break;
+        }
+
+        wxMessageDialog msgDlg(this
+            , wxString::Format("%s\n%s", check.summary(), _("Do you want to rebuild the month-end balances?"))
+            , _("DB Debug"), wxYES_NO | wxNO_DEFAULT | wxICON_WARNING);
+        if (msgDlg.ShowModal() != wxID_YES) break;
+        {
+            wxBusyCursor wait;
+            Model_MonthlyBalance::instance().rebuild();
+            check = Model_MonthlyBalance::instance().verify();
+        }
+        wxMessageBox(check.summary(), _("DB Debug"));
+        break;
+    }
+    default:
+        break;
     }
 }
 //----------------------------------------------------------------------------
@@ -2251,6 +2340,36 @@ void mmGUIFrame::OnImportXML(wxCommandEvent& /*event*/)
 
 //----------------------------------------------------------------------------
 
+void mmGUIFrame::OnWebAppSync(wxThreadEvent& event)
+{
+    mmWebApp::WebApp_StopSync();
+    const std::shared_ptr<mmWebApp::SyncResult> result = event.GetPayload<std::shared_ptr<mmWebApp::SyncResult> >();
+    if (!result) return;
+
+    if (!result->Error.IsEmpty())
+    {
+        wxMessageBox(result->Error, result->ErrorTitle, wxICON_ERROR);
+        return;
+    }
+    if (!result->DownloadError.IsEmpty())
+    {
+        // not shown at startup, as before the sync ran in the background
+        wxLogDebug("WebApp sync: %s", result->DownloadError);
+        return;
+    }
+
+    wxLogDebug("WebApp sync: %zu transactions, %zu attachments (%zu failed), download %s ms, parse %s ms, attachments %s ms"
+        , result->Transactions.size(), result->Attachments, result->FailedAttachments
+        , result->DownloadMs.ToString(), result->ParseMs.ToString(), result->AttachmentsMs.ToString());
+    if (result->Transactions.empty()) return;
+
+    mmWebAppDialog dlg(this, result->Transactions);
+    dlg.ShowModal();
+    if (dlg.getRefreshRequested())
+        refreshPanelData();
+}
+//----------------------------------------------------------------------------
+
 void mmGUIFrame::OnImportWebApp(wxCommandEvent& /*event*/)
 {
     mmWebAppDialog dlg(this, false);
@@ -2590,6 +2709,7 @@ void mmGUIFrame::OnBillsDeposits(wxCommandEvent& WXUNUSED(event))
 
 void mmGUIFrame::createHomePage()
 {
+    mmStartupTrace::Scope trace("Create home page");
     StringBuffer json_buffer;
     Writer<StringBuffer> json_writer(json_buffer);
 
@@ -2627,6 +2747,10 @@ void mmGUIFrame::createHomePage()
 
     json_writer.Key("seconds");
     json_writer.Double((wxDateTime::UNow() - time).GetMilliseconds().ToDouble() / 1000);
+    // collection steps and widgets, in milliseconds
+    const wxString timings = mmHomePageCollector::instance().GetTimingsAsJson();
+    json_writer.Key("timings");
+    json_writer.RawValue(timings.utf8_str(), timings.utf8_str().length(), kObjectType);
     json_writer.EndObject();
 
     Model_Usage::instance().AppendToUsage(wxString::FromUTF8(json_buffer.GetString()));
@@ -3142,6 +3266,7 @@ wxSizer* mmGUIFrame::cleanupHomePanel(bool new_sizer)
 void mmGUIFrame::SetDatabaseFile(const wxString& dbFileName, bool newDatabase)
 {
     autoRepeatTransactionsTimer_.Stop();
+    mmWebApp::WebApp_StopSync();
 
     if (openFile(dbFileName, newDatabase))
     {
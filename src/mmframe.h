@@ -154,6 +154,7 @@ private:
     void showTreePopupMenu(const wxTreeItemId& id, const wxPoint& pt);
     void showBeginAppDialog(bool fromScratch = false);
     void SetDataBaseParameters(const wxString& fileName);
+    void EnableReaders(const wxString& fileName);
     void OnLaunchAccountWebsite(wxCommandEvent& event);
     void OnAccountAttachments(wxCommandEvent& event);
 private:
@@ -173,6 +174,7 @@ private:
     void OnImportXML(wxCommandEvent& event);
     void OnImportQIF(wxCommandEvent& event);
     void OnImportWebApp(wxCommandEvent& event);
+    void OnWebAppSync(wxThreadEvent& event);
     void OnPrintPage(wxCommandEvent& WXUNUSED(event));
     void OnQuit(wxCommandEvent& event);
     void OnBillsDeposits(wxCommandEvent& event);
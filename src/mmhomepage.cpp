@@ -18,10 +18,13 @@ Copyright (C) 2014 - 2020 Nikolay Akimov
 
 #include "mmhomepage.h"
 #include "html_template.h"
-#include "billsdepositspanel.h"
 #include "constants.h"
+#include "option.h"
+#include "util.h"
 #include <algorithm>
 #include <cmath>
+#include <set>
+#include <wx/stopwatch.h>
 
 #include "model/Model_Stock.h"
 #include "model/Model_StockHistory.h"
@@ -30,7 +33,12 @@ Copyright (C) 2014 - 2020 Nikolay Akimov
 #include "model/Model_CurrencyHistory.h"
 #include "model/Model_Payee.h"
 #include "model/Model_Asset.h"
+#include "model/Model_Balance.h"
+#include "model/Model_Billsdeposits.h"
+#include "model/Model_Checking.h"
 #include "model/Model_Setting.h"
+#include "model/Model_Splittransaction.h"
+#include "model/Model_Translink.h"
 
 static const wxString TOP_CATEGS = R"(
 <table class = 'table'>
@@ -55,236 +63,354 @@ static const wxString TOP_CATEGS = R"(
 )";
 
 
-htmlWidgetStocks::htmlWidgetStocks()
-    : title_(_("Stocks"))
+mmHomePageData::Account::Account()
+    : rate(1)
+    , reconciled(0)
+    , balance(0)
 {
-    grand_gain_lost_ = 0.0;
-    grand_total_ = 0.0;
 }
 
-htmlWidgetStocks::~htmlWidgetStocks()
+mmHomePageData::Bill::Bill()
+    : days(0)
+    , amount(0)
+    , account_id(-1)
 {
 }
 
-const wxString htmlWidgetStocks::getHTMLText()
+mmHomePageData::mmHomePageData()
+    : has_stocks(false)
+    , stocks_total(0)
+    , stocks_gain_lost(0)
+    , assets(0)
+    , income(0)
+    , expenses(0)
+    , follow_ups(0)
+    , transactions(0)
 {
-    wxString output = "";
-    std::map<int, std::pair<double, double> > stockStats;
-    calculate_stats(stockStats);
-    if (!stockStats.empty())
-    {
-        output = "<table class ='sortable table'><col style='width: 50%'><col style='width: 25%'><col style='width: 25%'><thead><tr class='active'><th>\n";
-        output += _("Stocks") + "</th><th class = 'text-right'>" + _("Gain/Loss");
-        output += "</th>\n<th class='text-right'>" + _("Total") + "</th>\n";
-        output += wxString::Format("<th nowrap class='text-right sorttable_nosort'><a id='%s_label' onclick='toggleTable(\"%s\");' href='#%s' oncontextmenu='return false;'>[-]</a></th>\n"
-            , "INVEST", "INVEST", "INVEST");
-        output += "</tr></thead><tbody id='INVEST'>\n";
-        const auto &accounts = Model_Account::instance().all(Model_Account::COL_ACCOUNTNAME);
-        wxString body = "";
-        for (const auto& account : accounts)
-        {
-            if (Model_Account::type(account) != Model_Account::INVESTMENT) continue;
-            if (Model_Account::status(account) != Model_Account::OPEN) continue;
-            body += "<tr>";
-            body += wxString::Format("<td sorttable_customkey='*%s*'><a href='stock:%i' oncontextmenu='return false;'>%s</a>%s</td>\n"
-                , account.ACCOUNTNAME, account.ACCOUNTID, account.ACCOUNTNAME,
-                account.WEBSITE.empty() ? "" : wxString::Format("&nbsp;&nbsp;&nbsp;&nbsp;(<a href='%s' oncontextmenu='return false;' target='_blank'>WWW</a>)", account.WEBSITE));
-            body += wxString::Format("<td class='money' sorttable_customkey='%f'>%s</td>\n"
-                , stockStats[account.ACCOUNTID].first
-                , Model_Account::toCurrency(stockStats[account.ACCOUNTID].first, &account));
-            body += wxString::Format("<td colspan='2' class='money' sorttable_customkey='%f'>%s</td>"
-                , stockStats[account.ACCOUNTID].second
-                , Model_Account::toCurrency(stockStats[account.ACCOUNTID].second, &account));
-            body += "</tr>";
-        }
+}
 
-        output += body;
-        output += "</tbody><tfoot><tr class = 'total'><td>" + _("Total:") + "</td>";
-        output += wxString::Format("<td class='money'>%s</td>"
-            , Model_Currency::toCurrency(grand_gain_lost_));
-        output += wxString::Format("<td colspan='2' class='money'>%s</td></tr></tfoot></table>"
-            , Model_Currency::toCurrency(grand_total_));
-        if (body.empty()) output.clear();
-    }
-    return output;
+////////////////////////////////////////////////////////
+
+mmHomePageCollector::mmHomePageCollector()
+    : m_db(nullptr)
+    , m_generation(0)
+    , m_collected(0)
+    , m_cached(false)
+{
 }
 
-void htmlWidgetStocks::calculate_stats(std::map<int, std::pair<double, double> > &stockStats)
+mmHomePageCollector::~mmHomePageCollector()
 {
-    this->grand_total_ = 0;
-    this->grand_gain_lost_ = 0;
-    const auto &stocks = Model_Stock::instance().all();
+}
+
+mmHomePageCollector& mmHomePageCollector::instance(wxSQLite3Database* db)
+{
+    mmHomePageCollector& ins = Singleton<mmHomePageCollector>::instance();
+    ins.m_db = db;
+    ins.reset();
+
+    return ins;
+}
+
+mmHomePageCollector& mmHomePageCollector::instance()
+{
+    return Singleton<mmHomePageCollector>::instance();
+}
+
+const wxString mmHomePageCollector::key() const
+{
+    return wxString::Format("%s|%d|%d|%s"
+        , wxDate::Today().FormatISODate()
+        , Option::instance().getIgnoreFutureTransactions() ? 1 : 0
+        , Option::instance().getCurrencyHistoryEnabled() ? 1 : 0
+        , Model_Setting::instance().ViewAccounts());
+}
+
+bool mmHomePageCollector::collect()
+{
+    m_collect_ms.clear();
+    m_widget_ms.clear();
+
+    const wxString key = this->key();
+    m_cached = !m_key.empty() && m_key == key && m_collected == m_generation;
+    if (m_cached) return false;
+
+    m_data = mmHomePageData();
+    m_frames.clear();
+    m_data.view_accounts = Model_Setting::instance().ViewAccounts();
     const wxDate today = wxDate::Today();
-    for (const auto& stock : stocks)
-    {
-        double conv_rate = 1;
-        Model_Account::Data *account = Model_Account::instance().get(stock.HELDAT);
-        if (account)
-        {
-            conv_rate = Model_CurrencyHistory::getDayRate(account->CURRENCYID, today);
-        }
-        std::pair<double, double>& values = stockStats[stock.HELDAT];
-        double current_value = Model_Stock::CurrentValue(stock);
-        double gain_lost = (current_value - stock.VALUE - stock.COMMISSION);
-        values.first += gain_lost;
-        values.second += current_value;
-        if (account && account->STATUS == VIEW_ACCOUNTS_OPEN_STR)
-        {
-            grand_total_ += current_value * conv_rate;
-            grand_gain_lost_ += gain_lost * conv_rate;
-        }
-    }
+
+    wxStopWatch sw;
+    collect_accounts(today);
+    m_collect_ms.push_back(std::make_pair("accounts", sw.Time()));
+    sw.Start();
+    collect_transactions();
+    m_collect_ms.push_back(std::make_pair("transactions", sw.Time()));
+    sw.Start();
+    collect_statistics(today);
+    m_collect_ms.push_back(std::make_pair("statistics", sw.Time()));
+    sw.Start();
+    collect_bills(today);
+    m_collect_ms.push_back(std::make_pair("bills", sw.Time()));
+
+    m_key = key;
+    m_collected = m_generation;
+    return true;
 }
 
-double htmlWidgetStocks::get_total()
+const mmHomePageData& mmHomePageCollector::data() const
 {
-    return grand_total_;
+    return m_data;
 }
 
-double htmlWidgetStocks::get_total_gein_lost()
+std::map<wxString, wxString>& mmHomePageCollector::frames()
 {
-    return grand_gain_lost_;
+    return m_frames;
 }
 
-////////////////////////////////////////////////////////
+void mmHomePageCollector::touch(const wxString& table)
+{
+    // tables the home page does not read
+    static const std::set<wxString> unread = {
+        "ATTACHMENT_V1", "BUDGETSPLITTRANSACTIONS_V1", "BUDGETTABLE_V1", "BUDGETYEAR_V1"
+        , "CUSTOMFIELD_V1", "CUSTOMFIELDDATA_V1", "MONTHLYBALANCE_V1", "REPORT_V1", "STOCKHISTORY_V1" };
+    if (unread.find(table) != unread.end()) return;
 
+    ++m_generation;
+}
 
-htmlWidgetTop7Categories::htmlWidgetTop7Categories()
+void mmHomePageCollector::reset()
 {
-    date_range_ = new mmLast30Days();
-    title_ = wxString::Format(_("Top Withdrawals: %s"), date_range_->local_title());
+    m_key.clear();
+    m_data = mmHomePageData();
+    m_frames.clear();
 }
 
-htmlWidgetTop7Categories::~htmlWidgetTop7Categories()
+void mmHomePageCollector::add_timing(const wxString& widget, long ms)
 {
-    if (date_range_) delete date_range_;
+    m_widget_ms.push_back(std::make_pair(widget, ms));
 }
 
-const wxString htmlWidgetTop7Categories::getHTMLText()
+const wxString mmHomePageCollector::GetTimingsAsJson() const
 {
+    StringBuffer json_buffer;
+    Writer<StringBuffer> json_writer(json_buffer);
 
-    std::vector<std::pair<wxString, double> > topCategoryStats;
-    getTopCategoryStats(topCategoryStats, date_range_);
-    wxString output = "", data;
+    json_writer.StartObject();
+    json_writer.Key("cached");
+    json_writer.Bool(m_cached);
+    json_writer.Key("collect");
+    json_writer.StartObject();
+    for (const auto& step : m_collect_ms)
+    {
+        json_writer.Key(step.first.utf8_str());
+        json_writer.Int64(step.second);
+    }
+    json_writer.EndObject();
+    json_writer.Key("widgets");
+    json_writer.StartObject();
+    for (const auto& widget : m_widget_ms)
+    {
+        json_writer.Key(widget.first.utf8_str());
+        json_writer.Int64(widget.second);
+    }
+    json_writer.EndObject();
+    json_writer.EndObject();
 
-    if (!topCategoryStats.empty())
+    return wxString::FromUTF8(json_buffer.GetString());
+}
+
+void mmHomePageCollector::collect_accounts(const wxDate& today)
+{
+    // Asset and stock transfers are already left out of the widget sums of the snapshot.
+    const bool ignore_future = Option::instance().getIgnoreFutureTransactions();
+    std::map<int, double> rates;
+    std::map<int, size_t> index;
+    for (const auto& account : Model_Account::instance().all(Model_Account::COL_ACCOUNTNAME))
     {
-        for (const auto& i : topCategoryStats)
+        mmHomePageData::Account a;
+        a.data = account;
+        const auto it = rates.find(account.CURRENCYID);
+        if (it == rates.end())
+            a.rate = rates[account.CURRENCYID] = Model_CurrencyHistory::getDayRate(account.CURRENCYID, today);
+        else
+            a.rate = it->second;
+
+        const Model_Balance::Balance& b = Model_Balance::instance().get(account.ACCOUNTID);
+        a.reconciled = account.INITIALBAL + (ignore_future ? b.widget_reconciled_today : b.widget_reconciled);
+        a.balance = account.INITIALBAL + (ignore_future ? b.widget_balance_today : b.widget_balance);
+
+        index[account.ACCOUNTID] = m_data.accounts.size();
+        m_data.accounts.push_back(a);
+    }
+
+    const auto &stocks = Model_Stock::instance().all();
+    m_data.has_stocks = !stocks.empty();
+    for (const auto& stock : stocks)
+    {
+        std::pair<double, double>& values = m_data.stock_stats[stock.HELDAT];
+        double current_value = Model_Stock::CurrentValue(stock);
+        double gain_lost = (current_value - stock.VALUE - stock.COMMISSION);
+        values.first += gain_lost;
+        values.second += current_value;
+
+        const auto it = index.find(stock.HELDAT);
+        if (it == index.end()) continue;
+        const mmHomePageData::Account& a = m_data.accounts[it->second];
+        if (a.data.STATUS == VIEW_ACCOUNTS_OPEN_STR)
         {
-            data += "<tr>";
-            data += wxString::Format("<td>%s</td>", (i.first.IsEmpty() ? "..." : i.first));
-            data += wxString::Format("<td class='money' sorttable_customkey='%f'>%s</td>\n"
-                , i.second
-                , Model_Currency::toCurrency(i.second));
-            data += "</tr>\n";
+            m_data.stocks_total += current_value * a.rate;
+            m_data.stocks_gain_lost += gain_lost * a.rate;
         }
-        const wxString idStr = "TOP_CATEGORIES";
-        output += wxString::Format(TOP_CATEGS, title_, idStr, idStr, idStr, idStr, _("Category"), _("Summary"), data);
     }
 
-    return output;
+    m_data.assets = Model_Asset::instance().balance();
+
+    int limit = 10;
+    for (const auto& currency : Model_Currency::instance().all())
+    {
+        if (rates.find(currency.CURRENCYID) == rates.end()) continue;
+
+        m_data.currency_rates[currency.CURRENCY_SYMBOL] = rates[currency.CURRENCYID];
+        if (--limit <= 0) break;
+    }
 }
 
-void htmlWidgetTop7Categories::getTopCategoryStats(
-    std::vector<std::pair<wxString, double> > &categoryStats
-    , const mmDateRange* date_range) const
+void mmHomePageCollector::collect_transactions()
 {
+    const mmLast30Days top_range;
+    wxSharedPtr<mmDateRange> month_range;
+    if (Option::instance().getIgnoreFutureTransactions())
+        month_range = new mmCurrentMonthToDate;
+    else
+        month_range = new mmCurrentMonth;
+
+    m_data.top_title = wxString::Format(_("Top Withdrawals: %s"), top_range.local_title());
+    m_data.income_title = wxString::Format(_("Income vs Expenses: %s"), month_range->local_title());
+
+    const wxString top_start = top_range.start_date().FormatISODate();
+    const wxString top_end = top_range.end_date().FormatISODate();
+    const wxString month_start = month_range->start_date().FormatISODate();
+    const wxString month_end = month_range->end_date().FormatISODate();
+    const wxString start = std::min(top_start, month_start);
+    const wxString end = std::max(top_end, month_end);
+
     //Get base currency rates for all accounts
-    std::map<int, double> acc_conv_rates;
-    const wxDate today = wxDate::Today();
-    for (const auto& account : Model_Account::instance().all())
-    {
-        acc_conv_rates[account.ACCOUNTID] = Model_CurrencyHistory::getDayRate(account.CURRENCYID, today);
-    }
-    //Temporary map
-    std::map<std::pair<int /*category*/, int /*sub category*/>, double> stat;
+    std::map<int, const mmHomePageData::Account*> accounts;
+    for (const auto& a : m_data.accounts)
+        accounts[a.data.ACCOUNTID] = &a;
+
+    const std::vector<wxVariant> params = { wxVariant(start), wxVariant(end) };
+    const auto split = Model_Splittransaction::instance().get_all("TRANSDATE >= ? AND TRANSDATE <= ?", params);
 
-    const auto split = Model_Splittransaction::instance().get_all();
-    const auto &transactions = Model_Checking::instance().find(
-        Model_Checking::TRANSDATE(date_range->start_date(), GREATER_OR_EQUAL)
-        , Model_Checking::TRANSDATE(date_range->end_date(), LESS_OR_EQUAL)
+    const auto &transactions = Model_Checking::instance().find_arena(
+        DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(start, GREATER_OR_EQUAL)
+        , DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(end, LESS_OR_EQUAL)
         , Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL)
         , Model_Checking::TRANSCODE(Model_Checking::TRANSFER, NOT_EQUAL));
 
+    //Temporary map
+    std::map<std::pair<int /*category*/, int /*sub category*/>, double> stat;
+    std::map<std::pair<int, wxString>, double> day_rates;
+
     for (const auto &trx : transactions)
     {
         // Do not include asset or stock transfers in income expense calculations.
         if (Model_Checking::foreignTransactionAsTransfer(trx))
             continue;
 
+        const auto account = accounts.find(trx.ACCOUNTID);
         bool withdrawal = Model_Checking::type(trx) == Model_Checking::WITHDRAWAL;
-        const auto it = split.find(trx.TRANSID);
 
+        if (trx.TRANSDATE >= month_start && trx.TRANSDATE <= month_end && account != accounts.end())
+        {
+            const auto key = std::make_pair(account->second->data.CURRENCYID, trx.TRANSDATE);
+            auto it = day_rates.find(key);
+            if (it == day_rates.end())
+                it = day_rates.insert(std::make_pair(key, Model_CurrencyHistory::getDayRate(key.first, key.second))).first;
+
+            if (Model_Checking::type(trx) == Model_Checking::DEPOSIT)
+                m_data.income += trx.TRANSAMOUNT * it->second;
+            else
+                m_data.expenses += trx.TRANSAMOUNT * it->second;
+        }
+
+        if (trx.TRANSDATE < top_start || trx.TRANSDATE > top_end)
+            continue;
+
+        const double rate = account != accounts.end() ? account->second->rate : 0;
+        const auto it = split.find(trx.TRANSID);
         if (it == split.end())
         {
             std::pair<int, int> category = std::make_pair(trx.CATEGID, trx.SUBCATEGID);
             if (withdrawal)
-                stat[category] -= trx.TRANSAMOUNT * (acc_conv_rates[trx.ACCOUNTID]);
+                stat[category] -= trx.TRANSAMOUNT * rate;
             else
-                stat[category] += trx.TRANSAMOUNT * (acc_conv_rates[trx.ACCOUNTID]);
+                stat[category] += trx.TRANSAMOUNT * rate;
         }
         else
         {
             for (const auto& entry : it->second)
             {
                 std::pair<int, int> category = std::make_pair(entry.CATEGID, entry.SUBCATEGID);
-                double val = entry.SPLITTRANSAMOUNT
-                    * (acc_conv_rates[trx.ACCOUNTID])
-                    * (withdrawal ? -1 : 1);
-                stat[category] += val;
+                stat[category] += entry.SPLITTRANSAMOUNT * rate * (withdrawal ? -1 : 1);
             }
         }
     }
 
-    categoryStats.clear();
+    std::vector<std::pair<wxString, double> >& categoryStats = m_data.top_categories;
     for (const auto& i : stat)
     {
         if (i.second < 0)
-        {
-            std::pair <wxString, double> stat_pair;
-            stat_pair.first = Model_Category::full_name(i.first.first, i.first.second);
-            stat_pair.second = i.second;
-            categoryStats.push_back(stat_pair);
-        }
+            categoryStats.push_back(std::make_pair(Model_Category::full_name(i.first.first, i.first.second), i.second));
     }
 
     std::stable_sort(categoryStats.begin(), categoryStats.end()
-        , [](const std::pair<wxString, double> x, const std::pair<wxString, double> y)
+        , [](const std::pair<wxString, double>& x, const std::pair<wxString, double>& y)
     { return x.second < y.second; }
     );
-
-    int counter = 0;
-    std::vector<std::pair<wxString, double> >::iterator iter;
-    for (iter = categoryStats.begin(); iter != categoryStats.end(); )
-    {
-        counter++;
-        if (counter > 7)
-            iter = categoryStats.erase(iter);
-        else
-            ++iter;
-    }
+    if (categoryStats.size() > 7)
+        categoryStats.resize(7);
 }
 
-////////////////////////////////////////////////////////
-
+void mmHomePageCollector::collect_statistics(const wxDate& today)
+{
+    if (!m_db) return;
 
-htmlWidgetBillsAndDeposits::htmlWidgetBillsAndDeposits(const wxString& title, mmDateRange* date_range)
-    : title_(title)
-    , date_range_(date_range)
-{}
+    // Follow ups do not count asset or stock transfers, the total counts every transaction.
+    wxString sql = "SELECT COUNT(*), SUM(CASE WHEN UPPER(STATUS) IN ('F', ?)"
+        " AND NOT (IFNULL(TOACCOUNTID, -1) = ? AND TRANSCODE IN (?, ?)) THEN 1 ELSE 0 END)"
+        " FROM CHECKINGACCOUNT_V1";
+    const bool ignore_future = Option::instance().getIgnoreFutureTransactions();
+    if (ignore_future)
+        sql += " WHERE TRANSDATE <= ?";
 
-htmlWidgetBillsAndDeposits::~htmlWidgetBillsAndDeposits()
-{
-    if (date_range_) delete date_range_;
+    try
+    {
+        wxSQLite3Statement stmt = m_db->PrepareStatement(sql);
+        stmt.Bind(1, Model_Checking::all_status()[Model_Checking::FOLLOWUP].Upper());
+        stmt.Bind(2, static_cast<int>(Model_Translink::AS_TRANSFER));
+        stmt.Bind(3, Model_Checking::all_type()[Model_Checking::DEPOSIT]);
+        stmt.Bind(4, Model_Checking::all_type()[Model_Checking::WITHDRAWAL]);
+        if (ignore_future)
+            stmt.Bind(5, today.FormatISODate());
+
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        if (q.NextRow())
+        {
+            m_data.transactions = q.GetInt(0);
+            m_data.follow_ups = q.GetInt(1, 0);
+        }
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Home page statistics: Exception %s", e.GetMessage().utf8_str());
+    }
 }
 
-const wxString htmlWidgetBillsAndDeposits::getHTMLText()
+void mmHomePageCollector::collect_bills(const wxDate& today)
 {
-    wxString output = "";
-    wxDate today = wxDate::Today();
-
-    //                    days, payee, description, amount, account
-    std::vector< std::tuple<int, wxString, wxString, double, const Model_Account::Data*> > bd_days;
     for (const auto& entry : Model_Billsdeposits::instance().all(Model_Billsdeposits::COL_NEXTOCCURRENCEDATE))
     {
         int daysPayment = Model_Billsdeposits::NEXTOCCURRENCEDATE(&entry)
@@ -322,14 +448,133 @@ const wxString htmlWidgetBillsAndDeposits::getHTMLText()
             const Model_Payee::Data* payee = Model_Payee::instance().get(entry.PAYEEID);
             if (payee) payeeStr = payee->PAYEENAME;
         }
-        const auto *account = Model_Account::instance().get(entry.ACCOUNTID);
-        double amount = (Model_Billsdeposits::type(entry) == Model_Billsdeposits::DEPOSIT ? entry.TRANSAMOUNT : -entry.TRANSAMOUNT);
-        bd_days.push_back(std::make_tuple(daysPayment, payeeStr, daysRemainingStr, amount, account));
+
+        mmHomePageData::Bill bill;
+        bill.days = daysPayment;
+        bill.payee = payeeStr;
+        bill.remaining = daysRemainingStr;
+        bill.amount = (Model_Billsdeposits::type(entry) == Model_Billsdeposits::DEPOSIT ? entry.TRANSAMOUNT : -entry.TRANSAMOUNT);
+        bill.account_id = entry.ACCOUNTID;
+        m_data.bills.push_back(bill);
+    }
+}
+
+////////////////////////////////////////////////////////
+
+htmlWidgetStocks::htmlWidgetStocks(const mmHomePageData& data)
+    : data_(data)
+    , title_(_("Stocks"))
+{
+}
+
+htmlWidgetStocks::~htmlWidgetStocks()
+{
+}
+
+const wxString htmlWidgetStocks::getHTMLText()
+{
+    wxString output = "";
+    if (data_.has_stocks)
+    {
+        output = "<table class ='sortable table'><col style='width: 50%'><col style='width: 25%'><col style='width: 25%'><thead><tr class='active'><th>\n";
+        output += _("Stocks") + "</th><th class = 'text-right'>" + _("Gain/Loss");
+        output += "</th>\n<th class='text-right'>" + _("Total") + "</th>\n";
+        output += wxString::Format("<th nowrap class='text-right sorttable_nosort'><a id='%s_label' onclick='toggleTable(\"%s\");' href='#%s' oncontextmenu='return false;'>[-]</a></th>\n"
+            , "INVEST", "INVEST", "INVEST");
+        output += "</tr></thead><tbody id='INVEST'>\n";
+        wxString body = "";
+        for (const auto& a : data_.accounts)
+        {
+            const Model_Account::Data& account = a.data;
+            if (Model_Account::type(account) != Model_Account::INVESTMENT) continue;
+            if (Model_Account::status(account) != Model_Account::OPEN) continue;
+            body += "<tr>";
+            body += wxString::Format("<td sorttable_customkey='*%s*'><a href='stock:%i' oncontextmenu='return false;'>%s</a>%s</td>\n"
+                , account.ACCOUNTNAME, account.ACCOUNTID, account.ACCOUNTNAME,
+                account.WEBSITE.empty() ? "" : wxString::Format("&nbsp;&nbsp;&nbsp;&nbsp;(<a href='%s' oncontextmenu='return false;' target='_blank'>WWW</a>)", account.WEBSITE));
+            const auto it = data_.stock_stats.find(account.ACCOUNTID);
+            const std::pair<double, double> values = it != data_.stock_stats.end() ? it->second : std::make_pair(0.0, 0.0);
+            body += wxString::Format("<td class='money' sorttable_customkey='%f'>%s</td>\n"
+                , values.first
+                , Model_Account::toCurrency(values.first, &account));
+            body += wxString::Format("<td colspan='2' class='money' sorttable_customkey='%f'>%s</td>"
+                , values.second
+                , Model_Account::toCurrency(values.second, &account));
+            body += "</tr>";
+        }
+
+        output += body;
+        output += "</tbody><tfoot><tr class = 'total'><td>" + _("Total:") + "</td>";
+        output += wxString::Format("<td class='money'>%s</td>"
+            , Model_Currency::toCurrency(data_.stocks_gain_lost));
+        output += wxString::Format("<td colspan='2' class='money'>%s</td></tr></tfoot></table>"
+            , Model_Currency::toCurrency(data_.stocks_total));
+        if (body.empty()) output.clear();
     }
+    return output;
+}
 
-    //std::sort(bd_days.begin(), bd_days.end());
-    //std::reverse(bd_days.begin(), bd_days.end());
-    ////////////////////////////////////
+double htmlWidgetStocks::get_total()
+{
+    return data_.stocks_total;
+}
+
+double htmlWidgetStocks::get_total_gein_lost()
+{
+    return data_.stocks_gain_lost;
+}
+
+////////////////////////////////////////////////////////
+
+
+htmlWidgetTop7Categories::htmlWidgetTop7Categories(const mmHomePageData& data)
+    : data_(data)
+{
+}
+
+htmlWidgetTop7Categories::~htmlWidgetTop7Categories()
+{
+}
+
+const wxString htmlWidgetTop7Categories::getHTMLText()
+{
+    const std::vector<std::pair<wxString, double> >& topCategoryStats = data_.top_categories;
+    wxString output = "", data;
+
+    if (!topCategoryStats.empty())
+    {
+        for (const auto& i : topCategoryStats)
+        {
+            data += "<tr>";
+            data += wxString::Format("<td>%s</td>", (i.first.IsEmpty() ? "..." : i.first));
+            data += wxString::Format("<td class='money' sorttable_customkey='%f'>%s</td>\n"
+                , i.second
+                , Model_Currency::toCurrency(i.second));
+            data += "</tr>\n";
+        }
+        const wxString idStr = "TOP_CATEGORIES";
+        output += wxString::Format(TOP_CATEGS, data_.top_title, idStr, idStr, idStr, idStr, _("Category"), _("Summary"), data);
+    }
+
+    return output;
+}
+
+////////////////////////////////////////////////////////
+
+
+htmlWidgetBillsAndDeposits::htmlWidgetBillsAndDeposits(const wxString& title, const mmHomePageData& data)
+    : data_(data)
+    , title_(title)
+{}
+
+htmlWidgetBillsAndDeposits::~htmlWidgetBillsAndDeposits()
+{
+}
+
+const wxString htmlWidgetBillsAndDeposits::getHTMLText()
+{
+    wxString output = "";
+    const std::vector<mmHomePageData::Bill>& bd_days = data_.bills;
 
     if (!bd_days.empty())
     {
@@ -347,11 +592,11 @@ const wxString htmlWidgetBillsAndDeposits::getHTMLText()
 
         for (const auto& item : bd_days)
         {
-            output += wxString::Format("<tr %s>\n", std::get<0>(item) < 0 ? "class='danger'" : "");
-            output += "<td>" + std::get<1>(item) + "</td>"; //payee
+            output += wxString::Format("<tr %s>\n", item.days < 0 ? "class='danger'" : "");
+            output += "<td>" + item.payee + "</td>";
             output += wxString::Format("<td class='money'>%s</td>\n"
-                , Model_Account::toCurrency(std::get<3>(item), std::get<4>(item)));
-            output += "<td  class='money'>" + std::get<2>(item) + "</td></tr>\n";
+                , Model_Account::toCurrency(item.amount, Model_Account::instance().get(item.account_id)));
+            output += "<td  class='money'>" + item.remaining + "</td></tr>\n";
         }
         output += "</tbody></table>\n";
     }
@@ -361,51 +606,14 @@ const wxString htmlWidgetBillsAndDeposits::getHTMLText()
 ////////////////////////////////////////////////////////
 
 //* Income vs Expenses *//
-const wxString htmlWidgetIncomeVsExpenses::getHTMLText()
+htmlWidgetIncomeVsExpenses::htmlWidgetIncomeVsExpenses(const mmHomePageData& data)
+    : data_(data)
 {
-    bool ignoreFuture = Option::instance().getIgnoreFutureTransactions();
-    wxSharedPtr<mmDateRange> date_range;
-    if (ignoreFuture)
-        date_range = new mmCurrentMonthToDate;
-    else
-        date_range = new mmCurrentMonth;
-
-    wxLogDebug("%s - %s", date_range->start_date().FormatISODate(), date_range->end_date().FormatISODate());
-
-    double tIncome = 0.0, tExpenses = 0.0;
-    std::map<int, std::pair<double, double> > incomeExpensesStats;
-
-
-    //Calculations
-    const auto &transactions = Model_Checking::instance().find(
-        Model_Checking::TRANSDATE(date_range->start_date(), GREATER_OR_EQUAL)
-        , Model_Checking::TRANSDATE(date_range->end_date(), LESS_OR_EQUAL)
-        , Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL)
-        , Model_Checking::TRANSCODE(Model_Checking::TRANSFER, NOT_EQUAL)
-    );
-
-    for (const auto& pBankTransaction : transactions)
-    {
-
-        // Do not include asset or stock transfers in income expense calculations.
-        if (Model_Checking::foreignTransactionAsTransfer(pBankTransaction))
-            continue;
-
-        double convRate = Model_CurrencyHistory::getDayRate(Model_Account::instance().get(pBankTransaction.ACCOUNTID)->CURRENCYID, pBankTransaction.TRANSDATE);
-
-        int idx = pBankTransaction.ACCOUNTID;
-        if (Model_Checking::type(pBankTransaction) == Model_Checking::DEPOSIT)
-            incomeExpensesStats[idx].first += pBankTransaction.TRANSAMOUNT * convRate;
-        else
-            incomeExpensesStats[idx].second += pBankTransaction.TRANSAMOUNT * convRate;
-    }
+}
 
-    for (const auto& account : Model_Account::instance().all())
-    {
-        int idx = account.ACCOUNTID;
-        tIncome += incomeExpensesStats[idx].first;
-        tExpenses += incomeExpensesStats[idx].second;
-    }
+const wxString htmlWidgetIncomeVsExpenses::getHTMLText()
+{
+    double tIncome = data_.income, tExpenses = data_.expenses;
     // Compute chart spacing and interval (chart forced to start at zero)
     double steps = 10.0;
     double scaleStepWidth = ceil(std::max(tIncome, tExpenses) / steps);
@@ -420,7 +628,7 @@ const wxString htmlWidgetIncomeVsExpenses::getHTMLText()
     PrettyWriter<StringBuffer> json_writer(json_buffer);
     json_writer.StartObject();
     json_writer.Key("0");
-    json_writer.String(wxString::Format(_("Income vs Expenses: %s"), date_range.get()->local_title()).utf8_str());
+    json_writer.String(data_.income_title.utf8_str());
     json_writer.Key("1");
     json_writer.String(_("Type").utf8_str());
     json_writer.Key("2");
@@ -459,6 +667,11 @@ htmlWidgetIncomeVsExpenses::~htmlWidgetIncomeVsExpenses()
 {
 }
 
+htmlWidgetStatistics::htmlWidgetStatistics(const mmHomePageData& data)
+    : data_(data)
+{
+}
+
 const wxString htmlWidgetStatistics::getHTMLText()
 {
     StringBuffer json_buffer;
@@ -468,53 +681,14 @@ const wxString htmlWidgetStatistics::getHTMLText()
     json_writer.Key("NAME");
     json_writer.String(_("Transaction Statistics").utf8_str());
 
-    wxSharedPtr<mmDateRange> date_range;
-    if (Option::instance().getIgnoreFutureTransactions())
-        date_range = new mmCurrentMonthToDate;
-    else
-        date_range = new mmCurrentMonth;
-
-    Model_Checking::Data_Set all_trans;
-    if (Option::instance().getIgnoreFutureTransactions())
-    {
-        all_trans = Model_Checking::instance().find(
-            DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(date_range->today().FormatISODate(), LESS_OR_EQUAL));
-    }
-    else
-    {
-        all_trans = Model_Checking::instance().all();
-    }
-    int countFollowUp = 0;
-    int total_transactions = all_trans.size();
-
-    std::map<int, std::pair<double, double> > accountStats;
-    for (const auto& trx : all_trans)
-    {
-        // Do not include asset or stock transfers in income expense calculations.
-        if (Model_Checking::foreignTransactionAsTransfer(trx))
-            continue;
-
-        if (Model_Checking::status(trx) == Model_Checking::FOLLOWUP) countFollowUp++;
-
-        accountStats[trx.ACCOUNTID].first += Model_Checking::reconciled(trx, trx.ACCOUNTID);
-        accountStats[trx.ACCOUNTID].second += Model_Checking::balance(trx, trx.ACCOUNTID);
-
-        if (Model_Checking::type(trx) == Model_Checking::TRANSFER)
-        {
-            accountStats[trx.TOACCOUNTID].first += Model_Checking::reconciled(trx, trx.TOACCOUNTID);
-            accountStats[trx.TOACCOUNTID].second += Model_Checking::balance(trx, trx.TOACCOUNTID);
-        }
-    }
-
-
-    if (countFollowUp > 0)
+    if (data_.follow_ups > 0)
     {
         json_writer.Key(_("Follow Up On Transactions: ").utf8_str());
-        json_writer.Double(countFollowUp);
+        json_writer.Double(data_.follow_ups);
     }
 
     json_writer.Key(_("Total Transactions: ").utf8_str());
-    json_writer.Int(total_transactions);
+    json_writer.Int(data_.transactions);
     json_writer.EndObject();
 
     wxLogDebug("======= mmHomePagePanel::getStatWidget =======");
@@ -550,9 +724,14 @@ htmlWidgetGrandTotals::~htmlWidgetGrandTotals()
 {
 }
 
+htmlWidgetAssets::htmlWidgetAssets(const mmHomePageData& data)
+    : data_(data)
+{
+}
+
 const wxString htmlWidgetAssets::getHTMLText(double& tBalance)
 {
-    double asset_balance = Model_Asset::instance().balance();
+    double asset_balance = data_.assets;
     tBalance += asset_balance;
 
     StringBuffer json_buffer;
@@ -576,47 +755,9 @@ htmlWidgetAssets::~htmlWidgetAssets()
 
 //
 
-htmlWidgetAccounts::htmlWidgetAccounts()
+htmlWidgetAccounts::htmlWidgetAccounts(const mmHomePageData& data)
+    : data_(data)
 {
-    get_account_stats();
-}
-
-void htmlWidgetAccounts::get_account_stats()
-{
-
-    wxSharedPtr<mmDateRange> date_range;
-    if (Option::instance().getIgnoreFutureTransactions())
-        date_range = new mmCurrentMonthToDate;
-    else
-        date_range = new mmCurrentMonth;
-
-    Model_Checking::Data_Set all_trans;
-    if (Option::instance().getIgnoreFutureTransactions())
-    {
-        all_trans = Model_Checking::instance().find(
-            DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(date_range->today().FormatISODate(), LESS_OR_EQUAL));
-    }
-    else
-    {
-        all_trans = Model_Checking::instance().all();
-    }
-
-    for (const auto& trx : all_trans)
-    {
-        // Do not include asset or stock transfers in income expense calculations.
-        if (Model_Checking::foreignTransactionAsTransfer(trx))
-            continue;
-
-        accountStats_[trx.ACCOUNTID].first += Model_Checking::reconciled(trx, trx.ACCOUNTID);
-        accountStats_[trx.ACCOUNTID].second += Model_Checking::balance(trx, trx.ACCOUNTID);
-
-        if (Model_Checking::type(trx) == Model_Checking::TRANSFER)
-        {
-            accountStats_[trx.TOACCOUNTID].first += Model_Checking::reconciled(trx, trx.TOACCOUNTID);
-            accountStats_[trx.TOACCOUNTID].second += Model_Checking::balance(trx, trx.TOACCOUNTID);
-        }
-    }
-
 }
 
 const wxString htmlWidgetAccounts::displayAccounts(double& tBalance, int type = Model_Account::CHECKING)
@@ -645,17 +786,17 @@ const wxString htmlWidgetAccounts::displayAccounts(double& tBalance, int type =
 
     double tReconciled = 0;
     wxString body = "";
-    const wxDate today = wxDate::Today();
-    wxString vAccts = Model_Setting::instance().ViewAccounts();
-    for (const auto& account : Model_Account::instance().all(Model_Account::COL_ACCOUNTNAME))
+    const wxString& vAccts = data_.view_accounts;
+    for (const auto& a : data_.accounts)
     {
+        const Model_Account::Data& account = a.data;
         if (Model_Account::type(account) != type || Model_Account::status(account) == Model_Account::CLOSED) continue;
 
         Model_Currency::Data* currency = Model_Account::currency(account);
 
-        double currency_rate = Model_CurrencyHistory::getDayRate(account.CURRENCYID, today);
-        double bal = account.INITIALBAL + accountStats_[account.ACCOUNTID].second; //Model_Account::balance(account);
-        double reconciledBal = account.INITIALBAL + accountStats_[account.ACCOUNTID].first;
+        double currency_rate = a.rate;
+        double bal = a.balance;
+        double reconciledBal = a.reconciled;
         tBalance += bal * currency_rate;
         tReconciled += reconciledBal * currency_rate;
 
@@ -687,6 +828,11 @@ htmlWidgetAccounts::~htmlWidgetAccounts()
 }
 
 // Currency exchange rates
+htmlWidgetCurrency::htmlWidgetCurrency(const mmHomePageData& data)
+    : data_(data)
+{
+}
+
 const wxString htmlWidgetCurrency::getHtmlText()
 {
 
@@ -708,24 +854,7 @@ const wxString htmlWidgetCurrency::getHtmlText()
 )";
 
 
-    const wxString today = wxDate::Today().FormatISODate();
-    const wxString baseCurrencySymbol = Model_Currency::GetBaseCurrency()->CURRENCY_SYMBOL;
-    std::map<wxString, double> usedRates;
-    const auto currencies = Model_Currency::instance().all();
-    int limit = 10;
-    for (const auto currency : currencies)
-    {
-        if (Model_Account::is_used(currency)) {
-
-            double convertionRate = Model_CurrencyHistory::getDayRate(currency.CURRENCYID
-                , today);
-            usedRates[currency.CURRENCY_SYMBOL] = convertionRate;
-
-            if (--limit <= 0) {
-                break;
-            }
-        }
-    }
+    const std::map<wxString, double>& usedRates = data_.currency_rates;
 
     if (usedRates.size() == 1) {
         return "";
@@ -19,40 +19,148 @@ Copyright (C) 2014 - 2020 Nikolay Akimov
 #pragma once
 
 #include "reports/mmDateRange.h"
+#include "model/Model_Account.h"
+#include "singleton.h"
 #include <map>
+#include <utility>
 #include <vector>
 
+class wxSQLite3Database;
+
+/** Everything the home page widgets show */
+class mmHomePageData
+{
+public:
+    struct Account
+    {
+        Account();
+        Model_Account::Data data;
+        double rate;            // to the base currency, today
+        double reconciled;      // initial balance included
+        double balance;
+    };
+
+    struct Bill
+    {
+        Bill();
+        int days;
+        wxString payee;
+        wxString remaining;
+        double amount;
+        int account_id;
+    };
+
+public:
+    mmHomePageData();
+
+    std::vector<Account> accounts;      // by name
+    wxString view_accounts;
+
+    bool has_stocks;
+    std::map<int, std::pair<double, double> > stock_stats;  // per account: gain or loss, value
+    double stocks_total;                // open accounts, in the base currency
+    double stocks_gain_lost;
+
+    double assets;
+
+    wxString income_title;
+    double income;
+    double expenses;
+
+    wxString top_title;
+    std::vector<std::pair<wxString, double> > top_categories;
+
+    int follow_ups;
+    int transactions;
+
+    std::map<wxString, double> currency_rates;
+    std::vector<Bill> bills;
+};
+
+/**
+* Collects the home page data in one pass over the accounts and stocks and
+* one pass over the transactions dated in the last 30 days or the current
+* month. The data and the widgets rendered from it are kept until the SQLite
+* update hook reports a change to a table the home page reads, the day
+* changes or an option they depend on changes, so showing the home page again
+* reads nothing.
+*/
+class mmHomePageCollector
+{
+public:
+    mmHomePageCollector();
+    ~mmHomePageCollector();
+
+    /**
+    Initialize the collector for the database.
+    * Return the static instance address for mmHomePageCollector
+    */
+    static mmHomePageCollector& instance(wxSQLite3Database* db);
+    static mmHomePageCollector& instance();
+
+public:
+    /** Collect the data unless the cached data is current. Return true if it was collected */
+    bool collect();
+    const mmHomePageData& data() const;
+
+    /** Widgets rendered from the current data, cleared when it is collected again */
+    std::map<wxString, wxString>& frames();
+
+    /** Record a change reported by the SQLite update hook. Does not touch the database. */
+    void touch(const wxString& table);
+
+    /** Drop the data, it is collected again on the next call */
+    void reset();
+
+    /** Time spent rendering a widget, for the timings of the last collect() */
+    void add_timing(const wxString& widget, long ms);
+
+    /** {"cached":..., "collect":{step: ms}, "widgets":{widget: ms}} of the last collect() */
+    const wxString GetTimingsAsJson() const;
+
+private:
+    const wxString key() const;
+    void collect_accounts(const wxDate& today);
+    void collect_transactions();
+    void collect_statistics(const wxDate& today);
+    void collect_bills(const wxDate& today);
+
+private:
+    wxSQLite3Database* m_db;
+    size_t m_generation;        // bumped by the update hook
+    size_t m_collected;         // generation of m_data
+    wxString m_key;             // day and options of m_data
+    bool m_cached;
+    mmHomePageData m_data;
+    std::map<wxString, wxString> m_frames;
+    std::vector<std::pair<wxString, long> > m_collect_ms;
+    std::vector<std::pair<wxString, long> > m_widget_ms;
+};
+
 class htmlWidgetStocks
 {
 public:
     ~htmlWidgetStocks();
-    htmlWidgetStocks();
+    explicit htmlWidgetStocks(const mmHomePageData& data);
     double get_total();
     double get_total_gein_lost();
 
     const wxString getHTMLText();
 
 protected:
-
+    const mmHomePageData& data_;
     wxString title_;
-    double grand_total_;
-    double grand_gain_lost_;
-    void calculate_stats(std::map<int, std::pair<double, double> > &stockStats);
 };
 
 class htmlWidgetTop7Categories
 {
 public:
-    explicit htmlWidgetTop7Categories();
+    explicit htmlWidgetTop7Categories(const mmHomePageData& data);
     ~htmlWidgetTop7Categories();
     const wxString getHTMLText();
 
 protected:
-    mmDateRange* date_range_;
-    wxString title_;
-    void getTopCategoryStats(
-        std::vector<std::pair<wxString, double> > &categoryStats
-        , const mmDateRange* date_range) const;
+    const mmHomePageData& data_;
 };
 
 
@@ -60,28 +168,35 @@ class htmlWidgetBillsAndDeposits
 {
 public:
 
-    explicit htmlWidgetBillsAndDeposits(const wxString& title
-        , mmDateRange* date_range = new mmAllTime());
+    htmlWidgetBillsAndDeposits(const wxString& title, const mmHomePageData& data);
     ~htmlWidgetBillsAndDeposits();
     const wxString getHTMLText();
 
 protected:
-    mmDateRange* date_range_;
+    const mmHomePageData& data_;
     wxString title_;
 };
 
 class htmlWidgetIncomeVsExpenses
 {
 public:
+    explicit htmlWidgetIncomeVsExpenses(const mmHomePageData& data);
     ~htmlWidgetIncomeVsExpenses();
     const wxString getHTMLText();
+
+protected:
+    const mmHomePageData& data_;
 };
 
 class htmlWidgetStatistics
 {
 public:
+    explicit htmlWidgetStatistics(const mmHomePageData& data);
     ~htmlWidgetStatistics();
     const wxString getHTMLText();
+
+protected:
+    const mmHomePageData& data_;
 };
 
 class htmlWidgetGrandTotals
@@ -94,25 +209,32 @@ public:
 class htmlWidgetAssets
 {
 public:
+    explicit htmlWidgetAssets(const mmHomePageData& data);
     ~htmlWidgetAssets();
     const wxString getHTMLText(double& tBalance);
+
+protected:
+    const mmHomePageData& data_;
 };
 
 class htmlWidgetAccounts
 {
 public:
-    htmlWidgetAccounts();
+    explicit htmlWidgetAccounts(const mmHomePageData& data);
     const wxString displayAccounts(double& tBalance, int type);
     ~htmlWidgetAccounts();
 private:
-    std::map<int, std::pair<double, double> > accountStats_;
-    void get_account_stats();
+    const mmHomePageData& data_;
 };
 
 
 class htmlWidgetCurrency
 {
 public:
+    explicit htmlWidgetCurrency(const mmHomePageData& data);
     ~htmlWidgetCurrency();
     const wxString getHtmlText();
+
+protected:
+    const mmHomePageData& data_;
 };
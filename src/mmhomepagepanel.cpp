@@ -27,6 +27,7 @@ Copyright (C) 2014 - 2020 Nikolay Akimov
 #include "billsdepositspanel.h"
 #include <algorithm>
 #include <cmath>
+#include <wx/stopwatch.h>
 
 #include "constants.h"
 #include "option.h"
@@ -122,52 +123,78 @@ void mmHomePagePanel::PrintPage()
 
 void mmHomePagePanel::insertDataIntoTemplate()
 {
-    m_frames["HTMLSCALE"] = wxString::Format("%d", Option::instance().getHtmlFontSize());
-
-    double tBalance = 0.0, cardBalance = 0.0, termBalance = 0.0, cashBalance = 0.0, loanBalance = 0.0;
-
-    htmlWidgetAccounts account_stats;
-    m_frames["ACCOUNTS_INFO"] = account_stats.displayAccounts(tBalance, Model_Account::CHECKING);
-    m_frames["CARD_ACCOUNTS_INFO"] = account_stats.displayAccounts(cardBalance, Model_Account::CREDIT_CARD);
-    tBalance += cardBalance;
-
-    // Accounts
-    m_frames["CASH_ACCOUNTS_INFO"] = account_stats.displayAccounts(cashBalance, Model_Account::CASH);
-    tBalance += cashBalance;
-
-    m_frames["LOAN_ACCOUNTS_INFO"] = account_stats.displayAccounts(loanBalance, Model_Account::LOAN);
-    tBalance += loanBalance;
-
-    m_frames["TERM_ACCOUNTS_INFO"] = account_stats.displayAccounts(termBalance, Model_Account::TERM);
-    tBalance += termBalance;
-
-    //Stocks
-    htmlWidgetStocks stocks_widget;
-    m_frames["STOCKS_INFO"] = stocks_widget.getHTMLText();
-    tBalance += stocks_widget.get_total();
-
-    htmlWidgetAssets assets;
-    m_frames["ASSETS_INFO"] = assets.getHTMLText(tBalance);
+    mmHomePageCollector& collector = mmHomePageCollector::instance();
+    collector.collect();
+    std::map<wxString, wxString>& frames = collector.frames();
 
-    htmlWidgetGrandTotals grand_totals;
-    m_frames["GRAND_TOTAL"] = grand_totals.getHTMLText(tBalance);
-
-    //
-    htmlWidgetIncomeVsExpenses income_vs_expenses;
-    m_frames["INCOME_VS_EXPENSES"] = income_vs_expenses.getHTMLText();
-
-    htmlWidgetBillsAndDeposits bills_and_deposits(_("Upcoming Transactions"));
-    m_frames["BILLS_AND_DEPOSITS"] = bills_and_deposits.getHTMLText();
-
-    htmlWidgetTop7Categories top_trx;
-    m_frames["TOP_CATEGORIES"] = top_trx.getHTMLText();
+    // the widgets are rendered once per collected data
+    if (frames.empty())
+    {
+        const mmHomePageData& data = collector.data();
+        wxStopWatch sw;
+        double tBalance = 0.0, cardBalance = 0.0, termBalance = 0.0, cashBalance = 0.0, loanBalance = 0.0;
+
+        htmlWidgetAccounts account_stats(data);
+        frames["ACCOUNTS_INFO"] = account_stats.displayAccounts(tBalance, Model_Account::CHECKING);
+        frames["CARD_ACCOUNTS_INFO"] = account_stats.displayAccounts(cardBalance, Model_Account::CREDIT_CARD);
+        tBalance += cardBalance;
+
+        // Accounts
+        frames["CASH_ACCOUNTS_INFO"] = account_stats.displayAccounts(cashBalance, Model_Account::CASH);
+        tBalance += cashBalance;
+
+        frames["LOAN_ACCOUNTS_INFO"] = account_stats.displayAccounts(loanBalance, Model_Account::LOAN);
+        tBalance += loanBalance;
+
+        frames["TERM_ACCOUNTS_INFO"] = account_stats.displayAccounts(termBalance, Model_Account::TERM);
+        tBalance += termBalance;
+        collector.add_timing("accounts", sw.Time());
+
+        //Stocks
+        sw.Start();
+        htmlWidgetStocks stocks_widget(data);
+        frames["STOCKS_INFO"] = stocks_widget.getHTMLText();
+        tBalance += stocks_widget.get_total();
+        collector.add_timing("stocks", sw.Time());
+
+        sw.Start();
+        htmlWidgetAssets assets(data);
+        frames["ASSETS_INFO"] = assets.getHTMLText(tBalance);
+
+        htmlWidgetGrandTotals grand_totals;
+        frames["GRAND_TOTAL"] = grand_totals.getHTMLText(tBalance);
+        collector.add_timing("assets", sw.Time());
+
+        //
+        sw.Start();
+        htmlWidgetIncomeVsExpenses income_vs_expenses(data);
+        frames["INCOME_VS_EXPENSES"] = income_vs_expenses.getHTMLText();
+        collector.add_timing("income_vs_expenses", sw.Time());
+
+        sw.Start();
+        htmlWidgetBillsAndDeposits bills_and_deposits(_("Upcoming Transactions"), data);
+        frames["BILLS_AND_DEPOSITS"] = bills_and_deposits.getHTMLText();
+        collector.add_timing("bills_and_deposits", sw.Time());
+
+        sw.Start();
+        htmlWidgetTop7Categories top_trx(data);
+        frames["TOP_CATEGORIES"] = top_trx.getHTMLText();
+        collector.add_timing("top_categories", sw.Time());
+
+        sw.Start();
+        htmlWidgetStatistics stat_widget(data);
+        frames["STATISTICS"] = stat_widget.getHTMLText();
+        collector.add_timing("statistics", sw.Time());
+
+        sw.Start();
+        htmlWidgetCurrency currency_rates(data);
+        frames["CURRENCY_RATES"] = currency_rates.getHtmlText();
+        collector.add_timing("currency_rates", sw.Time());
+    }
 
-    htmlWidgetStatistics stat_widget;
-    m_frames["STATISTICS"] = stat_widget.getHTMLText();
+    m_frames = frames;
+    m_frames["HTMLSCALE"] = wxString::Format("%d", Option::instance().getHtmlFontSize());
     m_frames["TOGGLES"] = getToggles();
-
-    htmlWidgetCurrency currency_rates;
-    m_frames["CURRENCY_RATES"] = currency_rates.getHtmlText();
 }
 
 const wxString mmHomePagePanel::getToggles()
@@ -18,6 +18,7 @@
 
 #include "assetdialog.h"
 #include "attachmentdialog.h"
+#include "dbwrapper.h"
 #include "mmreportspanel.h"
 #include "mmex.h"
 #include "mmframe.h"
@@ -28,9 +29,45 @@
 #include "transdialog.h"
 #include "util.h"
 #include "reports/htmlbuilder.h"
+#include "reports/reportserver.h"
 #include "model/allmodel.h"
 #include <wx/wrapsizer.h>
 
+wxDEFINE_EVENT(mmEVT_REPORT_DONE, wxThreadEvent);
+
+/** Data pass of a general report on a reader of mmDBReaderPool, posts the html to the panel */
+class mmReportsPanel::Worker : public wxThread
+{
+public:
+    enum { NO_READER = -100 };
+
+    Worker(wxEvtHandler* handler, const Model_Report::Job& job, long id)
+        : wxThread(wxTHREAD_JOINABLE), m_handler(handler), m_job(job), m_id(id) {}
+
+protected:
+    virtual ExitCode Entry()
+    {
+        wxString out;
+        int error = NO_READER;
+        {
+            mmDBReaderPool::Lease db = mmDBReaderPool::instance().Acquire();
+            if (db) error = Model_Report::run(db.get(), m_job, out);
+        }
+
+        wxThreadEvent* event = new wxThreadEvent(mmEVT_REPORT_DONE);
+        event->SetInt(error);
+        event->SetString(out);
+        event->SetExtraLong(m_id);
+        wxQueueEvent(m_handler, event);
+        return 0;
+    }
+
+private:
+    wxEvtHandler* m_handler;
+    const Model_Report::Job m_job;
+    const long m_id;
+};
+
 wxBEGIN_EVENT_TABLE(mmReportsPanel, wxPanel)
 EVT_CHOICE(ID_CHOICE_DATE_RANGE, mmReportsPanel::OnDateRangeChanged)
 EVT_CHOICE(ID_CHOICE_ACCOUNTS, mmReportsPanel::OnAccountChanged)
@@ -54,6 +91,9 @@ mmReportsPanel::mmReportsPanel(
     , cleanup_(cleanupReport)
     , cleanupmem_(false)
     , m_shift(0)
+    , m_worker(nullptr)
+    , m_jobs(0)
+    , m_print(false)
 {
     m_all_date_ranges.push_back(new mmCurrentMonth());
     m_all_date_ranges.push_back(new mmCurrentMonthToDate());
@@ -81,12 +121,14 @@ mmReportsPanel::mmReportsPanel(
 
 mmReportsPanel::~mmReportsPanel()
 {
+    stopWorker();
     if (cleanup_ && rb_) {
         delete rb_;
     }
     std::for_each(m_all_date_ranges.begin(), m_all_date_ranges.end(), std::mem_fun(&mmDateRange::destroy));
     m_all_date_ranges.clear();
     clearVFprintedFiles("rep");
+    mmReportServer::instance().drop("rep");
 }
 
 bool mmReportsPanel::Create(wxWindow *parent, wxWindowID winid
@@ -159,8 +201,7 @@ bool mmReportsPanel::saveReportText(bool initial)
 
     const auto time = wxDateTime::UNow();
 
-    const auto& name = getVFname4print("rep", rb_->getHTMLText());
-    browser_->LoadURL(name);
+    loadReport();
 
     json_writer.Key("seconds");
     json_writer.Double((wxDateTime::UNow() - time).GetMilliseconds().ToDouble() / 1000);
@@ -171,6 +212,70 @@ bool mmReportsPanel::saveReportText(bool initial)
     return true;
 }
 
+/** Build the report, served by the report server if it runs so that large tables are paged */
+const wxString mmReportsPanel::getReportURL()
+{
+    mmReportServer& server = mmReportServer::instance();
+    const bool served = server.beginPage("rep");
+    const wxString html = rb_->getHTMLText();
+    const wxString url = served ? server.endPage("rep", html) : "";
+    return url.empty() ? getVFname4print("rep", html) : url;
+}
+
+void mmReportsPanel::loadReport()
+{
+    if (!runInBackground())
+        browser_->LoadURL(getReportURL());
+}
+
+/**
+* A general report only reads the database through its SQL, so its query,
+* Lua script and template run on a reader connection while the GUI stays
+* responsive. The other reports use the model caches and run here.
+*/
+bool mmReportsPanel::runInBackground()
+{
+    mmGeneralReport* report = dynamic_cast<mmGeneralReport*>(rb_);
+    if (!report || !mmDBReaderPool::instance().IsOpen())
+        return false;
+
+    stopWorker();
+    Worker* worker = new Worker(this, report->prepare(), ++m_jobs);
+    if (worker->Run() != wxTHREAD_NO_ERROR)
+    {
+        delete worker;
+        return false;
+    }
+    m_worker = worker;
+    return true;
+}
+
+void mmReportsPanel::stopWorker()
+{
+    if (!m_worker) return;
+    m_worker->Wait();
+    delete m_worker;
+    m_worker = nullptr;
+}
+
+void mmReportsPanel::OnReportDone(wxThreadEvent& event)
+{
+    // a newer run replaced this one
+    if (event.GetExtraLong() != m_jobs) return;
+    stopWorker();
+
+    if (event.GetInt() == Worker::NO_READER)
+    {
+        browser_->LoadURL(getReportURL());
+        return;
+    }
+
+    const wxString html = mmGeneralReport::getResultHTML(event.GetInt(), event.GetString());
+    mmReportServer& server = mmReportServer::instance();
+    const wxString url = server.beginPage("rep") ? server.endPage("rep", html) : "";
+    browser_->LoadURL(url.empty() ? getVFname4print("rep", html) : url);
+}
+
 // Adjust wxStaticText size after font change
 // Workaround for not auto Layout() after SetFont()
 void mmSetOwnFont(wxStaticText* w, const wxFont& font)
@@ -354,12 +459,30 @@ void mmReportsPanel::CreateControls()
     browser_->RegisterHandler(wxSharedPtr<wxWebViewHandler>(new wxWebViewFSHandler("memory")));
 
     Bind(wxEVT_WEBVIEW_NEWWINDOW, &mmReportsPanel::OnNewWindow, this, browser_->GetId());
+    Bind(wxEVT_WEBVIEW_LOADED, &mmReportsPanel::OnPageLoaded, this, browser_->GetId());
+    Bind(mmEVT_REPORT_DONE, &mmReportsPanel::OnReportDone, this);
 
     itemBoxSizer2->Add(browser_, 1, wxGROW | wxALL, 1);
 }
 
+/**
+* The served page only holds the table rows in view, so the complete page is
+* built without the report server, loaded and printed once it is loaded.
+*/
 void mmReportsPanel::PrintPage()
 {
+    // a general report still running would replace the page
+    stopWorker();
+    ++m_jobs;
+
+    m_print = true;
+    browser_->LoadURL(getVFname4print("rep", rb_->getHTMLText()));
+}
+
+void mmReportsPanel::OnPageLoaded(wxWebViewEvent& WXUNUSED(event))
+{
+    if (!m_print) return;
+    m_print = false;
     browser_->Print();
 }
 
@@ -393,6 +516,19 @@ void mmReportsPanel::OnAccountChanged(wxCommandEvent& WXUNUSED(event))
                 accountSelection = type_obj->GetData();
             }
             rb_->setAccounts(sel, accountSelection);
+            if (sel == 1)
+            {
+                const Model_Account::Data_Set accounts = rb_->selectableAccounts();
+                mmMultiChoiceDialog mcd(this, _("Choose Accounts"), rb_->getReportTitle(), accounts);
+                wxArrayString names;
+                if (mcd.ShowModal() == wxID_OK)
+                {
+                    for (const auto &i : mcd.GetSelections()) {
+                        names.Add(accounts.at(i).ACCOUNTNAME);
+                    }
+                }
+                rb_->setSelectedAccounts(names);
+            }
 
             saveReportText(false);
             rb_->setReportSettings();
@@ -499,8 +635,7 @@ void mmReportsPanel::OnNewWindow(wxWebViewEvent& evt)
                         saveReportText();
                     }
                 }
-                const auto name = getVFname4print("rep", getPrintableBase()->getHTMLText());
-                browser_->LoadURL(name);
+                loadReport();
             }
         }
     }
@@ -512,8 +647,7 @@ void mmReportsPanel::OnNewWindow(wxWebViewEvent& evt)
         if (Model_Attachment::instance().all_type().Index(RefType) != wxNOT_FOUND && RefId > 0)
         {
             mmAttachmentManage::OpenAttachmentFromPanelIcon(m_frame, RefType, RefId);
-            const auto name = getVFname4print("rep", getPrintableBase()->getHTMLText());
-            browser_->LoadURL(name);
+            loadReport();
         }
     }
 
@@ -50,6 +50,9 @@ public:
     void sortTable() {}
 
     bool saveReportText(bool initial = true);
+    const wxString getReportURL();
+    /** Show the report, the data pass of a general report runs in a worker thread */
+    void loadReport();
     mmPrintableBase* getPrintableBase() { return rb_; }
     void PrintPage();
 
@@ -59,12 +62,21 @@ public:
     {
         ID_CHOICE_DATE_RANGE = wxID_HIGHEST + 555,
         ID_CHOICE_ACCOUNTS,
-        ID_CHOICE_START_DATE,
-        ID_CHOICE_END_DATE,
+        ID_CHOICE_START_DATE = Model_Report::ID_PARAM_START_DATE,
+        ID_CHOICE_END_DATE = Model_Report::ID_PARAM_END_DATE,
         ID_CHOICE_CHART,
     };
 
 private:
+    class Worker;
+    bool runInBackground();
+    void stopWorker();
+    void OnReportDone(wxThreadEvent& event);
+    Worker* m_worker;
+    long m_jobs;
+    void OnPageLoaded(wxWebViewEvent& event);
+    bool m_print; // print the page once it is loaded
+
     void OnNewWindow(wxWebViewEvent& evt);
     std::vector<mmDateRange*> m_all_date_ranges;
     wxChoice* m_date_ranges;
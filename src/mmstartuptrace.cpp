@@ -0,0 +1,117 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmstartuptrace.h"
+#include "singleton.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include <wx/ffile.h>
+#include <wx/log.h>
+#include <wx/thread.h>
+#include <wx/time.h>
+
+mmStartupTrace::Scope::Scope(const wxString& name, const char* category)
+    : m_category(category)
+{
+    if (!mmStartupTrace::instance().recording()) return;
+    m_name = name;
+    m_start = wxGetUTCTimeUSec();
+}
+
+mmStartupTrace::Scope::~Scope()
+{
+    if (m_name.empty()) return;
+    mmStartupTrace::instance().add(m_name, m_category, m_start, wxGetUTCTimeUSec());
+}
+
+mmStartupTrace::mmStartupTrace()
+    : m_recording(true)
+    , m_origin(wxGetUTCTimeUSec())
+{
+}
+
+mmStartupTrace& mmStartupTrace::instance()
+{
+    return Singleton<mmStartupTrace>::instance();
+}
+
+bool mmStartupTrace::recording() const
+{
+    // worker threads are not traced
+    return m_recording && wxThread::IsMain();
+}
+
+void mmStartupTrace::add(const wxString& name, const char* category, const wxLongLong& start, const wxLongLong& end)
+{
+    if (!recording()) return;
+    m_events.push_back({ name, category, start - m_origin, end - start });
+}
+
+void mmStartupTrace::setOutput(const wxString& file_path)
+{
+    m_output = file_path;
+}
+
+void mmStartupTrace::finish()
+{
+    if (!m_recording) return;
+    add("startup", "startup", m_origin, wxGetUTCTimeUSec());
+    m_recording = false;
+
+    if (m_output.empty()) return;
+    wxFFile file(m_output, "w");
+    if (file.IsOpened() && file.Write(to_json()))
+        wxLogDebug("Startup trace written to %s", m_output);
+    else
+        wxLogError("Could not write startup trace to %s", m_output);
+}
+
+const wxString mmStartupTrace::to_json() const
+{
+    rapidjson::StringBuffer json_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> json_writer(json_buffer);
+
+    json_writer.StartObject();
+    json_writer.Key("traceEvents");
+    json_writer.StartArray();
+    for (const auto& e : m_events)
+    {
+        json_writer.StartObject();
+        json_writer.Key("name");
+        json_writer.String(e.name.utf8_str());
+        json_writer.Key("cat");
+        json_writer.String(e.category);
+        json_writer.Key("ph");
+        json_writer.String("X");
+        json_writer.Key("ts");
+        json_writer.Int64(e.start.GetValue());
+        json_writer.Key("dur");
+        json_writer.Int64(e.duration.GetValue());
+        json_writer.Key("pid");
+        json_writer.Int(1);
+        json_writer.Key("tid");
+        json_writer.Int(1);
+        json_writer.EndObject();
+    }
+    json_writer.EndArray();
+    json_writer.Key("displayTimeUnit");
+    json_writer.String("ms");
+    json_writer.EndObject();
+
+    return wxString::FromUTF8(json_buffer.GetString());
+}
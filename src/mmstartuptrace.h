@@ -0,0 +1,76 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#pragma once
+
+#include <vector>
+#include <wx/string.h>
+#include <wx/longlong.h>
+
+/*
+   mmStartupTrace records the phases of the application start
+   (settings, frame, database, models, navigation tree, home page)
+   until finish() is called. The events are written in the Chrome
+   trace format (chrome://tracing) when tracing was requested on
+   the command line.
+*/
+class mmStartupTrace
+{
+public:
+    /** Times the enclosing block while the trace is recording */
+    class Scope
+    {
+    public:
+        explicit Scope(const wxString& name, const char* category = "startup");
+        ~Scope();
+    private:
+        wxString m_name;
+        const char* m_category;
+        wxLongLong m_start;
+    };
+
+public:
+    mmStartupTrace();
+    static mmStartupTrace& instance();
+
+    bool recording() const;
+    void add(const wxString& name, const char* category, const wxLongLong& start, const wxLongLong& end);
+
+    /** Write the trace to the given file on finish(), empty to only keep it in memory */
+    void setOutput(const wxString& file_path);
+
+    /** Stop recording and write the trace file if one was requested */
+    void finish();
+
+    /** Return the recorded events in the Chrome trace json format */
+    const wxString to_json() const;
+
+private:
+    struct Event
+    {
+        wxString name;
+        const char* category;
+        wxLongLong start;
+        wxLongLong duration;
+    };
+
+    bool m_recording;
+    wxLongLong m_origin;
+    wxString m_output;
+    std::vector<Event> m_events;
+};
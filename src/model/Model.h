@@ -18,13 +18,16 @@ Copyright (C) 2018 Stefano Giorgio (stef145g)
  ********************************************************/
 #pragma once
 
+#include <set>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
 #include <wx/datetime.h>
 #include <wx/log.h>
+#include <wx/variant.h>
 #include "db/DB_Table.h"
 #include "singleton.h"
+#include "mmstartuptrace.h"
 
 class wxSQLite3Statement;
 class wxSQLite3Database;
@@ -51,7 +54,7 @@ namespace std
 class ModelBase
 {
 public:
-    ModelBase() :db_(0) {};
+    ModelBase() :db_(0), ensured_(true), preload_(false) {};
     virtual ~ModelBase() {};
 
 public:
@@ -87,6 +90,8 @@ public:
 
 protected:
     wxSQLite3Database* db_;
+    bool ensured_;  // false until the deferred table checks have run
+    bool preload_;  // fill the cache when the table is first used
 };
 
 template<class DB_TABLE>
@@ -97,15 +102,50 @@ public:
     using DB_TABLE::get;
     using DB_TABLE::save;
     using DB_TABLE::remove;
+    using DB_TABLE::insert;
 
     typedef typename DB_TABLE::COLUMN COLUMN;
+    /**
+    * Create the table at once when it is missing, otherwise defer the index
+    * checks and the optional preload of the cache to the first use of the model.
+    */
+    void ensure_lazy(wxSQLite3Database* db, bool preload = false)
+    {
+        this->ensured_ = false;
+        this->preload_ = preload;
+        if (!this->exists(db)) this->ensure_now();
+    }
+
+    /** Run the deferred table checks, does nothing after the first call */
+    void ensure_now()
+    {
+        if (this->ensured_) return;
+        this->ensured_ = true;
+
+        mmStartupTrace::Scope trace(this->name(), "model");
+        this->ensure(this->db_);
+        if (this->preload_)
+        {
+            this->preload_ = false;
+            this->preload();
+        }
+    }
+
     /** Return a list of Data record addresses (Data_Set) derived directly from the database. */
     const typename DB_TABLE::Data_Set all(COLUMN col = COLUMN(0), bool asc = true)
     {
-        this->ensure(this->db_);
+        this->ensure_now();
         return all(db_, col, asc);
     }
 
+    /** Return all records in a Compact_Set, only tables generated with one have it */
+    template<class TABLE = DB_TABLE>
+    const typename TABLE::Compact_Set all_compact()
+    {
+        this->ensure_now();
+        return this->TABLE::all_compact(db_);
+    }
+
     template<typename... Args>
     /**
     Command: find(const Args&... args)
@@ -119,6 +159,7 @@ public:
     */
     const typename DB_TABLE::Data_Set find(const Args&... args)
     {
+        this->ensure_now();
         return find_by(this, db_, true, args...);
     }
 
@@ -135,21 +176,86 @@ public:
     */
     const typename DB_TABLE::Data_Set find_or(const Args&... args)
     {
+        this->ensure_now();
         return find_by(this, db_, false, args...);
     }
 
+    template<typename... Args>
+    /**
+    * Same as find(), the records are kept in an arena that is released in one
+    * go. Meant for result sets that are only iterated, e.g. by the reports.
+    */
+    typename DB_TABLE::Data_Arena find_arena(const Args&... args)
+    {
+        this->ensure_now();
+        typename DB_TABLE::Data_Arena result;
+        find_into(result, this, db_, true, args...);
+        return result;
+    }
+
+    template<typename FN, typename... Args>
+    /**
+    * Call fn(const Data&) for each record matching the conditions, or for all
+    * records without any, in one forward pass over the result set. The record
+    * passed to fn is reused for the next row. A fn returning bool stops the
+    * scan with false. Returns the number of records passed to fn.
+    */
+    size_t for_each(FN fn, const Args&... args)
+    {
+        this->ensure_now();
+        return for_each_by(this, db_, fn, true, args...);
+    }
+
+    /**
+    * Return the records matching a SQL condition built at run time, e.g. by the
+    * transaction filter. The values of the '?' placeholders are bound in order,
+    * as long, double or string.
+    */
+    const typename DB_TABLE::Data_Set find_where(const wxString& where, const std::vector<wxVariant>& params = std::vector<wxVariant>())
+    {
+        typename DB_TABLE::Data_Set result;
+        find_where_into(result, where, params);
+        return result;
+    }
+
+    /** Same as find_where(), the records are kept in an arena, see find_arena() */
+    typename DB_TABLE::Data_Arena find_where_arena(const wxString& where, const std::vector<wxVariant>& params = std::vector<wxVariant>())
+    {
+        typename DB_TABLE::Data_Arena result;
+        find_where_into(result, where, params);
+        return result;
+    }
+
+    template<typename... Args>
+    /**
+    Same as find() on another connection, e.g. a reader of mmDBReaderPool in a worker thread.
+    * The model cache is not used, so the call is safe while the UI thread edits the table.
+    */
+    const typename DB_TABLE::Data_Set find_on(wxSQLite3Database* db, const Args&... args)
+    {
+        return find_by(this, db, true, args...);
+    }
+
+    /** Same as all() on another connection, see find_on */
+    const typename DB_TABLE::Data_Set all_on(wxSQLite3Database* db, COLUMN col = COLUMN(0), bool asc = true)
+    {
+        return all(db, col, asc);
+    }
+
     /**
     * Return the Data record pointer for the given ID
     * from either memory cache or the database.
     */
     typename DB_TABLE::Data* get(int id)
     {
+        this->ensure_now();
         return this->get(id, this->db_);
     }
 
     /** Save the Data record memory instance to the database. */
     int save(typename DB_TABLE::Data* r)
     {
+        this->ensure_now();
         r->save(this->db_);
         return r->id();
     }
@@ -183,12 +289,103 @@ public:
         return rows.size();
     }
 
+    /**
+    * Insert the new records created with create() in one savepoint,
+    * reusing one prepared statement. Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<typename DB_TABLE::Data*>& rows)
+    {
+        this->ensure_now();
+        this->Savepoint();
+        const size_t inserted = this->insert(rows, this->db_);
+        this->ReleaseSavepoint();
+
+        return inserted;
+    }
+
     /** Remove the Data record instance from memory and the database. */
     bool remove(int id)
     {
+        this->ensure_now();
         return this->remove(id, db_);
     }
 
+    template<typename... Cols>
+    /** Build the SET list of update(), e.g. Model_Checking::assign(Model_Checking::PAYEEID(2)) */
+    static DB_Assign<Cols...> assign(const Cols&... cols)
+    {
+        return DB_Assign<Cols...>(cols...);
+    }
+
+    template<typename... Cols, typename... Args>
+    /**
+    Command: update(assign(const Cols&... cols), const Args&... args)
+    Sets the columns of all matching records in a single UPDATE statement,
+    the conditions are the same as for find().
+    Example:
+    Model_Checking::instance().update(Model_Checking::assign(Model_Checking::PAYEEID(2)), Model_Checking::PAYEEID(1))
+    produces SQL statement: UPDATE CHECKINGACCOUNT_V1 SET PAYEEID = 2 WHERE PAYEEID = 1
+    * Only the matching records held in memory are patched.
+    * Returns the number of records changed, 0 on error.
+    */
+    int update(const DB_Assign<Cols...>& set, const Args&... args)
+    {
+        this->ensure_now();
+        wxString where;
+        condition(where, true, args...);
+        return this->update_where(set, where, [&](wxSQLite3Statement& stmt, int index) { bind(stmt, index, args...); });
+    }
+
+    template<typename COL, typename... Cols>
+    /**
+    Command: update_in<COL>(assign(const Cols&... cols), const std::vector<int>& values)
+    Same as update() for the records where column COL is one of the values,
+    e.g. the transaction ids shown in a list.
+    */
+    int update_in(const DB_Assign<Cols...>& set, const std::vector<int>& values)
+    {
+        this->ensure_now();
+        int rows = 0;
+        this->Savepoint();
+        for (const auto& where : in_conditions(COL::name(), values))
+        {
+            rows += this->update_where(set, where.first, [&](wxSQLite3Statement& stmt, int index) { bind_in(stmt, index, where.second); });
+        }
+        this->ReleaseSavepoint();
+        return rows;
+    }
+
+    template<typename... Args>
+    /**
+    Command: remove_where(const Args&... args)
+    Deletes all matching records in a single DELETE statement,
+    the conditions are the same as for find().
+    * Only the matching records held in memory are dropped from the cache.
+    * Returns the number of records deleted, 0 on error.
+    */
+    int remove_where(const Args&... args)
+    {
+        this->ensure_now();
+        wxString where;
+        condition(where, true, args...);
+        return this->remove_where_sql(where, [&](wxSQLite3Statement& stmt, int index) { bind(stmt, index, args...); });
+    }
+
+    template<typename COL>
+    /** Same as remove_where() for the records where column COL is one of the values */
+    int remove_in(const std::vector<int>& values)
+    {
+        this->ensure_now();
+        int rows = 0;
+        this->Savepoint();
+        for (const auto& where : in_conditions(COL::name(), values))
+        {
+            rows += this->remove_where_sql(where.first, [&](wxSQLite3Statement& stmt, int index) { bind_in(stmt, index, where.second); });
+        }
+        this->ReleaseSavepoint();
+        return rows;
+    }
+
 public:
     void preload(int max_num = 1000)
     {
@@ -235,4 +432,158 @@ public:
             this->index_by_id_.size(),
             this->hit_, this->miss_, this->skip_);
     }
+
+private:
+    /** Append the records of find_where() to result, a Data_Set or a Data_Arena */
+    template<typename RESULT>
+    void find_where_into(RESULT& result, const wxString& where, const std::vector<wxVariant>& params)
+    {
+        this->ensure_now();
+        try
+        {
+            DB_Query_Timer timer(this->query() + " WHERE " + where, this->db_);
+            wxSQLite3Statement stmt = this->db_->PrepareStatement(timer.shape_);
+            for (size_t i = 0; i < params.size(); ++i)
+            {
+                const int index = static_cast<int>(i) + 1;
+                if (params[i].GetType() == "long")
+                    stmt.Bind(index, static_cast<int>(params[i].GetLong()));
+                else if (params[i].GetType() == "double")
+                    stmt.Bind(index, params[i].GetDouble());
+                else
+                    stmt.Bind(index, params[i].GetString());
+            }
+
+            wxSQLite3ResultSet q = stmt.ExecuteQuery();
+            while (q.NextRow())
+            {
+                result.emplace_back(q, this);
+            }
+            q.Finalize();
+            timer.rows_ = result.size();
+        }
+        catch (const wxSQLite3Exception &e)
+        {
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+    }
+
+    /** Split the values into "COL IN (?, ...)" conditions with at most 500 values each */
+    static std::vector<std::pair<wxString, std::vector<int> > > in_conditions(const wxString& column, const std::vector<int>& values)
+    {
+        std::vector<std::pair<wxString, std::vector<int> > > result;
+        const size_t chunk = 500;
+        for (size_t i = 0; i < values.size(); i += chunk)
+        {
+            std::vector<int> part(values.begin() + i, values.begin() + std::min(values.size(), i + chunk));
+            wxString list;
+            for (size_t j = 0; j < part.size(); j++)
+                list += j ? ", ?" : "?";
+            result.push_back(std::make_pair(column + " IN (" + list + ")", part));
+        }
+        return result;
+    }
+
+    static void bind_in(wxSQLite3Statement& stmt, int index, const std::vector<int>& values)
+    {
+        for (const auto value : values)
+            stmt.Bind(index++, value);
+    }
+
+    template<typename... Cols, typename BIND>
+    int update_where(const DB_Assign<Cols...>& set, const wxString& where, const BIND& bind_where)
+    {
+        int rows = 0;
+        try
+        {
+            const std::set<int> ids = this->cached_ids(where, bind_where);
+
+            wxString columns;
+            set.sql(columns);
+            const wxString sql = "UPDATE " + this->name() + " SET " + columns + " WHERE " + where;
+            DB_Query_Timer timer(sql, this->db_);
+            wxSQLite3Statement stmt = this->db_->PrepareStatement(sql);
+            bind_where(stmt, set.bind(stmt, 1));
+            rows = stmt.ExecuteUpdate();
+            stmt.Finalize();
+            timer.rows_ = rows;
+
+            for (auto entity : this->cache_)
+            {
+                if (ids.count(entity->id())) set.apply(entity);
+            }
+        }
+        catch (const wxSQLite3Exception &e)
+        {
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
+    template<typename BIND>
+    int remove_where_sql(const wxString& where, const BIND& bind_where)
+    {
+        int rows = 0;
+        try
+        {
+            const std::set<int> ids = this->cached_ids(where, bind_where);
+
+            const wxString sql = "DELETE FROM " + this->name() + " WHERE " + where;
+            DB_Query_Timer timer(sql, this->db_);
+            wxSQLite3Statement stmt = this->db_->PrepareStatement(sql);
+            bind_where(stmt, 1);
+            rows = stmt.ExecuteUpdate();
+            stmt.Finalize();
+            timer.rows_ = rows;
+
+            if (!ids.empty())
+            {
+                typename DB_TABLE::Cache c;
+                for (auto entity : this->cache_)
+                {
+                    if (ids.count(entity->id()))
+                    {
+                        this->index_by_id_.erase(entity->id());
+                        delete entity;
+                    }
+                    else
+                        c.push_back(entity);
+                }
+                this->cache_.swap(c);
+            }
+        }
+        catch (const wxSQLite3Exception &e)
+        {
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+
+    template<typename BIND>
+    /**
+    * Return the ids of the matching records, only queried when records are held in memory.
+    * Throws wxSQLite3Exception.
+    */
+    std::set<int> cached_ids(const wxString& where, const BIND& bind_where)
+    {
+        std::set<int> ids;
+        if (this->index_by_id_.empty()) return ids;
+
+        const wxString sql = "SELECT " + DB_TABLE::PRIMARY::name() + " FROM " + this->name() + " WHERE " + where;
+        DB_Query_Timer timer(sql, this->db_);
+        wxSQLite3Statement stmt = this->db_->PrepareStatement(sql);
+        bind_where(stmt, 1);
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        while (q.NextRow())
+        {
+            const int id = q.GetInt(0);
+            if (this->index_by_id_.count(id)) ids.insert(id);
+        }
+        q.Finalize();
+        timer.rows_ = ids.size();
+
+        return ids;
+    }
 };
@@ -17,6 +17,7 @@
  ********************************************************/
 
 #include "Model_Account.h"
+#include "Model_Balance.h"
 #include "Model_Stock.h"
 #include "Model_Translink.h"
 #include "Model_Shareinfo.h"
@@ -57,8 +58,7 @@ Model_Account& Model_Account::instance(wxSQLite3Database* db)
     Model_Account& ins = Singleton<Model_Account>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
-    ins.preload();
+    ins.ensure_lazy(db, true);
 
     return ins;
 }
@@ -174,17 +174,15 @@ Model_Currency::Data* Model_Account::currency(const Data& r)
     return currency(&r);
 }
 
-const Model_Checking::Data_Set Model_Account::transaction(const Data*r)
+Model_Checking::Data_Arena Model_Account::transaction(const Data*r)
 {
-    auto trans = Model_Checking::instance().find_or(Model_Checking::ACCOUNTID(r->ACCOUNTID)
-        , Model_Checking::TOACCOUNTID(r->ACCOUNTID));
-    std::sort(trans.begin(), trans.end());
-    std::stable_sort(trans.begin(), trans.end(), SorterByTRANSDATE());
-
-    return trans;
+    std::vector<wxVariant> params;
+    params.push_back(static_cast<long>(r->ACCOUNTID));
+    params.push_back(static_cast<long>(r->ACCOUNTID));
+    return Model_Checking::instance().find_where_arena("(ACCOUNTID = ? OR TOACCOUNTID = ?) ORDER BY TRANSDATE, TRANSID", params);
 }
 
-const Model_Checking::Data_Set Model_Account::transaction(const Data& r)
+Model_Checking::Data_Arena Model_Account::transaction(const Data& r)
 {
     return transaction(&r);
 }
@@ -201,12 +199,7 @@ const Model_Billsdeposits::Data_Set Model_Account::billsdeposits(const Data& r)
 
 double Model_Account::balance(const Data* r)
 {
-    double sum = r->INITIALBAL;
-    for (const auto& tran: transaction(r))
-    {
-        sum += Model_Checking::balance(tran, r->ACCOUNTID); 
-    }
-    return sum;
+    return r->INITIALBAL + Model_Balance::instance().get(r->ACCOUNTID).balance;
 }
 
 double Model_Account::balance(const Data& r)
@@ -216,13 +209,8 @@ double Model_Account::balance(const Data& r)
 
 std::pair<double, double> Model_Account::investment_balance(const Data* r)
 {
-    std::pair<double /*origianl input value*/, double /**/> sum;
-    for (const auto& stock: Model_Stock::instance().find(Model_Stock::HELDAT(r->ACCOUNTID)))
-    {
-        sum.first += Model_Stock::CurrentValue(stock);
-        sum.second += Model_Stock::InvestmentValue(stock);
-    }
-    return sum;
+    const Model_Balance::Balance& b = Model_Balance::instance().get(r->ACCOUNTID);
+    return std::make_pair(b.investment_value, b.investment_cost);
 }
 
 std::pair<double, double> Model_Account::investment_balance(const Data& r)
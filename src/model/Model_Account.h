@@ -77,8 +77,9 @@ public:
     static Model_Currency::Data* currency(const Data* r);
     static Model_Currency::Data* currency(const Data& r);
 
-    static const Model_Checking::Data_Set transaction(const Data* r);
-    static const Model_Checking::Data_Set transaction(const Data& r);
+    /** The transactions from or to the account, by date then id, kept in an arena */
+    static Model_Checking::Data_Arena transaction(const Data* r);
+    static Model_Checking::Data_Arena transaction(const Data& r);
 
     static const Model_Billsdeposits::Data_Set billsdeposits(const Data* r);
     static const Model_Billsdeposits::Data_Set billsdeposits(const Data& r);
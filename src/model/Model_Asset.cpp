@@ -54,7 +54,7 @@ Model_Asset& Model_Asset::instance(wxSQLite3Database* db)
     Model_Asset& ins = Singleton<Model_Asset>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
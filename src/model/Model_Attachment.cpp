@@ -31,6 +31,7 @@ const std::vector<std::pair<Model_Attachment::REFTYPE, wxString> > Model_Attachm
 
 Model_Attachment::Model_Attachment()
 : Model<DB_Table_ATTACHMENT_V1>()
+, m_index("ATTACHMENT_V1", "SELECT ATTACHMENTID, REFTYPE, REFID FROM ATTACHMENT_V1", "ATTACHMENTID")
 {
 }
 
@@ -47,7 +48,8 @@ Model_Attachment& Model_Attachment::instance(wxSQLite3Database* db)
     Model_Attachment& ins = Singleton<Model_Attachment>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
+    ins.m_index.reset(db);
 
     return ins;
 }
@@ -82,7 +84,7 @@ const Model_Attachment::Data_Set Model_Attachment::FilterAttachments(const wxStr
 /** Return the number of attachments linked to a specific object */
 int Model_Attachment::NrAttachments(const wxString& RefType, const int RefId)
 {
-    return Model_Attachment::instance().find(Model_Attachment::DB_Table_ATTACHMENT_V1::REFTYPE(RefType), Model_Attachment::REFID(RefId)).size();
+    return Model_Attachment::instance().m_index.count(RefType, RefId);
 }
 
 /** Return the last attachment number linked to a specific object */
@@ -123,6 +125,21 @@ std::map<int, Model_Attachment::Data_Set> Model_Attachment::get_all(REFTYPE reft
     return data;
 }
 
+bool Model_Attachment::has_attachment(REFTYPE reftype, int RefId)
+{
+    return m_index.count(reftype_desc(reftype), RefId) > 0;
+}
+
+void Model_Attachment::touch(const wxString& table, wxLongLong rowid)
+{
+    m_index.touch(table, rowid);
+}
+
+void Model_Attachment::reset()
+{
+    m_index.reset(db_);
+}
+
 /** Return all attachments descriptions*/
 wxArrayString Model_Attachment::allDescriptions()
 {
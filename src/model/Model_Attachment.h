@@ -20,6 +20,7 @@
 #define MODEL_ATTACHMENT_H
 
 #include "Model.h"
+#include "Model_RefIndex.h"
 #include "db/DB_Table_Attachment_V1.h"
 
 class Model_Attachment : public Model<DB_Table_ATTACHMENT_V1>
@@ -68,8 +69,19 @@ public:
     /** Return a dataset with attachments linked to a specific type*/
     std::map<int, Data_Set> get_all(REFTYPE reftype);
 
+    /** Return true when the object has attachments, does not query the database once the index is loaded */
+    bool has_attachment(REFTYPE reftype, int RefId);
+
+    /** Forward a change reported by the SQLite update hook to the presence index */
+    void touch(const wxString& table, wxLongLong rowid);
+    /** Drop the presence index, it is loaded again on the next read */
+    void reset();
+
     /** Return all attachments descriptions*/
     wxArrayString allDescriptions();
+
+private:
+    Model_RefIndex m_index;
 };
 
 #endif // 
@@ -0,0 +1,376 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "Model_Balance.h"
+#include "Model_Checking.h"
+#include "Model_Translink.h"
+#include "mmstartuptrace.h"
+#include <atomic>
+#include <vector>
+#include <wx/stopwatch.h>
+#include <wx/thread.h>
+
+namespace
+{
+    const wxString TRANS_QUERY = "SELECT TRANSID, ACCOUNTID, TOACCOUNTID, TRANSCODE, STATUS"
+        ", TRANSAMOUNT, TOTRANSAMOUNT, TRANSDATE FROM CHECKINGACCOUNT_V1";
+
+    // minimum number of rows before the per account sums are spread over threads
+    const size_t PARALLEL_THRESHOLD = 20000;
+    const int MAX_THREADS = 8;
+
+    struct Partition
+    {
+        explicit Partition(int id = -1) : account_id(id) {}
+        int account_id;
+        std::vector<std::pair<const Model_Balance::Entry*, bool /*to account side*/> > rows;
+        Model_Balance::Balance result;
+
+        void sum()
+        {
+            for (const auto& row : rows)
+            {
+                const Model_Balance::Entry& e = *row.first;
+                Model_Balance::apply(result, row.second ? e.to_amount : e.amount, e, 1);
+            }
+        }
+    };
+
+    class BalanceWorker : public wxThread
+    {
+    public:
+        BalanceWorker(std::vector<Partition>& partitions, std::atomic<size_t>& next)
+            : wxThread(wxTHREAD_JOINABLE), m_partitions(partitions), m_next(next) {}
+
+    protected:
+        virtual ExitCode Entry()
+        {
+            for (size_t i = m_next++; i < m_partitions.size(); i = m_next++)
+                m_partitions[i].sum();
+            return 0;
+        }
+
+    private:
+        std::vector<Partition>& m_partitions;
+        std::atomic<size_t>& m_next;
+    };
+
+    Model_Balance::Entry make_entry(wxSQLite3ResultSet& q, const wxString& today)
+    {
+        Model_Balance::Entry e;
+        e.account_id = q.GetInt(1);
+        e.to_account_id = -1;
+        e.amount = 0.0;
+        e.to_amount = 0.0;
+
+        const wxString status = q.GetString(4);
+        const Model_Checking::TYPE type = Model_Checking::type(q.GetString(3));
+        const int to_account_id = q.GetInt(2);
+        e.reconciled = Model_Checking::status(status) == Model_Checking::RECONCILED;
+        e.as_transfer = type != Model_Checking::TRANSFER && to_account_id == Model_Translink::AS_TRANSFER;
+        e.future = q.GetString(7) > today;
+
+        if (Model_Checking::status(status) == Model_Checking::VOID_)
+            return e;
+
+        switch (type)
+        {
+        case Model_Checking::WITHDRAWAL:
+            e.amount = -q.GetDouble(5);
+            break;
+        case Model_Checking::DEPOSIT:
+            e.amount = q.GetDouble(5);
+            break;
+        case Model_Checking::TRANSFER:
+            e.amount = -q.GetDouble(5);
+            if (to_account_id > 0 && to_account_id != e.account_id)
+            {
+                e.to_account_id = to_account_id;
+                e.to_amount = q.GetDouble(6);
+            }
+            break;
+        }
+        return e;
+    }
+}
+
+Model_Balance::Balance::Balance()
+    : balance(0), reconciled(0)
+    , widget_balance(0), widget_reconciled(0)
+    , widget_balance_today(0), widget_reconciled_today(0)
+    , investment_value(0), investment_cost(0)
+{
+}
+
+Model_Balance::Model_Balance()
+    : m_db(nullptr)
+    , m_loaded(false)
+    , m_investments_dirty(true)
+    , m_loads(0), m_refreshes(0), m_rows_loaded(0), m_rows_refreshed(0), m_threads(0)
+    , m_load_ms(0), m_refresh_ms(0)
+{
+}
+
+Model_Balance::~Model_Balance()
+{
+}
+
+Model_Balance& Model_Balance::instance(wxSQLite3Database* db)
+{
+    Model_Balance& ins = Singleton<Model_Balance>::instance();
+    ins.m_db = db;
+    ins.reset();
+
+    return ins;
+}
+
+Model_Balance& Model_Balance::instance()
+{
+    return Singleton<Model_Balance>::instance();
+}
+
+const Model_Balance::Balance& Model_Balance::get(int account_id)
+{
+    if (!m_loaded || m_today != wxDate::Today().FormatISODate())
+        load();
+    else if (!m_dirty.empty())
+        refresh();
+
+    if (m_investments_dirty)
+        load_investments();
+
+    const auto it = m_balances.find(account_id);
+    return it != m_balances.end() ? it->second : m_empty;
+}
+
+void Model_Balance::touch(const wxString& table, wxLongLong rowid)
+{
+    if (!m_loaded) return;
+
+    if (table == "CHECKINGACCOUNT_V1")
+        m_dirty.insert(rowid.ToLong());
+    else if (table == "STOCK_V1")
+        m_investments_dirty = true;
+}
+
+void Model_Balance::reset()
+{
+    m_loaded = false;
+    m_investments_dirty = true;
+    m_entries.clear();
+    m_balances.clear();
+    m_dirty.clear();
+}
+
+void Model_Balance::load()
+{
+    mmStartupTrace::Scope trace("BALANCE", "model");
+    wxStopWatch sw;
+    reset();
+    if (!m_db) return;
+
+    m_today = wxDate::Today().FormatISODate();
+    try
+    {
+        wxSQLite3ResultSet q = m_db->ExecuteQuery(TRANS_QUERY);
+        while (q.NextRow())
+            m_entries[q.GetInt(0)] = make_entry(q, m_today);
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_Balance: Exception %s", e.GetMessage().utf8_str());
+        return;
+    }
+
+    // partition the rows by account, a transfer shows up in two partitions
+    std::vector<Partition> partitions;
+    std::map<int, size_t> index;
+    for (const auto& item : m_entries)
+    {
+        const Entry& e = item.second;
+        for (int side = 0; side < 2; side++)
+        {
+            int account_id = side ? e.to_account_id : e.account_id;
+            if (account_id < 0) continue;
+            auto it = index.find(account_id);
+            if (it == index.end())
+            {
+                it = index.insert(std::make_pair(account_id, partitions.size())).first;
+                partitions.push_back(Partition(account_id));
+            }
+            partitions[it->second].rows.push_back(std::make_pair(&e, side == 1));
+        }
+    }
+
+    int threads = std::min(wxThread::GetCPUCount(), MAX_THREADS);
+    if (m_entries.size() < PARALLEL_THRESHOLD || threads < 2 || partitions.size() < 2)
+        threads = 1;
+    threads = std::min(threads, static_cast<int>(partitions.size()));
+
+    std::atomic<size_t> next(0);
+    std::vector<BalanceWorker*> workers;
+    for (int i = 1; i < threads; i++)
+    {
+        BalanceWorker* worker = new BalanceWorker(partitions, next);
+        if (worker->Run() == wxTHREAD_NO_ERROR)
+            workers.push_back(worker);
+        else
+            delete worker;
+    }
+    // the calling thread takes its share as well
+    for (size_t i = next++; i < partitions.size(); i = next++)
+        partitions[i].sum();
+    for (auto worker : workers)
+    {
+        worker->Wait();
+        delete worker;
+    }
+
+    for (const auto& p : partitions)
+        m_balances[p.account_id] = p.result;
+
+    m_loaded = true;
+    m_loads++;
+    m_rows_loaded = m_entries.size();
+    m_threads = workers.size() + 1;
+    m_load_ms = sw.Time();
+}
+
+void Model_Balance::refresh()
+{
+    wxStopWatch sw;
+    std::vector<int> ids(m_dirty.begin(), m_dirty.end());
+    m_dirty.clear();
+
+    for (int id : ids)
+    {
+        const auto it = m_entries.find(id);
+        if (it == m_entries.end()) continue;
+        apply(it->second, -1);
+        m_entries.erase(it);
+    }
+
+    const size_t chunk = 500;
+    for (size_t i = 0; i < ids.size(); i += chunk)
+    {
+        wxString list;
+        for (size_t j = i; j < ids.size() && j < i + chunk; j++)
+            list += (list.empty() ? "" : ",") + wxString::Format("%i", ids[j]);
+
+        try
+        {
+            wxSQLite3ResultSet q = m_db->ExecuteQuery(TRANS_QUERY + " WHERE TRANSID IN (" + list + ")");
+            while (q.NextRow())
+            {
+                const Entry e = make_entry(q, m_today);
+                m_entries[q.GetInt(0)] = e;
+                apply(e, 1);
+            }
+            q.Finalize();
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("Model_Balance: Exception %s", e.GetMessage().utf8_str());
+            m_loaded = false;
+            return;
+        }
+    }
+
+    m_refreshes++;
+    m_rows_refreshed += ids.size();
+    m_refresh_ms += sw.Time();
+}
+
+void Model_Balance::load_investments()
+{
+    m_investments_dirty = false;
+    if (!m_db) return;
+
+    for (auto& item : m_balances)
+    {
+        item.second.investment_value = 0;
+        item.second.investment_cost = 0;
+    }
+
+    try
+    {
+        wxSQLite3ResultSet q = m_db->ExecuteQuery("SELECT HELDAT, NUMSHARES, CURRENTPRICE, VALUE FROM STOCK_V1");
+        while (q.NextRow())
+        {
+            Balance& b = m_balances[q.GetInt(0)];
+            b.investment_value += q.GetDouble(1) * q.GetDouble(2);
+            b.investment_cost += q.GetDouble(3);
+        }
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_Balance: Exception %s", e.GetMessage().utf8_str());
+    }
+}
+
+void Model_Balance::apply(const Entry& entry, int sign)
+{
+    apply(m_balances[entry.account_id], entry.amount, entry, sign);
+    if (entry.to_account_id > 0)
+        apply(m_balances[entry.to_account_id], entry.to_amount, entry, sign);
+}
+
+void Model_Balance::apply(Balance& b, double amount, const Entry& entry, int sign)
+{
+    const double value = sign * amount;
+    b.balance += value;
+    if (entry.reconciled) b.reconciled += value;
+    if (entry.as_transfer) return;
+
+    b.widget_balance += value;
+    if (entry.reconciled) b.widget_reconciled += value;
+    if (entry.future) return;
+
+    b.widget_balance_today += value;
+    if (entry.reconciled) b.widget_reconciled_today += value;
+}
+
+wxString Model_Balance::GetStatsAsJson() const
+{
+    StringBuffer json_buffer;
+    rapidjson::Writer<StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    json_writer.Key("table");
+    json_writer.String("BALANCE");
+    json_writer.Key("accounts");
+    json_writer.Int(static_cast<int>(m_balances.size()));
+    json_writer.Key("loads");
+    json_writer.Int(static_cast<int>(m_loads));
+    json_writer.Key("rows_loaded");
+    json_writer.Int(static_cast<int>(m_rows_loaded));
+    json_writer.Key("threads");
+    json_writer.Int(static_cast<int>(m_threads));
+    json_writer.Key("load_ms");
+    json_writer.Int(static_cast<int>(m_load_ms));
+    json_writer.Key("refreshes");
+    json_writer.Int(static_cast<int>(m_refreshes));
+    json_writer.Key("rows_refreshed");
+    json_writer.Int(static_cast<int>(m_rows_refreshed));
+    json_writer.Key("refresh_ms");
+    json_writer.Int(static_cast<int>(m_refresh_ms));
+    json_writer.EndObject();
+
+    return wxString::FromUTF8(json_buffer.GetString());
+}
@@ -0,0 +1,114 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MODEL_BALANCE_H
+#define MODEL_BALANCE_H
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <wx/string.h>
+#include <wx/longlong.h>
+#include "singleton.h"
+
+class wxSQLite3Database;
+
+/**
+* Snapshot of the balances of all accounts.
+* The snapshot is built in one pass over CHECKINGACCOUNT_V1, the per account
+* sums run on a small pool of worker threads. Later edits are reported by the
+* SQLite update hook and applied incrementally on the next read.
+* Initial balances are not included, callers add Model_Account::INITIALBAL.
+*/
+class Model_Balance
+{
+public:
+    struct Balance
+    {
+        Balance();
+        double balance;             // same rules as Model_Account::balance
+        double reconciled;
+        double widget_balance;      // excludes asset and stock transfers, as on the home page
+        double widget_reconciled;
+        double widget_balance_today;    // as above, ignoring future transactions
+        double widget_reconciled_today;
+        double investment_value;    // same rules as Model_Account::investment_balance
+        double investment_cost;
+    };
+
+    /** Contribution of a single transaction to up to two accounts */
+    struct Entry
+    {
+        int account_id;
+        int to_account_id;          // -1 unless the transaction is a transfer
+        double amount;
+        double to_amount;
+        bool reconciled;
+        bool as_transfer;
+        bool future;
+    };
+
+public:
+    Model_Balance();
+    ~Model_Balance();
+
+    /**
+    Initialize the global balance snapshot for the database.
+    * Return the static instance address for Model_Balance
+    */
+    static Model_Balance& instance(wxSQLite3Database* db);
+    static Model_Balance& instance();
+
+public:
+    /** Return the balances of the account, refreshing the snapshot if needed */
+    const Balance& get(int account_id);
+
+    /** Record a change reported by the SQLite update hook. Does not touch the database. */
+    void touch(const wxString& table, wxLongLong rowid);
+
+    /** Drop the snapshot, it is rebuilt on the next read */
+    void reset();
+
+    /** Return the timing counters as a json string */
+    wxString GetStatsAsJson() const;
+
+    /** Add (sign 1) or remove (sign -1) one side of a transaction to the balance */
+    static void apply(Balance& b, double amount, const Entry& entry, int sign);
+
+private:
+    void load();
+    void refresh();
+    void load_investments();
+    void apply(const Entry& entry, int sign);
+
+private:
+    wxSQLite3Database* m_db;
+    bool m_loaded;
+    bool m_investments_dirty;
+    wxString m_today;
+    std::unordered_map<int, Entry> m_entries;
+    std::map<int, Balance> m_balances;
+    std::set<int> m_dirty;
+    Balance m_empty;
+
+    // timing counters
+    size_t m_loads, m_refreshes, m_rows_loaded, m_rows_refreshed, m_threads;
+    long m_load_ms, m_refresh_ms;
+};
+
+#endif // MODEL_BALANCE_H
@@ -21,10 +21,10 @@
 #include "Model_Account.h"
 #include "Model_Attachment.h"
 #include "Model_Category.h"
+#include "Model_Checking.h"
 #include "Model_Payee.h"
 
-/* TODO: Move attachment management outside of attachmentdialog */
-#include "attachmentdialog.h"
+#include "mmattachment.h"
 
 const std::vector<std::pair<Model_Billsdeposits::TYPE, wxString> > Model_Billsdeposits::TYPE_CHOICES =
 {
@@ -85,7 +85,7 @@ Model_Billsdeposits& Model_Billsdeposits::instance(wxSQLite3Database* db)
     Model_Billsdeposits& ins = Singleton<Model_Billsdeposits>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -260,7 +260,7 @@ bool Model_Billsdeposits::allowExecution()
     return m_allowExecution;
 }
 
-bool Model_Billsdeposits::AllowTransaction(const Data& r, AccountBalance& bal)
+bool Model_Billsdeposits::within_limits(const Data& r, AccountBalance& bal, double& new_balance)
 {
     const int acct_id = r.ACCOUNTID;
     Model_Account::Data* account = Model_Account::instance().get(acct_id);
@@ -277,24 +277,27 @@ bool Model_Billsdeposits::AllowTransaction(const Data& r, AccountBalance& bal)
         bal[acct_id] = current_account_balance;
     }
 
-    double new_value = r.TRANSAMOUNT;
+    new_balance = r.TRANSAMOUNT;
 
     if (r.TRANSCODE == Model_Checking::all_type()[Model_Checking::WITHDRAWAL])
     {
-        new_value *= -1;
+        new_balance *= -1;
     }
-    new_value += current_account_balance;
+    new_balance += current_account_balance;
 
-    bool abort_transaction = false;
-    if ((account->MINIMUMBALANCE != 0) && (new_value < account->MINIMUMBALANCE))
-    {
-        abort_transaction = true;
-    }
+    if ((account->MINIMUMBALANCE != 0) && (new_balance < account->MINIMUMBALANCE))
+        return false;
 
-    if ((account->CREDITLIMIT != 0) && (new_value < (account->CREDITLIMIT * -1)))
-    {
-        abort_transaction = true;
-    }
+    if ((account->CREDITLIMIT != 0) && (new_balance < (account->CREDITLIMIT * -1)))
+        return false;
+
+    return true;
+}
+
+bool Model_Billsdeposits::AllowTransaction(const Data& r, AccountBalance& bal)
+{
+    double new_value = 0;
+    bool abort_transaction = !within_limits(r, bal, new_value);
 
     if (abort_transaction && wxMessageBox(_(
         "A recurring transaction will exceed your account limit.\n\n"
@@ -306,106 +309,455 @@ bool Model_Billsdeposits::AllowTransaction(const Data& r, AccountBalance& bal)
 
     if (!abort_transaction)
     {
-        bal[acct_id] = new_value;
+        bal[r.ACCOUNTID] = new_value;
     }
 
     return !abort_transaction;
 }
 
+void Model_Billsdeposits::advance(int repeats, int& numRepeats, int& payment_day, int& due_day)
+{
+    const int payment_day_update = Recurrence::next(repeats, numRepeats, payment_day);
+    const int due_day_update = Recurrence::next(repeats, numRepeats, due_day);
+
+    if (numRepeats != REPEAT_TYPE::REPEAT_INACTIVE)
+    {
+        if ((repeats < REPEAT_TYPE::REPEAT_IN_X_DAYS) || (repeats > REPEAT_TYPE::REPEAT_EVERY_X_MONTHS))
+            numRepeats--;
+    }
+
+    if (repeats == REPEAT_TYPE::REPEAT_NONE)
+        numRepeats = 0;
+    else if ((repeats == REPEAT_TYPE::REPEAT_IN_X_DAYS)
+        || (repeats == REPEAT_TYPE::REPEAT_IN_X_MONTHS))
+    {
+        if (numRepeats != -1) numRepeats = -1;
+    }
+
+    // Ensure that TRANDSATE is set correctly
+    due_day = payment_day > due_day ? payment_day_update : due_day_update;
+    payment_day = payment_day_update;
+}
+
 void Model_Billsdeposits::completeBDInSeries(int bdID)
 {
     Data* bill = get(bdID);
     if (bill)
     {
-        int repeats = bill->REPEATS;
         // DeMultiplex the Auto Executable fields.
-        if (repeats >= BD_REPEATS_MULTIPLEX_BASE)    // Auto Execute User Acknowlegement required
-            repeats -= BD_REPEATS_MULTIPLEX_BASE;
-        if (repeats >= BD_REPEATS_MULTIPLEX_BASE)    // Auto Execute Silent mode
-            repeats -= BD_REPEATS_MULTIPLEX_BASE;
+        const int repeats = bill->REPEATS % BD_REPEATS_MULTIPLEX_BASE;
         int numRepeats = bill->NUMOCCURRENCES;
-        const wxDateTime& payment_date_current = NEXTOCCURRENCEDATE(bill);
-        const wxDateTime& payment_date_update = nextOccurDate(repeats, numRepeats, payment_date_current);
+        int payment_day = Recurrence::to_day(bill->NEXTOCCURRENCEDATE);
+        int due_day = Recurrence::to_day(bill->TRANSDATE);
+        advance(repeats, numRepeats, payment_day, due_day);
 
-        const wxDateTime& due_date_current = TRANSDATE(bill);
-        const wxDateTime& due_date_update = nextOccurDate(repeats, numRepeats, due_date_current);
+        bill->NEXTOCCURRENCEDATE = Recurrence::to_iso(payment_day);
+        bill->TRANSDATE = Recurrence::to_iso(due_day);
+        bill->NUMOCCURRENCES = numRepeats;
+        save(bill);
 
-        if (numRepeats != REPEAT_TYPE::REPEAT_INACTIVE)
+        if (bill->NUMOCCURRENCES == REPEAT_TYPE::REPEAT_NONE)
         {
-            if ((repeats < REPEAT_TYPE::REPEAT_IN_X_DAYS) || (repeats > REPEAT_TYPE::REPEAT_EVERY_X_MONTHS))
-                numRepeats--;
+            mmAttachmentManage::DeleteAllAttachments(Model_Attachment::reftype_desc(Model_Attachment::BILLSDEPOSIT), bdID);
+            remove(bdID);
         }
+    }
+}
+
+Model_Billsdeposits::CatchUp_Stats Model_Billsdeposits::catch_up(const wxDate& today, const std::function<bool(const Data&)>& confirm)
+{
+    CatchUp_Stats stats;
+    wxLongLong start = wxGetUTCTimeMillis();
+    const int today_day = Recurrence::to_day(today);
+
+    AccountBalance bal;
+    std::vector<Model_Checking::Data*> transactions;
+    std::vector<int> sources;   // BDID of each transaction
+    std::vector<Data*> advanced;
+    std::vector<int> finished;
+
+    for (const auto& q1 : all())
+    {
+        decode_fields(q1);
+        if (!autoExecuteSilent() || !requireExecution()) continue;
+
+        const int repeats = q1.REPEATS % BD_REPEATS_MULTIPLEX_BASE;
+        int numRepeats = q1.NUMOCCURRENCES;
+        int payment_day = Recurrence::to_day(q1.NEXTOCCURRENCEDATE);
+        int due_day = Recurrence::to_day(q1.TRANSDATE);
+        bool stepped = false;
 
-        if (repeats == REPEAT_TYPE::REPEAT_NONE)
-            numRepeats = 0;
-        else if ((repeats == REPEAT_TYPE::REPEAT_IN_X_DAYS)
-            || (repeats == REPEAT_TYPE::REPEAT_IN_X_MONTHS))
+        while (payment_day <= today_day)
         {
-            if (numRepeats != -1) numRepeats = -1;
+            const bool allow_execution = (repeats < REPEAT_IN_X_DAYS) || (numRepeats > REPEAT_NONE) || (repeats > REPEAT_EVERY_X_MONTHS);
+            if (allow_execution)
+            {
+                double new_balance = 0;
+                if (!within_limits(q1, bal, new_balance) && !confirm(q1))
+                {
+                    ++stats.declined;
+                    break; // the occurrence stays due
+                }
+                bal[q1.ACCOUNTID] = new_balance;
+
+                Model_Checking::Data* tran = Model_Checking::instance().create();
+                tran->ACCOUNTID = q1.ACCOUNTID;
+                tran->TOACCOUNTID = q1.TOACCOUNTID;
+                tran->PAYEEID = q1.PAYEEID;
+                tran->TRANSCODE = q1.TRANSCODE;
+                tran->TRANSAMOUNT = q1.TRANSAMOUNT;
+                tran->TOTRANSAMOUNT = q1.TOTRANSAMOUNT;
+                tran->STATUS = q1.STATUS;
+                tran->TRANSACTIONNUMBER = q1.TRANSACTIONNUMBER;
+                tran->NOTES = q1.NOTES;
+                tran->CATEGID = q1.CATEGID;
+                tran->SUBCATEGID = q1.SUBCATEGID;
+                tran->TRANSDATE = Recurrence::to_iso(due_day);
+                transactions.push_back(tran);
+                sources.push_back(q1.BDID);
+            }
+
+            const int previous_day = payment_day;
+            advance(repeats, numRepeats, payment_day, due_day);
+            stepped = true;
+
+            // a schedule that cannot execute is only moved on, as completeBDInSeries() does
+            if (!allow_execution || numRepeats == REPEAT_NONE || payment_day <= previous_day)
+                break;
         }
 
-        bill->NEXTOCCURRENCEDATE = payment_date_update.FormatISODate();
-        bill->TRANSDATE = due_date_update.FormatISODate();
-
-        // Ensure that TRANDSATE is set correctly
-        if (payment_date_current > due_date_current)
-            bill->TRANSDATE = payment_date_update.FormatISODate();
+        if (!stepped) continue;
+        ++stats.schedules;
 
+        Data* bill = get(q1.BDID);
+        bill->NEXTOCCURRENCEDATE = Recurrence::to_iso(payment_day);
+        bill->TRANSDATE = Recurrence::to_iso(due_day);
         bill->NUMOCCURRENCES = numRepeats;
-        save(bill);
+        advanced.push_back(bill);
+        if (numRepeats == REPEAT_NONE)
+            finished.push_back(q1.BDID);
+    }
+    stats.collect_ms = (wxGetUTCTimeMillis() - start).GetValue();
 
-        if (bill->NUMOCCURRENCES == REPEAT_TYPE::REPEAT_NONE)
+    if (advanced.empty()) return stats;
+
+    start = wxGetUTCTimeMillis();
+    this->Savepoint();
+    stats.occurrences = Model_Checking::instance().insert(transactions);
+
+    std::map<int, Split_Data_Set> bill_splits;
+    std::vector<Model_Splittransaction::Data*> splits;
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        if (transactions[i]->id() <= 0) continue;
+        auto it = bill_splits.find(sources[i]);
+        if (it == bill_splits.end())
+            it = bill_splits.insert(std::make_pair(sources[i], splittransaction(get(sources[i])))).first;
+
+        for (const auto& item : it->second)
         {
-            mmAttachmentManage::DeleteAllAttachments(Model_Attachment::reftype_desc(Model_Attachment::BILLSDEPOSIT), bdID);
-            remove(bdID);
+            Model_Splittransaction::Data* split = Model_Splittransaction::instance().create();
+            split->TRANSID = transactions[i]->id();
+            split->CATEGID = item.CATEGID;
+            split->SUBCATEGID = item.SUBCATEGID;
+            split->SPLITTRANSAMOUNT = item.SPLITTRANSAMOUNT;
+            splits.push_back(split);
         }
     }
+    stats.splits = Model_Splittransaction::instance().insert(splits);
+
+    this->save(advanced);
+    for (const auto id : finished)
+    {
+        mmAttachmentManage::DeleteAllAttachments(Model_Attachment::reftype_desc(Model_Attachment::BILLSDEPOSIT), id);
+        remove(id);
+    }
+    stats.finished = finished.size();
+    this->ReleaseSavepoint();
+    stats.insert_ms = (wxGetUTCTimeMillis() - start).GetValue();
+
+    return stats;
+}
+
+const wxString Model_Billsdeposits::CatchUp_Stats::summary() const
+{
+    return wxString::Format("Schedules: %zu, finished: %zu, stopped at an account limit: %zu\n"
+        "Transactions: %zu, splits: %zu\n"
+        "Collected in %lld ms, written in %lld ms"
+        , schedules, finished, declined, occurrences, splits, collect_ms, insert_ms);
 }
 
 const wxDateTime Model_Billsdeposits::nextOccurDate(int repeatsType, int numRepeats, const wxDateTime& nextOccurDate)
 {
-    wxDateTime dt = nextOccurDate;
-    if (repeatsType == REPEAT_WEEKLY)
-        dt = dt.Add(wxTimeSpan::Week());
-    else if (repeatsType == REPEAT_BI_WEEKLY)
-        dt = dt.Add(wxTimeSpan::Weeks(2));
-    else if (repeatsType == REPEAT_MONTHLY)
-        dt = dt.Add(wxDateSpan::Month());
-    else if (repeatsType == REPEAT_BI_MONTHLY)
-        dt = dt.Add(wxDateSpan::Months(2));
-    else if (repeatsType == REPEAT_FOUR_MONTHLY)
-        dt = dt.Add(wxDateSpan::Months(4));
-    else if (repeatsType == REPEAT_HALF_YEARLY)
-        dt = dt.Add(wxDateSpan::Months(6));
-    else if (repeatsType == REPEAT_YEARLY)
-        dt = dt.Add(wxDateSpan::Year());
-    else if (repeatsType == REPEAT_QUARTERLY)
-        dt = dt.Add(wxDateSpan::Months(3));
-    else if (repeatsType == REPEAT_FOUR_WEEKLY)
-        dt = dt.Add(wxDateSpan::Weeks(4));
-    else if (repeatsType == REPEAT_DAILY)
-        dt = dt.Add(wxDateSpan::Days(1));
-    else if (repeatsType == REPEAT_IN_X_DAYS) // repeat in numRepeats Days (Once only)
-        dt = dt.Add(wxDateSpan::Days(numRepeats));
-    else if (repeatsType == REPEAT_IN_X_MONTHS) // repeat in numRepeats Months (Once only)
-        dt = dt.Add(wxDateSpan::Months(numRepeats));
-    else if (repeatsType == REPEAT_EVERY_X_DAYS) // repeat every numRepeats Days
-        dt = dt.Add(wxDateSpan::Days(numRepeats));
-    else if (repeatsType == REPEAT_EVERY_X_MONTHS) // repeat every numRepeats Months
-        dt = dt.Add(wxDateSpan::Months(numRepeats));
-    else if (repeatsType == REPEAT_MONTHLY_LAST_DAY
-        || REPEAT_MONTHLY_LAST_BUSINESS_DAY == repeatsType)
+    return Recurrence::to_date(Recurrence::next(repeatsType, numRepeats, Recurrence::to_day(nextOccurDate)));
+}
+
+namespace
+{
+    const int DAYS_IN_MONTH[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    int days_in_month(int year, int month)
+    {
+        if (month == 2 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)))
+            return 29;
+        return DAYS_IN_MONTH[month - 1];
+    }
+
+    int month_index(int day)
+    {
+        int year, month, mday;
+        Model_Billsdeposits::Recurrence::from_day(day, year, month, mday);
+        return year * 12 + month - 1;
+    }
+
+    // 0 = Sunday, 1970-01-01 was a Thursday
+    int week_day(int day)
+    {
+        return (day % 7 + 11) % 7;
+    }
+}
+
+Model_Billsdeposits::Recurrence::Recurrence(int repeats, int num_occurrences, int first_day)
+    : first_(first_day)
+{
+    step_kind(repeats, num_occurrences, kind_, every_);
+
+    if (repeats == REPEAT_NONE || every_ <= 0)
+        count_ = 1;
+    else if (repeats == REPEAT_IN_X_DAYS || repeats == REPEAT_IN_X_MONTHS)
+        count_ = 2; // this one and the one in x days or months
+    else if (repeats == REPEAT_EVERY_X_DAYS || repeats == REPEAT_EVERY_X_MONTHS)
+        count_ = -1;
+    else
+        count_ = num_occurrences == -1 ? -1 : std::max(num_occurrences, 1);
+}
+
+Model_Billsdeposits::Recurrence::Recurrence(const Data& r)
+    : Recurrence(r.REPEATS % BD_REPEATS_MULTIPLEX_BASE, r.NUMOCCURRENCES, to_day(r.NEXTOCCURRENCEDATE))
+{
+}
+
+void Model_Billsdeposits::Recurrence::step_kind(int repeats, int num_occurrences, KIND& kind, int& every)
+{
+    kind = DAYS;
+    every = 0;
+    switch (repeats)
     {
-        dt = dt.Add(wxDateSpan::Month());
-        dt = dt.SetToLastMonthDay(dt.GetMonth(), dt.GetYear());
-        if (repeatsType == REPEAT_MONTHLY_LAST_BUSINESS_DAY) // last weekday of month
+    case REPEAT_WEEKLY: every = 7; break;
+    case REPEAT_BI_WEEKLY: every = 14; break;
+    case REPEAT_FOUR_WEEKLY: every = 28; break;
+    case REPEAT_DAILY: every = 1; break;
+    case REPEAT_IN_X_DAYS:
+    case REPEAT_EVERY_X_DAYS: every = num_occurrences; break;
+    case REPEAT_MONTHLY: kind = MONTHS; every = 1; break;
+    case REPEAT_BI_MONTHLY: kind = MONTHS; every = 2; break;
+    case REPEAT_QUARTERLY: kind = MONTHS; every = 3; break;
+    case REPEAT_FOUR_MONTHLY: kind = MONTHS; every = 4; break;
+    case REPEAT_HALF_YEARLY: kind = MONTHS; every = 6; break;
+    case REPEAT_YEARLY: kind = MONTHS; every = 12; break;
+    case REPEAT_IN_X_MONTHS:
+    case REPEAT_EVERY_X_MONTHS: kind = MONTHS; every = num_occurrences; break;
+    case REPEAT_MONTHLY_LAST_DAY: kind = LAST_DAY; every = 1; break;
+    case REPEAT_MONTHLY_LAST_BUSINESS_DAY: kind = LAST_BUSINESS_DAY; every = 1; break;
+    default: break;
+    }
+}
+
+int Model_Billsdeposits::Recurrence::next(int repeats, int num_occurrences, int day)
+{
+    KIND kind;
+    int every;
+    step_kind(repeats, num_occurrences, kind, every);
+    switch (kind)
+    {
+    case MONTHS: return add_months(day, every);
+    case LAST_DAY: return month_end(month_index(day) + 1, false);
+    case LAST_BUSINESS_DAY: return month_end(month_index(day) + 1, true);
+    default: return day + every;
+    }
+}
+
+/** Same as wxDateTime::Add(wxDateSpan::Months(months)): the day is limited to the length of the month */
+int Model_Billsdeposits::Recurrence::add_months(int day, int months)
+{
+    int year, month, mday;
+    from_day(day, year, month, mday);
+    const int index = year * 12 + month - 1 + months;
+    year = index / 12;
+    month = index % 12 + 1;
+    return to_day(year, month, std::min(mday, days_in_month(year, month)));
+}
+
+int Model_Billsdeposits::Recurrence::month_end(int month_index, bool business_day)
+{
+    const int year = month_index / 12, month = month_index % 12 + 1;
+    const int day = to_day(year, month, days_in_month(year, month));
+    if (!business_day) return day;
+
+    switch (week_day(day))
+    {
+    case 6: return day - 1; // Saturday
+    case 0: return day - 2; // Sunday
+    default: return day;
+    }
+}
+
+int Model_Billsdeposits::Recurrence::first() const
+{
+    return first_;
+}
+
+int Model_Billsdeposits::Recurrence::count() const
+{
+    return count_;
+}
+
+bool Model_Billsdeposits::Recurrence::jumps() const
+{
+    if (kind_ != MONTHS) return true;
+    int year, month, mday;
+    from_day(first_, year, month, mday);
+    return mday <= 28; // the day exists in every month, it is never limited
+}
+
+int Model_Billsdeposits::Recurrence::occurrence(int k) const
+{
+    if (k == 0) return first_;
+    switch (kind_)
+    {
+    case DAYS:
+        return first_ + k * every_;
+    case LAST_DAY:
+    case LAST_BUSINESS_DAY:
+        return month_end(month_index(first_) + k, kind_ == LAST_BUSINESS_DAY);
+    case MONTHS:
+        if (jumps()) return add_months(first_, k * every_);
+        break;
+    }
+
+    // a day beyond the 28th is limited in the short months and stays so afterwards
+    int day = first_;
+    for (int i = 0; i < k; ++i)
+        day = add_months(day, every_);
+    return day;
+}
+
+int Model_Billsdeposits::Recurrence::index_from(int day) const
+{
+    if (day <= first_) return 0;
+    if (every_ <= 0) return 1;
+
+    int k = 0;
+    switch (kind_)
+    {
+    case DAYS:
+        return (day - first_ + every_ - 1) / every_;
+    case LAST_DAY:
+    case LAST_BUSINESS_DAY:
+        k = std::max(month_index(day) - month_index(first_), 1);
+        break;
+    case MONTHS:
+        k = (month_index(day) - month_index(first_) + every_ - 1) / every_;
+        break;
+    }
+    return occurrence(k) < day ? k + 1 : k;
+}
+
+int Model_Billsdeposits::Recurrence::first_from(int day) const
+{
+    if (jumps())
+    {
+        const int k = index_from(day);
+        if (count_ >= 0 && k >= count_) return -1;
+        return occurrence(k);
+    }
+
+    int d = first_;
+    for (int k = 0; count_ < 0 || k < count_; ++k, d = add_months(d, every_))
+    {
+        if (d >= day) return d;
+    }
+    return -1;
+}
+
+size_t Model_Billsdeposits::Recurrence::expand(int from_day, int to_day, std::vector<int>& days) const
+{
+    const size_t before = days.size();
+    if (to_day < from_day) return 0;
+
+    if (jumps())
+    {
+        for (int k = index_from(from_day); count_ < 0 || k < count_; ++k)
+        {
+            const int d = occurrence(k);
+            if (d > to_day) break;
+            days.push_back(d);
+        }
+    }
+    else
+    {
+        int d = first_;
+        for (int k = 0; (count_ < 0 || k < count_) && d <= to_day; ++k, d = add_months(d, every_))
         {
-            if (dt.GetWeekDay() == wxDateTime::Sun || dt.GetWeekDay() == wxDateTime::Sat)
-                dt.SetToPrevWeekDay(wxDateTime::Fri);
+            if (d >= from_day) days.push_back(d);
         }
     }
-    //wxLogDebug("init date: %s -> next date: %s", nextOccurDate.FormatISODate(), dt.FormatISODate());
-    return dt;
+    return days.size() - before;
+}
+
+/* The day number of a civil date, month 1 to 12 (H. Hinnant, chrono-compatible low-level date algorithms) */
+int Model_Billsdeposits::Recurrence::to_day(int year, int month, int mday)
+{
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yoe = year - era * 400;
+    const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + mday - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void Model_Billsdeposits::Recurrence::from_day(int day, int& year, int& month, int& mday)
+{
+    day += 719468;
+    const int era = (day >= 0 ? day : day - 146096) / 146097;
+    const int doe = day - era * 146097;
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int mp = (5 * doy + 2) / 153;
+    mday = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yoe + era * 400 + (month <= 2);
+}
+
+int Model_Billsdeposits::Recurrence::to_day(const wxString& iso_date)
+{
+    long year = 0, month = 0, mday = 0;
+    if (iso_date.length() >= 10 && iso_date.Mid(0, 4).ToLong(&year)
+        && iso_date.Mid(5, 2).ToLong(&month) && iso_date.Mid(8, 2).ToLong(&mday)
+        && month >= 1 && month <= 12)
+        return to_day(year, month, mday);
+
+    return to_day(Model_Billsdeposits::to_date(iso_date));
+}
+
+int Model_Billsdeposits::Recurrence::to_day(const wxDateTime& date)
+{
+    if (!date.IsValid()) return to_day(wxDateTime::Today());
+    return to_day(date.GetYear(), date.GetMonth() + 1, date.GetDay());
+}
+
+const wxString Model_Billsdeposits::Recurrence::to_iso(int day)
+{
+    int year, month, mday;
+    from_day(day, year, month, mday);
+    return wxString::Format("%04d-%02d-%02d", year, month, mday);
+}
+
+const wxDateTime Model_Billsdeposits::Recurrence::to_date(int day)
+{
+    int year, month, mday;
+    from_day(day, year, month, mday);
+    return wxDateTime(static_cast<wxDateTime::wxDateTime_t>(mday), static_cast<wxDateTime::Month>(month - 1), year);
 }
 
 Model_Billsdeposits::Full_Data::Full_Data()
@@ -146,6 +146,12 @@ public:
     bool allowExecution();
     typedef std::map<int, double> AccountBalance;
     bool AllowTransaction(const Data& r, AccountBalance& bal);
+    /**
+    * Check an occurrence against the limits of its account, using and filling the
+    * running balances in bal. new_balance is the balance after the occurrence,
+    * it is only stored in bal by the caller once the occurrence is accepted.
+    */
+    static bool within_limits(const Data& r, AccountBalance& bal, double& new_balance);
 
 private:
     bool m_autoExecuteManual;
@@ -168,6 +174,84 @@ public:
 
     void completeBDInSeries(int bdID);
     static const wxDateTime nextOccurDate(int type, int numRepeats, const wxDateTime& nextOccurDate);
+
+    /** Counts and timings of catch_up() */
+    struct CatchUp_Stats
+    {
+        size_t schedules = 0;       // schedules with due occurrences
+        size_t occurrences = 0;     // transactions inserted
+        size_t splits = 0;
+        size_t declined = 0;        // schedules stopped at an account limit
+        size_t finished = 0;        // schedules removed after their last occurrence
+        long long collect_ms = 0;
+        long long insert_ms = 0;
+
+        const wxString summary() const;
+    };
+
+    /**
+    * Execute every occurrence due up to today of the schedules executed silently,
+    * in one pass. The account limits are checked against one running balance per
+    * account, confirm(bill) decides on an occurrence over the limit and the
+    * schedule stops there when it returns false. The transactions, their splits
+    * and the advanced schedules are written in one savepoint.
+    * Schedules that need the user to acknowledge each occurrence are left alone.
+    */
+    CatchUp_Stats catch_up(const wxDate& today, const std::function<bool(const Data&)>& confirm);
+
+private:
+    /** One step of a schedule, with the changes completeBDInSeries() makes to the repeat count and dates */
+    static void advance(int repeats, int& num_occurrences, int& payment_day, int& due_day);
+
+public:
+    /**
+    * The occurrences of a schedule (REPEATS, NUMOCCURRENCES, NEXTOCCURRENCEDATE)
+    * as day numbers, the days since 1970-01-01. Schedules with a fixed number of
+    * days between occurrences, and monthly ones on a day that exists in every
+    * month, jump to the occurrence on or after a date in constant time, the
+    * others step from the first occurrence with integer arithmetic only.
+    */
+    class Recurrence
+    {
+    public:
+        /** repeats without the auto execute multiplex, see BD_REPEATS_MULTIPLEX_BASE */
+        Recurrence(int repeats, int num_occurrences, int first_day);
+        explicit Recurrence(const Data& r);
+
+        int first() const;
+        /** Number of occurrences, -1 for a schedule without end */
+        int count() const;
+        /** Return the first occurrence on or after day, -1 when there is none */
+        int first_from(int day) const;
+        /** Append the occurrences from from_day to to_day, both included, and return how many */
+        size_t expand(int from_day, int to_day, std::vector<int>& days) const;
+
+        /** The day after one step of the schedule, as nextOccurDate() does with dates */
+        static int next(int repeats, int num_occurrences, int day);
+
+        static int to_day(int year, int month, int mday);
+        static void from_day(int day, int& year, int& month, int& mday);
+        static int to_day(const wxString& iso_date);
+        static int to_day(const wxDateTime& date);
+        static const wxString to_iso(int day);
+        static const wxDateTime to_date(int day);
+
+    private:
+        enum KIND { DAYS = 0, MONTHS, LAST_DAY, LAST_BUSINESS_DAY };
+        static void step_kind(int repeats, int num_occurrences, KIND& kind, int& every);
+        static int add_months(int day, int months);
+        static int month_end(int month_index, bool business_day);
+        /** The occurrence k steps after the first, in constant time when the schedule allows */
+        int occurrence(int k) const;
+        /** The index of the first occurrence on or after day, for schedules that jump */
+        int index_from(int day) const;
+        bool jumps() const;
+
+        KIND kind_;
+        int every_;
+        int count_;
+        int first_;
+    };
 };
 
 #endif // 
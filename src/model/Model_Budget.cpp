@@ -39,7 +39,7 @@ Model_Budget& Model_Budget::instance(wxSQLite3Database* db)
     Model_Budget& ins = Singleton<Model_Budget>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
     
     return ins;
 }
@@ -0,0 +1,325 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "Model_BudgetActual.h"
+#include "Model_Account.h"
+#include "Model_Checking.h"
+#include "Model_CurrencyHistory.h"
+#include "Model_Translink.h"
+#include "option.h"
+#include <algorithm>
+#include <wx/log.h>
+
+namespace
+{
+    const wxString TRANS_QUERY = "SELECT TRANSID, ACCOUNTID, TOACCOUNTID, TRANSCODE, STATUS"
+        ", TRANSAMOUNT, TOTRANSAMOUNT, CATEGID, SUBCATEGID, TRANSDATE FROM CHECKINGACCOUNT_V1";
+    const wxString SPLIT_QUERY = "SELECT SPLITTRANSID, TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT"
+        " FROM SPLITTRANSACTIONS_V1";
+
+    struct Split
+    {
+        int categ_id;
+        int subcateg_id;
+        double amount;
+    };
+
+    /** yyyymmdd of an ISO date, 0 if it is not one */
+    int day_key(const wxString& date)
+    {
+        long y = 0, m = 0, d = 0;
+        if (date.length() < 10 || !date.Mid(0, 4).ToLong(&y) || !date.Mid(5, 2).ToLong(&m) || !date.Mid(8, 2).ToLong(&d))
+            return 0;
+        return static_cast<int>(y * 10000 + m * 100 + d);
+    }
+
+    int day_key(const wxDate& date)
+    {
+        return date.GetYear() * 10000 + (date.GetMonth() + 1) * 100 + date.GetDay();
+    }
+
+    void add(Model_BudgetActual::Sums& to, const Model_BudgetActual::Sums& from)
+    {
+        for (const auto& item : from)
+        {
+            Model_BudgetActual::Totals& t = to[item.first];
+            t.actual += item.second.actual;
+            t.transfer += item.second.transfer;
+        }
+    }
+
+    const wxString in_list(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end)
+    {
+        wxString list;
+        for (auto it = begin; it != end; ++it)
+            list += (list.empty() ? "" : ",") + wxString::Format("%i", *it);
+        return " WHERE TRANSID IN (" + list + ")";
+    }
+}
+
+Model_BudgetActual::Totals::Totals()
+    : actual(0), transfer(0)
+{
+}
+
+Model_BudgetActual::Entry::Entry()
+    : day(0)
+{
+}
+
+Model_BudgetActual::Model_BudgetActual()
+    : m_db(nullptr)
+    , m_loaded(false)
+    , m_history_enabled(false)
+    , m_base_currency_id(-1)
+{
+}
+
+Model_BudgetActual::~Model_BudgetActual()
+{
+}
+
+Model_BudgetActual& Model_BudgetActual::instance(wxSQLite3Database* db)
+{
+    Model_BudgetActual& ins = Singleton<Model_BudgetActual>::instance();
+    ins.m_db = db;
+    ins.reset();
+
+    return ins;
+}
+
+Model_BudgetActual& Model_BudgetActual::instance()
+{
+    return Singleton<Model_BudgetActual>::instance();
+}
+
+const Model_BudgetActual::Sums Model_BudgetActual::totals(const wxDate& begin, const wxDate& end)
+{
+    // the rates of the loaded amounts depend on the currency options
+    const Model_Currency::Data* base = Model_Currency::GetBaseCurrency();
+    if (!m_loaded || m_history_enabled != Option::instance().getCurrencyHistoryEnabled()
+        || m_base_currency_id != (base ? base->CURRENCYID : -1))
+        load();
+    else if (!m_dirty.empty() || !m_dirty_splits.empty())
+        refresh();
+
+    const int first = day_key(begin), last = day_key(end);
+    Sums sums;
+    for (auto month = m_months.lower_bound(first / 100); month != m_months.end() && month->first <= last / 100; ++month)
+    {
+        const int month_first = month->first * 100 + 1, month_last = month->first * 100 + 31;
+        if (month_first >= first && month_last <= last)
+        {
+            add(sums, month->second);
+            continue;
+        }
+        // the period starts or ends inside the month
+        const int to = std::min(last, month_last);
+        for (auto day = m_days.lower_bound(std::max(first, month_first)); day != m_days.end() && day->first <= to; ++day)
+            add(sums, day->second);
+    }
+    return sums;
+}
+
+double Model_BudgetActual::actual(const Sums& sums, int categ_id, int subcateg_id, bool with_transfers, double budget_amount)
+{
+    const auto it = sums.find(std::make_pair(categ_id, subcateg_id));
+    if (it == sums.end()) return 0.0;
+    if (!with_transfers) return it->second.actual;
+    return it->second.actual + (budget_amount < 0 ? -it->second.transfer : it->second.transfer);
+}
+
+void Model_BudgetActual::touch(const wxString& table, wxLongLong rowid)
+{
+    if (!m_loaded) return;
+
+    if (table == "CHECKINGACCOUNT_V1")
+        m_dirty.insert(rowid.ToLong());
+    else if (table == "SPLITTRANSACTIONS_V1")
+        m_dirty_splits.insert(rowid.ToLong());
+    else if (table == "ACCOUNTLIST_V1" || table == "CURRENCYFORMATS_V1"
+        || table == "CURRENCYHISTORY_V1" || table == "TRANSLINK_V1")
+        reset();
+}
+
+void Model_BudgetActual::reset()
+{
+    m_loaded = false;
+    m_entries.clear();
+    m_split_owner.clear();
+    m_months.clear();
+    m_days.clear();
+    m_dirty.clear();
+    m_dirty_splits.clear();
+}
+
+void Model_BudgetActual::load()
+{
+    reset();
+    if (!m_db) return;
+
+    const Model_Currency::Data* base = Model_Currency::GetBaseCurrency();
+    m_history_enabled = Option::instance().getCurrencyHistoryEnabled();
+    m_base_currency_id = base ? base->CURRENCYID : -1;
+    if (!read("", m_entries)) return;
+
+    for (const auto& item : m_entries)
+        apply(item.second, 1);
+    m_loaded = true;
+}
+
+void Model_BudgetActual::refresh()
+{
+    // a changed split refreshes the transaction it belonged to and the one it belongs to now
+    if (!m_dirty_splits.empty())
+    {
+        std::vector<int> splits(m_dirty_splits.begin(), m_dirty_splits.end());
+        m_dirty_splits.clear();
+        wxString list;
+        for (int id : splits)
+        {
+            const auto it = m_split_owner.find(id);
+            if (it != m_split_owner.end())
+                m_dirty.insert(it->second);
+            list += (list.empty() ? "" : ",") + wxString::Format("%i", id);
+        }
+        try
+        {
+            wxSQLite3ResultSet q = m_db->ExecuteQuery("SELECT TRANSID FROM SPLITTRANSACTIONS_V1 WHERE SPLITTRANSID IN (" + list + ")");
+            while (q.NextRow())
+                m_dirty.insert(q.GetInt(0));
+            q.Finalize();
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("Model_BudgetActual: Exception %s", e.GetMessage().utf8_str());
+            m_loaded = false;
+            return;
+        }
+    }
+
+    std::vector<int> ids(m_dirty.begin(), m_dirty.end());
+    m_dirty.clear();
+    for (int id : ids)
+    {
+        const auto it = m_entries.find(id);
+        if (it == m_entries.end()) continue;
+        apply(it->second, -1);
+        m_entries.erase(it);
+    }
+
+    const size_t chunk = 500;
+    for (size_t i = 0; i < ids.size(); i += chunk)
+    {
+        std::unordered_map<int, Entry> entries;
+        if (!read(in_list(ids.begin() + i, ids.begin() + std::min(ids.size(), i + chunk)), entries))
+        {
+            m_loaded = false;
+            return;
+        }
+        for (const auto& item : entries)
+        {
+            apply(item.second, 1);
+            m_entries[item.first] = item.second;
+        }
+    }
+}
+
+bool Model_BudgetActual::read(const wxString& where, std::unordered_map<int, Entry>& entries)
+{
+    try
+    {
+        std::unordered_map<int, std::vector<Split> > splits;
+        wxSQLite3ResultSet q = m_db->ExecuteQuery(SPLIT_QUERY + where);
+        while (q.NextRow())
+        {
+            const Split s = { q.GetInt(2), q.GetInt(3), q.GetDouble(4) };
+            splits[q.GetInt(1)].push_back(s);
+            m_split_owner[q.GetInt(0)] = q.GetInt(1);
+        }
+        q.Finalize();
+
+        q = m_db->ExecuteQuery(TRANS_QUERY + where);
+        while (q.NextRow())
+        {
+            Entry& e = entries[q.GetInt(0)];
+            const wxString date = q.GetString(9);
+            e.day = day_key(date);
+            if (Model_Checking::status(q.GetString(4)) == Model_Checking::VOID_)
+                continue;
+
+            const wxString code = q.GetString(3);
+            const Model_Checking::TYPE type = Model_Checking::type(code);
+            const Model_Account::Data* account = Model_Account::instance().get(q.GetInt(1));
+            const double rate = Model_CurrencyHistory::getDayRate(account ? account->CURRENCYID : -1, date);
+            const double amount = q.GetDouble(5);
+            const int to_account_id = q.GetInt(2);
+            const int categ_id = q.GetInt(7);
+
+            if (categ_id > -1)
+            {
+                Part part = { std::make_pair(categ_id, q.GetInt(8)), amount * rate, type == Model_Checking::TRANSFER };
+                if (type != Model_Checking::TRANSFER)
+                {
+                    // asset and stock transfers are not income or expenses, as Model_Checking::foreignTransactionAsTransfer
+                    if (to_account_id == Model_Translink::AS_TRANSFER && (code == Model_Checking::all_type()[Model_Checking::DEPOSIT]
+                        || code == Model_Checking::all_type()[Model_Checking::WITHDRAWAL]))
+                        continue;
+                    if (type == Model_Checking::WITHDRAWAL) part.amount = -part.amount;
+                }
+                e.parts.push_back(part);
+            }
+            else
+            {
+                // the sign of the transaction as seen by no account, as Model_Checking::balance(r)
+                const double balance = type == Model_Checking::WITHDRAWAL ? -amount
+                    : type == Model_Checking::DEPOSIT ? amount
+                    : type == Model_Checking::TRANSFER ? q.GetDouble(6) : 0.0;
+                const int sign = balance < 0 ? -1 : 1;
+                for (const auto& s : splits[q.GetInt(0)])
+                {
+                    const Part part = { std::make_pair(s.categ_id, s.subcateg_id), s.amount * rate * sign, false };
+                    e.parts.push_back(part);
+                }
+            }
+        }
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_BudgetActual: Exception %s", e.GetMessage().utf8_str());
+        return false;
+    }
+    return true;
+}
+
+void Model_BudgetActual::apply(const Entry& entry, int sign)
+{
+    if (entry.parts.empty()) return;
+
+    Sums& month = m_months[entry.day / 100];
+    Sums& day = m_days[entry.day];
+    for (const auto& part : entry.parts)
+    {
+        const double value = sign * part.amount;
+        Totals& m = month[part.key];
+        Totals& d = day[part.key];
+        (part.transfer ? m.transfer : m.actual) += value;
+        (part.transfer ? d.transfer : d.actual) += value;
+    }
+}
@@ -0,0 +1,117 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MODEL_BUDGETACTUAL_H
+#define MODEL_BUDGETACTUAL_H
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <wx/datetime.h>
+#include <wx/longlong.h>
+#include <wx/string.h>
+#include "singleton.h"
+
+class wxSQLite3Database;
+
+/**
+* Actual amounts of the budget, per category, subcategory and month, in the
+* base currency, with the rules of Model_Category::getCategoryStats.
+* The totals are built in one pass over CHECKINGACCOUNT_V1 and
+* SPLITTRANSACTIONS_V1. Later edits are reported by the SQLite update hook,
+* the changed transactions are taken out and added again on the next read,
+* so the budget panel does not scan the ledger when it opens or after an
+* estimate is edited.
+* A period starting or ending inside a month is summed by day for that month.
+*/
+class Model_BudgetActual
+{
+public:
+    struct Totals
+    {
+        Totals();
+        double actual;      // income and expenses, splits included
+        double transfer;    // transfers with a category, counted only if the budget includes them
+    };
+    typedef std::pair<int /*category*/, int /*subcategory*/> Key;
+    typedef std::map<Key, Totals> Sums;
+
+    /** Contribution of one transaction to one category */
+    struct Part
+    {
+        Key key;
+        double amount;
+        bool transfer;
+    };
+
+    struct Entry
+    {
+        Entry();
+        int day;            // yyyymmdd
+        std::vector<Part> parts;
+    };
+
+public:
+    Model_BudgetActual();
+    ~Model_BudgetActual();
+
+    /**
+    Initialize the global budget totals for the database.
+    * Return the static instance address for Model_BudgetActual
+    */
+    static Model_BudgetActual& instance(wxSQLite3Database* db);
+    static Model_BudgetActual& instance();
+
+public:
+    /** Return the totals of the transactions dated from begin to end, both included */
+    const Sums totals(const wxDate& begin, const wxDate& end);
+
+    /**
+    * Return the actual amount of the category as getCategoryStats does,
+    * a transfer adds to a budget of income and subtracts from one of expenses.
+    */
+    static double actual(const Sums& sums, int categ_id, int subcateg_id, bool with_transfers, double budget_amount);
+
+    /** Record a change reported by the SQLite update hook. Does not touch the database. */
+    void touch(const wxString& table, wxLongLong rowid);
+
+    /** Drop the totals, they are rebuilt on the next read */
+    void reset();
+
+private:
+    void load();
+    void refresh();
+    bool read(const wxString& where, std::unordered_map<int, Entry>& entries);
+    void apply(const Entry& entry, int sign);
+
+private:
+    wxSQLite3Database* m_db;
+    bool m_loaded;
+    bool m_history_enabled;     // the rates depend on these options
+    int m_base_currency_id;
+    std::unordered_map<int, Entry> m_entries;
+    std::unordered_map<int, int> m_split_owner;    // split id, transaction id
+    std::map<int /*yyyymm*/, Sums> m_months;
+    std::map<int /*yyyymmdd*/, Sums> m_days;
+    std::set<int> m_dirty;
+    std::set<int> m_dirty_splits;
+};
+
+#endif // MODEL_BUDGETACTUAL_H
@@ -36,7 +36,7 @@ Model_Budgetsplittransaction& Model_Budgetsplittransaction::instance(wxSQLite3Da
     Model_Budgetsplittransaction& ins = Singleton<Model_Budgetsplittransaction>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
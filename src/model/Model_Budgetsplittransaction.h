@@ -25,6 +25,8 @@
 class Model_Budgetsplittransaction : public Model<DB_Table_BUDGETSPLITTRANSACTIONS_V1>
 {
 public:
+    using Model<DB_Table_BUDGETSPLITTRANSACTIONS_V1>::update;
+
     Model_Budgetsplittransaction();
     ~Model_Budgetsplittransaction();
 
@@ -37,7 +37,7 @@ Model_Budgetyear& Model_Budgetyear::instance(wxSQLite3Database* db)
     Model_Budgetyear& ins = Singleton<Model_Budgetyear>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -21,6 +21,7 @@
 #include "Model_Billsdeposits.h"
 #include "Model_Account.h"
 #include "Model_CurrencyHistory.h"
+#include "Model_NameTable.h"
 #include "reports/mmDateRange.h"
 #include <tuple>
 
@@ -40,9 +41,8 @@ Model_Category& Model_Category::instance(wxSQLite3Database* db)
 {
     Model_Category& ins = Singleton<Model_Category>::instance();
     ins.db_ = db;
-    ins.ensure(db);
     ins.destroy_cache();
-    ins.preload();
+    ins.ensure_lazy(db, true);
 
     return ins;
 }
@@ -99,9 +99,8 @@ const wxString Model_Category::full_name(const Data* category, const Model_Subca
 
 const wxString Model_Category::full_name(const int category_id, const int subcategory_id)
 {
-    Data* category = Model_Category::instance().get(category_id);
-    Model_Subcategory::Data* sub_category = Model_Subcategory::instance().get(subcategory_id);
-    return full_name(category, sub_category);
+    Model_NameTable& names = Model_NameTable::instance();
+    return names.name(names.category(category_id, subcategory_id));
 }
 
 bool Model_Category::is_used(int id, int sub_id)
@@ -21,7 +21,7 @@
 #include "Model_Account.h"
 #include "Model_Payee.h"
 #include "Model_Category.h"
-#include <queue>
+#include "Model_Completion.h"
 #include "Model_Translink.h"
 
 const std::vector<std::pair<Model_Checking::TYPE, wxString> > Model_Checking::TYPE_CHOICES =
@@ -73,7 +73,7 @@ Model_Checking& Model_Checking::instance(wxSQLite3Database* db)
     Model_Checking& ins = Singleton<Model_Checking>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -86,10 +86,7 @@ Model_Checking& Model_Checking::instance()
 
 bool Model_Checking::remove(int id)
 {
-    //TODO: remove all split at once
-    //Model_Splittransaction::instance().remove(Model_Splittransaction::instance().find(Model_Splittransaction::TRANSID(id)));
-    for (const auto& r : Model_Splittransaction::instance().find(Model_Splittransaction::TRANSID(id)))
-        Model_Splittransaction::instance().remove(r.SPLITTRANSID);
+    Model_Splittransaction::instance().remove_where(Model_Splittransaction::TRANSID(id));
     return this->remove(id, db_);
 }
 
@@ -291,27 +288,28 @@ Model_Checking::Full_Data::Full_Data() : Data(0), BALANCE(0), AMOUNT(0)
 Model_Checking::Full_Data::Full_Data(const Data& r) : Data(r), BALANCE(0), AMOUNT(0)
 , m_splits(Model_Splittransaction::instance().find(Model_Splittransaction::TRANSID(r.TRANSID)))
 {
-    ACCOUNTNAME = Model_Account::get_account_name(r.ACCOUNTID);
+    Model_NameTable& names = Model_NameTable::instance();
+    ACCOUNTNAME = Model_NameTable::name(names.account(r.ACCOUNTID));
 
     if (Model_Checking::type(r) == Model_Checking::TRANSFER)
     {
-        TOACCOUNTNAME = Model_Account::get_account_name(r.TOACCOUNTID);
+        TOACCOUNTNAME = Model_NameTable::name(names.account(r.TOACCOUNTID));
         PAYEENAME = TOACCOUNTNAME;
     }
     else
     {
-        PAYEENAME = Model_Payee::get_payee_name(r.PAYEEID);
+        PAYEENAME = Model_NameTable::name(names.payee(r.PAYEEID));
     }
 
     if (!m_splits.empty())
     {
         for (const auto& entry : m_splits)
             this->CATEGNAME += (this->CATEGNAME.empty() ? " * " : ", ")
-            + Model_Category::full_name(entry.CATEGID, entry.SUBCATEGID);
+            + Model_NameTable::name(names.category(entry.CATEGID, entry.SUBCATEGID));
     }
     else
     {
-        this->CATEGNAME = Model_Category::instance().full_name(r.CATEGID, r.SUBCATEGID);
+        this->CATEGNAME = Model_NameTable::name(names.category(r.CATEGID, r.SUBCATEGID));
     }
 }
 
@@ -322,26 +320,27 @@ Model_Checking::Full_Data::Full_Data(const Data& r
     const auto it = splits.find(this->id());
     if (it != splits.end()) m_splits = it->second;
 
-    ACCOUNTNAME = Model_Account::get_account_name(r.ACCOUNTID);
+    Model_NameTable& names = Model_NameTable::instance();
+    ACCOUNTNAME = Model_NameTable::name(names.account(r.ACCOUNTID));
     if (Model_Checking::type(r) == Model_Checking::TRANSFER)
     {
-        TOACCOUNTNAME = Model_Account::get_account_name(r.TOACCOUNTID);
+        TOACCOUNTNAME = Model_NameTable::name(names.account(r.TOACCOUNTID));
         PAYEENAME = TOACCOUNTNAME;
     }
     else
     {
-        PAYEENAME = Model_Payee::get_payee_name(r.PAYEEID);
+        PAYEENAME = Model_NameTable::name(names.payee(r.PAYEEID));
     }
 
     if (!m_splits.empty())
     {
         for (const auto& entry : m_splits)
             this->CATEGNAME += (this->CATEGNAME.empty() ? " * " : ", ")
-            + Model_Category::full_name(entry.CATEGID, entry.SUBCATEGID);
+            + Model_NameTable::name(names.category(entry.CATEGID, entry.SUBCATEGID));
     }
     else
     {
-        CATEGNAME = Model_Category::full_name(r.CATEGID, r.SUBCATEGID);
+        CATEGNAME = Model_NameTable::name(names.category(r.CATEGID, r.SUBCATEGID));
     }
 }
 
@@ -385,31 +384,77 @@ wxString Model_Checking::Full_Data::info() const
     return info;
 }
 
-void Model_Checking::getFrequentUsedNotes(std::vector<wxString> &frequentNotes, int accountID)
+Model_Checking::Row_View::Row_View(Data* r, int account_id, const Split_Data_Set* splits)
+    : m_data(r)
+    , m_splits(splits && !splits->empty() ? splits : nullptr)
+    , m_to_account(nullptr)
+    , m_payee(nullptr)
+    , m_category(nullptr)
+    , m_account_id(account_id)
+    , AMOUNT(0)
+    , BALANCE(0)
+    , m_has_attachment(false)
 {
-    frequentNotes.clear();
-    size_t max = 20;
+    Model_NameTable& names = Model_NameTable::instance();
+    m_account = names.account(r->ACCOUNTID);
+    if (Model_Checking::type(r) == Model_Checking::TRANSFER)
+        m_to_account = names.account(r->TOACCOUNTID);
+    else
+        m_payee = names.payee(r->PAYEEID);
 
-    const auto notes = instance().find(NOTES("", NOT_EQUAL)
-        , accountID > 0 ? ACCOUNTID(accountID) : ACCOUNTID(-1, NOT_EQUAL));
+    if (!m_splits)
+        m_category = names.category(r->CATEGID, r->SUBCATEGID);
+}
 
-    std::map <wxString, int> counterMap;
-    for (const auto& entry : notes)
-        counterMap[entry.NOTES]--;
+const wxString& Model_Checking::Row_View::ACCOUNTNAME() const
+{
+    return Model_NameTable::name(m_account);
+}
 
-    std::priority_queue<std::pair<int, wxString> > q; // largest element to appear as the top
-    for (const auto & kv : counterMap)
+wxString Model_Checking::Row_View::PAYEENAME() const
+{
+    if (m_to_account)
     {
-        q.push(std::make_pair(kv.second, kv.first));
-        if (q.size() > max) q.pop(); // keep fixed queue as max
+        if (m_data->ACCOUNTID == m_account_id || m_account_id == -1)
+            return "> " + Model_NameTable::name(m_to_account);
+        else
+            return "< " + Model_NameTable::name(m_account);
     }
 
-    while (!q.empty())
-    {
-        const auto & kv = q.top();
-        frequentNotes.push_back(kv.second);
-        q.pop();
-    }
+    return Model_NameTable::name(m_payee);
+}
+
+wxString Model_Checking::Row_View::CATEGNAME() const
+{
+    if (m_category) return Model_NameTable::name(m_category);
+
+    wxString name;
+    Model_NameTable& names = Model_NameTable::instance();
+    for (const auto& entry : *m_splits)
+        name += (name.empty() ? " * " : ", ")
+        + Model_NameTable::name(names.category(entry.CATEGID, entry.SUBCATEGID));
+    return name;
+}
+
+bool Model_Checking::Row_View::has_split() const
+{
+    return m_splits != nullptr;
+}
+
+bool Model_Checking::Row_View::is_foreign() const
+{
+    return Model_Checking::foreignTransaction(*m_data);
+}
+
+bool Model_Checking::Row_View::is_foreign_transfer() const
+{
+    return Model_Checking::foreignTransactionAsTransfer(*m_data);
+}
+
+void Model_Checking::getFrequentUsedNotes(std::vector<wxString> &frequentNotes, int accountID)
+{
+    // ranked by use and recency in the shared completion index
+    Model_Completion::instance().frequent_notes(frequentNotes, accountID > 0 ? accountID : -1);
 }
 
 void Model_Checking::getEmptyTransaction(Data &data, int accountID)
@@ -537,6 +582,44 @@ const wxString Model_Checking::Full_Data::to_json()
     return wxString::FromUTF8(json_buffer.GetString());
 }
 
+namespace
+{
+    /* wxString::Matches wildcards to a LIKE pattern, a backslash escapes the LIKE metacharacters */
+    const wxString wildcard_to_like(const wxString& mask)
+    {
+        wxString like;
+        for (const auto& c : mask)
+        {
+            if (c == '%' || c == '_' || c == '\\')
+                like << '\\' << c;
+            else if (c == '*')
+                like << '%';
+            else if (c == '?')
+                like << '_';
+            else
+                like << c;
+        }
+        return like;
+    }
+}
+
+const wxString Model_Checking::text_condition(const wxString& column, const wxString& mask
+    , std::vector<wxVariant>& params, bool& exact)
+{
+    // Same rule as mmFilterTransactionsDialog::checkAll: an empty mask matches empty text only
+    if (mask.empty())
+        return wxString::Format("coalesce(%s, '') = ''", column);
+
+    // LIKE folds the case of ASCII letters only, a non-ASCII mask is left to the caller
+    if (!mask.IsAscii())
+    {
+        exact = false;
+        return wxString::Format("coalesce(%s, '') != ''", column);
+    }
+    params.push_back(wildcard_to_like(mask));
+    return wxString::Format("(coalesce(%s, '') != '' AND %s LIKE ? ESCAPE '\\')", column, column);
+}
+
 bool Model_Checking::foreignTransaction(const Data& data)
 {
     return (data.TOACCOUNTID > 0) && ((data.TRANSCODE == all_type()[DEPOSIT]) || (data.TRANSCODE == all_type()[WITHDRAWAL]));
@@ -22,6 +22,7 @@
 #include "Model.h"
 #include "db/DB_Table_Checkingaccount_V1.h"
 #include "Model_Splittransaction.h"
+#include "Model_NameTable.h"
 
 class Model_Checking : public Model<DB_Table_CHECKINGACCOUNT_V1>
 {
@@ -62,6 +63,38 @@ public:
     };
     typedef std::vector<Full_Data> Full_Data_Set;
 
+    /**
+    * Lightweight view of a transaction row for virtual list controls.
+    * Refers to a Data record owned by the caller and to interned names,
+    * display strings are built only when a row is shown.
+    */
+    struct Row_View
+    {
+        Row_View(Data* r, int account_id, const Split_Data_Set* splits = nullptr);
+
+        Data* operator->() const { return m_data; }
+        Data& operator*() const { return *m_data; }
+
+        const wxString& ACCOUNTNAME() const;
+        wxString PAYEENAME() const;
+        wxString CATEGNAME() const;
+        bool has_split() const;
+        bool is_foreign() const;
+        bool is_foreign_transfer() const;
+
+        Data* m_data;
+        const Split_Data_Set* m_splits;
+        const Model_NameTable::Entry* m_account;
+        const Model_NameTable::Entry* m_to_account;
+        const Model_NameTable::Entry* m_payee;
+        const Model_NameTable::Entry* m_category;
+        int m_account_id;
+        double AMOUNT;
+        double BALANCE;
+        bool m_has_attachment;
+    };
+    typedef std::vector<Row_View> Row_View_Set;
+
     struct SorterByBALANCE
     { 
         template<class DATA>
@@ -161,6 +194,13 @@ public:
     static void putDataToTransaction(Data *r, const Data &data);
     static bool foreignTransaction(const Data& data);
     static bool foreignTransactionAsTransfer(const Data& data);
+    /**
+    The condition on a text column for a wildcard mask in lower case, the placeholder
+    value is appended to params. exact is cleared when the condition only narrows
+    the rows and the caller has to match them with wxString::Matches.
+    */
+    static const wxString text_condition(const wxString& column, const wxString& mask
+        , std::vector<wxVariant>& params, bool& exact);
 };
 
 #endif // 
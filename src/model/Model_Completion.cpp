@@ -0,0 +1,407 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "Model_Completion.h"
+#include "Model_Checking.h"
+#include "mmstartuptrace.h"
+#include <algorithm>
+#include <wx/log.h>
+#include <wx/wxsqlite3.h>
+
+namespace
+{
+    const int RECENT_DAYS = 90;
+
+    bool by_key(const Model_Completion::Entry& x, const Model_Completion::Entry& y)
+    {
+        return x.key < y.key;
+    }
+
+    bool by_rank(const Model_Completion::Entry* x, const Model_Completion::Entry* y)
+    {
+        if (x->score() != y->score()) return x->score() > y->score();
+        if (x->last != y->last) return x->last > y->last;
+        return x->key < y->key;
+    }
+
+    Model_Completion::Entry make_entry(const wxString& text, int id)
+    {
+        Model_Completion::Entry e;
+        e.key = text.Lower();
+        e.text = text;
+        e.id = id;
+        e.uses = 0;
+        e.recent = 0;
+        return e;
+    }
+}
+
+void Model_Completion::Index::clear()
+{
+    m_entries.clear();
+}
+
+Model_Completion::Index::Range Model_Completion::Index::all() const
+{
+    return Range(0, m_entries.size());
+}
+
+Model_Completion::Index::Range Model_Completion::Index::range(const wxString& prefix, const Range& within) const
+{
+    const wxString key = prefix.Lower();
+    const auto begin = m_entries.begin() + std::min(within.first, m_entries.size());
+    const auto end = m_entries.begin() + std::min(within.second, m_entries.size());
+
+    const auto lo = std::lower_bound(begin, end, make_entry(prefix, -1), by_key);
+    // the keys starting with the prefix follow each other from lo on
+    const auto hi = std::partition_point(lo, end, [&key](const Entry& e)
+    {
+        return e.key.compare(0, key.length(), key) == 0;
+    });
+    return Range(lo - m_entries.begin(), hi - m_entries.begin());
+}
+
+std::vector<const Model_Completion::Entry*> Model_Completion::Index::top(const Range& r, size_t max) const
+{
+    std::vector<const Entry*> result;
+    for (size_t i = r.first; i < r.second && i < m_entries.size(); i++)
+        result.push_back(&m_entries[i]);
+
+    const size_t n = std::min(max, result.size());
+    std::partial_sort(result.begin(), result.begin() + n, result.end(), by_rank);
+    result.resize(n);
+    return result;
+}
+
+void Model_Completion::Index::build(std::vector<Entry>& entries)
+{
+    m_entries.swap(entries);
+    std::sort(m_entries.begin(), m_entries.end(), by_key);
+}
+
+Model_Completion::Entry& Model_Completion::Index::add(const wxString& text, int id)
+{
+    const Entry e = make_entry(text, id);
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), e, by_key);
+    for (auto same = it; same != m_entries.end() && same->key == e.key; ++same)
+    {
+        if (same->id == id && same->text == text) return *same;
+    }
+    return *m_entries.insert(it, e);
+}
+
+void Model_Completion::Index::use(Entry& e, int uses, int recent, const wxString& last)
+{
+    e.uses += uses;
+    e.recent += recent;
+    if (last > e.last) e.last = last;
+}
+
+void Model_Completion::Index::texts(wxArrayString& out) const
+{
+    for (const auto& e : m_entries)
+        out.Add(e.text);
+}
+
+size_t Model_Completion::Index::size() const
+{
+    return m_entries.size();
+}
+
+Model_Completion::PayeeCompleter::PayeeCompleter(size_t max)
+    : m_max(max), m_next(0), m_generation(0)
+{
+}
+
+bool Model_Completion::PayeeCompleter::Start(const wxString& prefix)
+{
+    Model_Completion& completion = Model_Completion::instance();
+    const Index& index = completion.payee_index();
+
+    // a longer prefix can only narrow the range of the previous keystroke
+    Index::Range within = index.all();
+    if (m_generation == completion.generation() && !m_prefix.empty()
+        && prefix.Lower().StartsWith(m_prefix.Lower()))
+    {
+        within = m_range;
+    }
+    m_range = index.range(prefix, within);
+    m_prefix = prefix;
+    m_generation = completion.generation();
+
+    m_results.clear();
+    for (const auto e : index.top(m_range, m_max))
+        m_results.push_back(e->text);
+    m_next = 0;
+    return !m_results.empty();
+}
+
+wxString Model_Completion::PayeeCompleter::GetNext()
+{
+    return m_next < m_results.size() ? m_results[m_next++] : wxString();
+}
+
+Model_Completion::Model_Completion()
+    : m_db(nullptr)
+    , m_loaded(false)
+    , m_payees_dirty(false)
+    , m_has_new(false)
+    , m_max_transid(0)
+    , m_generation(0)
+{
+}
+
+Model_Completion::~Model_Completion()
+{
+}
+
+Model_Completion& Model_Completion::instance(wxSQLite3Database* db)
+{
+    Model_Completion& ins = Singleton<Model_Completion>::instance();
+    ins.m_db = db;
+    ins.reset();
+
+    return ins;
+}
+
+Model_Completion& Model_Completion::instance()
+{
+    return Singleton<Model_Completion>::instance();
+}
+
+std::vector<wxString> Model_Completion::payees(const wxString& prefix, size_t max)
+{
+    const Index& index = payee_index();
+    std::vector<wxString> result;
+    for (const auto e : index.top(index.range(prefix, index.all()), max))
+        result.push_back(e->text);
+    return result;
+}
+
+const wxArrayString& Model_Completion::payee_names()
+{
+    payee_index();
+    return m_payee_names;
+}
+
+int Model_Completion::last_payee(int account_id)
+{
+    payee_index();
+    const auto it = m_last_payee.find(account_id);
+    return it != m_last_payee.end() ? it->second.second : -1;
+}
+
+void Model_Completion::frequent_notes(std::vector<wxString>& notes, int account_id, size_t max)
+{
+    notes.clear();
+    payee_index();
+    const auto it = m_notes.find(account_id);
+    if (it == m_notes.end()) return;
+
+    for (const auto e : it->second.top(it->second.all(), max))
+        notes.push_back(e->text);
+}
+
+void Model_Completion::touch(const wxString& table, wxLongLong rowid)
+{
+    if (!m_loaded) return;
+
+    if (table == "CHECKINGACCOUNT_V1")
+    {
+        // new rows are counted on the next read, an edit or a delete may change any count
+        if (rowid > m_max_transid)
+            m_has_new = true;
+        else
+            m_loaded = false;
+    }
+    else if (table == "PAYEE_V1")
+        m_payees_dirty = true;
+}
+
+void Model_Completion::reset()
+{
+    m_loaded = false;
+    m_payees_dirty = false;
+    m_has_new = false;
+    m_max_transid = 0;
+    m_payees.clear();
+    m_payee_names.clear();
+    m_notes.clear();
+    m_last_payee.clear();
+    m_generation++;
+}
+
+size_t Model_Completion::generation() const
+{
+    return m_generation;
+}
+
+const Model_Completion::Index& Model_Completion::payee_index()
+{
+    if (!m_loaded)
+        load();
+    if (m_has_new)
+        load_new_transactions();
+    if (m_payees_dirty)
+        load_payees();
+    return m_payees;
+}
+
+void Model_Completion::load()
+{
+    mmStartupTrace::Scope trace("COMPLETION", "model");
+    reset();
+    if (!m_db) return;
+
+    m_recent_date = wxDate::Today().Subtract(wxDateSpan::Days(RECENT_DAYS)).FormatISODate();
+    load_payees();
+    try
+    {
+        wxSQLite3Statement stmt = m_db->PrepareStatement("SELECT ACCOUNTID, NOTES, COUNT(*), SUM(TRANSDATE >= ?), MAX(TRANSDATE)"
+            " FROM CHECKINGACCOUNT_V1 WHERE NOTES <> '' GROUP BY ACCOUNTID, NOTES");
+        stmt.Bind(1, m_recent_date);
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        std::map<int, std::vector<Entry> > notes;
+        std::map<wxString, Entry> all_notes;
+        while (q.NextRow())
+        {
+            Entry e = make_entry(q.GetString(1), -1);
+            e.uses = q.GetInt(2);
+            e.recent = q.GetInt(3);
+            e.last = q.GetString(4);
+            notes[q.GetInt(0)].push_back(e);
+
+            auto it = all_notes.find(e.text);
+            if (it == all_notes.end())
+                all_notes.insert(std::make_pair(e.text, e));
+            else
+                Index::use(it->second, e.uses, e.recent, e.last);
+        }
+        q.Finalize();
+
+        for (auto& item : notes)
+            m_notes[item.first].build(item.second);
+        std::vector<Entry> entries;
+        for (const auto& item : all_notes)
+            entries.push_back(item.second);
+        m_notes[-1].build(entries);
+
+        // the last transaction up to today of each account, as the default payee of a new one
+        stmt = m_db->PrepareStatement("SELECT ACCOUNTID, MAX(TRANSID), PAYEEID FROM CHECKINGACCOUNT_V1"
+            " WHERE TRANSCODE <> ? AND TRANSDATE <= ? GROUP BY ACCOUNTID");
+        stmt.Bind(1, Model_Checking::all_type()[Model_Checking::TRANSFER]);
+        stmt.Bind(2, wxDate::Today().FormatISODate());
+        q = stmt.ExecuteQuery();
+        while (q.NextRow())
+            m_last_payee[q.GetInt(0)] = std::make_pair(q.GetInt(1), q.GetInt(2));
+        q.Finalize();
+
+        q = m_db->ExecuteQuery("SELECT MAX(TRANSID) FROM CHECKINGACCOUNT_V1");
+        if (q.NextRow())
+            m_max_transid = q.GetInt(0);
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_Completion: Exception %s", e.GetMessage().utf8_str());
+        return;
+    }
+    m_loaded = true;
+}
+
+void Model_Completion::load_payees()
+{
+    m_payees_dirty = false;
+    m_generation++;
+    std::vector<Entry> entries;
+    try
+    {
+        wxSQLite3Statement stmt = m_db->PrepareStatement("SELECT P.PAYEEID, P.PAYEENAME, COUNT(C.TRANSID)"
+            ", SUM(C.TRANSDATE >= ?), MAX(C.TRANSDATE) FROM PAYEE_V1 P"
+            " LEFT JOIN CHECKINGACCOUNT_V1 C ON C.PAYEEID = P.PAYEEID AND C.TRANSCODE <> ?"
+            " GROUP BY P.PAYEEID");
+        stmt.Bind(1, m_recent_date);
+        stmt.Bind(2, Model_Checking::all_type()[Model_Checking::TRANSFER]);
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        while (q.NextRow())
+        {
+            Entry e = make_entry(q.GetString(1), q.GetInt(0));
+            e.uses = q.GetInt(2);
+            e.recent = q.GetInt(3);
+            e.last = q.GetString(4);
+            entries.push_back(e);
+        }
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_Completion: Exception %s", e.GetMessage().utf8_str());
+    }
+
+    m_payees.build(entries);
+    m_payee_names.clear();
+    m_payees.texts(m_payee_names);
+}
+
+void Model_Completion::load_new_transactions()
+{
+    m_has_new = false;
+    const wxString today = wxDate::Today().FormatISODate();
+    const wxString transfer = Model_Checking::all_type()[Model_Checking::TRANSFER];
+    try
+    {
+        wxSQLite3Statement stmt = m_db->PrepareStatement("SELECT C.TRANSID, C.ACCOUNTID, C.PAYEEID, C.TRANSCODE"
+            ", C.NOTES, C.TRANSDATE, P.PAYEENAME FROM CHECKINGACCOUNT_V1 C"
+            " LEFT JOIN PAYEE_V1 P ON P.PAYEEID = C.PAYEEID WHERE C.TRANSID > ?");
+        stmt.Bind(1, m_max_transid);
+        wxSQLite3ResultSet q = stmt.ExecuteQuery();
+        while (q.NextRow())
+        {
+            const int transid = q.GetInt(0);
+            const int account_id = q.GetInt(1);
+            const wxString date = q.GetString(5);
+            const int recent = date >= m_recent_date ? 1 : 0;
+            m_max_transid = std::max(m_max_transid, transid);
+
+            if (q.GetString(3) != transfer)
+            {
+                if (!q.IsNull(6))
+                {
+                    const size_t size = m_payees.size();
+                    Index::use(m_payees.add(q.GetString(6), q.GetInt(2)), 1, recent, date);
+                    if (m_payees.size() != size) m_payees_dirty = true;
+                }
+                auto& last = m_last_payee[account_id];
+                if (date <= today && transid > last.first)
+                    last = std::make_pair(transid, q.GetInt(2));
+            }
+
+            const wxString notes = q.GetString(4);
+            if (!notes.empty())
+            {
+                Index::use(m_notes[account_id].add(notes, -1), 1, recent, date);
+                Index::use(m_notes[-1].add(notes, -1), 1, recent, date);
+            }
+        }
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_Completion: Exception %s", e.GetMessage().utf8_str());
+    }
+}
@@ -0,0 +1,144 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MODEL_COMPLETION_H
+#define MODEL_COMPLETION_H
+
+#include <map>
+#include <vector>
+#include <wx/arrstr.h>
+#include <wx/string.h>
+#include <wx/longlong.h>
+#include <wx/textcompleter.h>
+#include "singleton.h"
+
+class wxSQLite3Database;
+
+/**
+* Ranked completions for payee names and transaction notes.
+* The usage counts are read from CHECKINGACCOUNT_V1 in a few grouped queries
+* on first use. New transactions reported by the SQLite update hook are
+* counted on the next read, edited or deleted ones reload all the counts and
+* renamed or deleted payees reload the payee names.
+*/
+class Model_Completion
+{
+public:
+    struct Entry
+    {
+        wxString key;       // lower case text, the sort key
+        wxString text;
+        int id;             // PAYEEID, -1 for notes
+        int uses;
+        int recent;         // uses in the last RECENT_DAYS days
+        wxString last;      // date of the last use
+
+        int score() const { return uses + 2 * recent; }
+    };
+
+    /**
+    * Entries sorted by key, i.e. a flattened prefix trie: the entries
+    * starting with a prefix form one range found by binary search.
+    */
+    class Index
+    {
+    public:
+        typedef std::pair<size_t, size_t> Range;
+
+        void clear();
+        Range all() const;
+        /** Return the range of keys starting with prefix, searched within the given range */
+        Range range(const wxString& prefix, const Range& within) const;
+        /** Return up to max entries of the range, best score first */
+        std::vector<const Entry*> top(const Range& r, size_t max) const;
+
+        /** Replace the entries, they are sorted once */
+        void build(std::vector<Entry>& entries);
+        Entry& add(const wxString& text, int id);
+        static void use(Entry& e, int uses, int recent, const wxString& last);
+        /** Append the texts in key order */
+        void texts(wxArrayString& out) const;
+        size_t size() const;
+
+    private:
+        std::vector<Entry> m_entries;
+    };
+
+    /** Completes payee names as the user types, narrowing the last range while the prefix grows */
+    class PayeeCompleter : public wxTextCompleter
+    {
+    public:
+        explicit PayeeCompleter(size_t max = 50);
+        virtual bool Start(const wxString& prefix);
+        virtual wxString GetNext();
+
+    private:
+        size_t m_max;
+        wxString m_prefix;
+        Index::Range m_range;
+        std::vector<wxString> m_results;
+        size_t m_next;
+        size_t m_generation;
+    };
+
+public:
+    Model_Completion();
+    ~Model_Completion();
+
+    static Model_Completion& instance(wxSQLite3Database* db);
+    static Model_Completion& instance();
+
+public:
+    /** Return the payee names starting with prefix, most used first */
+    std::vector<wxString> payees(const wxString& prefix, size_t max);
+    /** Return all payee names in alphabetical order, e.g. for a combo box list */
+    const wxArrayString& payee_names();
+    /** Return the payee of the last transaction of the account up to today, -1 if none */
+    int last_payee(int account_id);
+    /** Return the most used notes of the account, of all accounts for -1 */
+    void frequent_notes(std::vector<wxString>& notes, int account_id = -1, size_t max = 20);
+
+    /** Record a change reported by the SQLite update hook. Does not touch the database. */
+    void touch(const wxString& table, wxLongLong rowid);
+    void reset();
+
+    /** Changes whenever the payee index is rebuilt or extended */
+    size_t generation() const;
+
+private:
+    const Index& payee_index();
+    void load();
+    void load_payees();
+    void load_new_transactions();
+
+private:
+    wxSQLite3Database* m_db;
+    bool m_loaded;
+    bool m_payees_dirty;
+    bool m_has_new;
+    int m_max_transid;
+    wxString m_recent_date;
+    size_t m_generation;
+
+    Index m_payees;
+    wxArrayString m_payee_names;
+    std::map<int, Index> m_notes;       // per ACCOUNTID, -1 for all accounts
+    std::map<int, std::pair<int, int> > m_last_payee;  // ACCOUNTID -> (TRANSID, PAYEEID)
+};
+
+#endif // MODEL_COMPLETION_H
@@ -43,9 +43,8 @@ Model_Currency& Model_Currency::instance(wxSQLite3Database* db)
 {
     Model_Currency& ins = Singleton<Model_Currency>::instance();
     ins.db_ = db;
-    ins.ensure(db);
     ins.destroy_cache();
-    ins.preload();
+    ins.ensure_lazy(db, true);
     return ins;
 }
 
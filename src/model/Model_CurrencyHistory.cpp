@@ -37,7 +37,7 @@ Model_CurrencyHistory& Model_CurrencyHistory::instance(wxSQLite3Database* db)
 {
     Model_CurrencyHistory& ins = Singleton<Model_CurrencyHistory>::instance();
     ins.db_ = db;
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -50,7 +50,7 @@ Model_CustomField& Model_CustomField::instance(wxSQLite3Database* db)
     Model_CustomField& ins = Singleton<Model_CustomField>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
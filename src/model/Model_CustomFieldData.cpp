@@ -22,6 +22,10 @@
 
 Model_CustomFieldData::Model_CustomFieldData()
 : Model<DB_Table_CUSTOMFIELDDATA_V1>()
+, m_index("CUSTOMFIELDDATA_V1"
+    , "SELECT D.FIELDATADID, F.REFTYPE, D.REFID FROM CUSTOMFIELDDATA_V1 D"
+    " INNER JOIN CUSTOMFIELD_V1 F ON F.FIELDID = D.FIELDID"
+    , "D.FIELDATADID", "CUSTOMFIELD_V1")
 {
 }
 
@@ -38,7 +42,8 @@ Model_CustomFieldData& Model_CustomFieldData::instance(wxSQLite3Database* db)
     Model_CustomFieldData& ins = Singleton<Model_CustomFieldData>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
+    ins.m_index.reset(db);
 
     return ins;
 }
@@ -109,3 +114,18 @@ bool Model_CustomFieldData::DeleteAllData(const wxString& RefType, int RefID)
     this->ReleaseSavepoint();
     return true;
 }
+
+int Model_CustomFieldData::NrData(const wxString& RefType, int RefID)
+{
+    return m_index.count(RefType, RefID);
+}
+
+void Model_CustomFieldData::touch(const wxString& table, wxLongLong rowid)
+{
+    m_index.touch(table, rowid);
+}
+
+void Model_CustomFieldData::reset()
+{
+    m_index.reset(db_);
+}
@@ -20,6 +20,7 @@
 #define MODEL_CUSTOMFIELDDATA_H
 
 #include "Model.h"
+#include "Model_RefIndex.h"
 #include "db/DB_Table_Customfielddata_V1.h"
 
 class Model_CustomFieldData : public Model<DB_Table_CUSTOMFIELDDATA_V1>
@@ -51,6 +52,17 @@ public:
     wxArrayString allValue(const int FieldID);
     bool RelocateAllData(const wxString& RefType, int OldRefId, int NewRefId);
     bool DeleteAllData(const wxString& RefType, int RefID);
+
+    /** Return the number of custom field values of the object, does not query the database once the index is loaded */
+    int NrData(const wxString& RefType, int RefID);
+
+    /** Forward a change reported by the SQLite update hook to the presence index */
+    void touch(const wxString& table, wxLongLong rowid);
+    /** Drop the presence index, it is loaded again on the next read */
+    void reset();
+
+private:
+    Model_RefIndex m_index;
 };
 
 #endif // 
@@ -0,0 +1,279 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "Model_MonthlyBalance.h"
+#include "Model_Checking.h"
+#include "mmHook.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <wx/stopwatch.h>
+
+namespace
+{
+    /** Amount of the transaction row r for its account, as Model_Checking::balance() */
+    const wxString amount(const wxString& r)
+    {
+        return wxString::Format("(CASE WHEN UPPER(%1$sSTATUS) IN ('V', 'VOID') THEN 0"
+            " WHEN UPPER(%1$sTRANSCODE) = 'DEPOSIT' THEN IFNULL(%1$sTRANSAMOUNT, 0)"
+            " ELSE -IFNULL(%1$sTRANSAMOUNT, 0) END)", r);
+    }
+
+    /** Amount of the transfer row r for its to account */
+    const wxString to_amount(const wxString& r)
+    {
+        return wxString::Format("(CASE WHEN UPPER(%1$sSTATUS) IN ('V', 'VOID') THEN 0"
+            " ELSE IFNULL(%1$sTOTRANSAMOUNT, 0) END)", r);
+    }
+
+    /** True if the row r also moves money into its to account */
+    const wxString has_to_account(const wxString& r)
+    {
+        return wxString::Format("(UPPER(%1$sTRANSCODE) = 'TRANSFER' AND %1$sTOACCOUNTID > 0"
+            " AND %1$sTOACCOUNTID <> %1$sACCOUNTID)", r);
+    }
+
+    /** Inflow and outflow of every account and month, ordered by account and month */
+    const wxString rebuild_query()
+    {
+        return "SELECT ACCOUNTID, MONTH, SUM(MAX(AMOUNT, 0)), SUM(MAX(-AMOUNT, 0)) FROM ("
+            " SELECT ACCOUNTID, substr(TRANSDATE, 1, 7) AS MONTH, " + amount("") + " AS AMOUNT FROM CHECKINGACCOUNT_V1"
+            " UNION ALL"
+            " SELECT TOACCOUNTID, substr(TRANSDATE, 1, 7), " + to_amount("") + " FROM CHECKINGACCOUNT_V1"
+            " WHERE " + has_to_account("") +
+            ") GROUP BY ACCOUNTID, MONTH ORDER BY ACCOUNTID, MONTH";
+    }
+
+    bool differ(double a, double b)
+    {
+        return std::fabs(a - b) > 0.005;
+    }
+}
+
+Model_MonthlyBalance::Check::Check()
+    : rows(0), missing(0), extra(0), wrong(0), ms(0)
+{
+}
+
+bool Model_MonthlyBalance::Check::ok() const
+{
+    return missing == 0 && extra == 0 && wrong == 0;
+}
+
+const wxString Model_MonthlyBalance::Check::summary() const
+{
+    wxString text = wxString::Format("Month rows: %zu, missing: %zu, extra: %zu, wrong: %zu (%ld ms)\n"
+        , rows, missing, extra, wrong, ms);
+    for (const auto& sample : samples)
+        text += "  " + sample + "\n";
+    return text;
+}
+
+Model_MonthlyBalance::Model_MonthlyBalance()
+    : Model<DB_Table_MONTHLYBALANCE_V1>()
+{
+}
+
+Model_MonthlyBalance::~Model_MonthlyBalance()
+{
+}
+
+/**
+* Initialize the global Model_MonthlyBalance table.
+* Creates the table and the triggers on CHECKINGACCOUNT_V1 if they do not exist,
+* an older file gets them filled by the upgrade to database version 8.
+*/
+Model_MonthlyBalance& Model_MonthlyBalance::instance(wxSQLite3Database* db)
+{
+    Model_MonthlyBalance& ins = Singleton<Model_MonthlyBalance>::instance();
+    ins.db_ = db;
+    ins.ensure(db);
+
+    return ins;
+}
+
+/** Return the static instance of Model_MonthlyBalance table */
+Model_MonthlyBalance& Model_MonthlyBalance::instance()
+{
+    return Singleton<Model_MonthlyBalance>::instance();
+}
+
+const Model_MonthlyBalance::Data_Set Model_MonthlyBalance::months(int account_id)
+{
+    Data_Set rows = find(ACCOUNTID(account_id));
+    std::sort(rows.begin(), rows.end(), SorterByMONTH());
+    return rows;
+}
+
+int Model_MonthlyBalance::rebuild()
+{
+    int result = 0;
+    Cache rows;
+    try
+    {
+        this->Savepoint();
+        db_->ExecuteUpdate("DELETE FROM MONTHLYBALANCE_V1");
+
+        DB_Query_Timer timer(rebuild_query(), db_);
+        wxSQLite3ResultSet q = db_->ExecuteQuery(timer.shape_);
+        int account_id = -1;
+        double balance = 0.0;
+        while (q.NextRow())
+        {
+            Data* r = create();
+            r->ACCOUNTID = q.GetInt(0);
+            r->MONTH = q.GetString(1);
+            r->INFLOW = q.GetDouble(2);
+            r->OUTFLOW = q.GetDouble(3);
+            if (r->ACCOUNTID != account_id)
+            {
+                account_id = r->ACCOUNTID;
+                balance = 0.0;
+            }
+            balance += r->INFLOW - r->OUTFLOW;
+            r->BALANCE = balance;
+            rows.push_back(r);
+        }
+        q.Finalize();
+        timer.rows_ = rows.size();
+
+        result = static_cast<int>(insert(rows));
+        this->ReleaseSavepoint();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("MONTHLYBALANCE_V1: Exception %s", e.GetMessage().utf8_str());
+        db_->Rollback("MMEX");
+        db_->ReleaseSavepoint("MMEX");
+        UpdateCallbackHook::ResetCaches();
+        result = -1;
+    }
+
+    // the rows are changed by the triggers behind the cache, it is not kept
+    destroy_cache();
+    return result;
+}
+
+const Model_MonthlyBalance::Check Model_MonthlyBalance::verify(size_t max_samples)
+{
+    struct Month
+    {
+        Month() : inflow(0), outflow(0), balance(0) {}
+        double inflow, outflow, balance;
+    };
+    typedef std::pair<int, wxString> Key;
+
+    Check check;
+    wxStopWatch sw;
+    const auto sample = [&](const wxString& text)
+    {
+        if (check.samples.size() < max_samples) check.samples.Add(text);
+    };
+
+    std::map<Key, Month> expected;
+    const auto add = [&](int account_id, const wxString& month, double value)
+    {
+        Month& m = expected[Key(account_id, month)];
+        if (value > 0) m.inflow += value;
+        else m.outflow -= value;
+    };
+    Model_Checking::instance().for_each([&](const Model_Checking::Data& tran)
+    {
+        const wxString month = MONTH(tran.TRANSDATE);
+        add(tran.ACCOUNTID, month, Model_Checking::balance(tran, tran.ACCOUNTID));
+        if (Model_Checking::type(tran) == Model_Checking::TRANSFER
+            && tran.TOACCOUNTID > 0 && tran.TOACCOUNTID != tran.ACCOUNTID)
+        {
+            add(tran.TOACCOUNTID, month, Model_Checking::balance(tran, tran.TOACCOUNTID));
+        }
+    });
+
+    int account_id = -1;
+    double balance = 0.0;
+    for (auto& m : expected)
+    {
+        if (m.first.first != account_id)
+        {
+            account_id = m.first.first;
+            balance = 0.0;
+        }
+        balance += m.second.inflow - m.second.outflow;
+        m.second.balance = balance;
+    }
+    check.rows = expected.size();
+
+    std::map<Key, Data> actual;
+    for_each([&](const Data& r) { actual.insert(std::make_pair(Key(r.ACCOUNTID, r.MONTH), r)); });
+
+    for (const auto& m : expected)
+    {
+        const auto it = actual.find(m.first);
+        if (it == actual.end())
+        {
+            check.missing++;
+            sample(wxString::Format("account %i %s: missing", m.first.first, m.first.second));
+            continue;
+        }
+        const Data& r = it->second;
+        if (differ(r.BALANCE, m.second.balance) || differ(r.INFLOW, m.second.inflow) || differ(r.OUTFLOW, m.second.outflow))
+        {
+            check.wrong++;
+            sample(wxString::Format("account %i %s: balance %.2f, in %.2f, out %.2f instead of %.2f, %.2f, %.2f"
+                , r.ACCOUNTID, r.MONTH, r.BALANCE, r.INFLOW, r.OUTFLOW, m.second.balance, m.second.inflow, m.second.outflow));
+        }
+        actual.erase(it);
+    }
+
+    // rows of months whose transactions were all removed are fine while they carry the balance over
+    for (const auto& a : actual)
+    {
+        const Data& r = a.second;
+        double closing = 0.0;
+        auto prev = expected.lower_bound(a.first);
+        if (prev != expected.begin() && (--prev)->first.first == r.ACCOUNTID)
+            closing = prev->second.balance;
+        if (differ(r.INFLOW, 0) || differ(r.OUTFLOW, 0) || differ(r.BALANCE, closing))
+        {
+            check.extra++;
+            sample(wxString::Format("account %i %s: not in the ledger", r.ACCOUNTID, r.MONTH));
+        }
+    }
+
+    check.ms = sw.Time();
+    return check;
+}
+
+const wxString Model_MonthlyBalance::MONTH(const wxString& date)
+{
+    return date.Left(7);
+}
+
+const wxString Model_MonthlyBalance::MONTH(const wxDate& date)
+{
+    return date.Format("%Y-%m");
+}
+
+const wxDate Model_MonthlyBalance::MONTH_START(const Data& r)
+{
+    return Model::to_date(r.MONTH + "-01");
+}
+
+const wxDate Model_MonthlyBalance::MONTH_END(const Data& r)
+{
+    return MONTH_START(r).GetLastMonthDay();
+}
@@ -0,0 +1,89 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MODEL_MONTHLYBALANCE_H
+#define MODEL_MONTHLYBALANCE_H
+
+#include "Model.h"
+#include "db/DB_Table_Monthlybalance_V1.h"
+
+/**
+* Closing balance, inflow and outflow of every account for every month with
+* transactions, so reports over many years read one row per account and month
+* instead of the whole ledger.
+* The rows are kept up to date by SQLite triggers on CHECKINGACCOUNT_V1, which
+* see every insert, update and delete whichever model or statement makes it.
+* The table and the triggers come with database version 8.
+* Void transactions count as zero and initial balances are not included,
+* callers add Model_Account::INITIALBAL.
+*/
+class Model_MonthlyBalance : public Model<DB_Table_MONTHLYBALANCE_V1>
+{
+public:
+    /** Outcome of verify() */
+    struct Check
+    {
+        Check();
+        size_t rows;        // rows expected from the ledger
+        size_t missing;     // expected rows not in the table
+        size_t extra;       // table rows with amounts the ledger does not have
+        size_t wrong;       // rows with a different balance, inflow or outflow
+        long ms;
+        wxArrayString samples;
+
+        bool ok() const;
+        const wxString summary() const;
+    };
+
+public:
+    Model_MonthlyBalance();
+    ~Model_MonthlyBalance();
+
+public:
+    /**
+    Initialize the global Model_MonthlyBalance table on initial call.
+    Creates the table and its triggers when they do not exist.
+    * Return the static instance address for Model_MonthlyBalance table
+    * Note: Assigning the address to a local variable can destroy the instance.
+    */
+    static Model_MonthlyBalance& instance(wxSQLite3Database* db);
+
+    /**
+    * Return the static instance address for Model_MonthlyBalance table
+    * Note: Assigning the address to a local variable can destroy the instance.
+    */
+    static Model_MonthlyBalance& instance();
+
+public:
+    /** Return the months of the account in ascending order */
+    const Data_Set months(int account_id);
+
+    /** Refill the table from CHECKINGACCOUNT_V1. Returns the number of rows, -1 on error */
+    int rebuild();
+
+    /** Compare the table with balances computed from the ledger as Model_Checking::balance() */
+    const Check verify(size_t max_samples = 10);
+
+    /** Month key of an ISO date, YYYY-MM */
+    static const wxString MONTH(const wxString& date);
+    static const wxString MONTH(const wxDate& date);
+    static const wxDate MONTH_START(const Data& r);
+    static const wxDate MONTH_END(const Data& r);
+};
+
+#endif // MODEL_MONTHLYBALANCE_H
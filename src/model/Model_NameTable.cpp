@@ -0,0 +1,132 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "Model_NameTable.h"
+#include "Model_Account.h"
+#include "Model_Payee.h"
+#include "Model_Category.h"
+
+Model_NameTable::Model_NameTable()
+    : m_categories_loaded(false)
+{
+}
+
+/** Return the static instance of the interned name table */
+Model_NameTable& Model_NameTable::instance()
+{
+    return Singleton<Model_NameTable>::instance();
+}
+
+const Model_NameTable::Entry* Model_NameTable::account(int account_id)
+{
+    auto it = m_accounts.find(account_id);
+    if (it == m_accounts.end())
+        it = m_accounts.insert(std::make_pair(account_id, Entry(ACCOUNT, account_id))).first;
+    return &it->second;
+}
+
+const Model_NameTable::Entry* Model_NameTable::payee(int payee_id)
+{
+    auto it = m_payees.find(payee_id);
+    if (it == m_payees.end())
+        it = m_payees.insert(std::make_pair(payee_id, Entry(PAYEE, payee_id))).first;
+    return &it->second;
+}
+
+const Model_NameTable::Entry* Model_NameTable::category(int category_id, int subcategory_id)
+{
+    if (!m_categories_loaded) load_categories();
+
+    const auto key = std::make_pair(category_id, subcategory_id);
+    auto it = m_categories.find(key);
+    if (it == m_categories.end())
+        it = m_categories.insert(std::make_pair(key, Entry(CATEGORY, category_id, subcategory_id))).first;
+    return &it->second;
+}
+
+const wxString& Model_NameTable::name(const Entry* entry)
+{
+    if (entry->stale_)
+    {
+        switch (entry->kind_)
+        {
+        case ACCOUNT:
+            entry->name_ = Model_Account::get_account_name(entry->id_);
+            break;
+        case PAYEE:
+            entry->name_ = Model_Payee::get_payee_name(entry->id_);
+            break;
+        case CATEGORY:
+            entry->name_ = Model_Category::full_name(Model_Category::instance().get(entry->id_)
+                , Model_Subcategory::instance().get(entry->sub_id_));
+            break;
+        }
+        entry->stale_ = false;
+    }
+    return entry->name_;
+}
+
+void Model_NameTable::invalidate(const wxString& table)
+{
+    if (table == "ACCOUNTLIST_V1")
+    {
+        for (auto& item : m_accounts) item.second.stale_ = true;
+    }
+    else if (table == "PAYEE_V1")
+    {
+        for (auto& item : m_payees) item.second.stale_ = true;
+    }
+    else if (table == "CATEGORY_V1" || table == "SUBCATEGORY_V1")
+    {
+        for (auto& item : m_categories) item.second.stale_ = true;
+        m_categories_loaded = false;
+    }
+}
+
+void Model_NameTable::load_categories()
+{
+    m_categories_loaded = true;
+
+    std::unordered_map<int, wxString> names;
+    for (const auto& c : Model_Category::instance().all())
+    {
+        names[c.CATEGID] = c.CATEGNAME;
+        Entry& e = m_categories[std::make_pair(c.CATEGID, -1)];
+        e = Entry(CATEGORY, c.CATEGID, -1);
+        e.name_ = c.CATEGNAME;
+        e.stale_ = false;
+    }
+
+    for (const auto& s : Model_Subcategory::instance().all())
+    {
+        const auto name = names.find(s.CATEGID);
+        if (name == names.end()) continue;
+        Entry& e = m_categories[std::make_pair(s.CATEGID, s.SUBCATEGID)];
+        e = Entry(CATEGORY, s.CATEGID, s.SUBCATEGID);
+        e.name_ = name->second + ":" + s.SUBCATEGNAME;
+        e.stale_ = false;
+    }
+}
+
+void Model_NameTable::reset()
+{
+    m_accounts.clear();
+    m_payees.clear();
+    m_categories.clear();
+    m_categories_loaded = false;
+}
@@ -0,0 +1,82 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MODEL_NAMETABLE_H
+#define MODEL_NAMETABLE_H
+
+#include <map>
+#include <unordered_map>
+#include <wx/string.h>
+#include "singleton.h"
+
+/**
+* Interned display names for accounts, payees and category paths.
+* Entries are never erased while the database is open, so row views may keep
+* pointers to them. A rename marks the entries stale and the name is rebuilt
+* the next time it is resolved.
+* The category paths are built for all categories at once, in one pass over
+* the category and subcategory tables, so Model_Category::full_name() is a
+* lookup.
+*/
+class Model_NameTable
+{
+public:
+    enum KIND { ACCOUNT = 0, PAYEE, CATEGORY };
+
+    struct Entry
+    {
+        Entry(KIND kind = ACCOUNT, int id = -1, int sub_id = -1)
+            : kind_(kind), id_(id), sub_id_(sub_id), stale_(true) {}
+        KIND kind_;
+        int id_;
+        int sub_id_;
+        mutable wxString name_;
+        mutable bool stale_;
+    };
+
+public:
+    Model_NameTable();
+
+    /** Return the static instance of the interned name table */
+    static Model_NameTable& instance();
+
+public:
+    const Entry* account(int account_id);
+    const Entry* payee(int payee_id);
+    const Entry* category(int category_id, int subcategory_id);
+
+    /** Return the display name of the entry, rebuilding it when stale */
+    static const wxString& name(const Entry* entry);
+
+    /** Mark the names depending on the given database table as stale */
+    void invalidate(const wxString& table);
+
+    /** Drop all entries. Only call when no row view refers to them (e.g. on database change) */
+    void reset();
+
+private:
+    void load_categories();
+
+private:
+    std::unordered_map<int, Entry> m_accounts;
+    std::unordered_map<int, Entry> m_payees;
+    std::map<std::pair<int, int>, Entry> m_categories;
+    bool m_categories_loaded;
+};
+
+#endif // MODEL_NAMETABLE_H
@@ -38,8 +38,7 @@ Model_Payee& Model_Payee::instance(wxSQLite3Database* db)
     Model_Payee& ins = Singleton<Model_Payee>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
-    ins.preload();
+    ins.ensure_lazy(db, true);
 
     return ins;
 }
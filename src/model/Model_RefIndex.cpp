@@ -0,0 +1,153 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "Model_RefIndex.h"
+#include "mmstartuptrace.h"
+#include <wx/log.h>
+#include <wx/wxsqlite3.h>
+
+Model_RefIndex::Model_RefIndex(const wxString& table, const wxString& query
+    , const wxString& id_column, const wxString& parent_table)
+    : m_table(table)
+    , m_query(query)
+    , m_id_column(id_column)
+    , m_parent_table(parent_table)
+    , m_db(nullptr)
+    , m_loaded(false)
+{
+}
+
+void Model_RefIndex::reset(wxSQLite3Database* db)
+{
+    m_db = db;
+    m_loaded = false;
+    m_types.clear();
+    m_counts.clear();
+    m_rows.clear();
+    m_dirty.clear();
+}
+
+int Model_RefIndex::count(const wxString& reftype, int refid)
+{
+    if (!m_loaded)
+        load();
+    else if (!m_dirty.empty())
+        refresh();
+
+    for (size_t i = 0; i < m_types.size(); i++)
+    {
+        if (m_types[i] != reftype) continue;
+        const auto& counts = m_counts[i];
+        return refid >= 0 && static_cast<size_t>(refid) < counts.size() ? counts[refid] : 0;
+    }
+    return 0;
+}
+
+void Model_RefIndex::touch(const wxString& table, wxLongLong rowid)
+{
+    if (!m_loaded) return;
+
+    if (table == m_table)
+        m_dirty.insert(rowid.ToLong());
+    else if (table == m_parent_table)
+        m_loaded = false;
+}
+
+void Model_RefIndex::load()
+{
+    mmStartupTrace::Scope trace(m_table + " index", "model");
+    reset(m_db);
+    if (!m_db) return;
+
+    try
+    {
+        wxSQLite3ResultSet q = m_db->ExecuteQuery(m_query);
+        while (q.NextRow())
+            add(q.GetInt(0), q.GetString(1), q.GetInt(2));
+        q.Finalize();
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("Model_RefIndex %s: Exception %s", m_table, e.GetMessage().utf8_str());
+        return;
+    }
+    m_loaded = true;
+}
+
+void Model_RefIndex::refresh()
+{
+    std::vector<int> ids(m_dirty.begin(), m_dirty.end());
+    m_dirty.clear();
+
+    for (int id : ids)
+        remove(id);
+
+    const size_t chunk = 500;
+    for (size_t i = 0; i < ids.size(); i += chunk)
+    {
+        wxString list;
+        for (size_t j = i; j < ids.size() && j < i + chunk; j++)
+            list += (list.empty() ? "" : ",") + wxString::Format("%i", ids[j]);
+
+        try
+        {
+            wxSQLite3ResultSet q = m_db->ExecuteQuery(m_query + " WHERE " + m_id_column + " IN (" + list + ")");
+            while (q.NextRow())
+                add(q.GetInt(0), q.GetString(1), q.GetInt(2));
+            q.Finalize();
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("Model_RefIndex %s: Exception %s", m_table, e.GetMessage().utf8_str());
+            m_loaded = false;
+            return;
+        }
+    }
+}
+
+int Model_RefIndex::type_index(const wxString& reftype)
+{
+    for (size_t i = 0; i < m_types.size(); i++)
+    {
+        if (m_types[i] == reftype) return static_cast<int>(i);
+    }
+    m_types.push_back(reftype);
+    m_counts.push_back(std::vector<unsigned short>());
+    return static_cast<int>(m_types.size()) - 1;
+}
+
+void Model_RefIndex::add(int rowid, const wxString& reftype, int refid)
+{
+    if (refid < 0) return;
+
+    const int type = type_index(reftype);
+    auto& counts = m_counts[type];
+    if (static_cast<size_t>(refid) >= counts.size())
+        counts.resize(refid + 1, 0);
+    counts[refid]++;
+    m_rows[rowid] = std::make_pair(type, refid);
+}
+
+void Model_RefIndex::remove(int rowid)
+{
+    const auto it = m_rows.find(rowid);
+    if (it == m_rows.end()) return;
+
+    m_counts[it->second.first][it->second.second]--;
+    m_rows.erase(it);
+}
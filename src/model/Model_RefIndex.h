@@ -0,0 +1,77 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MODEL_REFINDEX_H
+#define MODEL_REFINDEX_H
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+#include <wx/longlong.h>
+
+class wxSQLite3Database;
+
+/**
+* Number of rows of a table referring to each (REFTYPE, REFID) pair.
+* The counts are kept in a vector per REFTYPE indexed by REFID, so a lookup
+* does not touch the database. The index is loaded in one query on first use,
+* changes are reported by the SQLite update hook and applied on the next read.
+*/
+class Model_RefIndex
+{
+public:
+    /**
+    * query returns (row id, REFTYPE, REFID) for every row of table,
+    * id_column is the row id column used to reload single rows.
+    * A change in parent_table (the table providing REFTYPE) drops the index.
+    */
+    Model_RefIndex(const wxString& table, const wxString& query
+        , const wxString& id_column, const wxString& parent_table = "");
+
+    /** Use the database, the index is rebuilt on the next read */
+    void reset(wxSQLite3Database* db);
+
+    /** Return the number of rows referring to the object */
+    int count(const wxString& reftype, int refid);
+
+    /** Record a change reported by the SQLite update hook. Does not touch the database. */
+    void touch(const wxString& table, wxLongLong rowid);
+
+private:
+    void load();
+    void refresh();
+    int type_index(const wxString& reftype);
+    void add(int rowid, const wxString& reftype, int refid);
+    void remove(int rowid);
+
+private:
+    const wxString m_table;
+    const wxString m_query;
+    const wxString m_id_column;
+    const wxString m_parent_table;
+
+    wxSQLite3Database* m_db;
+    bool m_loaded;
+    std::vector<wxString> m_types;
+    std::vector<std::vector<unsigned short> > m_counts;    // [type index][REFID]
+    std::unordered_map<int, std::pair<int, int> > m_rows;  // row id -> (type index, REFID)
+    std::set<int> m_dirty;
+};
+
+#endif // MODEL_REFINDEX_H
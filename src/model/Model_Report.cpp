@@ -21,12 +21,12 @@
 #include "paths.h"
 #include "option.h"
 #include "platfdep.h"
-#include "attachmentdialog.h"
-#include "mmreportspanel.h"
 #include "reports/htmlbuilder.h"
 #include "model/Model_Setting.h"
 #include "LuaGlue/LuaGlue.h"
 #include "sqlite3.h"
+#include <wx/choice.h>
+#include <wx/datectrl.h>
 #include <wx/fs_mem.h>
 
 #if defined (__WXMSW__)
@@ -72,7 +72,7 @@ Model_Report& Model_Report::instance(wxSQLite3Database* db)
     Model_Report& ins = Singleton<Model_Report>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -82,9 +82,9 @@ const std::vector<Model_Report::Values> Model_Report::SqlPlaceHolders()
     const wxString def_date = wxDateTime::Today().FormatISODate();
 
     const std::vector<Model_Report::Values> v = {
-    {"&begin_date", "wxDatePickerCtrl", def_date, mmReportsPanel::RepPanel::ID_CHOICE_START_DATE, _("Begin date: ")},
-    {"&single_date", "wxDatePickerCtrl", def_date, mmReportsPanel::RepPanel::ID_CHOICE_START_DATE, _("Date: ")},
-    {"&end_date", "wxDatePickerCtrl", def_date, mmReportsPanel::RepPanel::ID_CHOICE_END_DATE, _("End date: ")},
+    {"&begin_date", "wxDatePickerCtrl", def_date, ID_PARAM_START_DATE, _("Begin date: ")},
+    {"&single_date", "wxDatePickerCtrl", def_date, ID_PARAM_START_DATE, _("Date: ")},
+    {"&end_date", "wxDatePickerCtrl", def_date, ID_PARAM_END_DATE, _("End date: ")},
     };
     return v;
 };
@@ -226,7 +226,32 @@ bool Model_Report::PrepareSQL(wxString& sql, std::map <wxString, wxString>& rep_
 
 int Model_Report::get_html(const Data* r, wxString& out)
 {
-    wxString sql = r->SQLCONTENT;
+    return run(this->db_, prepare(r), out);
+}
+
+Model_Report::Job Model_Report::prepare(const Data* r)
+{
+    Job job;
+    job.report = *r;
+    job.sql = r->SQLCONTENT;
+    PrepareSQL(job.sql, job.params);
+
+    auto p = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting());
+    //javascript does not handle backslashs
+    p.Replace("\\", "\\\\");
+    job.values[L"ATTACHMENTSFOLDER"] = p;
+    auto s = wxString(wxFileName::GetPathSeparator());
+    s.Replace("\\", "\\\\");
+    job.values[L"FILESEPARATOR"] = s;
+    job.values[L"LANGUAGE"] = Option::instance().getLanguageISO6391();
+    job.values[L"HTMLSCALE"] = wxString::Format("%d", Option::instance().getHtmlFontSize());
+    return job;
+}
+
+int Model_Report::run(wxSQLite3Database* db, const Job& job, wxString& out)
+{
+    const Data* r = &job.report;
+    const wxString& sql = job.sql;
     wxString templatecontent = r->TEMPLATECONTENT;
     if (templatecontent.empty()) {
         out = _("Template is empty");
@@ -235,12 +260,11 @@ int Model_Report::get_html(const Data* r, wxString& out)
 
     wxSQLite3ResultSet q;
     int columnCount = 0;
-    std::map <wxString, wxString> rep_params;
+    size_t rows = 0;
+    const wxLongLong start = wxGetUTCTimeUSec();
     try
     {
-        PrepareSQL(sql, rep_params);
-
-        wxSQLite3Statement stmt = this->db_->PrepareStatement(sql);
+        wxSQLite3Statement stmt = db->PrepareStatement(sql);
         if (!stmt.IsReadOnly())
         {
             out = wxString::Format(_("The SQL script:\n%s \nwill modify database! aborted!"), r->SQLCONTENT);
@@ -260,7 +284,7 @@ int Model_Report::get_html(const Data* r, wxString& out)
 
     std::map <std::wstring, int> colHeaders;
 
-    mm_html_template report(templatecontent);
+    mm_html_template report(templatecontent, db);
     r->to_template(report);
     loop_t contents;
     loop_t errors;
@@ -335,9 +359,12 @@ int Model_Report::get_html(const Data* r, wxString& out)
             row(item.first) = item.second;
         }
         contents += row;
-
+        ++rows;
     }
     q.Finalize();
+    // the statistics are kept per report, the row loop includes the lua handler
+    DB_Profiler::instance().record("REPORT " + r->REPORTNAME + ": " + r->SQLCONTENT
+        , db, (wxGetUTCTimeUSec() - start).GetValue(), rows, sql);
 
     Record result;
     if (lua_status && !skip_lua)
@@ -371,20 +398,13 @@ int Model_Report::get_html(const Data* r, wxString& out)
     }
 
     report(L"CONTENTS") = contents;
+    for (const auto& item : job.params)
     {
-        for (const auto& item : rep_params)
-        {
-            report(item.first.Upper().ToStdWstring()) = item.second;
-        }
-        auto p = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting());
-        //javascript does not handle backslashs
-        p.Replace("\\", "\\\\");
-        report(L"ATTACHMENTSFOLDER") = p;
-        auto s = wxString(wxFileName::GetPathSeparator());
-        s.Replace("\\", "\\\\");
-        report(L"FILESEPARATOR") = s;
-        report(L"LANGUAGE") = Option::instance().getLanguageISO6391();
-        report(L"HTMLSCALE") = wxString::Format("%d", Option::instance().getHtmlFontSize());
+        report(item.first.Upper().ToStdWstring()) = item.second;
+    }
+    for (const auto& item : job.values)
+    {
+        report(item.first) = item.second;
     }
     report(L"ERRORS") = errors;
 
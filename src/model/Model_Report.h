@@ -52,11 +52,31 @@ public:
     int get_html(const Data* r, wxString& out);
     //wxString get_html(const Data& r);
 
+    /** A report with its parameters filled in, everything its data pass needs besides a connection */
+    struct Job
+    {
+        Data report;
+        wxString sql;
+        std::map<wxString, wxString> params;
+        std::map<std::wstring, wxString> values;    // ATTACHMENTSFOLDER, LANGUAGE, ...
+    };
+    /** Read the parameters from the report panel and the settings, GUI thread only */
+    static Job prepare(const Data* r);
+    /** Run the query, the Lua script and the template on db, also from a worker thread on a reader */
+    static int run(wxSQLite3Database* db, const Job& job, wxString& out);
+
 public:
     Data* get(const wxString& name);
     static bool PrepareSQL(wxString& sql, std::map <wxString, wxString>& rep_params);
     static const std::vector<std::pair<wxString, wxString>> getParamNames();
 
+    /** Window ids of the date pickers PrepareSQL reads, the report panel creates them */
+    enum PARAM_ID
+    {
+        ID_PARAM_START_DATE = wxID_HIGHEST + 557,
+        ID_PARAM_END_DATE
+    };
+
 private:
     struct Values
     {
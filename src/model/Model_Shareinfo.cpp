@@ -37,7 +37,7 @@ Model_Shareinfo& Model_Shareinfo::instance(wxSQLite3Database* db)
     Model_Shareinfo& ins = Singleton<Model_Shareinfo>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
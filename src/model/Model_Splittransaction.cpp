@@ -38,7 +38,7 @@ Model_Splittransaction& Model_Splittransaction::instance(wxSQLite3Database* db)
     Model_Splittransaction& ins = Singleton<Model_Splittransaction>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -65,10 +65,18 @@ double Model_Splittransaction::get_total(const std::vector<Split>& rows)
 std::map<int, Model_Splittransaction::Data_Set> Model_Splittransaction::get_all()
 {
     std::map<int, Model_Splittransaction::Data_Set> data;
-    for (const auto &split : instance().all())
+    instance().for_each([&data](const Data& split)
     {
         data[split.TRANSID].push_back(split);
-    }
+    });
+    return data;
+}
+
+std::map<int, Model_Splittransaction::Data_Set> Model_Splittransaction::get_all(const wxString& where, const std::vector<wxVariant>& params)
+{
+    std::map<int, Model_Splittransaction::Data_Set> data;
+    for (const auto& split : instance().find_where("TRANSID IN (SELECT TRANSID FROM CHECKINGACCOUNT_V1 WHERE " + where + ")", params))
+        data[split.TRANSID].push_back(split);
     return data;
 }
 
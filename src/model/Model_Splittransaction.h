@@ -33,6 +33,8 @@ struct Split
 class Model_Splittransaction : public Model<DB_Table_SPLITTRANSACTIONS_V1>
 {
 public:
+    using Model<DB_Table_SPLITTRANSACTIONS_V1>::update;
+
     Model_Splittransaction();
     ~Model_Splittransaction();
 
@@ -56,6 +58,8 @@ public:
     static double get_total(const std::vector<Split>& local_splits);
     static const wxString get_tooltip(const std::vector<Split>& local_splits, const Model_Currency::Data* currency);
     std::map<int, Model_Splittransaction::Data_Set> get_all();
+    /** The splits of the transactions matching a condition on CHECKINGACCOUNT_V1, by TRANSID */
+    std::map<int, Model_Splittransaction::Data_Set> get_all(const wxString& where, const std::vector<wxVariant>& params);
     int update(const Data_Set& rows, int transactionID);
 };
 
@@ -37,7 +37,7 @@ Model_Stock& Model_Stock::instance(wxSQLite3Database* db)
     Model_Stock& ins = Singleton<Model_Stock>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -35,7 +35,7 @@ Model_StockHistory& Model_StockHistory::instance(wxSQLite3Database* db)
 {
     Model_StockHistory& ins = Singleton<Model_StockHistory>::instance();
     ins.db_ = db;
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
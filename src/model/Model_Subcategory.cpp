@@ -38,8 +38,7 @@ Model_Subcategory& Model_Subcategory::instance(wxSQLite3Database* db)
     Model_Subcategory& ins = Singleton<Model_Subcategory>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
-    ins.preload();
+    ins.ensure_lazy(db, true);
 
     return ins;
 }
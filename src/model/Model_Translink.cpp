@@ -39,7 +39,7 @@ Model_Translink& Model_Translink::instance(wxSQLite3Database* db)
     Model_Translink& ins = Singleton<Model_Translink>::instance();
     ins.db_ = db;
     ins.destroy_cache();
-    ins.ensure(db);
+    ins.ensure_lazy(db);
 
     return ins;
 }
@@ -21,17 +21,22 @@
 #include "Model_Account.h"
 #include "Model_Asset.h"
 #include "Model_Attachment.h"
+#include "Model_Balance.h"
 #include "Model_Billsdeposits.h"
 #include "Model_Budget.h"
+#include "Model_BudgetActual.h"
 #include "Model_Budgetsplittransaction.h"
 #include "Model_Budgetyear.h"
 #include "Model_Category.h"
 #include "Model_Checking.h"
+#include "Model_Completion.h"
 #include "Model_Currency.h"
 #include "Model_CurrencyHistory.h"
 #include "Model_CustomField.h"
 #include "Model_CustomFieldData.h"
 #include "Model_Infotable.h"
+#include "Model_MonthlyBalance.h"
+#include "Model_NameTable.h"
 #include "Model_Payee.h"
 #include "Model_Report.h"
 #include "Model_Setting.h"
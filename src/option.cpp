@@ -19,14 +19,10 @@
 
 #include "option.h"
 #include "constants.h"
-#include "images_list.h"
 #include "singleton.h"
 #include "model/Model_Infotable.h"
 #include "model/Model_Setting.h"
 #include "model/Model_Account.h"
-#include "maincurrencydialog.h"
-#include "model/Model_Currency.h"
-#include "model/Model_CurrencyHistory.h"
 
 //----------------------------------------------------------------------------
 Option::Option()
@@ -68,16 +64,6 @@ void Option::LoadOptions(bool include_infotable)
         m_baseCurrency = Model_Infotable::instance().GetIntInfo("BASECURRENCYID", -1);
         m_currencyHistoryEnabled = Model_Infotable::instance().GetBoolInfo(INIDB_USE_CURRENCY_HISTORY, true);
         m_budget_days_offset = Model_Infotable::instance().GetIntInfo("BUDGET_DAYS_OFFSET", 0);
-        // Ensure that base currency is set for the database.
-        while (m_baseCurrency < 1)
-        {
-            if (mmMainCurrencyDialog::Execute(m_baseCurrency))
-            {
-                BaseCurrency(m_baseCurrency);
-                Model_CurrencyHistory::ResetCurrencyHistory();
-                Model_Currency::ResetBaseConversionRates();
-            }
-        }
     }
 
     m_language = static_cast<wxLanguage>(Model_Setting::instance().GetIntSetting(LANGUAGE_PARAMETER, wxLANGUAGE_UNKNOWN));
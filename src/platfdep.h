@@ -24,6 +24,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 //----------------------------------------------------------------------------
 
+#include <cstddef>
+
 class wxFileName;
 class wxString;
 
@@ -42,6 +44,17 @@ namespace mmex
         Use mmex::getProgramName() for others purposes.
         */
     const wxString GetAppName();
+
+    /*
+        The peak resident memory of the process in KB, 0 if unknown.
+    */
+    size_t GetPeakMemoryKB();
+
+    /*
+        The heap bytes allocated and not yet freed, as the allocator counts
+        them, 0 if unknown.
+    */
+    size_t GetHeapBytesInUse();
 } // namespace mmex
 
 //----------------------------------------------------------------------------
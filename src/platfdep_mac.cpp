@@ -20,6 +20,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "platfdep.h"
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
+#include <sys/resource.h>
+#include <malloc/malloc.h>
 //----------------------------------------------------------------------------
 
 const wxFileName mmex::GetSharedDir()
@@ -55,3 +57,22 @@ const wxString mmex::GetAppName()
     return "MoneyManagerEx";
 }
 //----------------------------------------------------------------------------
+
+/*
+    ru_maxrss is in bytes on macOS.
+*/
+size_t mmex::GetPeakMemoryKB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+}
+//----------------------------------------------------------------------------
+
+size_t mmex::GetHeapBytesInUse()
+{
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+}
+//----------------------------------------------------------------------------
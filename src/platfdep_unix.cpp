@@ -20,6 +20,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "platfdep.h"
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
+#include <sys/resource.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 //----------------------------------------------------------------------------
 
 namespace
@@ -108,3 +112,25 @@ const wxString mmex::GetAppName()
     return "mmex";
 }
 //----------------------------------------------------------------------------
+
+size_t mmex::GetPeakMemoryKB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<size_t>(usage.ru_maxrss);
+}
+//----------------------------------------------------------------------------
+
+size_t mmex::GetHeapBytesInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd; // the large blocks are mapped apart
+#elif defined(__GLIBC__)
+    const struct mallinfo info = mallinfo();
+    return static_cast<unsigned int>(info.uordblks) + static_cast<unsigned int>(info.hblkhd);
+#else
+    return 0;
+#endif
+}
+//----------------------------------------------------------------------------
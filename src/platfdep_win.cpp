@@ -20,6 +20,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "platfdep.h"
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
+#include <windows.h>
+#include <psapi.h>
+#include <malloc.h>
 //----------------------------------------------------------------------------
 
 /*
@@ -71,3 +74,26 @@ const wxFileName mmex::GetResourceDir()
 
     return fname;
 }
+
+size_t mmex::GetPeakMemoryKB()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize / 1024;
+}
+//----------------------------------------------------------------------------
+
+size_t mmex::GetHeapBytesInUse()
+{
+    // walks the whole CRT heap, meant for tests and benchmarks
+    size_t bytes = 0;
+    _HEAPINFO entry;
+    entry._pentry = nullptr;
+    while (_heapwalk(&entry) == _HEAPOK)
+    {
+        if (entry._useflag == _USEDENTRY)
+            bytes += entry._size;
+    }
+    return bytes;
+}
+//----------------------------------------------------------------------------
@@ -170,66 +170,34 @@ void relocateCategoryDialog::OnOk(wxCommandEvent& WXUNUSED(event))
 
     if (wxMessageBox(_("Please Confirm:"), _("Category Relocation Confirmation"), wxOK | wxCANCEL) == wxOK)
     {
-        auto transactions = Model_Checking::instance()
-            .find(Model_Checking::CATEGID(m_sourceCatID)
-                , Model_Checking::SUBCATEGID(m_sourceSubCatID));
-        auto checking_split = Model_Splittransaction::instance()
-            .find(Model_Splittransaction::CATEGID(m_sourceCatID)
-                , Model_Splittransaction::SUBCATEGID(m_sourceSubCatID));
-        auto billsdeposits = Model_Billsdeposits::instance()
-            .find(Model_Billsdeposits::CATEGID(m_sourceCatID)
-                , Model_Billsdeposits::SUBCATEGID(m_sourceSubCatID));
-        auto budget = Model_Budget::instance()
-            .find(Model_Budget::CATEGID(m_sourceCatID)
-                , Model_Budget::SUBCATEGID(m_sourceSubCatID));
-        auto budget_split = Model_Budgetsplittransaction::instance()
-            .find(Model_Budgetsplittransaction::CATEGID(m_sourceCatID)
-                , Model_Budgetsplittransaction::SUBCATEGID(m_sourceSubCatID));
-        auto payees = Model_Payee::instance()
-            .find(Model_Payee::CATEGID(m_sourceCatID)
-                , Model_Payee::SUBCATEGID(m_sourceSubCatID));
-
-        for (auto &entry : transactions)
-        {
-            entry.CATEGID = m_destCatID;
-            entry.SUBCATEGID = m_destSubCatID;
-        }
-        m_changedRecords += Model_Checking::instance().save(transactions);
-
-        for (auto &entry : billsdeposits)
-        {
-            entry.CATEGID = m_destCatID;
-            entry.SUBCATEGID = m_destSubCatID;
-        }
-        m_changedRecords += Model_Billsdeposits::instance().save(billsdeposits);
-
-        for (auto &entry : checking_split)
-        {
-            entry.CATEGID = m_destCatID;
-            entry.SUBCATEGID = m_destSubCatID;
-        }
-        m_changedRecords += Model_Splittransaction::instance().save(checking_split);
-
-        for (auto &entry : payees)
-        {
-            entry.CATEGID = m_destCatID;
-            entry.SUBCATEGID = m_destSubCatID;
-        }
-        m_changedRecords += Model_Payee::instance().save(payees);
-        mmWebApp::MMEX_WebApp_UpdatePayee();
-
-        for (auto &entry : budget_split)
-        {
-            entry.CATEGID = m_destCatID;
-            entry.SUBCATEGID = m_destSubCatID;
-        }
-        m_changedRecords += Model_Budgetsplittransaction::instance().save(budget_split);
-
-        for (auto &entry : budget)
-        {
-            Model_Budget::instance().remove(entry.BUDGETENTRYID);
-            m_changedRecords++;
-        }
+        Model_Checking::instance().Savepoint();
+        m_changedRecords += Model_Checking::instance().update(
+            Model_Checking::assign(Model_Checking::CATEGID(m_destCatID), Model_Checking::SUBCATEGID(m_destSubCatID))
+            , Model_Checking::CATEGID(m_sourceCatID), Model_Checking::SUBCATEGID(m_sourceSubCatID));
+
+        m_changedRecords += Model_Billsdeposits::instance().update(
+            Model_Billsdeposits::assign(Model_Billsdeposits::CATEGID(m_destCatID), Model_Billsdeposits::SUBCATEGID(m_destSubCatID))
+            , Model_Billsdeposits::CATEGID(m_sourceCatID), Model_Billsdeposits::SUBCATEGID(m_sourceSubCatID));
+
+        m_changedRecords += Model_Splittransaction::instance().update(
+            Model_Splittransaction::assign(Model_Splittransaction::CATEGID(m_destCatID), Model_Splittransaction::SUBCATEGID(m_destSubCatID))
+            , Model_Splittransaction::CATEGID(m_sourceCatID), Model_Splittransaction::SUBCATEGID(m_sourceSubCatID));
+
+        const int payees = Model_Payee::instance().update(
+            Model_Payee::assign(Model_Payee::CATEGID(m_destCatID), Model_Payee::SUBCATEGID(m_destSubCatID))
+            , Model_Payee::CATEGID(m_sourceCatID), Model_Payee::SUBCATEGID(m_sourceSubCatID));
+        m_changedRecords += payees;
+
+        m_changedRecords += Model_Budgetsplittransaction::instance().update(
+            Model_Budgetsplittransaction::assign(Model_Budgetsplittransaction::CATEGID(m_destCatID), Model_Budgetsplittransaction::SUBCATEGID(m_destSubCatID))
+            , Model_Budgetsplittransaction::CATEGID(m_sourceCatID), Model_Budgetsplittransaction::SUBCATEGID(m_sourceSubCatID));
+
+        m_changedRecords += Model_Budget::instance().remove_where(
+            Model_Budget::CATEGID(m_sourceCatID), Model_Budget::SUBCATEGID(m_sourceSubCatID));
+        Model_Checking::instance().ReleaseSavepoint();
+
+        if (payees > 0)
+            mmWebApp::MMEX_WebApp_UpdatePayee();
 
         EndModal(wxID_OK);
     }
@@ -160,17 +160,14 @@ void relocatePayeeDialog::OnOk(wxCommandEvent& WXUNUSED(event))
 
     if (ans == wxOK)
     {
-        auto transactions = Model_Checking::instance().find(Model_Checking::PAYEEID(sourcePayeeID_));
-        for (auto &entry : transactions) {
-            entry.PAYEEID = destPayeeID_;
-        }
-        m_changed_records += Model_Checking::instance().save(transactions);
-
-        auto billsdeposits = Model_Billsdeposits::instance().find(Model_Billsdeposits::PAYEEID(sourcePayeeID_));
-        for (auto &entry : billsdeposits) {
-            entry.PAYEEID = destPayeeID_;
-        }
-        m_changed_records += Model_Billsdeposits::instance().save(billsdeposits);
+        Model_Checking::instance().Savepoint();
+        m_changed_records += Model_Checking::instance().update(
+            Model_Checking::assign(Model_Checking::PAYEEID(destPayeeID_))
+            , Model_Checking::PAYEEID(sourcePayeeID_));
+        m_changed_records += Model_Billsdeposits::instance().update(
+            Model_Billsdeposits::assign(Model_Billsdeposits::PAYEEID(destPayeeID_))
+            , Model_Billsdeposits::PAYEEID(sourcePayeeID_));
+        Model_Checking::instance().ReleaseSavepoint();
 
         if (cbDelete_->IsChecked())
         {
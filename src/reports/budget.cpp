@@ -18,8 +18,7 @@
  *************************************************************************/
 #include "budget.h"
 
-#include "mmex.h"
-#include "mmframe.h"
+#include "util.h"
 #include "reports/htmlbuilder.h"
 
 mmReportBudget::mmReportBudget(): mmPrintableBase("mmReportBudget")
@@ -22,8 +22,6 @@
 **************************************************************************/
 #include "budgetcategorysummary.h"
 #include "reports/htmlbuilder.h"
-#include "mmex.h"
-#include "mmframe.h"
 #include "model/Model_Budgetyear.h"
 #include "model/Model_Budget.h"
 #include "model/Model_Category.h"
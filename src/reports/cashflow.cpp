@@ -18,12 +18,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 ********************************************************/
 
 #include "cashflow.h"
-#include "mmex.h"
-#include "mmframe.h"
 #include "util.h"
 #include "reports/htmlbuilder.h"
 #include "model/Model_Account.h"
 #include "model/Model_Billsdeposits.h"
+#include "model/Model_Checking.h"
 #include "model/Model_CurrencyHistory.h"
 
 static const wxString COLORS [] = {
@@ -84,44 +83,34 @@ void mmReportCashFlow::getStats(double& tInitialBalance, std::vector<ValueTrio>&
     // We now know the total balance on the account
     // Start by walking through the recurring transaction list
 
-    const wxDateTime yearFromNow = today_.Add(wxDateSpan::Years(years));
+    typedef Model_Billsdeposits::Recurrence Recurrence;
+    const int yearFromNow = Recurrence::to_day(today_.Add(wxDateSpan::Years(years)));
     forecastVec fvec;
+    std::vector<int> days;
 
     for (const auto& entry : Model_Billsdeposits::instance().all())
     {
-        wxDateTime nextOccurDate = Model_Billsdeposits::NEXTOCCURRENCEDATE(entry);
-        if (nextOccurDate > yearFromNow) continue;
+        const Recurrence schedule(entry);
+        if (schedule.first() > yearFromNow) continue;
 
-        int repeatsType = entry.REPEATS;
-        int numRepeats = entry.NUMOCCURRENCES;
         double amt = entry.TRANSAMOUNT;
         double toAmt = entry.TOTRANSAMOUNT;
 
-        // DeMultiplex the Auto Executable fields from the db entry: REPEATS
-        repeatsType %= BD_REPEATS_MULTIPLEX_BASE;
-
-        bool processNumRepeats = numRepeats != -1 || repeatsType == 0;
-        if (repeatsType == 0)
-        {
-            numRepeats = 1;
-            processNumRepeats = true;
-        }
-
         bool isAccountFound = account_id.Index(entry.ACCOUNTID) != wxNOT_FOUND;
         bool isToAccountFound = account_id.Index(entry.TOACCOUNTID) != wxNOT_FOUND;
         if (!isAccountFound && !isToAccountFound)
             continue; // skip account
 
         // Process all possible recurring transactions for this BD
-        while (1)
+        days.clear();
+        schedule.expand(schedule.first(), yearFromNow, days);
+        for (const int day : days)
         {
-            if (nextOccurDate > yearFromNow) break;
-            if (processNumRepeats) numRepeats--;
-
             mmRepeatForecast rf;
-            rf.date = nextOccurDate;
+            rf.day = day;
             rf.amount = 0.0;
-            const double convRate = Model_CurrencyHistory::getDayRate(Model_Account::instance().get(entry.ACCOUNTID)->CURRENCYID, rf.date);
+            const wxString date = Recurrence::to_iso(day);
+            const double convRate = Model_CurrencyHistory::getDayRate(Model_Account::instance().get(entry.ACCOUNTID)->CURRENCYID, date);
 
             switch (Model_Billsdeposits::type(entry))
             {
@@ -136,7 +125,7 @@ void mmReportCashFlow::getStats(double& tInitialBalance, std::vector<ValueTrio>&
                     rf.amount -= amt * convRate;
                 if (isToAccountFound)
                 {
-                    const double toConvRate = Model_CurrencyHistory::getDayRate(Model_Account::instance().get(entry.TOACCOUNTID)->CURRENCYID, rf.date);
+                    const double toConvRate = Model_CurrencyHistory::getDayRate(Model_Account::instance().get(entry.TOACCOUNTID)->CURRENCYID, date);
                     rf.amount += toAmt * toConvRate;
                 }
                 break;
@@ -145,31 +134,7 @@ void mmReportCashFlow::getStats(double& tInitialBalance, std::vector<ValueTrio>&
             }
 
             fvec.push_back(rf);
-
-            if (processNumRepeats && (numRepeats <= 0))
-                break;
-
-            nextOccurDate = Model_Billsdeposits::nextOccurDate(repeatsType, numRepeats, nextOccurDate);
-
-            if (repeatsType == Model_Billsdeposits::REPEAT_IN_X_DAYS) // repeat in numRepeats Days (Once only)
-            {
-                if (numRepeats > 0)
-                    numRepeats = -1;
-                else
-                    break;
-            }
-            else if (repeatsType == Model_Billsdeposits::REPEAT_IN_X_MONTHS) // repeat in numRepeats Months (Once only)
-            {
-                if (numRepeats > 0)
-                    numRepeats = -1;
-                else
-                    break;
-            }
-            else if (repeatsType == Model_Billsdeposits::REPEAT_EVERY_X_DAYS) // repeat every numRepeats Days
-                numRepeats = entry.NUMOCCURRENCES;
-            else if (repeatsType == Model_Billsdeposits::REPEAT_EVERY_X_MONTHS) // repeat every numRepeats Months
-                numRepeats = entry.NUMOCCURRENCES;
-        } // end while
+        }
     } //end query
 
     const wxDateTime& dtBegin = today_;
@@ -178,9 +143,10 @@ void mmReportCashFlow::getStats(double& tInitialBalance, std::vector<ValueTrio>&
         wxDateTime dtEnd = cashFlowReportType_ == MONTHLY
             ? dtBegin.Add(wxDateSpan::Months(idx)) : dtBegin.Add(wxDateSpan::Days(idx));
 
+        const int dayBegin = Recurrence::to_day(dtBegin), dayEnd = Recurrence::to_day(dtEnd);
         for (const auto& balance : fvec)
         {
-            if (balance.date.IsBetween(dtBegin, dtEnd))
+            if (balance.day >= dayBegin && balance.day <= dayEnd)
                 forecastVector[idx].amount += balance.amount;
         }
 
@@ -40,7 +40,7 @@ protected:
 protected:
     struct mmRepeatForecast
     {
-        wxDateTime date;
+        int day;        // see Model_Billsdeposits::Recurrence
         double amount;
     };
 
@@ -34,23 +34,22 @@ mmReportForecast::~mmReportForecast()
 wxString mmReportForecast::getHTMLText()
 {
     std::map<wxString, std::pair<double, double> > amount_by_day;
-    Model_Checking::Data_Set all_trans;
-    
-    if (m_date_range && m_date_range->is_with_date()) {
-        all_trans = Model_Checking::instance().find(DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(m_date_range->start_date().FormatISODate(), GREATER_OR_EQUAL)
-            , DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(m_date_range->end_date().FormatISODate(), LESS_OR_EQUAL));
-    }
-    else {
-        all_trans = Model_Checking::instance().all();
-    }
-
-    for (const auto & trx : all_trans)
+    auto add_trx = [&amount_by_day](const Model_Checking::Data& trx)
     {
         if (Model_Checking::type(trx) == Model_Checking::TRANSFER || Model_Checking::foreignTransactionAsTransfer(trx))
-            continue;
+            return;
 
         amount_by_day[trx.TRANSDATE].first += Model_Checking::withdrawal(trx, -1);
         amount_by_day[trx.TRANSDATE].second += Model_Checking::deposit(trx, -1);
+    };
+
+    if (m_date_range && m_date_range->is_with_date()) {
+        Model_Checking::instance().for_each(add_trx
+            , DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(m_date_range->start_date().FormatISODate(), GREATER_OR_EQUAL)
+            , DB_Table_CHECKINGACCOUNT_V1::TRANSDATE(m_date_range->end_date().FormatISODate(), LESS_OR_EQUAL));
+    }
+    else {
+        Model_Checking::instance().for_each(add_trx);
     }
 
     loop_t contents;
@@ -23,6 +23,7 @@
 #include "constants.h"
 #include "model/Model_Currency.h"
 #include "model/Model_Infotable.h"
+#include "model/Model_Setting.h"
 
 namespace tags
 {
@@ -46,6 +47,7 @@ namespace tags
 <link href = 'memory:master.css' rel = 'stylesheet' />
 <script src = 'memory:ChartNew.js'></script>
 <script src = 'memory:sorttable.js'></script>
+<script src = 'memory:virtualtable.js'></script>
 <style>
     /* Sortable tables */
     table.sortable thead {cursor: default;}
@@ -68,6 +70,8 @@ namespace tags
     static const wxString THEAD_END = "</thead>\n";
     static const wxString TBODY_START = "<tbody>\n";
     static const wxString TBODY_END = "</tbody>\n";
+    static const wxString PAGED_TBODY = "<tbody id='%s' data-rows='%s' data-total='%i'></tbody>\n"
+        "<script>mmVirtualTable.attach('%s');</script>\n";
     static const wxString TFOOT_START = "<tfoot>\n";
     static const wxString TFOOT_END = "</tfoot>\n";
     static const wxString TABLE_ROW = "  <tr>\n";
@@ -107,9 +111,106 @@ namespace tags
         , "rgba(122, 179, 62, 0.7)"
         , "rgba(66, 68, 63, 0.7)"
         , "rgba(0, 102, 102, 0.7)" };
+    static const wxString CHART_POINTS_NOTE = "<p class='text-muted'><small>%s</small></p>\n";
+}
+
+namespace
+{
+    const int DEFAULT_CHART_POINTS = 500;
+    // Smaller table bodies are written into the page
+    const size_t MIN_PAGED_ROWS = 1000;
+
+    /**
+    * Largest-Triangle-Three-Buckets downsampling of a line series.
+    * Keeps the first and last point and, for every bucket in between, the
+    * point forming the largest triangle with the previously kept point and
+    * the average of the next bucket, so peaks and troughs survive.
+    */
+    const std::vector<LineGraphData> downsample_line(const std::vector<LineGraphData>& data, size_t threshold)
+    {
+        const size_t n = data.size();
+        if (threshold < 3 || n <= threshold)
+            return data;
+
+        std::vector<LineGraphData> sampled;
+        sampled.reserve(threshold);
+        sampled.push_back(data.front());
+
+        const double every = static_cast<double>(n - 2) / (threshold - 2);
+        size_t a = 0;
+        for (size_t i = 0; i < threshold - 2; i++)
+        {
+            size_t avg_start = static_cast<size_t>(floor((i + 1) * every)) + 1;
+            size_t avg_end = std::min(static_cast<size_t>(floor((i + 2) * every)) + 1, n);
+            double avg_x = 0, avg_y = 0;
+            for (size_t j = avg_start; j < avg_end; j++)
+            {
+                avg_x += j;
+                avg_y += data[j].amount;
+            }
+            const size_t avg_len = avg_end - avg_start;
+            if (avg_len > 0)
+            {
+                avg_x /= avg_len;
+                avg_y /= avg_len;
+            }
+
+            const size_t from = static_cast<size_t>(floor(i * every)) + 1;
+            const size_t to = std::min(static_cast<size_t>(floor((i + 1) * every)) + 1, n - 1);
+            double max_area = -1;
+            size_t next = from;
+            for (size_t j = from; j < to; j++)
+            {
+                const double area = fabs((a - avg_x) * (data[j].amount - data[a].amount)
+                    - (a - static_cast<double>(j)) * (avg_y - data[a].amount));
+                if (area > max_area)
+                {
+                    max_area = area;
+                    next = j;
+                }
+            }
+            sampled.push_back(data[next]);
+            a = next;
+        }
+
+        sampled.push_back(data.back());
+        return sampled;
+    }
+
+    /**
+    * Merge consecutive bar groups so that at most max_groups remain.
+    * The values of a bucket are summed per dataset and the bucket is labelled
+    * with its first and last label.
+    */
+    void downsample_bars(const wxArrayString& labels, const std::vector<BarGraphData>& data
+        , size_t max_groups, wxArrayString& out_labels, std::vector<BarGraphData>& out_data)
+    {
+        const size_t n = labels.size();
+        const size_t size = (n + max_groups - 1) / max_groups;
+
+        out_data = data;
+        for (auto& entry : out_data)
+            entry.data.clear();
+
+        for (size_t i = 0; i < n; i += size)
+        {
+            const size_t last = std::min(i + size, n) - 1;
+            out_labels.Add(last == i ? labels[i] : wxString::Format("%s - %s", labels[i], labels[last]));
+
+            for (size_t k = 0; k < data.size(); k++)
+            {
+                double sum = 0;
+                for (size_t j = i; j <= last && j < data[k].data.size(); j++)
+                    sum += data[k].data[j];
+                out_data[k].data.push_back(sum);
+            }
+        }
+    }
 }
 
 mmHTMLBuilder::mmHTMLBuilder()
+    : chart_points_(Model_Setting::instance().GetIntSetting("HTML_CHART_POINTS", DEFAULT_CHART_POINTS))
+    , row_start_(0)
 {
     today_.date = wxDateTime::Now();
     today_.todays_date = wxString::Format(_("Report Generated %s %s")
@@ -165,6 +266,13 @@ void mmHTMLBuilder::startTbody()
 {
     html_ += tags::TBODY_START;
 }
+void mmHTMLBuilder::startPagedTbody()
+{
+    if (mmReportServer::instance().collecting())
+        paged_rows_ = std::make_shared<mmReportServer::Table>();
+    else
+        startTbody();
+}
 void mmHTMLBuilder::startTfoot()
 {
     html_ += tags::TFOOT_START;
@@ -367,6 +475,29 @@ void mmHTMLBuilder::endTbody()
 {
     html_ += tags::TBODY_END;
 };
+void mmHTMLBuilder::endPagedTbody()
+{
+    if (!paged_rows_)
+    {
+        endTbody();
+        return;
+    }
+
+    std::shared_ptr<mmReportServer::Table> table;
+    table.swap(paged_rows_);
+    if (table->rows.size() < MIN_PAGED_ROWS)
+    {
+        startTbody();
+        for (const auto& row : table->rows)
+            html_ += wxString::FromUTF8(row.c_str());
+        endTbody();
+        return;
+    }
+
+    const wxString url = mmReportServer::instance().addTable(table);
+    const wxString id = "paged_" + url.AfterLast('/');
+    html_ += wxString::Format(tags::PAGED_TBODY, id, url, static_cast<int>(table->rows.size()), id);
+};
 void mmHTMLBuilder::endTfoot()
 {
     html_ += tags::TFOOT_END;
@@ -374,10 +505,12 @@ void mmHTMLBuilder::endTfoot()
 
 void mmHTMLBuilder::startTableRow()
 {
+    row_start_ = html_.length();
     html_ += tags::TABLE_ROW;
 }
 void mmHTMLBuilder::startTableRow(const wxString& color)
 {
+    row_start_ = html_.length();
     html_ += wxString::Format(tags::TABLE_ROW_BG, wxString::Format("style='background-color:%s'", color));
 }
 
@@ -389,6 +522,13 @@ void mmHTMLBuilder::startTotalTableRow()
 void mmHTMLBuilder::endTableRow()
 {
     html_ += tags::TABLE_ROW_END;
+
+    // Rows of a paged body are kept apart from the page
+    if (paged_rows_)
+    {
+        paged_rows_->rows.push_back(std::string(html_.Mid(row_start_).utf8_str()));
+        html_.Truncate(row_start_);
+    }
 }
 
 void mmHTMLBuilder::addText(const wxString& text)
@@ -532,8 +672,8 @@ void mmHTMLBuilder::addPieChart(std::vector<ValueTrio>& valueList, const wxStrin
     addText(wxString::Format(html_parts, id, x, y, x / 2, y / 2, data, id));
 }
 
-void mmHTMLBuilder::addBarChart(const wxArrayString& labels
-    , const std::vector<BarGraphData>& data, const wxString& id
+void mmHTMLBuilder::addBarChart(const wxArrayString& all_labels
+    , const std::vector<BarGraphData>& all_data, const wxString& id
     , int x, int y)
 {
     static const wxString html_parts = R"(
@@ -545,6 +685,17 @@ void mmHTMLBuilder::addBarChart(const wxArrayString& labels
 </script>
 )";
 
+    // Bars are merged into buckets before the JSON is built when the point budget is exceeded
+    const size_t datasets = std::max<size_t>(all_data.size(), 1);
+    const size_t max_groups = std::max<size_t>(chart_points_ / datasets, 1);
+    wxArrayString reduced_labels;
+    std::vector<BarGraphData> reduced_data;
+    const bool reduce = chart_points_ > 0 && all_labels.size() > max_groups;
+    if (reduce)
+        downsample_bars(all_labels, all_data, max_groups, reduced_labels, reduced_data);
+    const wxArrayString& labels = reduce ? reduced_labels : all_labels;
+    const std::vector<BarGraphData>& data = reduce ? reduced_data : all_data;
+
     int precision = Model_Currency::precision(Model_Currency::GetBaseCurrency());
 
     Document jsonDoc;
@@ -631,9 +782,11 @@ void mmHTMLBuilder::addBarChart(const wxArrayString& labels
 
     const wxString d = strbuf.GetString();
     addText(wxString::Format(html_parts, id, x, y, x, y, d, id));
+    if (reduce)
+        addChartPointsNote(all_labels.size() * datasets, labels.size() * datasets);
 }
 
-void mmHTMLBuilder::addLineChart(const std::vector<LineGraphData>& data, const wxString& id, int colorNum, int x, int y, bool pointDot, bool showGridLines, bool datasetFill)
+void mmHTMLBuilder::addLineChart(const std::vector<LineGraphData>& all_data, const wxString& id, int colorNum, int x, int y, bool pointDot, bool showGridLines, bool datasetFill)
 {
     static const wxString html_parts = R"(
 <canvas id='%s' width ='%i' height='%i'></canvas>
@@ -644,6 +797,11 @@ var reportChart = new Chart(ctx).Line(d.data, d.options);
 </script>
 )";
 
+    // The series is downsampled before the JSON is built when the point budget is exceeded
+    const bool reduce = chart_points_ > 0 && all_data.size() > static_cast<size_t>(chart_points_);
+    const std::vector<LineGraphData> data = reduce
+        ? downsample_line(all_data, std::max(chart_points_, 3)) : all_data;
+
     int precision = Model_Currency::precision(Model_Currency::GetBaseCurrency());
     int round = pow(10, precision);
 
@@ -717,6 +875,22 @@ var reportChart = new Chart(ctx).Line(d.data, d.options);
 
     const auto text = (wxString::Format(html_parts, id, x, y, d, id));
     addText(text);
+    if (reduce)
+        addChartPointsNote(all_data.size(), data.size());
+}
+
+void mmHTMLBuilder::setChartPointBudget(int points)
+{
+    chart_points_ = points;
+}
+
+void mmHTMLBuilder::addChartPointsNote(size_t original, size_t reduced)
+{
+    wxLogDebug("mmHTMLBuilder: chart reduced from %i to %i points"
+        , static_cast<int>(original), static_cast<int>(reduced));
+    addText(wxString::Format(tags::CHART_POINTS_NOTE
+        , wxString::Format(_("Chart simplified: %i of %i points shown")
+            , static_cast<int>(reduced), static_cast<int>(original))));
 }
 
 const wxString mmHTMLBuilder::getHTMLText() const
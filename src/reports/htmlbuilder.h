@@ -24,6 +24,7 @@
 #include "model/Model_Currency.h"
 #include "html_template.h"
 #include "util.h"
+#include "reportserver.h"
 
 class mmHTMLBuilder
 {
@@ -51,6 +52,11 @@ public:
     void startSortTable();
     void startThead();
     void startTbody();
+    /**
+    * Start a table body whose rows may be served page by page by the report
+    * server instead of being written into the page, see mmReportServer.
+    */
+    void startPagedTbody();
     void startTfoot();
 
     /** Add a special row that will format total values */
@@ -82,6 +88,7 @@ public:
     void endTable();
     void endThead();
     void endTbody();
+    void endPagedTbody();
     void endTfoot();
     void addDivContainer();
     void addDivRow();
@@ -117,8 +124,21 @@ public:
     void addLineChart(const std::vector<LineGraphData>& data, const wxString& id, const int index, const int x = 640, const int y = 256, bool pointDot = false, bool showGridLines = true, bool datasetFill = false);
     void addBarChart(const wxArrayString& labels, const std::vector<BarGraphData>& data, const wxString& id, int x = 192, int y = 256);
 
+    /**
+    * Maximum number of points sent to a line or bar chart, 0 for no limit.
+    * Longer line series are reduced with LTTB, bars are merged into buckets.
+    * Defaults to the HTML_CHART_POINTS setting.
+    */
+    void setChartPointBudget(int points);
+
+private:
+    void addChartPointsNote(size_t original, size_t reduced);
+
 private:
     wxString html_;
+    int chart_points_;
+    std::shared_ptr<mmReportServer::Table> paged_rows_;
+    size_t row_start_;
     struct today_
     {
         wxDateTime date;
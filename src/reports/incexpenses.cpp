@@ -51,7 +51,7 @@ wxString mmReportIncomeExpenses::getHTMLText()
     hb.addDateNow();
 
     std::pair<double, double> income_expenses_pair;
-    for (const auto& transaction : Model_Checking::instance().find(
+    for (const auto& transaction : Model_Checking::instance().find_arena(
         Model_Checking::TRANSDATE(m_date_range->start_date(), GREATER_OR_EQUAL)
         , Model_Checking::TRANSDATE(m_date_range->end_date(), LESS_OR_EQUAL)
         , Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL)))
@@ -157,7 +157,7 @@ wxString mmReportIncomeExpensesMonthly::getHTMLText()
 
     std::map<int, std::pair<double, double> > incomeExpensesStats;
     //TODO: init all the map values with 0.0
-    for (const auto& transaction : Model_Checking::instance().find(
+    for (const auto& transaction : Model_Checking::instance().find_arena(
         Model_Checking::TRANSDATE(m_date_range->start_date(), GREATER_OR_EQUAL)
         , Model_Checking::TRANSDATE(m_date_range->end_date(), LESS_OR_EQUAL)
         , Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL)))
@@ -156,11 +156,14 @@ void mmReportPayeeExpenses::getPayeeStats(std::map<int, std::pair<double, double
                                           , mmDateRange* date_range, bool WXUNUSED(ignoreFuture)) const
 {
 // FIXME: do not ignore ignoreFuture param
-    const auto &transactions = Model_Checking::instance().find(
+    const auto &transactions = Model_Checking::instance().find_arena(
         Model_Checking::STATUS(Model_Checking::VOID_, NOT_EQUAL)
         , Model_Checking::TRANSDATE(date_range->start_date(), GREATER_OR_EQUAL)
         , Model_Checking::TRANSDATE(date_range->end_date(), LESS_OR_EQUAL));
-    const auto all_splits = Model_Splittransaction::instance().get_all();
+    const std::vector<wxVariant> params = { wxVariant(date_range->start_date().FormatISODate())
+        , wxVariant(date_range->end_date().FormatISODate()) };
+    const auto all_splits = Model_Splittransaction::instance().get_all("TRANSDATE >= ? AND TRANSDATE <= ?", params);
+    const Model_Splittransaction::Data_Set no_splits;
     for (const auto& trx: transactions)
     {
         if (Model_Checking::type(trx) == Model_Checking::TRANSFER) continue;
@@ -171,8 +174,8 @@ void mmReportPayeeExpenses::getPayeeStats(std::map<int, std::pair<double, double
 
         const double convRate = Model_CurrencyHistory::getDayRate(Model_Account::instance().get(trx.ACCOUNTID)->CURRENCYID, trx.TRANSDATE);
 
-        Model_Splittransaction::Data_Set splits;
-        if (all_splits.count(trx.id())) splits = all_splits.at(trx.id());
+        const auto it = all_splits.find(trx.id());
+        const Model_Splittransaction::Data_Set& splits = it != all_splits.end() ? it->second : no_splits;
         if (splits.empty())
         {
             if (Model_Checking::type(trx) == Model_Checking::DEPOSIT)
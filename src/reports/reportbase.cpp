@@ -19,8 +19,6 @@
 
 #include "reportbase.h"
 #include "constants.h"
-#include "mmex.h"
-#include "mmSimpleDialogs.h"
 #include "mmDateRange.h"
 #include "model/Model_Account.h"
 #include "util.h"
@@ -207,27 +205,8 @@ void mmPrintableBase::setAccounts(int selection, const wxString& name)
         {
         case 0: // All Accounts
             break;
-        case 1: // Select Accounts
-        {
-            wxArrayString* accountSelections = new wxArrayString();
-            Model_Account::Data_Set accounts =
-                (m_only_active ? Model_Account::instance().find(Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL)
-                    , Model_Account::STATUS(Model_Account::OPEN))
-                    : Model_Account::instance().find(Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL)));
-            std::stable_sort(accounts.begin(), accounts.end(), SorterByACCOUNTNAME());
-
-            mmMultiChoiceDialog mcd(0, _("Choose Accounts"), m_title, accounts);
-
-            if (mcd.ShowModal() == wxID_OK)
-            {
-                for (const auto &i : mcd.GetSelections()) {
-                    accountSelections->Add(accounts.at(i).ACCOUNTNAME);
-                }
-            }
-
-            accountArray_ = accountSelections;
-        }
-        break;
+        case 1: // Select Accounts, the report panel asks for them
+            break;
         default: // All of Account type
         {
             wxArrayString* accountSelections = new wxArrayString();
@@ -242,6 +221,23 @@ void mmPrintableBase::setAccounts(int selection, const wxString& name)
     }
 }
 
+const Model_Account::Data_Set mmPrintableBase::selectableAccounts() const
+{
+    Model_Account::Data_Set accounts =
+        (m_only_active ? Model_Account::instance().find(Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL)
+            , Model_Account::STATUS(Model_Account::OPEN))
+            : Model_Account::instance().find(Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL)));
+    std::stable_sort(accounts.begin(), accounts.end(), SorterByACCOUNTNAME());
+    return accounts;
+}
+
+void mmPrintableBase::setSelectedAccounts(const wxArrayString& names)
+{
+    if (accountArray_)
+        delete accountArray_;
+    accountArray_ = new wxArrayString(names);
+}
+
 //----------------------------------------------------------------------
 
 mmGeneralReport::mmGeneralReport(const Model_Report::Data* report)
@@ -254,6 +250,16 @@ wxString mmGeneralReport::getHTMLText()
 {
     wxString out;
     int error = Model_Report::instance().get_html(this->m_report, out);
+    return getResultHTML(error, out);
+}
+
+const Model_Report::Job mmGeneralReport::prepare() const
+{
+    return Model_Report::prepare(this->m_report);
+}
+
+wxString mmGeneralReport::getResultHTML(int error, const wxString& out)
+{
     if (error != 0) {
         const char* error_template = R"(
 <!DOCTYPE html>
@@ -285,7 +291,7 @@ wxString mmGeneralReport::getHTMLText()
 )";
         wxString html = error_template;
         html.Replace("<TMPL_VAR ERROR>", out);
-        out.swap(html);
+        return html;
     }
 
     return out;
@@ -349,20 +355,36 @@ void mmPrintableBaseSpecificAccounts::getSpecificAccounts()
     accountArray_ = selections;
 }
 
-mm_html_template::mm_html_template(const wxString& arg_template): html_template(arg_template.ToStdWstring())
+mm_html_template::mm_html_template(const wxString& arg_template, wxSQLite3Database* db): html_template(arg_template.ToStdWstring())
 {
-    this->load_context();
+    this->load_context(db);
 }
 
-void mm_html_template::load_context()
+void mm_html_template::load_context(wxSQLite3Database* db)
 {
     (*this)(L"TODAY") = wxDate::Now().FormatISODate();
-    for (const auto &r: Model_Infotable::instance().all())
+    if (!db)
+    {
+        for (const auto &r: Model_Infotable::instance().all())
+            (*this)(r.INFONAME.ToStdWstring()) = r.INFOVALUE;
+        (*this)(L"INFOTABLE") = Model_Infotable::to_loop_t();
+
+        const Model_Currency::Data* currency = Model_Currency::GetBaseCurrency();
+        if (currency) currency->to_template(*this);
+        return;
+    }
+
+    // a reader in a worker thread, the model caches belong to the GUI thread
+    loop_t infotable;
+    for (const auto &r: Model_Infotable::instance().all_on(db))
+    {
         (*this)(r.INFONAME.ToStdWstring()) = r.INFOVALUE;
-    (*this)(L"INFOTABLE") = Model_Infotable::to_loop_t();
+        infotable += r.to_row_t();
+    }
+    (*this)(L"INFOTABLE") = infotable;
 
-    const Model_Currency::Data* currency = Model_Currency::GetBaseCurrency();
-    if (currency) currency->to_template(*this);
+    const auto currency = Model_Currency::instance().find_on(db, Model_Currency::CURRENCYID(Option::instance().getBaseCurrencyID()));
+    if (!currency.empty()) currency[0].to_template(*this);
 }
 
 const wxString mmPrintableBase::getReportTitle() const
@@ -22,6 +22,7 @@
 //----------------------------------------------------------------------------
 #include "mmDateRange.h"
 #include "option.h"
+#include "model/Model_Account.h"
 #include "model/Model_Report.h"
 class wxString;
 class wxArrayString;
@@ -46,6 +47,10 @@ public:
     const wxString getAccountNames() const;
     void chart(int selection);
     void setAccounts(int selection, const wxString& name);
+    /** The accounts offered by "Select Accounts", sorted by name */
+    const Model_Account::Data_Set selectableAccounts() const;
+    /** Keep the accounts picked from selectableAccounts() */
+    void setSelectedAccounts(const wxArrayString& names);
     void setSelection(int sel);
     void setReportSettings();
     void setReportParameters(int id);
@@ -124,6 +129,10 @@ public:
 public:
     wxString getHTMLText();
     virtual int report_parameters();
+    /** The report for Model_Report::run, e.g. on a worker thread */
+    const Model_Report::Job prepare() const;
+    /** The page of a finished run, an error page if it failed */
+    static wxString getResultHTML(int error, const wxString& out);
 
 private:
     const Model_Report::Data* m_report;
@@ -144,10 +153,11 @@ protected:
 class mm_html_template: public html_template
 {
 public:
-    explicit mm_html_template(const wxString & arg_template);
+    /** The context comes from the models, or from db if it is given */
+    explicit mm_html_template(const wxString & arg_template, wxSQLite3Database* db = nullptr);
 
 private:
-    void load_context();
+    void load_context(wxSQLite3Database* db);
 };
 
 //----------------------------------------------------------------------------
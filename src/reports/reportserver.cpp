@@ -0,0 +1,420 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "reportserver.h"
+#include "platfdep.h"
+#include "singleton.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <wx/file.h>
+#include <wx/log.h>
+#include <wx/socket.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace
+{
+    const size_t MAX_REQUEST = 16 * 1024;
+    const size_t MAX_PAGE_ROWS = 1000;
+
+    const std::string query_value(const std::string& query, const std::string& key)
+    {
+        size_t pos = 0;
+        while (pos < query.size())
+        {
+            size_t end = query.find('&', pos);
+            if (end == std::string::npos) end = query.size();
+            const std::string pair = query.substr(pos, end - pos);
+            const size_t eq = pair.find('=');
+            if (eq != std::string::npos && pair.compare(0, eq, key) == 0)
+                return pair.substr(eq + 1);
+            pos = end + 1;
+        }
+        return "";
+    }
+
+    long query_number(const std::string& query, const std::string& key, long def)
+    {
+        const std::string value = query_value(query, key);
+        return value.empty() ? def : std::strtol(value.c_str(), nullptr, 10);
+    }
+
+    /** The sort key of each cell of a row: sorttable_customkey if given, else the text */
+    void cell_keys(const std::string& row, std::vector<std::string>& keys)
+    {
+        keys.clear();
+        size_t pos = row.find("<td");
+        while (pos != std::string::npos)
+        {
+            const size_t open_end = row.find('>', pos);
+            if (open_end == std::string::npos) break;
+            size_t end = row.find("</td>", open_end);
+            if (end == std::string::npos) end = row.size();
+
+            std::string key;
+            const std::string attrs = row.substr(pos, open_end - pos);
+            const size_t custom = attrs.find("sorttable_customkey");
+            const size_t quote = custom == std::string::npos ? custom : attrs.find('\'', custom);
+            if (quote != std::string::npos)
+            {
+                key = attrs.substr(quote + 1, attrs.find('\'', quote + 1) - quote - 1);
+            }
+            else
+            {
+                bool in_tag = false;
+                for (size_t i = open_end + 1; i < end; i++)
+                {
+                    const char c = row[i];
+                    if (c == '<') in_tag = true;
+                    else if (c == '>') in_tag = false;
+                    else if (!in_tag) key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                }
+            }
+            keys.push_back(key);
+            pos = row.find("<td", end);
+        }
+    }
+
+    const char* mime_type(const std::string& file)
+    {
+        const size_t dot = file.rfind('.');
+        const std::string ext = dot == std::string::npos ? "" : file.substr(dot + 1);
+        if (ext == "css") return "text/css";
+        if (ext == "js") return "application/javascript";
+        if (ext == "png") return "image/png";
+        if (ext == "htm" || ext == "html" || ext == "htt") return "text/html; charset=utf-8";
+        return "application/octet-stream";
+    }
+}
+
+class mmReportServer::Worker : public wxThread
+{
+public:
+    explicit Worker(mmReportServer& server)
+        : wxThread(wxTHREAD_JOINABLE), m_server(server) {}
+
+protected:
+    virtual ExitCode Entry()
+    {
+        while (!TestDestroy())
+        {
+            if (!m_server.m_socket->WaitForAccept(0, 200)) continue;
+
+            wxSocketBase* socket = m_server.m_socket->Accept(false);
+            if (!socket) continue;
+            m_server.serve(*socket);
+            socket->Destroy();
+        }
+        return 0;
+    }
+
+private:
+    mmReportServer& m_server;
+};
+
+const std::vector<size_t>& mmReportServer::Table::order(size_t column, bool desc)
+{
+    const auto key = std::make_pair(column, desc);
+    auto it = m_orders.find(key);
+    if (it != m_orders.end()) return it->second;
+
+    std::vector<std::string> text(rows.size());
+    std::vector<double> numbers(rows.size());
+    bool numeric = true;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        cell_keys(rows[i], keys);
+        text[i] = column < keys.size() ? keys[column] : "";
+        char* end = nullptr;
+        numbers[i] = std::strtod(text[i].c_str(), &end);
+        if (!text[i].empty() && (end == text[i].c_str() || *end != '\0'))
+            numeric = false;
+    }
+
+    std::vector<size_t> order(rows.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+        if (desc) std::swap(a, b);
+        return numeric ? numbers[a] < numbers[b] : text[a] < text[b];
+    });
+
+    return m_orders[key] = order;
+}
+
+mmReportServer::mmReportServer()
+    : m_worker(nullptr)
+    , m_socket(nullptr)
+    , m_failed(false)
+    , m_port(0)
+    , m_next_table(0)
+{
+}
+
+mmReportServer::~mmReportServer()
+{
+    stop();
+}
+
+mmReportServer& mmReportServer::instance()
+{
+    return Singleton<mmReportServer>::instance();
+}
+
+bool mmReportServer::start()
+{
+    if (m_worker) return true;
+    if (m_failed) return false;
+
+    wxSocketBase::Initialize();
+    wxIPV4address address;
+    address.Hostname("127.0.0.1");
+    address.Service(0);
+    m_socket = new wxSocketServer(address, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+    wxIPV4address local;
+    if (!m_socket->IsOk() || !m_socket->GetLocal(local))
+    {
+        wxLogDebug("mmReportServer: cannot listen on the loopback interface");
+        m_socket->Destroy();
+        m_socket = nullptr;
+        m_failed = true;
+        return false;
+    }
+    m_port = local.Service();
+
+    std::random_device random;
+    const char hex[] = "0123456789abcdef";
+    m_token.clear();
+    for (int i = 0; i < 32; i++)
+        m_token += hex[random() % 16];
+
+    m_worker = new Worker(*this);
+    if (m_worker->Run() != wxTHREAD_NO_ERROR)
+    {
+        delete m_worker;
+        m_worker = nullptr;
+        m_socket->Destroy();
+        m_socket = nullptr;
+        m_failed = true;
+        return false;
+    }
+    wxLogDebug("mmReportServer: listening on 127.0.0.1:%i", m_port);
+    return true;
+}
+
+void mmReportServer::stop()
+{
+    if (m_worker)
+    {
+        m_worker->Delete();
+        delete m_worker;
+        m_worker = nullptr;
+    }
+    if (m_socket)
+    {
+        m_socket->Destroy();
+        m_socket = nullptr;
+    }
+
+    wxCriticalSectionLocker lock(m_lock);
+    m_pages.clear();
+    m_tables.clear();
+}
+
+bool mmReportServer::beginPage(const wxString& name)
+{
+    if (!start()) return false;
+    drop(name);
+    m_collecting = name;
+    m_pending.clear();
+    return true;
+}
+
+bool mmReportServer::collecting() const
+{
+    return !m_collecting.empty();
+}
+
+const wxString mmReportServer::addTable(std::shared_ptr<Table> table)
+{
+    const int id = ++m_next_table;
+    m_pending.push_back(id);
+
+    wxCriticalSectionLocker lock(m_lock);
+    m_tables[id] = table;
+    return wxString::Format("rows/%i", id);
+}
+
+const wxString mmReportServer::endPage(const wxString& name, const wxString& html)
+{
+    if (m_collecting != name) return "";
+    m_collecting.clear();
+
+    // Resources referenced as memory:file are served from the resource folder
+    wxString text = html;
+    text.Replace("memory:", "res/");
+
+    Page page;
+    page.html = std::string(text.utf8_str());
+    page.tables.swap(m_pending);
+
+    const std::string key(name.utf8_str());
+    {
+        wxCriticalSectionLocker lock(m_lock);
+        m_pages[key] = page;
+    }
+
+    // A changing query string keeps the web view from reusing the previous page
+    return wxString::Format("http://127.0.0.1:%i/%s/%s.htm?%i"
+        , m_port, m_token, name, m_next_table);
+}
+
+void mmReportServer::drop(const wxString& name)
+{
+    wxCriticalSectionLocker lock(m_lock);
+    const auto it = m_pages.find(std::string(name.utf8_str()));
+    if (it == m_pages.end()) return;
+
+    for (int id : it->second.tables)
+        m_tables.erase(id);
+    m_pages.erase(it);
+}
+
+void mmReportServer::serve(wxSocketBase& socket)
+{
+    socket.SetFlags(wxSOCKET_BLOCK);
+    socket.SetTimeout(5);
+
+    std::string request;
+    char buffer[4096];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST)
+    {
+        socket.Read(buffer, sizeof(buffer));
+        const size_t count = socket.LastReadCount();
+        if (socket.Error() || count == 0) break;
+        request.append(buffer, count);
+    }
+
+    // Only "GET <path>[?query] HTTP/1.x" requests are answered
+    std::string type, body;
+    const size_t path_start = request.compare(0, 4, "GET ") == 0 ? 4 : std::string::npos;
+    const size_t path_end = path_start == std::string::npos ? path_start : request.find(' ', path_start);
+    if (path_end != std::string::npos)
+    {
+        std::string path = request.substr(path_start, path_end - path_start), query;
+        const size_t q = path.find('?');
+        if (q != std::string::npos)
+        {
+            query = path.substr(q + 1);
+            path.erase(q);
+        }
+        body = respond(path, query, type);
+    }
+
+    const std::string status = type.empty() ? "404 Not Found" : "200 OK";
+    if (type.empty()) type = "text/plain";
+    const std::string header = "HTTP/1.1 " + status
+        + "\r\nContent-Type: " + type
+        + "\r\nContent-Length: " + std::to_string(body.size())
+        + "\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n";
+
+    socket.SetFlags(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+    socket.Write(header.data(), header.size());
+    if (!socket.Error() && !body.empty())
+        socket.Write(body.data(), body.size());
+    socket.Close();
+}
+
+const std::string mmReportServer::respond(const std::string& path, const std::string& query, std::string& type)
+{
+    const std::string prefix = "/" + m_token + "/";
+    if (path.compare(0, prefix.size(), prefix) != 0) return "";
+    const std::string item = path.substr(prefix.size());
+
+    if (item.compare(0, 5, "rows/") == 0)
+    {
+        type = "application/json";
+        return rows(std::atoi(item.c_str() + 5), query);
+    }
+
+    if (item.compare(0, 4, "res/") == 0)
+    {
+        const std::string file = item.substr(4);
+        if (file.empty() || file.find_first_of("/\\") != std::string::npos || file.find("..") != std::string::npos)
+            return "";
+
+        wxFile f(mmex::GetResourceDir().GetPathWithSep() + wxString::FromUTF8(file.c_str()));
+        if (!f.IsOpened()) return "";
+        std::string data(static_cast<size_t>(f.Length()), '\0');
+        if (!data.empty() && f.Read(&data[0], data.size()) != static_cast<ssize_t>(data.size()))
+            return "";
+        type = mime_type(file);
+        return data;
+    }
+
+    const size_t ext = item.rfind(".htm");
+    if (ext == std::string::npos) return "";
+
+    wxCriticalSectionLocker lock(m_lock);
+    const auto it = m_pages.find(item.substr(0, ext));
+    if (it == m_pages.end()) return "";
+    type = mime_type(item);
+    return it->second.html;
+}
+
+const std::string mmReportServer::rows(int table_id, const std::string& query)
+{
+    std::shared_ptr<Table> table;
+    {
+        wxCriticalSectionLocker lock(m_lock);
+        const auto it = m_tables.find(table_id);
+        if (it != m_tables.end()) table = it->second;
+    }
+    const size_t total = table ? table->rows.size() : 0;
+
+    const size_t offset = std::min(static_cast<size_t>(std::max(query_number(query, "offset", 0), 0L)), total);
+    const size_t limit = std::min(static_cast<size_t>(std::max(query_number(query, "limit", 100), 0L)), MAX_PAGE_ROWS);
+    const long sort = query_number(query, "sort", -1);
+    const bool desc = query_number(query, "desc", 0) != 0;
+
+    // The sort orders are only built and read here, in the server thread
+    const std::vector<size_t>* order = table && sort >= 0
+        ? &table->order(static_cast<size_t>(sort), desc) : nullptr;
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("total");
+    writer.Uint(static_cast<unsigned>(total));
+    writer.Key("offset");
+    writer.Uint(static_cast<unsigned>(offset));
+    writer.Key("rows");
+    writer.StartArray();
+    for (size_t i = offset; i < total && i < offset + limit; i++)
+    {
+        const std::string& row = table->rows[order ? (*order)[i] : i];
+        writer.String(row.c_str(), static_cast<rapidjson::SizeType>(row.size()));
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
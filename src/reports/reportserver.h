@@ -0,0 +1,110 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_REPORTSERVER_H_
+#define MM_EX_REPORTSERVER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+#include <wx/thread.h>
+
+class wxSocketBase;
+class wxSocketServer;
+
+/**
+* HTTP server on the loopback interface serving the report pages.
+* Large tables are not written into the page: their rows are kept here and
+* the page fetches them page by page from a JSON endpoint, so the web view
+* only ever holds the rows on screen (see virtualtable.js).
+*
+* All URLs start with a random token and the server only listens on
+* 127.0.0.1. Pages and tables are created in the GUI thread and only read by
+* the server thread, the rows are stored as UTF-8 and never change.
+*/
+class mmReportServer
+{
+public:
+    /** Rows of a table body, each one the HTML of a <tr> element */
+    struct Table
+    {
+        std::vector<std::string> rows;
+
+        /** Row order when sorted by a column, built on first request */
+        const std::vector<size_t>& order(size_t column, bool desc);
+
+    private:
+        std::map<std::pair<size_t, bool>, std::vector<size_t> > m_orders;
+    };
+
+public:
+    mmReportServer();
+    ~mmReportServer();
+    static mmReportServer& instance();
+
+    /**
+    * Start collecting the tables of page name, the previous tables of the
+    * page are dropped. Returns false if the server cannot run, the tables
+    * are then written into the page as usual.
+    */
+    bool beginPage(const wxString& name);
+    /** Publish the page built since beginPage(), return its URL or an empty string */
+    const wxString endPage(const wxString& name, const wxString& html);
+    /** True between beginPage() and endPage() */
+    bool collecting() const;
+
+    /** Keep the rows of a table of the current page, return the URL of its rows relative to the page */
+    const wxString addTable(std::shared_ptr<Table> table);
+
+    /** Forget the page and its tables */
+    void drop(const wxString& name);
+    void stop();
+
+private:
+    class Worker;
+    friend class Worker;
+
+    struct Page
+    {
+        std::string html;
+        std::vector<int> tables;
+    };
+
+    bool start();
+    void serve(wxSocketBase& socket);
+    const std::string respond(const std::string& path, const std::string& query, std::string& type);
+    const std::string rows(int table_id, const std::string& query);
+
+private:
+    wxCriticalSection m_lock;
+    Worker* m_worker;
+    wxSocketServer* m_socket;
+    bool m_failed;
+    unsigned short m_port;
+    std::string m_token;
+
+    wxString m_collecting;
+    std::vector<int> m_pending;
+    int m_next_table;
+    std::map<std::string, Page> m_pages;
+    std::map<int, std::shared_ptr<Table> > m_tables;
+};
+
+#endif // MM_EX_REPORTSERVER_H_
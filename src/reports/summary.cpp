@@ -134,6 +134,8 @@ wxString mmReportSummaryByDate::getHTMLText()
     std::vector<double> arBalance(balanceMapVec.size());
     std::vector<wxString>   totBalanceData;
     std::vector<wxDate> arDates;
+    const wxString today = wxDate::Today().FormatISODate();
+    const wxString currentMonth = Model_MonthlyBalance::MONTH(wxDate::Today());
 
     hb.init();
     hb.addDivContainer();
@@ -164,17 +166,45 @@ wxString mmReportSummaryByDate::getHTMLText()
         {
             // balanceMapVec contains transactions totals day by day
             const Model_Currency::Data* currency = Model_Account::currency(account);
-            for (const auto& tran : Model_Account::transaction(account))
+            wxDate first;
+            if (!Option::instance().getCurrencyHistoryEnabled() || currency->id() == Model_Currency::GetBaseCurrency()->CURRENCYID)
             {
-                balanceMapVec[i][Model_Checking::TRANSDATE(tran)]
-                    += Model_Checking::balance(tran, account.ACCOUNTID)
-                    * Model_CurrencyHistory::getDayRate(currency->id(), tran.TRANSDATE);
+                // constant rate: the months before the current one come from the month-end table,
+                // each as one total on its last day, the current month and later from the ledger
+                const double rate = Model_CurrencyHistory::getDayRate(currency->id(), today);
+                for (const auto& month : Model_MonthlyBalance::instance().months(account.ACCOUNTID))
+                {
+                    if (!first.IsValid())
+                        first = Model_MonthlyBalance::MONTH_START(month);
+                    if (month.MONTH >= currentMonth)
+                        break;
+                    balanceMapVec[i][Model_MonthlyBalance::MONTH_END(month)] += (month.INFLOW - month.OUTFLOW) * rate;
+                }
+                std::vector<wxVariant> params;
+                params.push_back(static_cast<long>(account.ACCOUNTID));
+                params.push_back(static_cast<long>(account.ACCOUNTID));
+                params.push_back(currentMonth + "-01");
+                for (const auto& tran : Model_Checking::instance().find_where_arena("(ACCOUNTID = ? OR TOACCOUNTID = ?) AND TRANSDATE >= ?", params))
+                {
+                    balanceMapVec[i][Model_Checking::TRANSDATE(tran)]
+                        += Model_Checking::balance(tran, account.ACCOUNTID) * rate;
+                }
+            }
+            else
+            {
+                for (const auto& tran : Model_Account::transaction(account))
+                {
+                    balanceMapVec[i][Model_Checking::TRANSDATE(tran)]
+                        += Model_Checking::balance(tran, account.ACCOUNTID)
+                        * Model_CurrencyHistory::getDayRate(currency->id(), tran.TRANSDATE);
+                }
             }
-            if (Model_Account::type(account) != Model_Account::TERM && balanceMapVec[i].size())
+            if (!first.IsValid() && balanceMapVec[i].size())
+                first = balanceMapVec[i].begin()->first;
+            if (Model_Account::type(account) != Model_Account::TERM && first.IsValid())
             {
-                date = balanceMapVec[i].begin()->first;
-                if (date.IsEarlierThan(dateStart))
-                    dateStart = date;
+                if (first.IsEarlierThan(dateStart))
+                    dateStart = first;
             }
             arBalance[i] = account.INITIALBAL * Model_CurrencyHistory::getDayRate(currency->id(), dateStart);
         }
@@ -21,7 +21,6 @@
 
 #include "reportbase.h"
 #include <vector>
-#include "mmex.h"
 #include "model/Model.h"
 #include "model/Model_Account.h"
 
@@ -20,13 +20,13 @@
 #include "reports/htmlbuilder.h"
 
 #include "constants.h"
-#include "stockspanel.h"
 #include "budget.h"
 #include "util.h"
 #include "reports/mmDateRange.h"
 #include "model/Model_Account.h"
 #include "model/Model_Currency.h"
 #include "model/Model_CurrencyHistory.h"
+#include "model/Model_Stock.h"
 #include "model/Model_StockHistory.h"
 
 #include <algorithm>
@@ -78,7 +78,7 @@ wxString mmReportTransactions::getHTMLText()
     hb.endTableRow();
     hb.endThead();
 
-    hb.startTbody();
+    hb.startPagedTbody();
 
     std::map<int, double> total; //Store transaction amount with original currency
     std::map<int, double> total_in_base_curr; //Store transactions amount daily converted to base currency
@@ -144,7 +144,7 @@ wxString mmReportTransactions::getHTMLText()
         }
         hb.endTableRow();
     }
-    hb.endTbody();
+    hb.endPagedTbody();
 
     hb.startTfoot();
     // display the total balance.
@@ -176,10 +176,13 @@ wxString mmReportTransactions::getHTMLText()
 void mmReportTransactions::Run(mmFilterTransactionsDialog* dlg)
 {
     trans_.clear();
-    const auto splits = Model_Splittransaction::instance().get_all();
-    for (const auto& tran : Model_Checking::instance().all()) //TODO: find should be faster
+    // the splits of the transactions the filter reads
+    std::vector<wxVariant> params;
+    bool exact = true;
+    const wxString where = dlg->getSqlCondition(m_refAccountID, params, exact);
+    const auto splits = Model_Splittransaction::instance().get_all(where, params);
+    for (const auto& tran : dlg->findMatching(m_refAccountID))
     {
-        if (!dlg->checkAll(tran, m_refAccountID, splits)) continue;
         Model_Checking::Full_Data full_tran(tran, splits);
         full_tran.PAYEENAME = full_tran.real_payee_name(m_refAccountID);
         if (m_transDialog->getCategoryCheckBox() && full_tran.has_split()) 
@@ -36,6 +36,7 @@
 #include "model/Model_Account.h"
 #include "model/Model_Attachment.h"
 #include "model/Model_Category.h"
+#include "model/Model_Completion.h"
 #include "model/Model_CurrencyHistory.h"
 #include "model/Model_CustomFieldData.h"
 #include "model/Model_Subcategory.h"
@@ -302,22 +303,19 @@ void mmTransDialog::dataToControls()
                 m_trx_data.TOACCOUNTID = -1;
             }
 
-            wxArrayString all_payees = Model_Payee::instance().all_payee_names();
+            const wxArrayString& all_payees = Model_Completion::instance().payee_names();
             if (!all_payees.empty()) {
                 cbPayee_->Insert(all_payees, 0);
-                cbPayee_->AutoComplete(all_payees);
+                cbPayee_->AutoComplete(new Model_Completion::PayeeCompleter());
             }
 
             if (m_new_trx && !m_duplicate && Option::instance().TransPayeeSelection() == Option::LASTUSED)
             {
                 Model_Account::Data* account = Model_Account::instance().get(cbAccount_->GetValue());
-                Model_Checking::Data_Set transactions = Model_Checking::instance().find(
-                    Model_Checking::TRANSCODE(Model_Checking::TRANSFER, NOT_EQUAL)
-                    , Model_Checking::ACCOUNTID(account->ACCOUNTID, EQUAL)
-                    , Model_Checking::TRANSDATE(wxDateTime::Today(), LESS_OR_EQUAL));
-
-                if (!transactions.empty()) {
-                    Model_Payee::Data* payee = Model_Payee::instance().get(transactions.back().PAYEEID);
+                Model_Payee::Data* payee = account
+                    ? Model_Payee::instance().get(Model_Completion::instance().last_payee(account->ACCOUNTID))
+                    : nullptr;
+                if (payee) {
                     cbPayee_->ChangeValue(payee->PAYEENAME);
                 }
             }
@@ -27,14 +27,16 @@
 #include "constants.h"
 #include "platfdep.h"
 #include "paths.h"
-#include "validators.h"
 #include "model/Model_Currency.h"
 #include "model/Model_Infotable.h"
 #include "model/Model_Setting.h"
 #include "model/Model_CurrencyHistory.h"
 #include <wx/sstream.h>
 #include <wx/xml/xml.h>
+#include <algorithm>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <lua.hpp>
 #include <wx/fs_mem.h>
 
@@ -496,13 +498,6 @@ void windowsFreezeThaw(wxWindow* w)
 
 //--------------------------------------------------------------------
 
-IMPLEMENT_DYNAMIC_CLASS(mmCalcValidator, wxTextValidator)
-BEGIN_EVENT_TABLE(mmCalcValidator, wxTextValidator)
-EVT_CHAR(mmCalcValidator::OnChar)
-END_EVENT_TABLE()
-
-//--------------------------------------------------------------------
-
 bool getOnlineCurrencyRates(wxString& msg, int curr_id, bool used_only)
 {
     wxString base_currency_symbol;
@@ -774,23 +769,31 @@ static int log_libcurl_debug(CURL *handle, curl_infotype type, char *data, size_
 }
 #endif
 
-void curl_set_common_options(CURL* curl, const wxString& useragent = wxEmptyString) {
-    wxString proxyName = Model_Setting::instance().GetStringSetting("PROXYIP", "");
+const http_options http_current_options(const wxString& useragent)
+{
+    http_options options;
+    const wxString proxyName = Model_Setting::instance().GetStringSetting("PROXYIP", "");
     if (!proxyName.IsEmpty())
     {
         int proxyPort = Model_Setting::instance().GetIntSetting("PROXYPORT", 0);
-        const wxString& proxySettings = wxString::Format("%s:%d", proxyName, proxyPort);
-        curl_easy_setopt(curl, CURLOPT_PROXY, static_cast<const char*>(proxySettings.mb_str()));
+        options.proxy = wxString::Format("%s:%d", proxyName, proxyPort);
     }
 
-    int networkTimeout = Model_Setting::instance().GetIntSetting("NETWORKTIMEOUT", 10); // default 10 secs
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, networkTimeout);
+    options.timeout = Model_Setting::instance().GetIntSetting("NETWORKTIMEOUT", 10); // default 10 secs
 
     if (useragent.IsEmpty())
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, static_cast<const char*>(wxString::Format("%s/%s", mmex::getProgramName(), mmex::version::string).mb_str()));
+        options.useragent = wxString::Format("%s/%s", mmex::getProgramName(), mmex::version::string);
     else
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, static_cast<const char*>(useragent.mb_str()));
+        options.useragent = useragent;
+    return options;
+}
+
+void curl_set_common_options(CURL* curl, const http_options& options) {
+    if (!options.proxy.IsEmpty())
+        curl_easy_setopt(curl, CURLOPT_PROXY, static_cast<const char*>(options.proxy.mb_str()));
 
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, options.timeout);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, static_cast<const char*>(options.useragent.mb_str()));
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
 
 #ifdef _DEBUG
@@ -799,6 +802,10 @@ void curl_set_common_options(CURL* curl, const wxString& useragent = wxEmptyStri
 #endif
 }
 
+void curl_set_common_options(CURL* curl, const wxString& useragent = wxEmptyString) {
+    curl_set_common_options(curl, http_current_options(useragent));
+}
+
 void curl_set_writedata_options(CURL* curl, curlBuff& chunk)
 {
     chunk.memory = static_cast<char *>(malloc(1));
@@ -808,11 +815,16 @@ void curl_set_writedata_options(CURL* curl, curlBuff& chunk)
 }
 
 CURLcode http_get_data(const wxString& sSite, wxString& sOutput, const wxString& useragent)
+{
+    return http_get_data(sSite, sOutput, http_current_options(useragent));
+}
+
+CURLcode http_get_data(const wxString& sSite, wxString& sOutput, const http_options& options)
 {
     CURL *curl = curl_easy_init();
     if (!curl) return CURLE_FAILED_INIT;
 
-    curl_set_common_options(curl, useragent);
+    curl_set_common_options(curl, options);
 
     struct curlBuff chunk;
     curl_set_writedata_options(curl, chunk);
@@ -895,6 +907,82 @@ CURLcode http_download_file(const wxString& sSite, const wxString& sPath)
     return err_code;
 }
 
+size_t http_download_files(const std::vector<std::pair<wxString, wxString> >& files, size_t max_parallel
+    , const http_options& options, std::vector<CURLcode>& results)
+{
+    results.assign(files.size(), CURLE_OK);
+    if (files.empty()) return 0;
+
+    CURLM* multi = curl_multi_init();
+    if (!multi)
+    {
+        results.assign(files.size(), CURLE_FAILED_INIT);
+        return files.size();
+    }
+
+    std::vector<std::unique_ptr<wxFileOutputStream> > outputs(files.size());
+    size_t next = 0, running = 0, failed = 0;
+    while (running > 0 || next < files.size())
+    {
+        // keep at most max_parallel transfers open, start the next file as soon as one is done
+        for (; next < files.size() && running < std::max<size_t>(max_parallel, 1); next++)
+        {
+            const size_t i = next;
+            outputs[i].reset(new wxFileOutputStream(files[i].second));
+            CURL* curl = outputs[i]->IsOk() ? curl_easy_init() : nullptr;
+            if (!curl)
+            {
+                results[i] = outputs[i]->IsOk() ? CURLE_FAILED_INIT : CURLE_WRITE_ERROR;
+                wxLogDebug("http_download_files: cannot start %s error = %s", files[i].first, curl_easy_strerror(results[i]));
+                outputs[i].reset();
+                failed++;
+                continue;
+            }
+
+            curl_set_common_options(curl, options);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteFileCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, outputs[i].get());
+            curl_easy_setopt(curl, CURLOPT_URL, static_cast<const char*>(files[i].first.mb_str()));
+            curl_easy_setopt(curl, CURLOPT_PRIVATE, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+            curl_multi_add_handle(multi, curl);
+            running++;
+        }
+
+        int still_running = 0;
+        curl_multi_perform(multi, &still_running);
+
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &queued))
+        {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            CURL* curl = msg->easy_handle;
+            char* index = nullptr;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, &index);
+            const size_t i = static_cast<size_t>(reinterpret_cast<uintptr_t>(index));
+
+            results[i] = msg->data.result;
+            outputs[i]->Close();
+            outputs[i].reset();
+            if (results[i] != CURLE_OK)
+            {
+                wxLogDebug("http_download_files: URL = %s error = %s", files[i].first, curl_easy_strerror(results[i]));
+                failed++;
+            }
+
+            curl_multi_remove_handle(multi, curl);
+            curl_easy_cleanup(curl);
+            running--;
+        }
+
+        if (running > 0 && still_running > 0)
+            curl_multi_wait(multi, nullptr, 0, 1000, nullptr);
+    }
+
+    curl_multi_cleanup(multi);
+    return failed;
+}
+
 //All components version in TXT, HTML, ABOUT
 const wxString getProgramDescription(int type)
 {
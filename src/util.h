@@ -22,6 +22,7 @@
 #include "reports/reportbase.h"
 #include <wx/valnum.h>
 #include <map>
+#include <vector>
 #include <curl/curl.h>
 #include <rapidjson/document.h>
 
@@ -187,9 +188,31 @@ extern const std::map<int, std::pair<wxConvAuto, wxString> > g_encoding;
 inline const wxString mmGetMonthName(wxDateTime::Month month) { return MONTHS[static_cast<int>(month)]; }
 //----------------------------------------------------------------------------
 
+/** Proxy, timeout and user agent of a transfer */
+struct http_options
+{
+    wxString proxy;
+    long timeout;
+    wxString useragent;
+};
+
+/**
+* Read the network settings. Transfers made in a worker thread take the
+* options read here in the GUI thread, the settings table is not thread safe.
+*/
+const http_options http_current_options(const wxString& useragent = wxEmptyString);
+
 CURLcode http_get_data(const wxString& site, wxString& output, const wxString& useragent = wxEmptyString);
+CURLcode http_get_data(const wxString& site, wxString& output, const http_options& options);
 CURLcode http_post_data(const wxString& site, const wxString& data, const wxString& contentType, wxString& output);
 CURLcode http_download_file(const wxString& site, const wxString& path);
+/**
+* Download the (url, path) pairs with up to max_parallel transfers at once on
+* one curl multi handle. results holds the code of each file, returns the
+* number of failed files.
+*/
+size_t http_download_files(const std::vector<std::pair<wxString, wxString> >& files, size_t max_parallel
+    , const http_options& options, std::vector<CURLcode>& results);
 
 //----------------------------------------------------------------------------
 
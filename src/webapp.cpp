@@ -18,19 +18,27 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 
 #include "webapp.h"
-#include "attachmentdialog.h"
+#include "mmattachment.h"
 #include "paths.h"
-#include "transdialog.h"
 #include "util.h"
 #include "model/Model_Account.h"
 #include "model/Model_Attachment.h"
 #include "model/Model_Category.h"
+#include "model/Model_Checking.h"
+#include "model/Model_Payee.h"
 #include "model/Model_Subcategory.h"
 #include "model/Model_Infotable.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <wx/stopwatch.h>
+#include <rapidjson/reader.h>
 
 //Expected WebAppVersion
 const wxString WebAppParam::ApiExpectedVersion = "1.0.1";
 
+wxDEFINE_EVENT(mmEVT_WEBAPP_SYNC, wxThreadEvent);
+
 //Internal constants
 const wxString mmWebApp::getUrl()
 {
@@ -76,6 +84,153 @@ const wxString mmWebApp::WebApp_getApiVersion()
 }
 
 
+namespace
+{
+    const size_t MAX_DOWNLOADS = 4;     // attachments downloaded at once
+    const size_t DELETE_BATCH = 100;    // transaction IDs per delete request
+
+    //Message for a check_guid reply other than success
+    const wxString guidError(const wxString& outputMessage, wxString& title)
+    {
+        if (outputMessage == WebAppParam::MessageWrongGuid)
+        {
+            title = _("Wrong WebApp settings");
+            return wxString() << _("Wrong WebApp GUID:") << "\n"
+                << _("please check it in network options.") << "\n";
+        }
+        title = _("WebApp connection error");
+        return wxString() << _("Unable to connect to WebApp:") << "\n"
+            << _("please check settings and / or internet connection.") << "\n\n"
+            << wxString::Format(_("Error: %s"), "\n" + outputMessage + "\n");
+    }
+
+    //Message for an unexpected check_api_version reply
+    const wxString apiVersionError(const wxString& apiVersion, wxString& title)
+    {
+        title = _("Wrong WebApp API version");
+        return _("Wrong WebApp API version:") + "\n"
+            + wxString::Format(_("WebApp   API version -> %s"), apiVersion) + "\n"
+            + wxString::Format(_("Expected API version -> %s"), WebAppParam::ApiExpectedVersion) + "\n";
+    }
+
+    /**
+    * SAX handler for the download_transaction reply: an object holding one
+    * object of string fields per transaction. Other values are skipped.
+    */
+    class WebTranReader : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, WebTranReader>
+    {
+    public:
+        explicit WebTranReader(mmWebApp::WebTranVector& transactions)
+            : m_transactions(transactions), m_depth(0) {}
+
+        bool StartObject()
+        {
+            if (++m_depth == 2) m_tran = mmWebApp::webtran_holder();
+            return true;
+        }
+        bool EndObject(rapidjson::SizeType)
+        {
+            if (m_depth-- == 2) m_transactions.push_back(m_tran);
+            return true;
+        }
+        bool StartArray() { ++m_depth; return true; }
+        bool EndArray(rapidjson::SizeType) { --m_depth; return true; }
+        bool Key(const char* str, rapidjson::SizeType length, bool)
+        {
+            if (m_depth == 2) m_key.assign(str, length);
+            return true;
+        }
+        bool String(const char* str, rapidjson::SizeType length, bool)
+        {
+            if (m_depth == 2) set(wxString::FromUTF8(str, length));
+            return true;
+        }
+        bool Default() { return true; }
+
+    private:
+        void set(const wxString& value)
+        {
+            if (m_key == "ID")
+                m_tran.ID = wxAtoi(value);
+            else if (m_key == "Date")
+                m_tran.Date = mmParseISODate(value);
+            else if (m_key == "Amount")
+                value.ToCDouble(&m_tran.Amount);
+            else if (m_key == "Account")
+                m_tran.Account = value;
+            else if (m_key == "ToAccount")
+                m_tran.ToAccount = value;
+            else if (m_key == "Status")
+                m_tran.Status = value;
+            else if (m_key == "Type")
+                m_tran.Type = value;
+            else if (m_key == "Payee")
+                m_tran.Payee = (value == "None" || value.IsEmpty()) ? _("Unknown") : value;
+            else if (m_key == "Category")
+            {
+                wxString Category = value;
+                Category.Replace(":", "|");
+                m_tran.Category = (Category == "None" || Category.IsEmpty()) ? _("Unknown") : Category;
+            }
+            else if (m_key == "SubCategory")
+            {
+                wxString SubCategory = value;
+                SubCategory.Replace(":", "|");
+                //Empty and not "Unknown" because it could be a category without any subcategory: if categories are not used at all, Unknown as category is enough
+                m_tran.SubCategory = (SubCategory == "None") ? wxString() : SubCategory;
+            }
+            else if (m_key == "Notes")
+                m_tran.Notes = value;
+            else if (m_key == "Attachments")
+                m_tran.Attachments = value;
+        }
+
+    private:
+        mmWebApp::WebTranVector& m_transactions;
+        mmWebApp::webtran_holder m_tran;
+        std::string m_key;
+        int m_depth;
+    };
+
+    //Worker thread of mmWebApp::WebApp_StartSync()
+    class SyncThread : public wxThread
+    {
+    public:
+        SyncThread(wxEvtHandler* handler, const wxString& url, const http_options& options)
+            : wxThread(wxTHREAD_JOINABLE), m_handler(handler), m_url(url), m_options(options), m_cancelled(false) {}
+
+        void cancel() { m_cancelled = true; }
+
+    protected:
+        virtual ExitCode Entry()
+        {
+            std::shared_ptr<mmWebApp::SyncResult> result = std::make_shared<mmWebApp::SyncResult>();
+            mmWebApp::WebApp_Sync(m_url, m_options, *result);
+
+            if (m_cancelled)
+            {
+                for (const auto& WebTran : result->Transactions)
+                    for (const auto& file : WebTran.AttachmentFiles)
+                        if (!file.IsEmpty()) wxRemoveFile(file);
+                return 0;
+            }
+
+            wxThreadEvent* event = new wxThreadEvent(mmEVT_WEBAPP_SYNC);
+            event->SetPayload(result);
+            wxQueueEvent(m_handler, event);
+            return 0;
+        }
+
+    private:
+        wxEvtHandler* m_handler;
+        const wxString m_url;
+        const http_options m_options;
+        std::atomic<bool> m_cancelled;
+    };
+
+    SyncThread* g_sync = nullptr;
+}
+
 /***************
 ** Functions  **
 ***************/
@@ -106,32 +261,22 @@ bool mmWebApp::WebApp_CheckGuid()
 
     if (outputMessage == WebAppParam::MessageSuccedeed)
         return true;
-    else if (outputMessage == WebAppParam::MessageWrongGuid)
-    {
-        wxString msgStr = wxString() << _("Wrong WebApp GUID:") << "\n"
-            << _("please check it in network options.") << "\n";
-        wxMessageBox(msgStr, _("Wrong WebApp settings"), wxICON_ERROR);
-        return false;
-    }
-    else
-    {
-        wxString msgStr = wxString() << _("Unable to connect to WebApp:") << "\n"
-            << _("please check settings and / or internet connection.") << "\n\n"
-            << wxString::Format(_("Error: %s"), "\n" + outputMessage + "\n");
-        wxMessageBox(msgStr, _("WebApp connection error"), wxICON_ERROR);
-        return false;
-    }
+
+    wxString title;
+    const wxString msgStr = guidError(outputMessage, title);
+    wxMessageBox(msgStr, title, wxICON_ERROR);
+    return false;
 }
 
 //Check WebApp Api version
 bool mmWebApp::WebApp_CheckApiVersion()
 {
-    if (mmWebApp::WebApp_getApiVersion() != WebAppParam::ApiExpectedVersion)
+    const wxString apiVersion = mmWebApp::WebApp_getApiVersion();
+    if (apiVersion != WebAppParam::ApiExpectedVersion)
     {
-        wxString msgStr = _("Wrong WebApp API version:") + "\n"
-            + wxString::Format(_("WebApp   API version -> %s"), mmWebApp::WebApp_getApiVersion()) + "\n"
-            + wxString::Format(_("Expected API version -> %s"), WebAppParam::ApiExpectedVersion) + "\n";
-        wxMessageBox(msgStr, _("Wrong WebApp API version"), wxICON_ERROR);
+        wxString title;
+        const wxString msgStr = apiVersionError(apiVersion, title);
+        wxMessageBox(msgStr, title, wxICON_ERROR);
         return false;
     }
     else
@@ -343,98 +488,151 @@ bool mmWebApp::WebApp_DownloadNewTransaction(WebTranVector& WebAppTransactions_,
     }
     else if (CheckOnly)
         return true;
-    else
+    else if (!mmWebApp::WebApp_ParseTransactions(NewTransactionJSON, WebAppTransactions_))
     {
-        Document j_doc;
-        if (j_doc.Parse(NewTransactionJSON.utf8_str()).HasParseError())
-        {
-            Error = curl_easy_strerror(CURLE_BAD_CONTENT_ENCODING);
-            return false;
-        }
-
-        //Define variables
-        webtran_holder WebTran;
-        WebAppTransactions_.clear();
+        Error = curl_easy_strerror(CURLE_BAD_CONTENT_ENCODING);
+        return false;
+    }
+    return true;
+}
 
-        for (auto& m : j_doc.GetObject())
-        {
-            Value trx = m.value.GetObject();
+//Parse downloaded transactions
+bool mmWebApp::WebApp_ParseTransactions(const wxString& Json, WebTranVector& WebAppTransactions_)
+{
+    WebAppTransactions_.clear();
 
-            if (trx.HasMember("ID") && trx["ID"].IsString()) {
-                WebTran.ID = wxAtoi(trx["ID"].GetString());
-            }
+    const wxScopedCharBuffer utf8 = Json.utf8_str();
+    rapidjson::StringStream stream(utf8.data());
+    WebTranReader handler(WebAppTransactions_);
+    rapidjson::Reader reader;
+    if (reader.Parse(stream, handler).IsError())
+    {
+        WebAppTransactions_.clear();
+        return false;
+    }
+    return true;
+}
 
-            if (trx.HasMember("Date") && trx["Date"].IsString()) {
-                WebTran.Date = mmParseISODate(wxString::FromUTF8(trx["Date"].GetString()));
-            }
+//Download the attachments of the transactions into temporary files
+size_t mmWebApp::WebApp_PrefetchAttachments(WebTranVector& WebAppTransactions_)
+{
+    return mmWebApp::WebApp_PrefetchAttachments(mmWebApp::getServicesPageURL(), http_current_options(), WebAppTransactions_);
+}
 
-            if (trx.HasMember("Amount") && trx["Amount"].IsString()) {
-                wxString sAmount = trx["Amount"].GetString();
-                double dAmount;
-                sAmount.ToCDouble(&dAmount);
-                WebTran.Amount = dAmount;
-            }
+size_t mmWebApp::WebApp_PrefetchAttachments(const wxString& ServicesPageURL, const http_options& Options, WebTranVector& WebAppTransactions_)
+{
+    size_t failed = 0;
+    std::vector<std::pair<wxString, wxString> > files;
+    std::vector<std::pair<size_t, size_t> > owners; // transaction and attachment of each file
+    for (size_t t = 0; t < WebAppTransactions_.size(); t++)
+    {
+        webtran_holder& WebTran = WebAppTransactions_[t];
+        if (WebTran.Attachments.IsEmpty() || !WebTran.AttachmentFiles.IsEmpty())
+            continue;
 
-            if (trx.HasMember("Account") && trx["Account"].IsString()) {
-                WebTran.Account = wxString::FromUTF8(trx["Account"].GetString());
+        wxStringTokenizer tkz(WebTran.Attachments, (';'), wxTOKEN_RET_EMPTY_ALL);
+        while (tkz.HasMoreTokens())
+        {
+            const wxString AttachmentName = tkz.GetNextToken();
+            const wxString TempFile = wxFileName::CreateTempFileName("mmex_webapp");
+            if (TempFile.IsEmpty())
+                failed++;
+            else
+            {
+                files.push_back(std::make_pair(ServicesPageURL + "&" + WebAppParam::DownloadAttachments + "=" + AttachmentName, TempFile));
+                owners.push_back(std::make_pair(t, WebTran.AttachmentFiles.GetCount()));
             }
+            WebTran.AttachmentFiles.Add(TempFile);
+        }
+    }
 
-            if (trx.HasMember("ToAccount") && trx["ToAccount"].IsString()) {
-                WebTran.ToAccount = wxString::FromUTF8(trx["ToAccount"].GetString());
-            }
+    std::vector<CURLcode> results;
+    failed += http_download_files(files, MAX_DOWNLOADS, Options, results);
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        if (results[i] == CURLE_OK) continue;
+        wxRemoveFile(files[i].second);
+        WebAppTransactions_[owners[i].first].AttachmentFiles[owners[i].second].clear();
+    }
+    return failed;
+}
 
-            if (trx.HasMember("Status") && trx["Status"].IsString()) {
-                WebTran.Status = wxString::FromUTF8(trx["Status"].GetString());
-            }
+//Check, download and prefetch in a worker thread
+bool mmWebApp::WebApp_StartSync(wxEvtHandler* handler)
+{
+    if (g_sync) return false;
 
-            if (trx.HasMember("Type") && trx["Type"].IsString()) {
-                WebTran.Type = wxString::FromUTF8(trx["Type"].GetString());
-            }
+    g_sync = new SyncThread(handler, mmWebApp::getServicesPageURL(), http_current_options());
+    if (g_sync->Run() != wxTHREAD_NO_ERROR)
+    {
+        delete g_sync;
+        g_sync = nullptr;
+        return false;
+    }
+    return true;
+}
 
+void mmWebApp::WebApp_StopSync()
+{
+    if (!g_sync) return;
 
-            if (trx.HasMember("Payee") && trx["Payee"].IsString()) {
-                wxString Payee = wxString::FromUTF8(trx["Payee"].GetString());
-                if (Payee == "None" || Payee.IsEmpty()) {
-                    Payee = _("Unknown");
-                }
-                WebTran.Payee = Payee;
-            }
+    g_sync->cancel();
+    g_sync->Wait();
+    delete g_sync;
+    g_sync = nullptr;
+}
 
-            if (trx.HasMember("Category") && trx["Category"].IsString()) {
-                wxString Category = wxString::FromUTF8(trx["Category"].GetString());
-                Category.Replace(":", "|");
-                if (Category == "None" || Category.IsEmpty()) {
-                    Category = _("Unknown");
-                }
-                WebTran.Category = Category;
-            }
+void mmWebApp::WebApp_Sync(const wxString& ServicesPageURL, const http_options& Options, SyncResult& Result)
+{
+    Result.Attachments = 0;
+    Result.FailedAttachments = 0;
+    Result.DownloadMs = Result.ParseMs = Result.AttachmentsMs = 0;
 
-            if (trx.HasMember("SubCategory") && trx["SubCategory"].IsString()) {
-                wxString SubCategory = wxString::FromUTF8(trx["SubCategory"].GetString());
-                SubCategory.Replace(":", "|");
-                if (SubCategory == "None" || SubCategory.IsEmpty()) {
-                    //Empty and not "Unknown" because it could be a category without any subcategory: if categories are not used at all, Unknown as category is enough
-                    SubCategory = wxEmptyString;
-                }
-                WebTran.SubCategory = SubCategory;
-            }
+    wxString outputMessage;
+    http_get_data(ServicesPageURL + "&" + WebAppParam::CheckGuid, outputMessage, Options);
+    if (outputMessage != WebAppParam::MessageSuccedeed)
+    {
+        Result.Error = guidError(outputMessage, Result.ErrorTitle);
+        return;
+    }
 
-            if (trx.HasMember("Notes") && trx["Notes"].IsString()) {
-                WebTran.Notes = wxString::FromUTF8(trx["Notes"].GetString());
-            }
+    wxString apiVersion;
+    http_get_data(ServicesPageURL + "&" + WebAppParam::CheckApiVersion, apiVersion, Options);
+    if (apiVersion != WebAppParam::ApiExpectedVersion)
+    {
+        Result.Error = apiVersionError(apiVersion, Result.ErrorTitle);
+        return;
+    }
 
-            if (trx.HasMember("Attachments") && trx["Attachments"].IsString()) {
-                WebTran.Attachments = wxString::FromUTF8(trx["Attachments"].GetString());
-            }
+    wxStopWatch sw;
+    wxString NewTransactionJSON;
+    CURLcode ErrorCode = http_get_data(ServicesPageURL + "&" + WebAppParam::DownloadNewTransaction, NewTransactionJSON, Options);
+    Result.DownloadMs = sw.Time();
+    if (ErrorCode != CURLE_OK)
+    {
+        Result.DownloadError = curl_easy_strerror(ErrorCode);
+        return;
+    }
+    if (NewTransactionJSON == "null" || NewTransactionJSON.IsEmpty())
+        return;
 
-            WebAppTransactions_.push_back(WebTran);
-        }
-        return true;
+    sw.Start();
+    if (!mmWebApp::WebApp_ParseTransactions(NewTransactionJSON, Result.Transactions))
+    {
+        Result.DownloadError = curl_easy_strerror(CURLE_BAD_CONTENT_ENCODING);
+        return;
     }
+    Result.ParseMs = sw.Time();
+
+    sw.Start();
+    Result.FailedAttachments = mmWebApp::WebApp_PrefetchAttachments(ServicesPageURL, Options, Result.Transactions);
+    for (const auto& WebTran : Result.Transactions)
+        Result.Attachments += WebTran.AttachmentFiles.GetCount();
+    Result.AttachmentsMs = sw.Time();
 }
 
 //Insert new transaction
-int mmWebApp::MMEX_InsertNewTransaction(webtran_holder& WebAppTrans)
+int mmWebApp::MMEX_InsertNewTransaction(webtran_holder& WebAppTrans, std::vector<int>* DeleteLater)
 {
     int DeskNewTrID = 0;
     bool bDeleteTrWebApp = false;
@@ -575,7 +773,8 @@ int mmWebApp::MMEX_InsertNewTransaction(webtran_holder& WebAppTrans)
                     AttachmentNr++;
                     WebAppAttachmentName = AttachmentsArray.Item(i);
                     wxString CurlError = "";
-                    DesktopAttachmentName = WebApp_DownloadOneAttachment(WebAppAttachmentName, DeskNewTrID, AttachmentNr, CurlError);
+                    const wxString Prefetched = i < WebAppTrans.AttachmentFiles.GetCount() ? WebAppTrans.AttachmentFiles.Item(i) : wxString();
+                    DesktopAttachmentName = WebApp_DownloadOneAttachment(WebAppAttachmentName, DeskNewTrID, AttachmentNr, Prefetched, CurlError);
                     if (DesktopAttachmentName != wxEmptyString)
                     {
                         Model_Attachment::Data* NewAttachment = Model_Attachment::instance().create();
@@ -600,7 +799,7 @@ int mmWebApp::MMEX_InsertNewTransaction(webtran_holder& WebAppTrans)
                     WebAppAttachmentName = wxEmptyString;
 
                 } //End loop thought attachments
-                bDeleteTrWebApp = true;
+                bDeleteTrWebApp = DeskNewTrID > 0; // keep it on the WebApp if an attachment failed
             }
         }
         else //Transaction without attachments
@@ -609,7 +808,9 @@ int mmWebApp::MMEX_InsertNewTransaction(webtran_holder& WebAppTrans)
         }
     }
 
-    if (bDeleteTrWebApp)
+    if (bDeleteTrWebApp && DeleteLater)
+        DeleteLater->push_back(WebAppTrans.ID);
+    else if (bDeleteTrWebApp)
         WebApp_DeleteOneTransaction(WebAppTrans.ID);
     return DeskNewTrID;
 }
@@ -617,22 +818,48 @@ int mmWebApp::MMEX_InsertNewTransaction(webtran_holder& WebAppTrans)
 //Delete one transaction from WebApp
 bool mmWebApp::WebApp_DeleteOneTransaction(int WebAppTransactionId)
 {
-    wxString DeleteOneTransactionUrl = mmWebApp::getServicesPageURL() + "&" + WebAppParam::DeleteOneTransaction + "=" << WebAppTransactionId;
+    return mmWebApp::WebApp_DeleteTransactions(std::vector<int>(1, WebAppTransactionId));
+}
 
-    wxString outputMessage;
-    int ErrorCode = http_get_data(DeleteOneTransactionUrl, outputMessage);
+//Delete transactions from WebApp, delete_group takes a comma separated list
+bool mmWebApp::WebApp_DeleteTransactions(const std::vector<int>& WebAppTransactionIds)
+{
+    if (WebAppTransactionIds.empty()) return true;
+    return mmWebApp::WebApp_DeleteTransactions(mmWebApp::getServicesPageURL(), http_current_options(), WebAppTransactionIds);
+}
 
-    return mmWebApp::returnResult(ErrorCode, outputMessage);
+bool mmWebApp::WebApp_DeleteTransactions(const wxString& ServicesPageURL, const http_options& Options, const std::vector<int>& WebAppTransactionIds)
+{
+    bool deleted = true;
+    for (size_t first = 0; first < WebAppTransactionIds.size(); first += DELETE_BATCH)
+    {
+        const size_t last = std::min(WebAppTransactionIds.size(), first + DELETE_BATCH);
+        wxString DeleteGroupUrl = ServicesPageURL + "&" + WebAppParam::DeleteOneTransaction + "=";
+        for (size_t i = first; i < last; i++)
+        {
+            if (i > first) DeleteGroupUrl << ",";
+            DeleteGroupUrl << WebAppTransactionIds[i];
+        }
+
+        wxString outputMessage;
+        int ErrorCode = http_get_data(DeleteGroupUrl, outputMessage, Options);
+        if (!mmWebApp::returnResult(ErrorCode, outputMessage))
+            deleted = false;
+    }
+    return deleted;
 }
 
-//Download one attachment from WebApp
-wxString mmWebApp::WebApp_DownloadOneAttachment(const wxString& AttachmentName, int DesktopTransactionID, int AttachmentNr, wxString& Error)
+//Download one attachment from WebApp, or move its prefetched copy in place
+wxString mmWebApp::WebApp_DownloadOneAttachment(const wxString& AttachmentName, int DesktopTransactionID, int AttachmentNr, const wxString& Prefetched, wxString& Error)
 {
     wxString FileExtension = wxFileName(AttachmentName).GetExt().MakeLower();
     wxString FileName = Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION) + "_" + wxString::Format("%i", DesktopTransactionID)
         + "_Attach" + wxString::Format("%i", AttachmentNr) + "." + FileExtension;
     wxString FilePath = mmex::getPathAttachment(mmAttachmentManage::InfotablePathSetting()) + wxFileName::GetPathSeparator()
         + Model_Attachment::reftype_desc(Model_Attachment::TRANSACTION) + wxFileName::GetPathSeparator() + FileName;
+    if (!Prefetched.IsEmpty() && wxFileExists(Prefetched) && wxRenameFile(Prefetched, FilePath))
+        return FileName;
+
     wxString URL = mmWebApp::getServicesPageURL() + "&" + WebAppParam::DownloadAttachments + "=" + AttachmentName;
     CURLcode CurlStatus = http_download_file(URL, FilePath);
     if (CurlStatus == CURLE_OK)
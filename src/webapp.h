@@ -22,6 +22,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include <vector>
 #include <wx/string.h>
 #include <wx/datetime.h>
+#include <wx/arrstr.h>
+#include <wx/event.h>
+#include <wx/longlong.h>
+
+struct http_options;
 
 //Parameters used in services.php
 namespace WebAppParam
@@ -56,7 +61,7 @@ static int WebApp_SendJson(wxString& Website, const wxString& JsonData, wxString
 static bool WebApp_DeleteAllAccount();
 static bool WebApp_DeleteAllPayee();
 static bool WebApp_DeleteAllCategory();
-static wxString WebApp_DownloadOneAttachment(const wxString& AttachmentName, int DesktopTransactionID, int AttachmentNr, wxString& Error);
+static wxString WebApp_DownloadOneAttachment(const wxString& AttachmentName, int DesktopTransactionID, int AttachmentNr, const wxString& Prefetched, wxString& Error);
 
 public:
     const static wxString getUrl();
@@ -76,9 +81,24 @@ public:
         double Amount;
         wxString Notes;
         wxString Attachments;
+        wxArrayString AttachmentFiles; // temporary copies of the Attachments, downloaded ahead of the import
     };
     typedef std::vector<webtran_holder> WebTranVector;
 
+    /** Outcome of a background sync, the payload of the mmEVT_WEBAPP_SYNC event */
+    struct SyncResult
+    {
+        wxString Error;             // wrong GUID, API version or no connection, to show to the user
+        wxString ErrorTitle;
+        wxString DownloadError;     // the transactions could not be downloaded
+        WebTranVector Transactions;
+        size_t Attachments;
+        size_t FailedAttachments;
+        wxLongLong DownloadMs;
+        wxLongLong ParseMs;
+        wxLongLong AttachmentsMs;
+    };
+
     static bool returnResult(int& ErrorCode, wxString& outputMessage);
 
     /** Return true if WebApp is enabled */
@@ -102,12 +122,44 @@ public:
     /** Download new transaction */
     static bool WebApp_DownloadNewTransaction(WebTranVector& WebAppTransactions_, const bool CheckOnly, wxString& Error);
 
-    /** Insert transaction in MMEX desktop, returns transaction ID */
-    static int MMEX_InsertNewTransaction(webtran_holder& WebAppTrans);
+    /** Parse the downloaded transactions with the SAX reader, false if the JSON is not valid */
+    static bool WebApp_ParseTransactions(const wxString& Json, WebTranVector& WebAppTransactions_);
+
+    /**
+    * Download the attachments of the transactions into temporary files, a few
+    * at a time, and keep their paths in AttachmentFiles. Returns the number of
+    * attachments that could not be downloaded, they are retried one by one on
+    * insert.
+    */
+    static size_t WebApp_PrefetchAttachments(WebTranVector& WebAppTransactions_);
+
+    /**
+    * Check the settings, download and parse the new transactions and prefetch
+    * their attachments in a worker thread. The handler gets one
+    * mmEVT_WEBAPP_SYNC event carrying a std::shared_ptr<SyncResult> when done.
+    * Returns false if a sync is already running.
+    */
+    static bool WebApp_StartSync(wxEvtHandler* handler);
+    /** Wait for the sync thread to finish */
+    static void WebApp_StopSync();
+    /** The work of the sync thread, does not touch the database */
+    static void WebApp_Sync(const wxString& ServicesPageURL, const http_options& Options, SyncResult& Result);
+
+    /**
+    * Insert transaction in MMEX desktop, returns transaction ID.
+    * The WebApp transaction is deleted at once, or its ID is added to
+    * DeleteLater for one WebApp_DeleteTransactions() call after a batch.
+    */
+    static int MMEX_InsertNewTransaction(webtran_holder& WebAppTrans, std::vector<int>* DeleteLater = nullptr);
 
     /** Delete transaction from WebApp */
     static bool WebApp_DeleteOneTransaction(int WebAppTransactionId);
 
+    /** Delete transactions from WebApp, in one request per DELETE_BATCH IDs */
+    static bool WebApp_DeleteTransactions(const std::vector<int>& WebAppTransactionIds);
+    /** The same with the services page URL and the options of the caller */
+    static bool WebApp_DeleteTransactions(const wxString& ServicesPageURL, const http_options& Options, const std::vector<int>& WebAppTransactionIds);
+
     /* Return attachment URL */
     static bool WebApp_DownloadAttachment(wxString& AttachmentFileName, wxString& Error);
 
@@ -120,6 +172,11 @@ public:
 
     /** Update all categories on WebApp if enabled */
     static bool MMEX_WebApp_UpdateCategory();
+
+private:
+    static size_t WebApp_PrefetchAttachments(const wxString& ServicesPageURL, const http_options& Options, WebTranVector& WebAppTransactions_);
 };
 
+wxDECLARE_EVENT(mmEVT_WEBAPP_SYNC, wxThreadEvent);
+
 #endif // MM_EX_WEBAPP_H_
@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "webapp.h"
 #include "mmSimpleDialogs.h"
 #include <wx/timer.h>
+#include <algorithm>
 
 wxIMPLEMENT_DYNAMIC_CLASS(mmWebAppDialog, wxDialog);
 
@@ -45,7 +46,7 @@ mmWebAppDialog::~mmWebAppDialog()
     autoWebAppDialogTimer_.Stop();
     for (const auto& entry : tempFiles_)
     {
-        wxRemoveFile(entry);
+        if (wxFileExists(entry)) wxRemoveFile(entry);
     }
 }
 
@@ -70,6 +71,26 @@ mmWebAppDialog::mmWebAppDialog(wxWindow *parent, const bool startup, const wxStr
     Create(parent, name);
 }
 
+mmWebAppDialog::mmWebAppDialog(wxWindow *parent, const mmWebApp::WebTranVector& synced) :
+    m_webtran_id(-1)
+    , webtranListBox_(nullptr)
+    , m_maskTextCtrl(nullptr)
+    , url_text_(nullptr)
+    , guid_text_(nullptr)
+    , net_button_(nullptr)
+    , refreshRequested_(false)
+    , isStartup_(true)
+    , isFilledOnce_(false)
+    , autoWebAppDialogTimer_(this, wxID_REFRESH)
+    , syncedTransactions_(synced)
+{
+    // the prefetched attachments not imported are removed with the dialog
+    for (const auto& WebTran : syncedTransactions_)
+        for (const auto& file : WebTran.AttachmentFiles)
+            if (!file.IsEmpty()) tempFiles_.Add(file);
+    Create(parent, "mmWebAppDialog");
+}
+
 void mmWebAppDialog::Create(wxWindow* parent, const wxString& name)
 {
     SetExtraStyle(GetExtraStyle() | wxWS_EX_BLOCK_EVENTS);
@@ -188,34 +209,43 @@ void mmWebAppDialog::fillControls()
     WebAppTransactions_.clear();
     mainBoxSizer_->Show(loadingSizer_, true);
 
-    if (mmWebApp::getUrl().empty())
+    if (!syncedTransactions_.empty())
     {
-        mainBoxSizer_->Hide(loadingSizer_, true);
-        return mmErrorDialogs::ToolTip4Object(url_text_, _("Empty value"), _("Error"));
+        // downloaded by the background sync, the next refresh asks the WebApp again
+        WebAppTransactions_.swap(syncedTransactions_);
+        syncedTransactions_.clear();
     }
-    if (mmWebApp::getGuid().empty())
+    else
     {
-        mainBoxSizer_->Hide(loadingSizer_, true);
-        return mmErrorDialogs::ToolTip4Object(guid_text_, _("Empty value"), _("Error"));
-    }
-
-    if (!mmWebApp::WebApp_CheckGuid() || !mmWebApp::WebApp_CheckApiVersion())
-    {
-        mainBoxSizer_->Hide(loadingSizer_, true);
-        return;
-    }
+        if (mmWebApp::getUrl().empty())
+        {
+            mainBoxSizer_->Hide(loadingSizer_, true);
+            return mmErrorDialogs::ToolTip4Object(url_text_, _("Empty value"), _("Error"));
+        }
+        if (mmWebApp::getGuid().empty())
+        {
+            mainBoxSizer_->Hide(loadingSizer_, true);
+            return mmErrorDialogs::ToolTip4Object(guid_text_, _("Empty value"), _("Error"));
+        }
 
-    wxString CurlError = "";
-    if (!mmWebApp::WebApp_DownloadNewTransaction(WebAppTransactions_, false, CurlError))
-    {
-        mainBoxSizer_->Hide(loadingSizer_, true);
-        if (!isStartup_)
+        if (!mmWebApp::WebApp_CheckGuid() || !mmWebApp::WebApp_CheckApiVersion())
         {
-            wxString msgStr = wxString() << _("Unable to download transactions from webapp.") << "\n" << CurlError;
-            wxMessageBox(msgStr, _("Transactions download error"), wxICON_ERROR);
+            mainBoxSizer_->Hide(loadingSizer_, true);
+            return;
         }
 
-        return net_button_->SetBitmap(mmBitmap(png::LED_RED));
+        wxString CurlError = "";
+        if (!mmWebApp::WebApp_DownloadNewTransaction(WebAppTransactions_, false, CurlError))
+        {
+            mainBoxSizer_->Hide(loadingSizer_, true);
+            if (!isStartup_)
+            {
+                wxString msgStr = wxString() << _("Unable to download transactions from webapp.") << "\n" << CurlError;
+                wxMessageBox(msgStr, _("Transactions download error"), wxICON_ERROR);
+            }
+
+            return net_button_->SetBitmap(mmBitmap(png::LED_RED));
+        }
     }
 
     net_button_->SetBitmap(mmBitmap(png::LED_GREEN));
@@ -281,47 +311,59 @@ void mmWebAppDialog::OnListItemActivated(wxDataViewEvent& event)
     if (selected_index >= 0)
     {
         int WebTrID = static_cast<int>(webtranListBox_->GetItemData(item));
-        mmWebAppDialog::ImportWebTr(WebTrID, true);
+        mmWebAppDialog::ImportWebTrs(std::vector<int>(1, WebTrID), true);
         fillControls();
     }
 }
 
-bool mmWebAppDialog::ImportWebTr(int WebTrID, bool open)
+bool mmWebAppDialog::ImportWebTr(mmWebApp::webtran_holder& WebTrToImport, bool open, std::vector<int>& Imported)
 {
-    mmWebApp::webtran_holder WebTrToImport;
-    bool bFound = false;
+    int InsertedTransactionID = mmWebApp::MMEX_InsertNewTransaction(WebTrToImport, &Imported);
+    if (InsertedTransactionID <= 0)
+    {
+        wxString msgStr = wxString() << _("Unable to insert transaction in MMEX database") << "\n";
+        wxMessageBox(msgStr, _("WebApp communication error"), wxICON_ERROR);
+        return false;
+    }
 
-    for (const auto WebTr : WebAppTransactions_)
+    if (open)
     {
-        if (WebTr.ID == WebTrID)
-        {
-            bFound = true;
-            WebTrToImport = WebTr;
-            int InsertedTransactionID = mmWebApp::MMEX_InsertNewTransaction(WebTrToImport);
-            if (InsertedTransactionID > 0)
-            {
-                if (open)
-                {
-                    //fillControls(); //TODO: Delete transaction from view
-                    mmTransDialog EditTransactionDialog(this, 1, InsertedTransactionID, 0);
-                    EditTransactionDialog.ShowModal();
-                }
-                refreshRequested_ = true;
-            }
-            else
-            {
-                bFound = false;
-            }
-            break;
-        }
+        //fillControls(); //TODO: Delete transaction from view
+        mmTransDialog EditTransactionDialog(this, 1, InsertedTransactionID, 0);
+        EditTransactionDialog.ShowModal();
     }
-    if (!bFound)
+    refreshRequested_ = true;
+    return true;
+}
+
+void mmWebAppDialog::ImportWebTrs(const std::vector<int>& WebTrIDs, const bool open)
+{
+    mmWebApp::WebTranVector WebTrsToImport;
+    for (int WebTrID : WebTrIDs)
     {
-        wxString msgStr = wxString() << _("Unable to insert transaction in MMEX database") << "\n";
-        wxMessageBox(msgStr, _("WebApp communication error"), wxICON_ERROR);
+        const auto WebTr = std::find_if(WebAppTransactions_.begin(), WebAppTransactions_.end()
+            , [WebTrID](const mmWebApp::webtran_holder& t) { return t.ID == WebTrID; });
+        if (WebTr != WebAppTransactions_.end())
+            WebTrsToImport.push_back(*WebTr);
+        else
+        {
+            wxString msgStr = wxString() << _("Unable to insert transaction in MMEX database") << "\n";
+            wxMessageBox(msgStr, _("WebApp communication error"), wxICON_ERROR);
+        }
     }
 
-    return bFound;
+    // all attachments a few at a time, the ones failing here are retried one by one on insert
+    mmWebApp::WebApp_PrefetchAttachments(WebTrsToImport);
+    for (const auto& WebTr : WebTrsToImport)
+        for (const auto& file : WebTr.AttachmentFiles)
+            if (!file.IsEmpty()) tempFiles_.Add(file);
+
+    std::vector<int> Imported;
+    for (auto& WebTr : WebTrsToImport)
+        mmWebAppDialog::ImportWebTr(WebTr, open, Imported);
+
+    // one delete request for the whole batch
+    mmWebApp::WebApp_DeleteTransactions(Imported);
 }
 
 void mmWebAppDialog::OpenAttachment()
@@ -359,15 +401,16 @@ void mmWebAppDialog::ImportWebTrSelected(const bool open)
     if (Selected.size() == 0)
         return;
 
+    std::vector<int> WebTrIDs;
     for (wxDataViewItem Item : Selected)
     {
         int selectedIndex_ = webtranListBox_->ItemToRow(Item);
         if (selectedIndex_ >= 0)
         {
-            int WebTrID = static_cast<int>(webtranListBox_->GetItemData(Item));
-            mmWebAppDialog::ImportWebTr(WebTrID, open);
+            WebTrIDs.push_back(static_cast<int>(webtranListBox_->GetItemData(Item)));
         }
     }
+    mmWebAppDialog::ImportWebTrs(WebTrIDs, open);
     fillControls();
 }
 
@@ -379,14 +422,16 @@ void mmWebAppDialog::DeleteWebTr()
     if (Selected.size() == 0)
         return;
 
+    std::vector<int> WebTrIDs;
     for (wxDataViewItem Item : Selected)
     {
         int selectedIndex_ = webtranListBox_->ItemToRow(Item);
         if (selectedIndex_ >= 0)
         {
-            mmWebApp::WebApp_DeleteOneTransaction(static_cast<int>(webtranListBox_->GetItemData(Item)));
+            WebTrIDs.push_back(static_cast<int>(webtranListBox_->GetItemData(Item)));
         }
     }
+    mmWebApp::WebApp_DeleteTransactions(WebTrIDs);
     fillControls();
 }
 
@@ -427,11 +472,12 @@ void mmWebAppDialog::OnItemRightClick(wxDataViewEvent& event)
 
 void mmWebAppDialog::ImportAllWebTr(const bool open)
 {
+    std::vector<int> WebTrIDs;
     for (int i = 0; i < webtranListBox_->GetItemCount(); i++)
     {
-        int WebTrID = wxAtoi(webtranListBox_->GetTextValue(i, WEBTRAN_ID));
-        mmWebAppDialog::ImportWebTr(WebTrID, open);
+        WebTrIDs.push_back(wxAtoi(webtranListBox_->GetTextValue(i, WEBTRAN_ID)));
     }
+    mmWebAppDialog::ImportWebTrs(WebTrIDs, open);
 }
 
 void mmWebAppDialog::OnCancel(wxCommandEvent& /*event*/)
@@ -32,6 +32,8 @@ class mmWebAppDialog : public wxDialog
 
 public:
     mmWebAppDialog(wxWindow* parent, const bool startup, const wxString& name = "mmWebAppDialog");
+    /** Show the transactions downloaded by a background sync, see mmWebApp::WebApp_StartSync() */
+    mmWebAppDialog(wxWindow* parent, const mmWebApp::WebTranVector& synced);
     ~mmWebAppDialog();
     bool getRefreshRequested() const { return refreshRequested_; }
     void fillControls();
@@ -76,6 +78,7 @@ private:
     bool isFilledOnce_;
     int m_webtran_id;
     mmWebApp::WebTranVector WebAppTransactions_;
+    mmWebApp::WebTranVector syncedTransactions_;
 
     mmWebAppDialog() : m_webtran_id(-1), refreshRequested_(false) {}
 
@@ -88,7 +91,8 @@ private:
     void OnOk(wxCommandEvent& /*event*/);
     void OnCheckNetwork(wxCommandEvent& /*event*/);
 
-    bool ImportWebTr(int WebTrID, bool open);
+    bool ImportWebTr(mmWebApp::webtran_holder& WebTrToImport, bool open, std::vector<int>& Imported);
+    void ImportWebTrs(const std::vector<int>& WebTrIDs, const bool open);
     void ImportAllWebTr(const bool open);
 
     void OnListItemActivated(wxDataViewEvent& event);
@@ -0,0 +1,51 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_MMTEST_H_
+#define MM_EX_MMTEST_H_
+
+#include "mmbench.h"
+#include <wx/log.h>
+#include <wx/string.h>
+
+/** A test case returns true when it passes and logs what it found */
+typedef bool (*mmTestFunction)();
+
+/**
+* The test cases of mmex_tests. Each one registers itself under the name
+* CMakeLists.txt passes to add_test, and usually runs a check on an
+* in-memory database filled by mmBench::generate.
+*/
+class mmTest
+{
+public:
+    mmTest(const char* name, mmTestFunction function);
+
+    /** Run the named test case, return the exit code of the process */
+    static int run(const wxString& name);
+
+    /** A small generated database, enough rows for every check in a few seconds */
+    static const mmBench::Params params();
+};
+
+#define MM_TEST(name) \
+    static bool test_##name(); \
+    static const mmTest register_##name(#name, test_##name); \
+    static bool test_##name()
+
+#endif // MM_EX_MMTEST_H_
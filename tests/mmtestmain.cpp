@@ -0,0 +1,74 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include <map>
+#include <wx/init.h>
+
+namespace
+{
+    std::map<wxString, mmTestFunction>& registry()
+    {
+        static std::map<wxString, mmTestFunction> tests;
+        return tests;
+    }
+}
+
+mmTest::mmTest(const char* name, mmTestFunction function)
+{
+    registry()[name] = function;
+}
+
+int mmTest::run(const wxString& name)
+{
+    const auto it = registry().find(name);
+    if (it == registry().end())
+    {
+        wxLogError("Unknown test: %s", name);
+        return 2;
+    }
+    const bool passed = it->second();
+    wxLogMessage("%s: %s", name, passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+const mmBench::Params mmTest::params()
+{
+    mmBench::Params params;
+    params.accounts = 5;
+    params.years = 2;
+    params.per_day = 5;
+    params.currencies = 2;
+    params.stocks = 2;
+    return params;
+}
+
+int main(int argc, char** argv)
+{
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+        return 2;
+
+    if (argc < 2)
+    {
+        for (const auto& test : registry())
+            wxLogMessage("%s", test.first);
+        return 2;
+    }
+    return mmTest::run(wxString::FromUTF8(argv[1]));
+}
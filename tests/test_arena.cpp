@@ -0,0 +1,52 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Account.h"
+#include "model/Model_Checking.h"
+#include <algorithm>
+
+MM_TEST(account_transactions)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    size_t rows = 0, allocations = 0, differences = 0;
+    for (const auto& account : Model_Account::instance().all())
+    {
+        // the order Model_Account::transaction had when it sorted a Data_Set
+        auto expected = Model_Checking::instance().find_or(Model_Checking::ACCOUNTID(account.ACCOUNTID)
+            , Model_Checking::TOACCOUNTID(account.ACCOUNTID));
+        std::sort(expected.begin(), expected.end());
+        std::stable_sort(expected.begin(), expected.end(), SorterByTRANSDATE());
+
+        const Model_Checking::Data_Arena arena = Model_Account::transaction(account);
+        if (arena.size() != expected.size())
+            ++differences;
+        for (size_t i = 0; i < arena.size() && i < expected.size(); ++i)
+            if (arena[i].TRANSID != expected[i].TRANSID) ++differences;
+
+        rows += arena.size();
+        allocations += arena.allocations();
+    }
+
+    wxLogMessage("Transactions of every account: %zu, row allocations: %zu, out of order: %zu"
+        , rows, allocations, differences);
+    return rows > 0 && differences == 0 && allocations < rows;
+}
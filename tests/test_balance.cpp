@@ -0,0 +1,91 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "mmHook.h"
+#include "model/Model_Account.h"
+#include "model/Model_Balance.h"
+#include "model/Model_Checking.h"
+#include <cmath>
+
+namespace
+{
+    /** Number of accounts whose snapshot balance is not the sum of their transactions */
+    size_t differences()
+    {
+        size_t result = 0;
+        for (const auto& account : Model_Account::instance().all())
+        {
+            double expected = 0.0;
+            for (const auto& tran : Model_Account::transaction(account))
+                expected += Model_Checking::balance(tran, account.ACCOUNTID);
+            if (std::fabs(Model_Balance::instance().get(account.ACCOUNTID).balance - expected) > 0.005)
+                ++result;
+        }
+        return result;
+    }
+
+    /** Insert a withdrawal the snapshot takes in on the next read */
+    void withdraw(int account_id, double amount)
+    {
+        Model_Checking::Data* tran = Model_Checking::instance().create();
+        tran->ACCOUNTID = account_id;
+        tran->TOACCOUNTID = -1;
+        tran->PAYEEID = -1;
+        tran->CATEGID = -1;
+        tran->SUBCATEGID = -1;
+        tran->TRANSCODE = Model_Checking::all_type()[Model_Checking::WITHDRAWAL];
+        tran->TRANSAMOUNT = amount;
+        tran->TRANSDATE = "2020-01-01";
+        Model_Checking::instance().save(tran);
+        Model_Balance::instance().get(account_id);
+    }
+}
+
+MM_TEST(balance_rollback)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    const Model_Account::Data_Set accounts = Model_Account::instance().all();
+    if (accounts.empty()) return false;
+    const int account_id = accounts[0].ACCOUNTID;
+    const size_t loaded = differences();
+
+    // a whole transaction rolled back, the rollback hook resets the snapshot
+    db.get()->Begin();
+    withdraw(account_id, 1000);
+    const double inside = Model_Balance::instance().get(account_id).balance;
+    db.get()->Rollback();
+    const size_t after_rollback = differences();
+
+    // a rollback to a savepoint, the caller resets the caches
+    Model_Checking::instance().Savepoint();
+    withdraw(account_id, 1000);
+    Model_Checking::instance().Rollback();
+    Model_Checking::instance().ReleaseSavepoint();
+    UpdateCallbackHook::ResetCaches();
+    const size_t after_savepoint = differences();
+
+    const double balance = Model_Balance::instance().get(account_id).balance;
+    wxLogMessage("Accounts: %zu, balances that differ: %zu after loading, %zu after a rollback, %zu after a rollback to a savepoint\n"
+        "Account %i: %.2f within the transaction, %.2f after"
+        , accounts.size(), loaded, after_rollback, after_savepoint, account_id, inside, balance);
+    return loaded == 0 && after_rollback == 0 && after_savepoint == 0 && std::fabs(inside + 1000 - balance) < 0.005;
+}
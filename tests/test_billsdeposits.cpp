@@ -0,0 +1,189 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Account.h"
+#include "model/Model_Billsdeposits.h"
+#include <map>
+#include <vector>
+#include <wx/time.h>
+
+namespace
+{
+    typedef Model_Billsdeposits::Recurrence Recurrence;
+
+    /** The schedule stepped with wxDateSpan as before the recurrence engine */
+    const wxDateTime next_by_span(int repeats, int num, const wxDateTime& date)
+    {
+        wxDateTime dt = date;
+        switch (repeats)
+        {
+        case Model_Billsdeposits::REPEAT_WEEKLY: return dt.Add(wxDateSpan::Week());
+        case Model_Billsdeposits::REPEAT_BI_WEEKLY: return dt.Add(wxDateSpan::Weeks(2));
+        case Model_Billsdeposits::REPEAT_FOUR_WEEKLY: return dt.Add(wxDateSpan::Weeks(4));
+        case Model_Billsdeposits::REPEAT_DAILY: return dt.Add(wxDateSpan::Days(1));
+        case Model_Billsdeposits::REPEAT_MONTHLY: return dt.Add(wxDateSpan::Month());
+        case Model_Billsdeposits::REPEAT_BI_MONTHLY: return dt.Add(wxDateSpan::Months(2));
+        case Model_Billsdeposits::REPEAT_QUARTERLY: return dt.Add(wxDateSpan::Months(3));
+        case Model_Billsdeposits::REPEAT_FOUR_MONTHLY: return dt.Add(wxDateSpan::Months(4));
+        case Model_Billsdeposits::REPEAT_HALF_YEARLY: return dt.Add(wxDateSpan::Months(6));
+        case Model_Billsdeposits::REPEAT_YEARLY: return dt.Add(wxDateSpan::Year());
+        case Model_Billsdeposits::REPEAT_IN_X_DAYS:
+        case Model_Billsdeposits::REPEAT_EVERY_X_DAYS: return dt.Add(wxDateSpan::Days(num));
+        case Model_Billsdeposits::REPEAT_IN_X_MONTHS:
+        case Model_Billsdeposits::REPEAT_EVERY_X_MONTHS: return dt.Add(wxDateSpan::Months(num));
+        case Model_Billsdeposits::REPEAT_MONTHLY_LAST_DAY:
+        case Model_Billsdeposits::REPEAT_MONTHLY_LAST_BUSINESS_DAY:
+            dt.Add(wxDateSpan::Month());
+            dt.SetToLastMonthDay(dt.GetMonth(), dt.GetYear());
+            if (repeats == Model_Billsdeposits::REPEAT_MONTHLY_LAST_BUSINESS_DAY
+                && (dt.GetWeekDay() == wxDateTime::Sun || dt.GetWeekDay() == wxDateTime::Sat))
+                dt.SetToPrevWeekDay(wxDateTime::Fri);
+            return dt;
+        default:
+            return dt;
+        }
+    }
+}
+
+MM_TEST(catch_up)
+{
+    const size_t schedules = 500;
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    const auto accounts = Model_Account::instance().all();
+    if (accounts.empty()) return false;
+
+    // overdue schedules executed silently, a month to a year late
+    Model_Billsdeposits& bills = Model_Billsdeposits::instance();
+    const int today = Recurrence::to_day(wxDate::Today());
+    const int types[] = { Model_Billsdeposits::REPEAT_WEEKLY, Model_Billsdeposits::REPEAT_BI_WEEKLY
+        , Model_Billsdeposits::REPEAT_MONTHLY, Model_Billsdeposits::REPEAT_DAILY
+        , Model_Billsdeposits::REPEAT_EVERY_X_DAYS, Model_Billsdeposits::REPEAT_MONTHLY_LAST_DAY };
+    Model_Billsdeposits::Cache overdue;
+    for (size_t i = 0; i < schedules; ++i)
+    {
+        const int repeats = types[i % (sizeof(types) / sizeof(types[0]))];
+        Model_Billsdeposits::Data* bill = bills.create();
+        bill->ACCOUNTID = accounts[i % accounts.size()].ACCOUNTID;
+        bill->TOACCOUNTID = -1;
+        bill->PAYEEID = -1;
+        bill->TRANSCODE = Model_Billsdeposits::all_type()[Model_Billsdeposits::WITHDRAWAL];
+        bill->TRANSAMOUNT = 0.01;
+        bill->TOTRANSAMOUNT = 0.01;
+        bill->STATUS = "";
+        bill->CATEGID = -1;
+        bill->SUBCATEGID = -1;
+        bill->REPEATS = repeats + 2 * BD_REPEATS_MULTIPLEX_BASE;
+        bill->NUMOCCURRENCES = repeats == Model_Billsdeposits::REPEAT_EVERY_X_DAYS ? 10 : -1;
+        bill->NEXTOCCURRENCEDATE = Recurrence::to_iso(today - 30 - static_cast<int>(i % 300));
+        bill->TRANSDATE = bill->NEXTOCCURRENCEDATE;
+        overdue.push_back(bill);
+    }
+    bills.insert(overdue);
+
+    // the occurrences up to today and the next date, stepped with wxDateSpan
+    const wxDateTime today_date = Recurrence::to_date(today);
+    size_t expected = 0;
+    std::map<int, wxString> expected_next;
+    for (const auto bill : overdue)
+    {
+        wxDateTime date = Recurrence::to_date(Recurrence::to_day(bill->NEXTOCCURRENCEDATE));
+        for (; date <= today_date; ++expected)
+            date = next_by_span(bill->REPEATS % BD_REPEATS_MULTIPLEX_BASE, bill->NUMOCCURRENCES, date);
+        expected_next[bill->BDID] = date.FormatISODate();
+    }
+
+    const Model_Billsdeposits::CatchUp_Stats stats = bills.catch_up(wxDate::Today()
+        , [](const Model_Billsdeposits::Data&) { return true; });
+
+    size_t wrong_dates = 0;
+    for (const auto& item : expected_next)
+    {
+        const Model_Billsdeposits::Data* bill = bills.get(item.first);
+        if (!bill || bill->NEXTOCCURRENCEDATE != item.second)
+            ++wrong_dates;
+    }
+
+    wxLogMessage("Overdue schedules: %zu\nExpected occurrences: %zu, wrong next dates: %zu\n%s"
+        , schedules, expected, wrong_dates, stats.summary());
+    return stats.schedules == schedules && stats.occurrences == expected && wrong_dates == 0;
+}
+
+MM_TEST(recurrence)
+{
+    const size_t schedules = 1000;
+    const int years = 10;
+    const int today = Recurrence::to_day(wxDateTime::Today());
+    const int last = Recurrence::to_day(wxDateTime::Today().Add(wxDateSpan::Years(years)));
+
+    // every repeat type, with a first occurrence on every day of the last year
+    std::vector<Recurrence> all;
+    std::vector<std::pair<int, int> > types;
+    for (size_t i = 0; i < schedules; ++i)
+    {
+        const int repeats = Model_Billsdeposits::REPEAT_WEEKLY + i % Model_Billsdeposits::REPEAT_MONTHLY_LAST_BUSINESS_DAY;
+        const int num = (repeats == Model_Billsdeposits::REPEAT_EVERY_X_DAYS || repeats == Model_Billsdeposits::REPEAT_IN_X_DAYS) ? 1 + i % 45
+            : (repeats == Model_Billsdeposits::REPEAT_EVERY_X_MONTHS || repeats == Model_Billsdeposits::REPEAT_IN_X_MONTHS) ? 1 + i % 5 : -1;
+        all.push_back(Recurrence(repeats, num, today - static_cast<int>(i % 365)));
+        types.push_back(std::make_pair(repeats, num));
+    }
+
+    wxLongLong start = wxGetUTCTimeMillis();
+    std::vector<std::vector<int> > expanded(all.size());
+    size_t occurrences = 0;
+    for (size_t i = 0; i < all.size(); ++i)
+        occurrences += all[i].expand(today, last, expanded[i]);
+    const wxLongLong expand_ms = wxGetUTCTimeMillis() - start;
+
+    // the same occurrences one step at a time, with nextOccurDate() and with wxDateSpan
+    start = wxGetUTCTimeMillis();
+    size_t stepped = 0, differences = 0;
+    const wxDateTime from = Recurrence::to_date(today), to = Recurrence::to_date(last);
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        const std::vector<int>& days = expanded[i];
+        size_t n = 0;
+        wxDateTime next = Recurrence::to_date(all[i].first());
+        wxDateTime span = next;
+        for (int k = 0; (all[i].count() < 0 || k < all[i].count()) && next <= to; ++k)
+        {
+            if (next >= from)
+            {
+                if (n >= days.size() || next.FormatISODate() != Recurrence::to_iso(days[n])) ++differences;
+                ++n;
+            }
+            if (!next.IsSameDate(span)) ++differences;
+            next = Model_Billsdeposits::nextOccurDate(types[i].first, types[i].second, next);
+            span = next_by_span(types[i].first, types[i].second, span);
+        }
+        if (n < days.size()) differences += days.size() - n;
+        stepped += n;
+    }
+    const wxLongLong step_ms = wxGetUTCTimeMillis() - start;
+
+    wxLogMessage("Schedules: %zu over %i years\n"
+        "Recurrence::expand: %zu occurrences in %lld ms\n"
+        "nextOccurDate and wxDateSpan steps: %zu occurrences in %lld ms\n"
+        "Occurrences that differ: %zu"
+        , all.size(), years, occurrences, expand_ms.GetValue()
+        , stepped, step_ms.GetValue(), differences);
+    return occurrences > 0 && occurrences == stepped && differences == 0;
+}
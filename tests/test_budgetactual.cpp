@@ -0,0 +1,234 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Account.h"
+#include "model/Model_Balance.h"
+#include "model/Model_BudgetActual.h"
+#include "model/Model_Category.h"
+#include "model/Model_Checking.h"
+#include "model/Model_MonthlyBalance.h"
+#include "model/Model_Splittransaction.h"
+#include "model/Model_Subcategory.h"
+#include "option.h"
+#include "reports/mmDateRange.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <wx/stopwatch.h>
+
+namespace
+{
+    bool differ(double a, double b)
+    {
+        return std::fabs(a - b) > 0.005;
+    }
+
+    /**
+    * Apply random edits to transactions and splits in a savepoint that is
+    * rolled back, and compare the totals with getCategoryStats after each round.
+    * Returns true when every amount matched, the counts and timings go to summary.
+    */
+    bool compare_all(wxSQLite3Database* db, int rounds, wxString& summary)
+    {
+        const auto accounts = Model_Account::instance().find(Model_Account::ACCOUNTTYPE(Model_Account::all_type()[Model_Account::INVESTMENT], NOT_EQUAL));
+        std::vector<Model_BudgetActual::Key> categories;
+        for (const auto& c : Model_Category::instance().all())
+            categories.push_back(std::make_pair(c.CATEGID, -1));
+        for (const auto& s : Model_Subcategory::instance().all())
+            categories.push_back(std::make_pair(s.CATEGID, s.SUBCATEGID));
+        if (accounts.empty() || categories.empty())
+        {
+            summary = "The check needs an account and a category";
+            return false;
+        }
+
+        // a calendar year and a financial year starting inside a month, in the year of the last transaction
+        int year = wxDate::Today().GetYear();
+        const auto all_trans = Model_Checking::instance().all(Model_Checking::COL_TRANSDATE);
+        if (!all_trans.empty())
+            year = Model_Checking::TRANSDATE(all_trans.back()).GetYear();
+        const std::vector<std::pair<wxDate, wxDate> > periods = {
+            std::make_pair(wxDate(1, wxDateTime::Jan, year), wxDate(31, wxDateTime::Dec, year))
+            , std::make_pair(wxDate(6, wxDateTime::Apr, year), wxDate(5, wxDateTime::Apr, year + 1))
+        };
+        const wxDate first = periods[0].first - wxDateSpan::Days(20);
+        const int span = (periods[1].second - first).GetDays() + 20;
+
+        std::mt19937 rng(2020);
+        auto pick = [&rng](int n) { return n > 0 ? static_cast<int>(rng() % static_cast<unsigned int>(n)) : 0; };
+        std::map<int, std::map<int, double> > budget_amounts;
+        for (const auto& key : categories)
+            budget_amounts[key.first][key.second] = pick(2) ? 100.0 : -100.0;
+
+        const bool updated = Option::instance().DatabaseUpdated();
+        db->Savepoint("MMEX_CHECK");
+        Model_BudgetActual& engine = Model_BudgetActual::instance();
+        engine.reset();
+
+        std::vector<int> ids;
+        for (const auto& tran : Model_Checking::instance().find(Model_Checking::TRANSDATE(first, GREATER_OR_EQUAL)
+            , Model_Checking::TRANSDATE(first + wxDateSpan::Days(span), LESS_OR_EQUAL)))
+        {
+            ids.push_back(tran.TRANSID);
+            if (ids.size() >= 200) break;
+        }
+
+        size_t edits = 0, compared = 0, differences = 0;
+        long recompute_ms = 0, engine_ms = 0;
+        wxString samples;
+        for (int round = 0; round <= rounds; round++)
+        {
+            // round 0 checks the initial load
+            for (int i = 0; round > 0 && i < 50; i++, edits++)
+            {
+                const int op = ids.empty() ? 0 : pick(4);
+                Model_Checking::Data* tran = op == 0 ? Model_Checking::instance().create()
+                    : Model_Checking::instance().get(ids[pick(static_cast<int>(ids.size()))]);
+                if (!tran) continue;
+
+                if (op == 2)
+                {
+                    ids.erase(std::find(ids.begin(), ids.end(), tran->TRANSID));
+                    Model_Checking::instance().remove(tran->TRANSID);
+                    continue;
+                }
+
+                const Model_BudgetActual::Key& key = categories[pick(static_cast<int>(categories.size()))];
+                if (op == 3)
+                {
+                    // replace the category by 1 to 3 splits
+                    Model_Splittransaction::Data_Set splits;
+                    for (int n = 1 + pick(3); n > 0; n--)
+                    {
+                        const Model_BudgetActual::Key& split_key = categories[pick(static_cast<int>(categories.size()))];
+                        Model_Splittransaction::Data split;
+                        split.CATEGID = split_key.first;
+                        split.SUBCATEGID = split_key.second;
+                        split.SPLITTRANSAMOUNT = (1 + pick(50000)) / 100.0;
+                        splits.push_back(split);
+                    }
+                    Model_Splittransaction::instance().update(splits, tran->TRANSID);
+                    tran->CATEGID = -1;
+                    tran->SUBCATEGID = -1;
+                    Model_Checking::instance().save(tran);
+                    continue;
+                }
+
+                const int kind = pick(10);
+                tran->ACCOUNTID = accounts[pick(static_cast<int>(accounts.size()))].ACCOUNTID;
+                tran->TOACCOUNTID = -1;
+                tran->TRANSCODE = Model_Checking::all_type()[kind < 5 ? Model_Checking::WITHDRAWAL
+                    : kind < 8 ? Model_Checking::DEPOSIT : Model_Checking::TRANSFER];
+                if (kind >= 8)
+                {
+                    tran->TOACCOUNTID = accounts[pick(static_cast<int>(accounts.size()))].ACCOUNTID;
+                    if (tran->TOACCOUNTID == tran->ACCOUNTID && accounts.size() < 2)
+                        tran->TRANSCODE = Model_Checking::all_type()[Model_Checking::DEPOSIT];
+                }
+                tran->TRANSAMOUNT = (1 + pick(100000)) / 100.0;
+                tran->TOTRANSAMOUNT = tran->TRANSAMOUNT;
+                tran->STATUS = pick(10) == 0 ? Model_Checking::all_status()[Model_Checking::VOID_] : "";
+                tran->CATEGID = key.first;
+                tran->SUBCATEGID = key.second;
+                tran->TRANSDATE = (first + wxDateSpan::Days(pick(span))).FormatISODate();
+                if (op == 0)
+                {
+                    tran->PAYEEID = -1;
+                    tran->FOLLOWUPID = -1;
+                    Model_Checking::instance().save(tran);
+                    ids.push_back(tran->TRANSID);
+                }
+                else
+                {
+                    Model_Checking::instance().save(tran);
+                    // a transaction with a category keeps no split
+                    if (pick(2)) Model_Splittransaction::instance().update(Model_Splittransaction::Data_Set(), tran->TRANSID);
+                }
+            }
+
+            for (const auto& period : periods)
+            {
+                for (int with_transfers = 0; with_transfers < 2; with_transfers++)
+                {
+                    mmSpecifiedRange range(period.first, period.second);
+                    std::map<int, std::map<int, std::map<int, double> > > stats;
+                    wxStopWatch sw;
+                    Model_Category::getCategoryStats(stats, nullptr, &range, false, false, with_transfers ? &budget_amounts : nullptr);
+                    recompute_ms += sw.Time();
+
+                    sw.Start();
+                    const Model_BudgetActual::Sums sums = engine.totals(period.first, period.second);
+                    engine_ms += sw.Time();
+
+                    for (const auto& c : stats)
+                    {
+                        for (const auto& s : c.second)
+                        {
+                            compared++;
+                            const double expected = s.second.count(0) ? s.second.at(0) : 0.0;
+                            const double value = Model_BudgetActual::actual(sums, c.first, s.first, with_transfers != 0, budget_amounts[c.first][s.first]);
+                            if (!differ(expected, value)) continue;
+                            if (differences++ < 10)
+                                samples += wxString::Format("round %i, %s - %s, category %i:%i: %.2f expected, %.2f found\n"
+                                    , round, period.first.FormatISODate(), period.second.FormatISODate()
+                                    , c.first, s.first, expected, value);
+                        }
+                    }
+                    for (const auto& item : sums)
+                    {
+                        if (stats.count(item.first.first) && stats[item.first.first].count(item.first.second)) continue;
+                        compared++;
+                        const double value = Model_BudgetActual::actual(sums, item.first.first, item.first.second, with_transfers != 0, 0.0);
+                        if (differ(0.0, value) && differences++ < 10)
+                            samples += wxString::Format("round %i, category %i:%i: %.2f found, none expected\n"
+                                , round, item.first.first, item.first.second, value);
+                    }
+                }
+            }
+        }
+
+        db->Rollback("MMEX_CHECK");
+        db->ReleaseSavepoint("MMEX_CHECK");
+        Option::instance().DatabaseUpdated(updated);
+        Model_Checking::instance().destroy_cache();
+        Model_Splittransaction::instance().destroy_cache();
+        Model_MonthlyBalance::instance().destroy_cache();
+        Model_Balance::instance().reset();
+        engine.reset();
+
+        summary = wxString::Format("Rounds: %i of 50 random edits, %zu edits\n"
+            "Compared amounts: %zu, different: %zu\n"
+            "getCategoryStats: %ld ms in total\n"
+            "Incremental totals: %ld ms in total, the first load included\n"
+            , rounds, edits, compared, differences, recompute_ms, engine_ms) + samples;
+        return compared > 0 && differences == 0;
+    }
+}
+
+MM_TEST(budget_actual)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    wxString summary;
+    const bool passed = compare_all(db.get(), 20, summary);
+    wxLogMessage("%s", summary);
+    return passed;
+}
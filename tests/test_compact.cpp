@@ -0,0 +1,76 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "platfdep.h"
+#include "model/Model_Checking.h"
+#include <algorithm>
+#include <limits>
+
+MM_TEST(compact_storage)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    // the heap bytes in use before and after each load, as the allocator counts them
+    Model_Checking::instance().destroy_cache();
+    size_t start = mmex::GetHeapBytesInUse();
+    Model_Checking::instance().preload(std::numeric_limits<int>::max());
+    const size_t cache_bytes = mmex::GetHeapBytesInUse() - start;
+
+    start = mmex::GetHeapBytesInUse();
+    const Model_Checking::Data_Set data = Model_Checking::instance().all();
+    const size_t data_bytes = mmex::GetHeapBytesInUse() - start;
+
+    start = mmex::GetHeapBytesInUse();
+    const Model_Checking::Compact_Set compact = Model_Checking::instance().all_compact();
+    const size_t compact_bytes = mmex::GetHeapBytesInUse() - start;
+
+    size_t differences = 0, lazy_differences = 0;
+    for (size_t i = 0; i < data.size() && i < compact.size(); ++i)
+    {
+        if (data[i].to_json() != compact[i].to_json())
+            ++differences;
+
+        const Model_Checking::Compact_Set::Row row = compact.row(i);
+        if (row.TRANSID() != data[i].TRANSID || row.TRANSAMOUNT() != data[i].TRANSAMOUNT
+            || row.NOTES() != data[i].NOTES || row.TRANSDATE() != data[i].TRANSDATE
+            || row.STATUS() != data[i].STATUS || row.TRANSCODE() != data[i].TRANSCODE)
+            ++lazy_differences;
+        if (Model_Checking::type(data[i].TRANSCODE) != static_cast<int>(row.TRANSCODE_code()))
+            ++lazy_differences;
+    }
+
+    const size_t rows = std::max<size_t>(1, compact.size());
+    wxLogMessage("Transactions: %zu\n"
+        "Model cache: %zu KB, %zu bytes per record\n"
+        "Data_Set: %zu KB, %zu bytes per record\n"
+        "Compact_Set: %zu KB, %zu bytes per record (%zu bytes fixed)\n"
+        "Records that differ: %zu, lazy accessors that differ: %zu"
+        , compact.size()
+        , cache_bytes / 1024, cache_bytes / rows
+        , data_bytes / 1024, data_bytes / rows
+        , compact_bytes / 1024, compact_bytes / rows, sizeof(Model_Checking::Compact_Set::Record)
+        , differences, lazy_differences);
+
+    // a platform without heap statistics reports 0 for all three
+    const bool smaller = cache_bytes == 0 || compact_bytes * 3 < cache_bytes;
+    return !compact.empty() && compact.size() == data.size()
+        && differences == 0 && lazy_differences == 0 && smaller;
+}
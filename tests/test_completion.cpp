@@ -0,0 +1,71 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Account.h"
+#include "model/Model_Checking.h"
+#include "model/Model_Completion.h"
+
+namespace
+{
+    /** The payees, the notes and the last payee of every account, as the dialogs read them */
+    const wxString snapshot()
+    {
+        Model_Completion& completion = Model_Completion::instance();
+        wxString result;
+        for (const auto& name : completion.payees("", 20))
+            result << name << ";";
+        std::vector<wxString> notes;
+        completion.frequent_notes(notes, -1, 20);
+        for (const auto& text : notes)
+            result << text << ";";
+        for (const auto& account : Model_Account::instance().all())
+            result << account.ACCOUNTID << ":" << completion.last_payee(account.ACCOUNTID) << ";";
+        return result;
+    }
+}
+
+MM_TEST(completion)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+    const wxString before = snapshot();
+
+    // edit the notes and the payee of existing transactions, delete the last one of each account
+    for (int id = 1; id <= 60; id += 3)
+    {
+        Model_Checking::Data* tran = Model_Checking::instance().get(id);
+        if (!tran) continue;
+        tran->NOTES = "Edited note";
+        if (tran->PAYEEID > 0) tran->PAYEEID = 1;
+        Model_Checking::instance().save(tran);
+    }
+    for (const auto& account : Model_Account::instance().all())
+    {
+        const auto trans = Model_Checking::instance().find(Model_Checking::ACCOUNTID(account.ACCOUNTID));
+        if (!trans.empty()) Model_Checking::instance().remove(trans.back().TRANSID);
+    }
+    const wxString incremental = snapshot();
+
+    Model_Completion::instance().reset();
+    const wxString reloaded = snapshot();
+
+    wxLogMessage("before: %s\nafter the edits: %s\nreloaded: %s", before, incremental, reloaded);
+    return incremental == reloaded && incremental != before;
+}
@@ -0,0 +1,41 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Checking.h"
+
+MM_TEST(cursor_stop)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    size_t visited = 0;
+    const size_t all = Model_Checking::instance().for_each([&visited](const Model_Checking::Data&) { visited++; });
+    const size_t total = visited;
+
+    // the callback returning false ends the scan on the 10th record
+    visited = 0;
+    const size_t read = Model_Checking::instance().for_each([&visited](const Model_Checking::Data&) -> bool
+    {
+        return ++visited < 10;
+    });
+
+    wxLogMessage("%zu records, the scan stopped after %zu, %zu visited", all, read, visited);
+    return all == total && total > 10 && read == 10 && visited == 10;
+}
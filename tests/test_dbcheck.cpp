@@ -0,0 +1,110 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "dbcheck.h"
+#include <algorithm>
+
+namespace
+{
+    // one broken row per rule, in rule order, around a set of valid rows with the ID SEED
+    const int SEED = 1900000000;
+    const char* const SEED_ROWS[] =
+    {
+        "INSERT INTO ACCOUNTLIST_V1 (ACCOUNTID, ACCOUNTNAME, ACCOUNTTYPE, STATUS, FAVORITEACCT, CURRENCYID) VALUES (%1$d, 'MMEX_CHECK %1$d', 'Investment', 'Open', 'FALSE', 1)",
+        "INSERT INTO PAYEE_V1 (PAYEEID, PAYEENAME) VALUES (%1$d, 'MMEX_CHECK %1$d')",
+        "INSERT INTO CATEGORY_V1 (CATEGID, CATEGNAME) VALUES (%1$d, 'MMEX_CHECK %1$d')",
+        "INSERT INTO SUBCATEGORY_V1 (SUBCATEGID, SUBCATEGNAME, CATEGID) VALUES (%1$d, 'MMEX_CHECK %1$d', %1$d)",
+        "INSERT INTO CHECKINGACCOUNT_V1 (TRANSID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, CATEGID, SUBCATEGID) VALUES (%1$d, %1$d, -1, %1$d, 'Withdrawal', 1, %1$d, %1$d)",
+        "INSERT INTO BILLSDEPOSITS_V1 (BDID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT) VALUES (%1$d, %1$d, -1, %1$d, 'Withdrawal', 1)",
+        "INSERT INTO STOCK_V1 (STOCKID, HELDAT, PURCHASEDATE, STOCKNAME, PURCHASEPRICE, CURRENTPRICE) VALUES (%1$d, %1$d, '2020-01-01', 'MMEX_CHECK', 1, 1)",
+        "INSERT INTO ASSETS_V1 (ASSETID, STARTDATE, ASSETNAME) VALUES (%1$d, '2020-01-01', 'MMEX_CHECK')",
+        // broken rows, IDs SEED + 1.. refer to SEED + 99
+        "INSERT INTO CHECKINGACCOUNT_V1 (TRANSID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, CATEGID, SUBCATEGID) VALUES (%1$d + 1, %1$d + 99, -1, %1$d, 'Withdrawal', 1, %1$d, %1$d)",
+        "INSERT INTO CHECKINGACCOUNT_V1 (TRANSID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, CATEGID, SUBCATEGID) VALUES (%1$d + 2, %1$d, %1$d + 99, -1, 'Transfer', 1, %1$d, %1$d)",
+        "INSERT INTO CHECKINGACCOUNT_V1 (TRANSID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, CATEGID, SUBCATEGID) VALUES (%1$d + 3, %1$d, -1, %1$d + 99, 'Withdrawal', 1, %1$d, %1$d)",
+        "INSERT INTO CHECKINGACCOUNT_V1 (TRANSID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, CATEGID, SUBCATEGID) VALUES (%1$d + 4, %1$d, -1, %1$d, 'Withdrawal', 1, %1$d + 99, -1)",
+        "INSERT INTO CHECKINGACCOUNT_V1 (TRANSID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, CATEGID, SUBCATEGID) VALUES (%1$d + 5, %1$d, -1, %1$d, 'Withdrawal', 1, %1$d, %1$d + 99)",
+        "INSERT INTO SPLITTRANSACTIONS_V1 (SPLITTRANSID, TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT) VALUES (%1$d + 1, %1$d + 99, %1$d, -1, 1)",
+        "INSERT INTO SPLITTRANSACTIONS_V1 (SPLITTRANSID, TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT) VALUES (%1$d + 2, %1$d, %1$d + 99, -1, 1)",
+        "INSERT INTO BILLSDEPOSITS_V1 (BDID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT) VALUES (%1$d + 1, %1$d + 99, -1, %1$d, 'Withdrawal', 1)",
+        "INSERT INTO BILLSDEPOSITS_V1 (BDID, ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT) VALUES (%1$d + 2, %1$d, %1$d + 99, -1, 'Transfer', 1)",
+        "INSERT INTO BUDGETSPLITTRANSACTIONS_V1 (SPLITTRANSID, TRANSID, CATEGID, SUBCATEGID, SPLITTRANSAMOUNT) VALUES (%1$d + 1, %1$d + 99, %1$d, -1, 1)",
+        "INSERT INTO STOCK_V1 (STOCKID, HELDAT, PURCHASEDATE, STOCKNAME, PURCHASEPRICE, CURRENTPRICE) VALUES (%1$d + 1, %1$d + 99, '2020-01-01', 'MMEX_CHECK', 1, 1)",
+        "INSERT INTO TRANSLINK_V1 (TRANSLINKID, CHECKINGACCOUNTID, LINKTYPE, LINKRECORDID) VALUES (%1$d + 1, %1$d + 99, 'Asset', %1$d)",
+        "INSERT INTO TRANSLINK_V1 (TRANSLINKID, CHECKINGACCOUNTID, LINKTYPE, LINKRECORDID) VALUES (%1$d + 2, %1$d, 'Asset', %1$d + 99)",
+        "INSERT INTO TRANSLINK_V1 (TRANSLINKID, CHECKINGACCOUNTID, LINKTYPE, LINKRECORDID) VALUES (%1$d + 3, %1$d, 'Stock', %1$d + 99)",
+        "INSERT INTO ATTACHMENT_V1 (ATTACHMENTID, REFTYPE, REFID, FILENAME) VALUES (%1$d + 1, 'Transaction', %1$d + 99, 'MMEX_CHECK')",
+    };
+
+    // the ID of the broken row seeded for each rule
+    const int SEED_IDS[] = { 1, 2, 3, 4, 5, 1, 2, 1, 2, 1, 1, 1, 2, 3, 1 };
+}
+
+MM_TEST(integrity)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    // the generated rows break no rule
+    const dbCheck::Results before = dbCheck::run(db.get(), false, 0);
+    wxLogMessage("%s", dbCheck::report(before));
+    bool passed = dbCheck::clean(before);
+
+    dbCheck::Results seeded, fixed, after;
+    try
+    {
+        for (const auto& row : SEED_ROWS)
+            db.get()->ExecuteUpdate(wxString::Format(row, SEED));
+    }
+    catch (const wxSQLite3Exception& e)
+    {
+        wxLogError("integrity: Exception %s", e.GetMessage().utf8_str());
+        return false;
+    }
+    seeded = dbCheck::run(db.get(), false, static_cast<size_t>(-1));
+    fixed = dbCheck::run(db.get(), true, 0);
+    after = dbCheck::run(db.get(), false, 0);
+    wxLogMessage("%s", dbCheck::report(fixed));
+
+    const size_t rules = sizeof(SEED_IDS) / sizeof(SEED_IDS[0]);
+    if (before.size() != rules || seeded.size() != rules || after.size() != rules)
+    {
+        wxLogMessage("%zu rules ran, %zu seeded", seeded.size(), rules);
+        return false;
+    }
+
+    // each rule finds its own broken row and the fix mode leaves none
+    for (size_t i = 0; i < rules; i++)
+    {
+        const dbCheck::Result& r = seeded[i];
+        const int id = SEED + SEED_IDS[i];
+        if (r.count != 1 || std::find(r.samples.begin(), r.samples.end(), id) == r.samples.end())
+        {
+            wxLogMessage("%s: %zu found, 1 expected", r.name, r.count);
+            passed = false;
+        }
+        if (r.fixable && after[i].count != 0)
+        {
+            wxLogMessage("%s: %zu left after the fix", r.name, after[i].count);
+            passed = false;
+        }
+    }
+    return passed;
+}
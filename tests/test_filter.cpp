@@ -0,0 +1,93 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Checking.h"
+#include <algorithm>
+
+namespace
+{
+    // UTF-8 escapes, split where a letter would extend the escape
+    const char* NOTES[] = {
+        "Caf\xC3\xA9 \xC3\xBC" "ber"
+        , "CAF\xC3\x89 \xC3\x9C" "BER"
+        , "cafe uber"
+        , "\xC3\x86r\xC3\xB8 ferry"
+        , "Bench note 1"
+    };
+    const char* MASKS[] = {
+        "*\xC3\xBC" "ber*"
+        , "caf\xC3\xA9*"
+        , "*\xC3\xA9?*"
+        , "*\xC3\xB8*"
+        , "caf*"
+        , "bench note 1*"
+    };
+}
+
+MM_TEST(filter_text)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    for (const auto& notes : NOTES)
+    {
+        Model_Checking::Data* tran = Model_Checking::instance().create();
+        tran->ACCOUNTID = 1;
+        tran->TOACCOUNTID = -1;
+        tran->PAYEEID = -1;
+        tran->TRANSCODE = Model_Checking::all_type()[Model_Checking::WITHDRAWAL];
+        tran->TRANSAMOUNT = 1;
+        tran->TOTRANSAMOUNT = 1;
+        tran->CATEGID = -1;
+        tran->SUBCATEGID = -1;
+        tran->FOLLOWUPID = -1;
+        tran->TRANSDATE = "2019-12-31";
+        tran->NOTES = wxString::FromUTF8(notes);
+        Model_Checking::instance().save(tran);
+    }
+    const auto all = Model_Checking::instance().all();
+
+    bool passed = true;
+    for (const auto& item : MASKS)
+    {
+        const wxString mask = wxString::FromUTF8(item);
+        std::vector<wxVariant> params;
+        bool exact = true;
+        const wxString condition = Model_Checking::text_condition("NOTES", mask, params, exact);
+        // the reference rule of checkAll
+        auto matches = [&mask](const Model_Checking::Data& tran)
+        {
+            return !tran.NOTES.empty() && tran.NOTES.Lower().Matches(mask);
+        };
+
+        size_t found = 0;
+        for (const auto& tran : Model_Checking::instance().find_where(condition, params))
+            if (exact || matches(tran)) found++;
+        const size_t expected = std::count_if(all.begin(), all.end(), matches);
+
+        // a non-ASCII mask only narrows to the rows with text, LIKE would miss case variants
+        const bool ascii = mask.IsAscii();
+        const bool ok = found == expected && expected > 0
+            && exact == ascii && (ascii || !condition.Contains("LIKE"));
+        wxLogMessage("%s: %s, %zu found, %zu expected%s", mask, condition, found, expected, ok ? "" : " - wrong");
+        passed = passed && ok;
+    }
+    return passed;
+}
@@ -0,0 +1,198 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "dbwrapper.h"
+#include "option.h"
+#include "model/Model_Account.h"
+#include "model/Model_Category.h"
+#include "model/Model_Checking.h"
+#include "model/Model_CurrencyHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <wx/time.h>
+#include <wx/wxsqlite3.h>
+
+namespace
+{
+    /** The value of a one column query, false when it is NULL */
+    bool scalar(wxSQLite3Database* db, const wxString& sql, double& value)
+    {
+        wxSQLite3ResultSet q = db->ExecuteQuery(sql);
+        const bool found = q.NextRow() && !q.IsNull(0);
+        value = found ? q.GetDouble(0) : 0;
+        q.Finalize();
+        return found;
+    }
+
+    int last_id(wxSQLite3Database* db)
+    {
+        return static_cast<int>(db->GetLastRowId().GetLo());
+    }
+
+    /**
+    * Convert every transaction with the SQL functions in one query and with
+    * the models row by row, as the C++ reports do. True if they agree.
+    */
+    bool compare_all(wxSQLite3Database* db)
+    {
+        struct Row
+        {
+            int account_id, categ_id, subcateg_id;
+            wxString date;
+            double amount, base;
+            bool has_base;
+            wxString path;
+        };
+        std::vector<Row> rows;
+        wxArrayString samples;
+        size_t rate_differences = 0, path_differences = 0;
+
+        // one query, the conversion is done by SQLite
+        mmDBWrapper::InvalidateFunctions("CURRENCYFORMATS_V1");
+        wxLongLong start = wxGetUTCTimeMillis();
+        try
+        {
+            wxSQLite3ResultSet q = db->ExecuteQuery("SELECT ACCOUNTID, CATEGID, SUBCATEGID, TRANSDATE, TRANSAMOUNT"
+                ", mmex_to_base(TRANSAMOUNT, ACCOUNTID, TRANSDATE), mmex_catpath(CATEGID, SUBCATEGID) FROM CHECKINGACCOUNT_V1");
+            while (q.NextRow())
+            {
+                Row r;
+                r.account_id = q.GetInt(0);
+                r.categ_id = q.GetInt(1, -1);
+                r.subcateg_id = q.GetInt(2, -1);
+                r.date = q.GetString(3);
+                r.amount = q.GetDouble(4);
+                r.has_base = !q.IsNull(5);
+                r.base = q.GetDouble(5);
+                r.path = q.GetString(6);
+                rows.push_back(r);
+            }
+            q.Finalize();
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("sql_functions: Exception %s", e.GetMessage().utf8_str());
+            return false;
+        }
+        const wxLongLong sql_ms = wxGetUTCTimeMillis() - start;
+
+        // the same columns from a plain query, converted row by row with the models as the C++ reports do
+        start = wxGetUTCTimeMillis();
+        std::vector<std::pair<double, wxString> > converted;
+        for (const auto& tran : Model_Checking::instance().all())
+        {
+            const Model_Account::Data* account = Model_Account::instance().get(tran.ACCOUNTID);
+            const Model_Currency::Data* currency = account ? Model_Account::currency(account) : nullptr;
+            converted.push_back(std::make_pair(currency ? tran.TRANSAMOUNT * Model_CurrencyHistory::getDayRate(currency->CURRENCYID, tran.TRANSDATE) : 0
+                , Model_Category::full_name(tran.CATEGID, tran.SUBCATEGID)));
+        }
+        const wxLongLong model_ms = wxGetUTCTimeMillis() - start;
+
+        for (const auto& r : rows)
+        {
+            const Model_Account::Data* account = Model_Account::instance().get(r.account_id);
+            const Model_Currency::Data* currency = account ? Model_Account::currency(account) : nullptr;
+            const double base = currency ? r.amount * Model_CurrencyHistory::getDayRate(currency->CURRENCYID, r.date) : 0;
+            if (r.has_base != (currency != nullptr) || std::fabs(r.base - base) > 0.000001 * std::max(1.0, std::fabs(base)))
+            {
+                if (rate_differences++ < 5)
+                    samples.Add(wxString::Format("account %i %s %.2f: %.6f instead of %.6f", r.account_id, r.date, r.amount, r.base, base));
+            }
+            const wxString path = Model_Category::full_name(r.categ_id, r.subcateg_id);
+            if (r.path != path)
+            {
+                if (path_differences++ < 5)
+                    samples.Add(wxString::Format("category %i:%i: '%s' instead of '%s'", r.categ_id, r.subcateg_id, r.path, path));
+            }
+        }
+
+        wxString summary = wxString::Format("Transactions: %zu\n"
+            "SQL functions: %lld ms\n"
+            "Models row by row: %lld ms\n"
+            "Rates that differ: %zu\n"
+            "Category paths that differ: %zu\n"
+            , rows.size(), sql_ms.GetValue(), model_ms.GetValue()
+            , rate_differences, path_differences);
+        for (const auto& sample : samples)
+            summary += "  " + sample + "\n";
+        wxLogMessage("%s", summary);
+        return !rows.empty() && rate_differences == 0 && path_differences == 0;
+    }
+}
+
+MM_TEST(sql_functions)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    // every generated transaction, against the models
+    bool passed = compare_all(db.get());
+
+    // a currency worth 2 without history, with rates on 2020-01-10 and 2020-01-20, and an account in it
+    db.get()->ExecuteUpdate("INSERT INTO CURRENCYFORMATS_V1 (CURRENCYNAME, PFX_SYMBOL, SFX_SYMBOL, DECIMAL_POINT, GROUP_SEPARATOR"
+        ", UNIT_NAME, CENT_NAME, SCALE, BASECONVRATE, CURRENCY_SYMBOL) VALUES ('Test', '', '', '.', ',', '', '', 100, 2, 'TST')");
+    const int currency = last_id(db.get());
+    db.get()->ExecuteUpdate(wxString::Format("INSERT INTO CURRENCYHISTORY_V1 (CURRENCYID, CURRDATE, CURRVALUE, CURRUPDTYPE)"
+        " VALUES (%i, '2020-01-10', 1.5, 1), (%i, '2020-01-20', 2.5, 1)", currency, currency));
+    db.get()->ExecuteUpdate(wxString::Format("INSERT INTO ACCOUNTLIST_V1 (ACCOUNTNAME, ACCOUNTTYPE, STATUS, FAVORITEACCT, CURRENCYID, INITIALBAL)"
+        " VALUES ('Test', 'Checking', 'Open', 'FALSE', %i, 0)", currency));
+    const int account = last_id(db.get());
+
+    auto check = [&](const wxString& name, const wxString& sql, bool is_null, double expected)
+    {
+        double value = 0;
+        const bool found = scalar(db.get(), sql, value);
+        const bool ok = is_null ? !found : found && std::fabs(value - expected) < 0.000001;
+        wxLogMessage("%s: %s, %s expected", name, found ? wxString::Format("%g", value) : wxString("NULL")
+            , is_null ? wxString("NULL") : wxString::Format("%g", expected));
+        passed = passed && ok;
+    };
+    // and the same rate from the models
+    auto rate = [&](const wxString& name, int currency_id, const wxString& date, double expected)
+    {
+        check(name, wxString::Format("SELECT mmex_rate(%i, '%s')", currency_id, date), false, expected);
+        const double model = Model_CurrencyHistory::getDayRate(currency_id, date);
+        if (std::fabs(model - expected) > 0.000001)
+        {
+            wxLogMessage("%s: the models give %g", name, model);
+            passed = false;
+        }
+    };
+
+    rate("base currency", Option::instance().getBaseCurrencyID(), "2020-01-15", 1);
+    rate("before the first rate", currency, "2020-01-01", 1.5);
+    rate("after the last rate", currency, "2020-02-01", 2.5);
+    rate("rate of the day", currency, "2020-01-20", 2.5);
+    rate("tie between the neighbours, the earlier wins", currency, "2020-01-15", 1.5);
+    rate("nearer to the later rate", currency, "2020-01-16", 2.5);
+    check("amount of an account", wxString::Format("SELECT mmex_to_base(100, %i, '2020-01-16')", account), false, 250);
+    check("unknown account", "SELECT mmex_to_base(100, 999999, '2020-01-16')", true, 0);
+    check("unknown currency", "SELECT mmex_rate(999999, '2020-01-16')", true, 0);
+
+    // without history every date has the rate of the currency
+    Option::instance().CurrencyHistoryEnabled(false);
+    rate("history off", currency, "2020-01-15", 2);
+    check("history off, amount of an account", wxString::Format("SELECT mmex_to_base(100, %i, '2020-01-01')", account), false, 200);
+    check("history off, unknown account", "SELECT mmex_to_base(100, 999999, '2020-01-16')", true, 0);
+    Option::instance().CurrencyHistoryEnabled(true);
+
+    return passed;
+}
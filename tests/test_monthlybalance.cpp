@@ -0,0 +1,182 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "dbupgrade.h"
+#include "model/Model_Checking.h"
+#include "model/Model_MonthlyBalance.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <wx/stopwatch.h>
+
+namespace
+{
+    const int ACCOUNTS = 20;
+    const int FIRST_ACCOUNT = 1900000000;
+
+    // transactions dated in order over the period on the synthetic accounts
+    const wxString SYNTHETIC_INSERT =
+        "WITH RECURSIVE N(I) AS (SELECT 0 UNION ALL SELECT I + 1 FROM N WHERE I + 1 < ?1)"
+        " INSERT INTO CHECKINGACCOUNT_V1 (ACCOUNTID, TOACCOUNTID, PAYEEID, TRANSCODE, TRANSAMOUNT, STATUS"
+        ", TRANSACTIONNUMBER, NOTES, CATEGID, SUBCATEGID, TRANSDATE, FOLLOWUPID, TOTRANSAMOUNT)"
+        " SELECT ?2 + I % ?3"
+        ", CASE WHEN I % 10 = 0 THEN ?2 + (I + 1) % ?3 ELSE -1 END"
+        ", -1"
+        ", CASE WHEN I % 10 = 0 THEN 'Transfer' WHEN I % 3 = 0 THEN 'Deposit' ELSE 'Withdrawal' END"
+        ", (I % 50000) / 100.0 + 1"
+        ", CASE WHEN I % 97 = 0 THEN 'Void' WHEN I % 5 = 0 THEN 'R' ELSE '' END"
+        ", '', '', -1, -1"
+        ", date(?4, '+' || (I * ?5 / ?1) || ' days')"
+        ", -1"
+        ", (I % 50000) / 100.0 + 1"
+        " FROM N";
+
+    bool insert(wxSQLite3Database* db, int transactions)
+    {
+        const wxDate today = wxDate::Today();
+        const wxDate first = today - wxDateSpan::Years(10);
+        try
+        {
+            wxSQLite3Statement stmt = db->PrepareStatement(SYNTHETIC_INSERT);
+            stmt.Bind(1, transactions);
+            stmt.Bind(2, FIRST_ACCOUNT);
+            stmt.Bind(3, ACCOUNTS);
+            stmt.Bind(4, first.FormatISODate());
+            stmt.Bind(5, (today - first).GetDays());
+            stmt.ExecuteUpdate();
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("monthly_balance: Exception %s", e.GetMessage().utf8_str());
+            return false;
+        }
+        Model_Checking::instance().destroy_cache();
+        Model_MonthlyBalance::instance().destroy_cache();
+        return true;
+    }
+
+    /** Month-end balances as the summary reports read them before the table */
+    size_t ledger(std::map<std::pair<int, wxString>, double>& closing)
+    {
+        size_t rows = 0;
+        for (int account_id = FIRST_ACCOUNT; account_id < FIRST_ACCOUNT + ACCOUNTS; account_id++)
+        {
+            const auto trans = Model_Checking::instance().find_or(Model_Checking::ACCOUNTID(account_id)
+                , Model_Checking::TOACCOUNTID(account_id));
+            rows += trans.size();
+            std::map<wxString, double> flows;
+            for (const auto& tran : trans)
+                flows[Model_MonthlyBalance::MONTH(tran.TRANSDATE)] += Model_Checking::balance(tran, account_id);
+
+            double balance = 0.0;
+            for (const auto& f : flows)
+            {
+                balance += f.second;
+                closing[std::make_pair(account_id, f.first)] = balance;
+            }
+        }
+        return rows;
+    }
+
+    size_t snapshot(std::map<std::pair<int, wxString>, double>& closing)
+    {
+        size_t rows = 0;
+        for (int account_id = FIRST_ACCOUNT; account_id < FIRST_ACCOUNT + ACCOUNTS; account_id++)
+        {
+            for (const auto& r : Model_MonthlyBalance::instance().months(account_id))
+            {
+                closing[std::make_pair(account_id, r.MONTH)] = r.BALANCE;
+                rows++;
+            }
+        }
+        return rows;
+    }
+
+    /** Replace the table and its triggers by the ones of the upgrade to version 8 */
+    bool upgrade(wxSQLite3Database* db)
+    {
+        try
+        {
+            db->ExecuteUpdate("DROP TRIGGER TRG_MONTHLYBALANCE_INSERT");
+            db->ExecuteUpdate("DROP TRIGGER TRG_MONTHLYBALANCE_UPDATE");
+            db->ExecuteUpdate("DROP TRIGGER TRG_MONTHLYBALANCE_DELETE");
+            db->ExecuteUpdate("DROP TABLE MONTHLYBALANCE_V1");
+            for (const auto& query : dbUpgrade::SplitQueries(dbUpgradeQuery[8]))
+                db->ExecuteUpdate(query);
+        }
+        catch (const wxSQLite3Exception& e)
+        {
+            wxLogError("monthly_balance: Exception %s", e.GetMessage().utf8_str());
+            return false;
+        }
+        Model_MonthlyBalance::instance().destroy_cache();
+        return true;
+    }
+}
+
+MM_TEST(monthly_balance)
+{
+    const int transactions = 100000;
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    wxStopWatch sw;
+    if (!insert(db.get(), transactions)) return false;
+    const long insert_ms = sw.Time();
+
+    std::map<std::pair<int, wxString>, double> by_ledger, by_table;
+    sw.Start();
+    const size_t ledger_rows = ledger(by_ledger);
+    const long ledger_ms = sw.Time();
+    sw.Start();
+    const size_t table_rows = snapshot(by_table);
+    const long table_ms = sw.Time();
+
+    size_t different = by_ledger.size() > by_table.size() ? by_ledger.size() - by_table.size() : by_table.size() - by_ledger.size();
+    for (const auto& l : by_ledger)
+    {
+        const auto it = by_table.find(l.first);
+        if (it != by_table.end() && std::fabs(it->second - l.second) > 0.005) different++;
+    }
+    const Model_MonthlyBalance::Check check = Model_MonthlyBalance::instance().verify(5);
+
+    // an older file gets the table filled by the upgrade, the triggers keep it from then on
+    const bool upgraded = upgrade(db.get());
+    const Model_MonthlyBalance::Check filled = Model_MonthlyBalance::instance().verify(5);
+    const bool inserted = insert(db.get(), transactions / 10);
+    const Model_MonthlyBalance::Check updated = Model_MonthlyBalance::instance().verify(5);
+
+    wxLogMessage("Synthetic transactions: %i on %i accounts over 10 years\n"
+        "Insert with the triggers: %ld ms\n"
+        "Ledger scan: %zu transactions, %ld ms\n"
+        "Month-end table: %zu rows, %ld ms (%.0fx)\n"
+        "Different month-end balances: %zu\n"
+        "%s"
+        "Upgrade to version 8: %s%s"
+        "After inserts: %s"
+        , transactions, ACCOUNTS, insert_ms
+        , ledger_rows, ledger_ms
+        , table_rows, table_ms, static_cast<double>(ledger_ms) / std::max(1L, table_ms)
+        , different, check.summary()
+        , upgraded ? "" : "failed\n", filled.summary(), updated.summary());
+
+    return ledger_rows > 0 && different == 0 && check.ok()
+        && upgraded && filled.ok() && inserted && updated.ok();
+}
@@ -0,0 +1,62 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "model/Model_Account.h"
+#include "model/Model_Category.h"
+#include "model/Model_NameTable.h"
+#include "model/Model_Payee.h"
+
+MM_TEST(name_rename)
+{
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    Model_Account::Data* account = Model_Account::instance().get(1);
+    Model_Payee::Data* payee = Model_Payee::instance().get(1);
+    Model_Category::Data* category = Model_Category::instance().get(1);
+    if (!account || !payee || !category) return false;
+
+    // the entries a row view keeps, resolved once before the renames
+    Model_NameTable& names = Model_NameTable::instance();
+    const Model_NameTable::Entry* account_entry = names.account(account->ACCOUNTID);
+    const Model_NameTable::Entry* payee_entry = names.payee(payee->PAYEEID);
+    const Model_NameTable::Entry* category_entry = names.category(category->CATEGID, -1);
+    const bool before = Model_NameTable::name(account_entry) == account->ACCOUNTNAME
+        && Model_NameTable::name(payee_entry) == payee->PAYEENAME
+        && Model_NameTable::name(category_entry) == category->CATEGNAME;
+
+    // the update hook marks the entries stale, the same pointers give the new names
+    account->ACCOUNTNAME = "Renamed account";
+    Model_Account::instance().save(account);
+    payee->PAYEENAME = "Renamed payee";
+    Model_Payee::instance().save(payee);
+    category->CATEGNAME = "Renamed category";
+    Model_Category::instance().save(category);
+
+    const wxString account_name = Model_NameTable::name(account_entry);
+    const wxString payee_name = Model_NameTable::name(payee_entry);
+    const wxString category_name = Model_NameTable::name(category_entry);
+    const wxString full_name = Model_Category::full_name(category->CATEGID, -1);
+
+    wxLogMessage("Names before the renames: %s\nAfter: %s, %s, %s, full_name %s"
+        , before ? "resolved" : "wrong", account_name, payee_name, category_name, full_name);
+    return before && account_name == "Renamed account" && payee_name == "Renamed payee"
+        && category_name == "Renamed category" && full_name == "Renamed category";
+}
@@ -0,0 +1,76 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "platfdep.h"
+#include "util.h"
+#include "import_export/qif_import.h"
+#include <algorithm>
+#include <wx/filename.h>
+#include <wx/time.h>
+#include <wx/wfstream.h>
+
+MM_TEST(qif_import)
+{
+    // mmex_bench imports 200000 lines, a tenth is enough to cover the tokenizer, the decoder and the writer
+    const size_t lines = 20000;
+    mmBench::Database db(":memory:");
+    if (!db.IsOpen()) return false;
+    mmBench::generate(db.get(), mmTest::params());
+
+    const wxString checking = "Test Checking";
+    const wxString path = wxFileName::CreateTempFileName("mmex");
+    const size_t written = mmBench::write_qif(path, lines, checking, "Test Savings");
+    const size_t peak_before = mmex::GetPeakMemoryKB();
+
+    mmQIFImport qif;
+    mmDates dates;
+    wxLongLong start = wxGetUTCTimeMillis();
+    size_t read_lines = 0;
+    {
+        wxFileInputStream input(path);
+        read_lines = qif.read(input, wxConvUTF8, checking, false, &dates, mmQIFImport::Line_Callback());
+    }
+    dates.doFinalizeStatistics();
+    const wxLongLong read_ms = wxGetUTCTimeMillis() - start;
+    wxRemoveFile(path);
+
+    mmQIFImport::Target target;
+    target.account = checking;
+    target.date_format = dates.isDateFormatFound() ? dates.getDateFormat() : "%m/%d/%Y";
+    start = wxGetUTCTimeMillis();
+    qif.decode(target.date_format, target.decimal);
+    const wxLongLong decode_ms = wxGetUTCTimeMillis() - start;
+
+    const mmQIFImport::Result result = qif.write(target, mmQIFImport::Progress_Callback());
+    const size_t peak_after = mmex::GetPeakMemoryKB();
+
+    const double rows = static_cast<double>(result.imported + result.splits);
+    const double write_s = std::max<double>(1, result.ms.ToDouble()) / 1000;
+    wxLogMessage("QIF lines: %zu, entries: %zu\n"
+        "Read: %lld ms (%.0f lines/s), date mask %s\n"
+        "Decode: %lld ms\n"
+        "Write: %lld ms, %zu transactions and %zu splits (%.0f rows/s), %zu errors\n"
+        "Peak RSS: %zu KB before, %zu KB after"
+        , read_lines, qif.entries().size()
+        , read_ms.GetValue(), read_lines * 1000.0 / std::max<double>(1, read_ms.ToDouble()), target.date_format
+        , decode_ms.GetValue()
+        , result.ms.GetValue(), result.imported, result.splits, rows / write_s, result.errors
+        , peak_before, peak_after);
+    return read_lines == written && result.errors == 0 && result.imported > 0 && result.splits > 0;
+}
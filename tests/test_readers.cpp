@@ -0,0 +1,173 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "dbwrapper.h"
+#include "model/Model_Account.h"
+#include "model/Model_Checking.h"
+#include "model/Model_Report.h"
+#include <vector>
+#include <wx/filename.h>
+#include <wx/thread.h>
+#include <wx/time.h>
+
+namespace
+{
+    const int READERS = 3;
+    const int SECONDS = 3;
+
+    /**
+    * Reads the transactions through the models on a reader of the pool, in
+    * one read transaction per pass: the count, the rows of every account and
+    * the general report must all see the same snapshot while the writer inserts.
+    */
+    class ReaderThread : public wxThread
+    {
+    public:
+        ReaderThread(const Model_Report::Job& job, wxLongLong until)
+            : wxThread(wxTHREAD_JOINABLE), m_queries(0), m_mismatches(0), m_errors(0), m_job(job), m_until(until) {}
+        size_t m_queries, m_mismatches, m_errors;
+
+    protected:
+        virtual ExitCode Entry()
+        {
+            mmDBReaderPool::Lease db = mmDBReaderPool::instance().Acquire();
+            if (!db) return reinterpret_cast<ExitCode>(1);
+
+            while (wxGetUTCTimeMillis() < m_until)
+            {
+                try
+                {
+                    db->Begin();
+                    wxSQLite3ResultSet q = db->ExecuteQuery("SELECT COUNT(*) FROM CHECKINGACCOUNT_V1");
+                    q.NextRow();
+                    const int count = q.GetInt(0);
+                    q.Finalize();
+
+                    size_t rows = 0;
+                    for (const auto& account : Model_Account::instance().all_on(db.get()))
+                        rows += Model_Checking::instance().find_on(db.get(), Model_Checking::ACCOUNTID(account.ACCOUNTID)).size();
+
+                    wxString out;
+                    const int error = Model_Report::run(db.get(), m_job, out);
+                    db->Commit();
+
+                    if (rows != static_cast<size_t>(count) || error != 0 || out.Trim().Trim(false) != wxString::Format("%i", count))
+                        ++m_mismatches;
+                    ++m_queries;
+                }
+                catch (const wxSQLite3Exception&)
+                {
+                    if (!db->GetAutoCommit()) db->Rollback();
+                    ++m_errors;
+                }
+            }
+            return 0;
+        }
+
+    private:
+        const Model_Report::Job m_job;
+        wxLongLong m_until;
+    };
+
+    int count(wxSQLite3Database* db)
+    {
+        wxSQLite3ResultSet q = db->ExecuteQuery("SELECT COUNT(*) FROM CHECKINGACCOUNT_V1");
+        const int rows = q.NextRow() ? q.GetInt(0) : -1;
+        q.Finalize();
+        return rows;
+    }
+}
+
+MM_TEST(concurrent_readers)
+{
+    // WAL needs a file, an in-memory database has a single connection
+    const wxString path = wxFileName::CreateTempFileName("mmex");
+    size_t queries = 0, mismatches = 0, errors = 0, writes = 0, write_errors = 0;
+    int readers = 0, written = -1, read = -2;
+    bool wal = false;
+    {
+        mmBench::Database db(path);
+        if (!db.IsOpen()) return false;
+        mmBench::generate(db.get(), mmTest::params());
+        wal = mmDBWrapper::SetWAL(db.get(), true);
+        mmDBReaderPool::instance().Open(path, "");
+
+        Model_Report::Data* report = Model_Report::instance().create();
+        report->REPORTNAME = "Transactions";
+        report->SQLCONTENT = "SELECT COUNT(*) AS N FROM CHECKINGACCOUNT_V1";
+        report->TEMPLATECONTENT = "<TMPL_LOOP CONTENTS><TMPL_VAR N></TMPL_LOOP>";
+        const Model_Report::Job job = Model_Report::prepare(report);
+
+        const Model_Account::Data_Set accounts = Model_Account::instance().all();
+        const wxLongLong until = wxGetUTCTimeMillis() + SECONDS * 1000;
+        std::vector<ReaderThread*> threads;
+        for (int i = 0; i < READERS; ++i)
+        {
+            ReaderThread* reader = new ReaderThread(job, until);
+            if (reader->Run() == wxTHREAD_NO_ERROR)
+                threads.push_back(reader);
+            else
+                delete reader;
+        }
+
+        // the writer commits one transaction at a time on the main connection
+        while (wxGetUTCTimeMillis() < until && !accounts.empty())
+        {
+            Model_Checking::Data* tran = Model_Checking::instance().create();
+            tran->ACCOUNTID = accounts[writes % accounts.size()].ACCOUNTID;
+            tran->TOACCOUNTID = -1;
+            tran->PAYEEID = -1;
+            tran->CATEGID = -1;
+            tran->SUBCATEGID = -1;
+            tran->TRANSCODE = Model_Checking::all_type()[Model_Checking::WITHDRAWAL];
+            tran->TRANSAMOUNT = 1.0 + writes % 100;
+            tran->TRANSDATE = "2020-01-01";
+            if (Model_Checking::instance().save(tran) > 0)
+                ++writes;
+            else
+                ++write_errors;
+        }
+
+        for (auto reader : threads)
+        {
+            reader->Wait();
+            queries += reader->m_queries;
+            mismatches += reader->m_mismatches;
+            errors += reader->m_errors;
+            delete reader;
+        }
+        readers = static_cast<int>(threads.size());
+
+        // a reader taken after the last commit sees every row
+        written = count(db.get());
+        {
+            mmDBReaderPool::Lease reader = mmDBReaderPool::instance().Acquire();
+            if (reader) read = count(reader.get());
+        }
+        mmDBReaderPool::instance().Close();
+        mmDBWrapper::SetWAL(db.get(), false);
+    }
+    wxRemoveFile(path);
+
+    wxLogMessage("WAL: %s\nReaders: %i, passes: %zu, snapshots that differ: %zu, errors: %zu\n"
+        "Writer inserts: %zu, errors: %zu\nRows: %i on the writer, %i on a reader"
+        , wal ? "yes" : "no", readers, queries, mismatches, errors, writes, write_errors, written, read);
+    return wal && readers == READERS && queries >= static_cast<size_t>(READERS) && mismatches == 0 && errors == 0
+        && writes > 0 && write_errors == 0 && written == read;
+}
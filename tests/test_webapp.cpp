@@ -0,0 +1,183 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "mmtest.h"
+#include "util.h"
+#include "webapp.h"
+#include "webappstub.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+#include <wx/tokenzr.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+/**
+* Sync canned transactions from mmWebAppStub, a services.php on the loopback
+* interface, and compare what the reader and the attachment downloads got.
+*/
+MM_TEST(webapp_sync)
+{
+    const size_t TRANSACTIONS = 100;
+    const size_t ATTACHMENTS_PER_TRANSACTION = 2;
+    const int LATENCY_MS = 20;
+    const size_t ATTACHMENT_SIZE = 64 * 1024;
+
+    // canned transactions with escapes, non ASCII text and values the reader skips
+    mmWebApp::WebTranVector expected;
+    std::map<std::string, std::string> attachments;
+    rapidjson::StringBuffer json_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> json_writer(json_buffer);
+    json_writer.StartObject();
+    for (size_t i = 0; i < TRANSACTIONS; i++)
+    {
+        mmWebApp::webtran_holder WebTran = mmWebApp::webtran_holder();
+        WebTran.ID = static_cast<int>(i + 1);
+        WebTran.Date = wxDateTime(static_cast<wxDateTime::wxDateTime_t>(1 + i % 28), static_cast<wxDateTime::Month>(i % 12), 2020);
+        WebTran.Account = wxString::Format("Account %zu", i % 3);
+        WebTran.ToAccount = "None";
+        WebTran.Status = "R";
+        WebTran.Type = i % 5 ? "Withdrawal" : "Deposit";
+        WebTran.Payee = wxString::FromUTF8("Caf\xC3\xA9 \"") << i << "\"";
+        WebTran.Category = "Food|Lunch";
+        WebTran.Amount = i + 0.25;
+        WebTran.Notes = wxString::Format("line 1\nline 2 \\ %zu", i);
+        for (size_t k = 1; k <= ATTACHMENTS_PER_TRANSACTION; k++)
+        {
+            const wxString name = wxString::Format("Transaction_%zu_Attach%zu.txt", i + 1, k);
+            if (k > 1) WebTran.Attachments << ";";
+            WebTran.Attachments << name;
+            attachments[std::string(name.ToUTF8())] = std::string(ATTACHMENT_SIZE, static_cast<char>('a' + (i + k) % 26));
+        }
+        expected.push_back(WebTran);
+
+        json_writer.Key(std::to_string(i).c_str());
+        json_writer.StartObject();
+        const std::pair<const char*, wxString> fields[] = {
+            { "ID", wxString::Format("%i", WebTran.ID) },
+            { "Date", WebTran.Date.FormatISODate() },
+            { "Account", WebTran.Account },
+            { "ToAccount", WebTran.ToAccount },
+            { "Status", WebTran.Status },
+            { "Type", WebTran.Type },
+            { "Payee", WebTran.Payee },
+            { "Category", "Food:Lunch" },
+            { "SubCategory", "None" },
+            { "Amount", wxString::FromCDouble(WebTran.Amount) },
+            { "Notes", WebTran.Notes },
+            { "Attachments", WebTran.Attachments }
+        };
+        for (const auto& field : fields)
+        {
+            json_writer.Key(field.first);
+            json_writer.String(field.second.ToUTF8());
+        }
+        json_writer.Key("Tags");
+        json_writer.StartArray();
+        json_writer.String("skipped");
+        json_writer.StartObject();
+        json_writer.Key("Notes");
+        json_writer.String("skipped");
+        json_writer.EndObject();
+        json_writer.EndArray();
+        json_writer.Key("Extra");
+        json_writer.Null();
+        json_writer.EndObject();
+    }
+    json_writer.EndObject();
+
+    mmWebAppStub stub("0123456789abcdef", json_buffer.GetString(), LATENCY_MS);
+    for (const auto& attachment : attachments)
+        stub.addAttachment(attachment.first, attachment.second);
+    if (!stub.start())
+    {
+        wxLogError("Cannot listen on the loopback interface");
+        return false;
+    }
+
+    const wxString url = stub.servicesPageURL();
+    const http_options options = http_current_options();
+    size_t mismatches = 0;
+
+    // one attachment after the other, as MMEX_InsertNewTransaction() did
+    wxStopWatch sw;
+    for (const auto& attachment : attachments)
+    {
+        const wxString TempFile = wxFileName::CreateTempFileName("mmex_webapp");
+        if (http_download_file(url + "&" + WebAppParam::DownloadAttachments + "=" + wxString::FromUTF8(attachment.first.c_str()), TempFile) != CURLE_OK)
+            mismatches++;
+        wxRemoveFile(TempFile);
+    }
+    const wxLongLong serial_ms = sw.Time();
+
+    sw.Start();
+    mmWebApp::SyncResult Result;
+    mmWebApp::WebApp_Sync(url, options, Result);
+    const wxLongLong sync_ms = sw.Time();
+
+    if (!Result.Error.IsEmpty() || !Result.DownloadError.IsEmpty() || Result.Transactions.size() != expected.size())
+        mismatches++;
+    std::vector<int> ids;
+    for (size_t i = 0; i < std::min(Result.Transactions.size(), expected.size()); i++)
+    {
+        const mmWebApp::webtran_holder& got = Result.Transactions[i];
+        const mmWebApp::webtran_holder& want = expected[i];
+        if (got.ID != want.ID || !got.Date.IsSameDate(want.Date) || got.Account != want.Account
+            || got.ToAccount != want.ToAccount || got.Status != want.Status || got.Type != want.Type
+            || got.Payee != want.Payee || got.Category != want.Category || !got.SubCategory.IsEmpty()
+            || got.Amount != want.Amount || got.Notes != want.Notes || got.Attachments != want.Attachments
+            || got.AttachmentFiles.GetCount() != ATTACHMENTS_PER_TRANSACTION)
+            mismatches++;
+        ids.push_back(got.ID);
+
+        wxStringTokenizer tkz(got.Attachments, (';'), wxTOKEN_RET_EMPTY_ALL);
+        for (const auto& file : got.AttachmentFiles)
+        {
+            const std::string& data = attachments[std::string(tkz.GetNextToken().ToUTF8())];
+            std::string content(data.size() + 1, '\0');
+            wxFile f(file);
+            if (!f.IsOpened() || f.Read(&content[0], content.size()) != static_cast<ssize_t>(data.size())
+                || content.compare(0, data.size(), data) != 0)
+                mismatches++;
+            f.Close();
+            wxRemoveFile(file);
+        }
+    }
+
+    mmWebApp::WebApp_DeleteTransactions(url, options, ids);
+    if (stub.deleted() != ids)
+        mismatches++;
+    stub.stop();
+
+    wxLogMessage("%zu transactions, %zu attachments of %zu KB, %i ms latency\n"
+        "attachments one by one: %s ms\n"
+        "sync: %s ms (download %s ms, parse %s ms, attachments %s ms, peak %zu connections)\n"
+        "delete: %zu IDs in %zu requests\n"
+        "mismatches: %zu"
+        , TRANSACTIONS, attachments.size(), ATTACHMENT_SIZE / 1024, LATENCY_MS
+        , serial_ms.ToString()
+        , sync_ms.ToString(), Result.DownloadMs.ToString(), Result.ParseMs.ToString(), Result.AttachmentsMs.ToString()
+        , stub.peakConnections()
+        , ids.size(), stub.deleteRequests()
+        , mismatches);
+    return mismatches == 0;
+}
@@ -0,0 +1,310 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#include "webappstub.h"
+#include "webapp.h"
+#include <cstdlib>
+#include <wx/log.h>
+#include <wx/socket.h>
+#include <wx/utils.h>
+
+namespace
+{
+    const size_t MAX_REQUEST = 16 * 1024;
+    const size_t CONNECTIONS = 8;
+
+    /** True if the query has the key, value is set to the text after '=' if any */
+    bool query_has(const std::string& query, const std::string& key, std::string& value)
+    {
+        size_t pos = 0;
+        while (pos < query.size())
+        {
+            size_t end = query.find('&', pos);
+            if (end == std::string::npos) end = query.size();
+            const std::string pair = query.substr(pos, end - pos);
+            const size_t eq = pair.find('=');
+            if (pair.compare(0, eq, key) == 0)
+            {
+                value = eq == std::string::npos ? "" : pair.substr(eq + 1);
+                return true;
+            }
+            pos = end + 1;
+        }
+        return false;
+    }
+}
+
+class mmWebAppStub::Acceptor : public wxThread
+{
+public:
+    explicit Acceptor(mmWebAppStub& stub)
+        : wxThread(wxTHREAD_JOINABLE), m_stub(stub) {}
+
+protected:
+    virtual ExitCode Entry()
+    {
+        while (!TestDestroy())
+        {
+            if (!m_stub.m_socket->WaitForAccept(0, 200)) continue;
+
+            wxSocketBase* socket = m_stub.m_socket->Accept(false);
+            if (socket) m_stub.m_queue.Post(socket);
+        }
+        return 0;
+    }
+
+private:
+    mmWebAppStub& m_stub;
+};
+
+class mmWebAppStub::Connection : public wxThread
+{
+public:
+    explicit Connection(mmWebAppStub& stub)
+        : wxThread(wxTHREAD_JOINABLE), m_stub(stub) {}
+
+protected:
+    virtual ExitCode Entry()
+    {
+        wxSocketBase* socket = nullptr;
+        while (m_stub.m_queue.Receive(socket) == wxMSGQUEUE_NO_ERROR && socket)
+        {
+            m_stub.serve(*socket);
+            socket->Destroy();
+        }
+        return 0;
+    }
+
+private:
+    mmWebAppStub& m_stub;
+};
+
+mmWebAppStub::mmWebAppStub(const std::string& guid, const std::string& transactions, int latency_ms)
+    : m_guid(guid)
+    , m_transactions(transactions)
+    , m_latency_ms(latency_ms)
+    , m_socket(nullptr)
+    , m_port(0)
+    , m_acceptor(nullptr)
+    , m_delete_requests(0)
+    , m_attachment_requests(0)
+    , m_active(0)
+    , m_peak(0)
+{
+}
+
+mmWebAppStub::~mmWebAppStub()
+{
+    stop();
+}
+
+void mmWebAppStub::addAttachment(const std::string& name, const std::string& data)
+{
+    m_attachments[name] = data;
+}
+
+bool mmWebAppStub::start()
+{
+    if (m_acceptor) return true;
+
+    wxSocketBase::Initialize();
+    wxIPV4address address;
+    address.Hostname("127.0.0.1");
+    address.Service(0);
+    m_socket = new wxSocketServer(address, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+    wxIPV4address local;
+    if (!m_socket->IsOk() || !m_socket->GetLocal(local))
+    {
+        wxLogDebug("mmWebAppStub: cannot listen on the loopback interface");
+        m_socket->Destroy();
+        m_socket = nullptr;
+        return false;
+    }
+    m_port = local.Service();
+
+    for (size_t i = 0; i < CONNECTIONS; i++)
+    {
+        Connection* connection = new Connection(*this);
+        if (connection->Run() != wxTHREAD_NO_ERROR)
+        {
+            delete connection;
+            break;
+        }
+        m_connections.push_back(connection);
+    }
+
+    m_acceptor = new Acceptor(*this);
+    if (m_connections.empty() || m_acceptor->Run() != wxTHREAD_NO_ERROR)
+    {
+        delete m_acceptor;
+        m_acceptor = nullptr;
+        stop();
+        return false;
+    }
+    wxLogDebug("mmWebAppStub: listening on 127.0.0.1:%i", m_port);
+    return true;
+}
+
+void mmWebAppStub::stop()
+{
+    if (m_acceptor)
+    {
+        m_acceptor->Delete();
+        delete m_acceptor;
+        m_acceptor = nullptr;
+    }
+
+    // a null socket ends a connection thread, the sockets still queued are served first
+    for (size_t i = 0; i < m_connections.size(); i++)
+        m_queue.Post(nullptr);
+    for (auto connection : m_connections)
+    {
+        connection->Wait();
+        delete connection;
+    }
+    m_connections.clear();
+
+    if (m_socket)
+    {
+        m_socket->Destroy();
+        m_socket = nullptr;
+    }
+}
+
+const wxString mmWebAppStub::servicesPageURL() const
+{
+    return wxString::Format("http://127.0.0.1:%i/%s?guid=%s", m_port, WebAppParam::ServicesPage, m_guid);
+}
+
+const std::vector<int> mmWebAppStub::deleted() const
+{
+    wxCriticalSectionLocker lock(m_lock);
+    return m_deleted;
+}
+
+size_t mmWebAppStub::deleteRequests() const
+{
+    wxCriticalSectionLocker lock(m_lock);
+    return m_delete_requests;
+}
+
+size_t mmWebAppStub::attachmentRequests() const
+{
+    return m_attachment_requests;
+}
+
+size_t mmWebAppStub::peakConnections() const
+{
+    return m_peak;
+}
+
+void mmWebAppStub::serve(wxSocketBase& socket)
+{
+    const size_t active = ++m_active;
+    size_t peak = m_peak;
+    while (active > peak && !m_peak.compare_exchange_weak(peak, active)) {}
+
+    socket.SetFlags(wxSOCKET_BLOCK);
+    socket.SetTimeout(5);
+
+    std::string request;
+    char buffer[4096];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST)
+    {
+        socket.Read(buffer, sizeof(buffer));
+        const size_t count = socket.LastReadCount();
+        if (socket.Error() || count == 0) break;
+        request.append(buffer, count);
+    }
+
+    // Only "GET <path>[?query] HTTP/1.x" requests are answered
+    bool found = false;
+    std::string body;
+    const size_t path_start = request.compare(0, 4, "GET ") == 0 ? 4 : std::string::npos;
+    const size_t path_end = path_start == std::string::npos ? path_start : request.find(' ', path_start);
+    if (path_end != std::string::npos)
+    {
+        std::string path = request.substr(path_start, path_end - path_start), query;
+        const size_t q = path.find('?');
+        if (q != std::string::npos)
+        {
+            query = path.substr(q + 1);
+            path.erase(q);
+        }
+        body = respond(path, query, found);
+    }
+
+    const std::string header = std::string("HTTP/1.1 ") + (found ? "200 OK" : "404 Not Found")
+        + "\r\nContent-Type: " + (found ? "application/octet-stream" : "text/plain")
+        + "\r\nContent-Length: " + std::to_string(body.size())
+        + "\r\nConnection: close\r\n\r\n";
+
+    socket.SetFlags(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+    socket.Write(header.data(), header.size());
+    if (!socket.Error() && !body.empty())
+        socket.Write(body.data(), body.size());
+    socket.Close();
+    --m_active;
+}
+
+const std::string mmWebAppStub::respond(const std::string& path, const std::string& query, bool& found)
+{
+    found = path == "/" + std::string(WebAppParam::ServicesPage.ToUTF8());
+    if (!found) return "";
+
+    std::string value;
+    if (!query_has(query, "guid", value) || value != m_guid)
+        return std::string(WebAppParam::MessageWrongGuid.ToUTF8());
+
+    if (query_has(query, std::string(WebAppParam::CheckGuid.ToUTF8()), value))
+        return std::string(WebAppParam::MessageSuccedeed.ToUTF8());
+
+    if (query_has(query, std::string(WebAppParam::CheckApiVersion.ToUTF8()), value))
+        return std::string(WebAppParam::ApiExpectedVersion.ToUTF8());
+
+    if (query_has(query, std::string(WebAppParam::DownloadNewTransaction.ToUTF8()), value))
+        return m_transactions.empty() ? "null" : m_transactions;
+
+    if (query_has(query, std::string(WebAppParam::DownloadAttachments.ToUTF8()), value))
+    {
+        ++m_attachment_requests;
+        wxMilliSleep(m_latency_ms);
+        const auto it = m_attachments.find(value);
+        found = it != m_attachments.end();
+        return found ? it->second : "";
+    }
+
+    if (query_has(query, std::string(WebAppParam::DeleteOneTransaction.ToUTF8()), value))
+    {
+        wxCriticalSectionLocker lock(m_lock);
+        m_delete_requests++;
+        const char* pos = value.c_str();
+        while (*pos)
+        {
+            char* end = nullptr;
+            const long id = std::strtol(pos, &end, 10);
+            if (end == pos) break;
+            m_deleted.push_back(static_cast<int>(id));
+            pos = *end == ',' ? end + 1 : end;
+        }
+        return std::string(WebAppParam::MessageSuccedeed.ToUTF8());
+    }
+
+    found = false;
+    return "";
+}
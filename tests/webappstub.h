@@ -0,0 +1,89 @@
+/*******************************************************
+ Copyright (C) 2020
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ ********************************************************/
+
+#ifndef MM_EX_WEBAPPSTUB_H_
+#define MM_EX_WEBAPPSTUB_H_
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+#include <wx/msgqueue.h>
+#include <wx/string.h>
+#include <wx/thread.h>
+
+class wxSocketBase;
+class wxSocketServer;
+
+/**
+* The services.php of the WebApp on the loopback interface, serving canned
+* transactions and attachments so the sync can be measured and checked
+* without a network. Requests are answered by a few threads at once and
+* every attachment reply is delayed like a remote server would be.
+*/
+class mmWebAppStub
+{
+public:
+    mmWebAppStub(const std::string& guid, const std::string& transactions, int latency_ms);
+    ~mmWebAppStub();
+
+    void addAttachment(const std::string& name, const std::string& data);
+
+    bool start();
+    void stop();
+
+    /** URL of services.php with the GUID, as mmWebApp::getServicesPageURL() */
+    const wxString servicesPageURL() const;
+
+    /** Transaction IDs received by delete_group, in order */
+    const std::vector<int> deleted() const;
+    size_t deleteRequests() const;
+    size_t attachmentRequests() const;
+    /** Most requests served at the same time */
+    size_t peakConnections() const;
+
+private:
+    class Acceptor;
+    class Connection;
+    friend class Acceptor;
+    friend class Connection;
+
+    void serve(wxSocketBase& socket);
+    const std::string respond(const std::string& path, const std::string& query, bool& found);
+
+private:
+    const std::string m_guid;
+    const std::string m_transactions;
+    const int m_latency_ms;
+    std::map<std::string, std::string> m_attachments;
+
+    wxSocketServer* m_socket;
+    unsigned short m_port;
+    Acceptor* m_acceptor;
+    std::vector<Connection*> m_connections;
+    wxMessageQueue<wxSocketBase*> m_queue;
+
+    mutable wxCriticalSection m_lock;
+    std::vector<int> m_deleted;
+    size_t m_delete_requests;
+    std::atomic<size_t> m_attachment_requests;
+    std::atomic<size_t> m_active;
+    std::atomic<size_t> m_peak;
+};
+
+#endif // MM_EX_WEBAPPSTUB_H_
@@ -86,6 +86,14 @@ def get_index_list(cursor, tbl_name):
         ORDER BY name""" % tbl_name)
     return [row[1] for row in cursor.fetchall()]
 
+def get_trigger_list(cursor, tbl_name):
+    "Returns the triggers writing to the table, they are created together with it."
+    cursor.execute("""
+        SELECT name, sql FROM sqlite_master
+        WHERE type='trigger' AND (sql LIKE '%% INTO %s %%' OR sql LIKE '%%UPDATE %s %%')
+        ORDER BY name""" % (tbl_name, tbl_name))
+    return [row[1] for row in cursor.fetchall()]
+
 def get_data_initializer_list(cursor, tbl_name):
     "Returns a list of data in the current table."
     cursor.execute("select * from %s" % tbl_name)
@@ -107,14 +115,28 @@ base_data_types_function = {
     'REAL': 'GetDouble',
 }
 
+# Tables that get a Compact_Set, i.e. the ones that can hold many rows
+compact_tables = ['CHECKINGACCOUNT_V1', 'SPLITTRANSACTIONS_V1', 'CURRENCYHISTORY_V1', 'STOCKHISTORY_V1']
+
+# Tables whose cached records are also indexed by id in a vector, the ones looked up per transaction
+dense_tables = ['ACCOUNTLIST_V1', 'CURRENCYFORMATS_V1', 'PAYEE_V1', 'CATEGORY_V1', 'SUBCATEGORY_V1']
+
+# TEXT columns with a few known values, stored as an enum in a Compact_Set.
+# Other values found in the table get the codes after the known ones.
+compact_enum_columns = {
+    'STATUS': [('NONE', ''), ('RECONCILED', 'R'), ('VOID', 'V'), ('FOLLOWUP', 'F'), ('DUPLICATE', 'D')],
+    'TRANSCODE': [('WITHDRAWAL', 'Withdrawal'), ('DEPOSIT', 'Deposit'), ('TRANSFER', 'Transfer')],
+}
+
 class DB_Table:
     """ Class: Defines the database table in SQLite3"""
-    def __init__(self, table, fields, index, data):
+    def __init__(self, table, fields, index, data, trigger):
         self._table = table
         self._fields = fields
         self._primay_key = [field['name'] for field in self._fields if field['pk']][0]
         self._index = index
         self._data = data
+        self._trigger = trigger
 
     def generate_currency_table_data(self, sf1, utf_only):
         """Extract currency table data from table_v1
@@ -163,6 +185,159 @@ UPDATE OR IGNORE %s SET %s WHERE CURRENCY_SYMBOL='%s';''' % (self._table, row['C
         rfp.write(header + self.to_string(sql))
         rfp.close()
 
+    def compact_to_string(self):
+        """Create the Compact_Set of the table"""
+        def kind(field):
+            ftype = base_data_types_reverse[field['type']]
+            if ftype == 'wxString':
+                return 'enum' if field['name'] in compact_enum_columns else 'pool'
+            return ftype
+
+        # widest members first, so that the record has no padding between them
+        order = {'double': 0, 'int': 1, 'pool': 1, 'enum': 2}
+        fields = sorted(self._fields, key=lambda f: order[kind(f)])
+        enums = [field['name'] for field in self._fields if kind(field) == 'enum']
+
+        s = '''
+    /**
+    * Compact read only copy of many records. The records are fixed size PODs
+    * in one array, the TEXT columns are offsets of UTF-8 strings in a pool
+    * shared by the set and the columns with a few known values are enums.
+    * Iterating yields Data records built on the fly, so code written for a
+    * Data_Set compiles unchanged. row() converts only the columns it reads.
+    */
+    struct Compact_Set
+    {'''
+        for name in enums:
+            s += '''
+        enum %s_CODE
+        {''' % name
+            for i, (label, value) in enumerate(compact_enum_columns[name]):
+                s += '''
+            %s_%s%s, // "%s"''' % (name, label, ' = 0' if i == 0 else '', value)
+            s += '''
+            %s_KNOWN // first code of the other values
+        };''' % name
+        s += '''
+
+        struct Record
+        {'''
+        for field in fields:
+            k = kind(field)
+            ctype = {'double': 'double', 'int': 'int', 'pool': 'DB_String_Pool::Offset', 'enum': 'unsigned char'}[k]
+            s += '''
+            %s %s;''' % (ctype, field['name'])
+        s += '''
+        };
+
+        /** Lazy accessors of one record, a TEXT column is converted on each call */
+        struct Row
+        {
+            const Compact_Set* set_;
+            const Record* r_;
+'''
+        for field in self._fields:
+            k = kind(field)
+            if k == 'pool':
+                s += '''
+            wxString %s() const { return set_->pool_.get(r_->%s); }''' % (field['name'], field['name'])
+            elif k == 'enum':
+                s += '''
+            const wxString& %s() const { return set_->%s_.get(r_->%s); }
+            %s_CODE %s_code() const { return static_cast<%s_CODE>(r_->%s); }''' % (field['name'], field['name'], field['name']
+                    , field['name'], field['name'], field['name'], field['name'])
+            else:
+                s += '''
+            %s %s() const { return r_->%s; }''' % (k, field['name'], field['name'])
+        s += '''
+        };
+
+        struct const_iterator
+        {
+            const Compact_Set* set_;
+            size_t i_;
+
+            Data operator*() const { return set_->data(i_); }
+            const_iterator& operator++() { ++i_; return *this; }
+            bool operator==(const const_iterator& other) const { return i_ == other.i_; }
+            bool operator!=(const const_iterator& other) const { return i_ != other.i_; }
+        };
+
+        Compact_Set()
+        {'''
+        for name in enums:
+            for label, value in compact_enum_columns[name]:
+                s += '''
+            %s_.add("%s");''' % (name, value)
+        s += '''
+        }
+
+        size_t size() const { return records_.size(); }
+        bool empty() const { return records_.empty(); }
+        void reserve(size_t n) { records_.reserve(n); }
+        const_iterator begin() const { const_iterator it = { this, 0 }; return it; }
+        const_iterator end() const { const_iterator it = { this, records_.size() }; return it; }
+        Data operator[](size_t i) const { return data(i); }
+        Row row(size_t i) const { Row r = { this, &records_[i] }; return r; }
+
+        /** Append the current row of the result set, as Data(q) would read it */
+        void push_back(wxSQLite3ResultSet& q)
+        {
+            Record r;'''
+        for field in self._fields:
+            k = kind(field)
+            i = self._fields.index(field)
+            if k == 'pool':
+                s += '''
+            r.%s = pool_.add(q.GetString(%d)); // %s''' % (field['name'], i, field['name'])
+            elif k == 'enum':
+                s += '''
+            r.%s = %s_.add(q.GetString(%d)); // %s''' % (field['name'], field['name'], i, field['name'])
+            else:
+                s += '''
+            r.%s = q.%s(%d); // %s''' % (field['name'], base_data_types_function[field['type']], i, field['name'])
+        s += '''
+            records_.push_back(r);
+        }
+
+        /** Build the Data record, it does not belong to the table cache */
+        Data data(size_t i) const
+        {
+            const Record& r = records_[i];
+            Data d;'''
+        for field in self._fields:
+            k = kind(field)
+            if k == 'pool':
+                s += '''
+            d.%s = pool_.get(r.%s);''' % (field['name'], field['name'])
+            elif k == 'enum':
+                s += '''
+            d.%s = %s_.get(r.%s);''' % (field['name'], field['name'], field['name'])
+            else:
+                s += '''
+            d.%s = r.%s;''' % (field['name'], field['name'])
+        s += '''
+            return d;
+        }
+
+        /** Release the unused capacity once the set is complete */
+        void shrink()
+        {
+            records_.shrink_to_fit();
+            pool_.shrink();
+        }
+
+    private:
+        std::vector<Record> records_;
+        DB_String_Pool pool_;'''
+        for name in enums:
+            s += '''
+        DB_String_Dict %s_;''' % name
+        s += '''
+    };
+'''
+        return s
+
     def to_string(self, sql=None):
         """Create the data for the .h file"""
         s = '''#pragma once
@@ -196,6 +371,9 @@ struct DB_Table_%s : public DB_Table
         }
     };
 
+    /** Query results kept in an arena and released in one go, see DB_Arena */
+    typedef DB_Arena<Self::Data> Data_Arena;
+
     /** A container to hold a list of Data record pointers for the table in memory*/
     typedef std::vector<Self::Data*> Cache;
     typedef std::map<int, Self::Data*> Index_By_Id;
@@ -218,6 +396,10 @@ struct DB_Table_%s : public DB_Table
         index_by_id_.clear(); // no memory release since it just stores pointer and the according objects are in cache
     }
 ''' % (self._table, self._table, self._table)
+        if self._table in dense_tables:
+            s = s.replace('typedef std::map<int, Self::Data*> Index_By_Id;',
+                '''/** Cached records by id, with the small ids in a vector, see DB_Id_Index */
+    typedef DB_Id_Index<Self::Data> Index_By_Id;''')
 
         s += '''
     /** Creates the database table if the table does not exist*/
@@ -237,11 +419,12 @@ struct DB_Table_%s : public DB_Table
             }
         }
 
-        this->ensure_index(db);
+        this->ensure_index(db);%s
 
         return true;
     }
-''' % (sql.replace('\n', ''), self._table)
+''' % (sql.replace('\n', ''), self._table, '''
+        this->ensure_trigger(db);''' if self._trigger else '')
 
         s += '''
     bool ensure_index(wxSQLite3Database* db)
@@ -265,6 +448,32 @@ struct DB_Table_%s : public DB_Table
             return false;
         }
 
+        return true;
+    }
+''' % (self._table)
+
+        if self._trigger:
+            s += '''
+    bool ensure_trigger(wxSQLite3Database* db)
+    {
+        try
+        {'''
+            for t in self._trigger:
+                mt = t.split()
+                mt.insert(2, 'IF')
+                mt.insert(3, 'NOT')
+                mt.insert(4, 'EXISTS')
+                s += '''
+            db->ExecuteUpdate("%s");''' % (' '.join(mt))
+
+            s += '''
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %%s", e.GetMessage().utf8_str());
+            return false;
+        }
+
         return true;
     }
 ''' % (self._table)
@@ -420,6 +629,17 @@ struct DB_Table_%s : public DB_Table
         s += '''
         }
 
+        /** Read the current row of the result set into the record, reusing its string buffers */
+        void fetch(wxSQLite3ResultSet& q)
+        {'''
+        for field in self._fields:
+            func = base_data_types_function[field['type']]
+            s += '''
+            %s = q.%s(%d); // %s''' % (field['name'], func, field['cid'], field['name'])
+
+        s += '''
+        }
+
         Data& operator=(const Data& other)
         {
             if (this == &other) return *this;
@@ -454,6 +674,14 @@ struct DB_Table_%s : public DB_Table
             return this->%s == in.v_;
         }''' % (field['name'], field['name'])
 
+        for field in self._fields:
+            s += '''
+
+        void set(const Self::%s &in)
+        {
+            this->%s = in.v_;
+        }''' % (field['name'], field['name'])
+
         s += '''
 
         // Return the data record as a json string
@@ -549,6 +777,9 @@ struct DB_Table_%s : public DB_Table
         }
     };
 ''' % (self._table.upper(), self._table.upper())
+        if self._table in compact_tables:
+            s += self.compact_to_string()
+
         s += '''
     enum
     {
@@ -612,6 +843,7 @@ struct DB_Table_%s : public DB_Table
 
         try
         {
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
 ''' % (self._table, ', '.join([field['name'] + ' = ?'\
         for field in self._fields if not field['pk']]), self._primay_key)
@@ -625,7 +857,7 @@ struct DB_Table_%s : public DB_Table
             if (entity->id() > 0)
                 stmt.Bind(%d, entity->%s);
 
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             if (entity->id() > 0) // existent
@@ -653,6 +885,48 @@ struct DB_Table_%s : public DB_Table
     }
 ''' % (len(self._fields), self._primay_key, self._table)
         s += '''
+    /**
+    * Insert the new Data records with one prepared statement.
+    * The records come from create(), the caller wraps the call in a savepoint.
+    * Returns the number of records inserted.
+    */
+    size_t insert(const std::vector<Self::Data*>& entities, wxSQLite3Database* db)
+    {
+        const wxString sql = "INSERT INTO %s(%s) VALUES(%s)";
+        size_t rows = 0;
+        try
+        {
+            DB_Query_Timer timer(sql, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(sql);
+            for (Self::Data* entity : entities)
+            {''' % (self._table, ', '.join([field['name']\
+                for field in self._fields if not field['pk']]),
+                ', '.join(['?' for field in self._fields if not field['pk']]))
+
+        for index, name in enumerate([field['name'] for field in self._fields if not field['pk']]):
+            s += '''
+                stmt.Bind(%d, entity->%s);'''% (index + 1, name)
+
+        s += '''
+                stmt.ExecuteUpdate();
+                stmt.Reset();
+
+                entity->id((db->GetLastRowId()).ToLong());
+                index_by_id_.insert(std::make_pair(entity->id(), entity));
+                ++ rows;
+            }
+            stmt.Finalize();
+            timer.rows_ = rows;
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %%s", e.GetMessage().utf8_str());
+        }
+
+        return rows;
+    }
+''' % self._table
+        s += '''
     /** Remove the Data record from the database and the memory table (cache) */
     bool remove(int id, wxSQLite3Database* db)
     {
@@ -660,9 +934,10 @@ struct DB_Table_%s : public DB_Table
         try
         {
             wxString sql = "DELETE FROM %s WHERE %s = ?";
+            DB_Query_Timer timer(sql, db);
             wxSQLite3Statement stmt = db->PrepareStatement(sql);
             stmt.Bind(1, id);
-            stmt.ExecuteUpdate();
+            timer.rows_ = stmt.ExecuteUpdate();
             stmt.Finalize();
 
             Cache c;
@@ -737,11 +1012,11 @@ struct DB_Table_%s : public DB_Table
             return 0;
         }
 
-        Index_By_Id::iterator it = index_by_id_.find(id);
-        if (it != index_by_id_.end())
+        Self::Data* cached = index_lookup(index_by_id_, id);
+        if (cached)
         {
             ++ hit_;
-            return it->second;
+            return cached;
         }
         
         ++ miss_;
@@ -749,12 +1024,14 @@ struct DB_Table_%s : public DB_Table
         wxString where = wxString::Format(" WHERE %s = ?", PRIMARY::name().utf8_str());
         try
         {
-            wxSQLite3Statement stmt = db->PrepareStatement(this->query() + where);
+            DB_Query_Timer timer(this->query() + where, db);
+            wxSQLite3Statement stmt = db->PrepareStatement(timer.shape_);
             stmt.Bind(1, id);
 
             wxSQLite3ResultSet q = stmt.ExecuteQuery();
             if(q.NextRow())
             {
+                timer.rows_ = 1;
                 entity = new Self::Data(q, this);
                 cache_.push_back(entity);
                 index_by_id_.insert(std::make_pair(id, entity));
@@ -785,7 +1062,8 @@ struct DB_Table_%s : public DB_Table
         Data_Set result;
         try
         {
-            wxSQLite3ResultSet q = db->ExecuteQuery(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "));
+            DB_Query_Timer timer(col == COLUMN(0) ? this->query() : this->query() + " ORDER BY " + column_to_name(col) + " COLLATE NOCASE " + (asc ? " ASC " : " DESC "), db);
+            wxSQLite3ResultSet q = db->ExecuteQuery(timer.shape_);
 
             while(q.NextRow())
             {
@@ -794,6 +1072,37 @@ struct DB_Table_%s : public DB_Table
             }
 
             q.Finalize();
+            timer.rows_ = result.size();
+        }
+        catch(const wxSQLite3Exception &e) 
+        { 
+            wxLogError("%s: Exception %s", this->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+
+        return result;
+    }
+'''
+        if self._table in compact_tables:
+            s += '''
+    /** Return all records in a Compact_Set, read directly from the database */
+    const Compact_Set all_compact(wxSQLite3Database* db)
+    {
+        Compact_Set result;
+        try
+        {
+            // the records are allocated once, at their final size
+            wxSQLite3ResultSet q = db->ExecuteQuery("SELECT COUNT(*) FROM " + this->name());
+            if (q.NextRow()) result.reserve(q.GetInt(0));
+            q.Finalize();
+
+            DB_Query_Timer timer(this->query(), db);
+            q = db->ExecuteQuery(timer.shape_);
+            while(q.NextRow())
+                result.push_back(q);
+
+            q.Finalize();
+            result.shrink();
+            timer.rows_ = result.size();
         }
         catch(const wxSQLite3Exception &e) 
         { 
@@ -814,10 +1123,16 @@ def generate_base_class(header, fields=set):
 
 #include <vector>
 #include <map>
+#include <string>
+#include <iterator>
+#include <new>
 #include <algorithm>
 #include <functional>
+#include <type_traits>
 #include <wx/wxsqlite3.h>
 #include <wx/intl.h>
+#include <wx/time.h>
+#include <wx/thread.h>
 
 #include "rapidjson/document.h"
 #include "rapidjson/pointer.h"
@@ -840,6 +1155,190 @@ struct DB_Column
     {}
 };
 
+/** UTF-8 strings appended to one buffer and referred to by their offset */
+class DB_String_Pool
+{
+public:
+    typedef unsigned int Offset;
+
+    DB_String_Pool(): buffer_(1, '\\0') {} // offset 0 is the empty string
+
+    Offset add(const wxString& s)
+    {
+        if (s.empty()) return 0;
+        const wxScopedCharBuffer utf8 = s.utf8_str();
+        const Offset offset = static_cast<Offset>(buffer_.size());
+        buffer_.append(utf8.data(), utf8.length());
+        buffer_.push_back('\\0');
+        return offset;
+    }
+    wxString get(Offset offset) const
+    {
+        return offset ? wxString::FromUTF8(buffer_.data() + offset) : wxString();
+    }
+    void shrink() { buffer_.shrink_to_fit(); }
+
+private:
+    std::string buffer_;
+};
+
+/** The distinct values of a column with few of them, referred to by a code */
+class DB_String_Dict
+{
+public:
+    typedef unsigned char Code;
+
+    Code add(const wxString& s)
+    {
+        for (size_t i = 0; i < values_.size(); ++i)
+            if (values_[i] == s) return static_cast<Code>(i);
+        wxASSERT(values_.size() < 256);
+        values_.push_back(s);
+        return static_cast<Code>(values_.size() - 1);
+    }
+    const wxString& get(Code code) const { return values_[code]; }
+
+private:
+    std::vector<wxString> values_;
+};
+
+/** Statistics of one statement shape, i.e. the SQL text before the values are bound */
+struct DB_Query_Stats
+{
+    DB_Query_Stats(): calls_(0), rows_(0), total_us_(0), max_us_(0)
+    {
+        std::fill(buckets_, buckets_ + 32, 0);
+    }
+    size_t calls_, rows_;
+    wxLongLong_t total_us_, max_us_;
+    size_t buckets_[32]; // latency histogram, bucket i counts calls below 2^(i+1) microseconds
+    wxString plan_;      // EXPLAIN QUERY PLAN of the first slow call
+
+    /** Return the upper bound in microseconds of the latency percentile p (0-100) */
+    wxLongLong_t percentile(double p) const
+    {
+        size_t rank = static_cast<size_t>(calls_ * p / 100.0 + 0.5), seen = 0;
+        for (int i = 0; i < 32; ++i)
+        {
+            seen += buckets_[i];
+            if (seen >= rank && seen > 0)
+                return std::min(max_us_, (wxLongLong_t(1) << (i + 1)));
+        }
+        return max_us_;
+    }
+};
+
+/** Collects the statement statistics of all tables and reports, also from reader threads */
+class DB_Profiler
+{
+public:
+    DB_Profiler(): slow_us_(-1) {}
+    static DB_Profiler& instance()
+    {
+        static DB_Profiler profiler;
+        return profiler;
+    }
+
+    /** Capture EXPLAIN QUERY PLAN for statements slower than the threshold, -1 to disable */
+    void explain_slow(int milliseconds) { slow_us_ = milliseconds < 0 ? -1 : milliseconds * 1000; }
+    void reset() { wxMutexLocker lock(mutex_); stats_.clear(); }
+
+    void record(const wxString& shape, wxSQLite3Database* db, wxLongLong_t us, size_t rows, const wxString& sql = wxEmptyString)
+    {
+        wxMutexLocker lock(mutex_);
+        DB_Query_Stats& s = stats_[shape];
+        ++ s.calls_;
+        s.rows_ += rows;
+        s.total_us_ += us;
+        s.max_us_ = std::max(s.max_us_, us);
+        int bucket = 0;
+        while (bucket < 31 && (wxLongLong_t(1) << (bucket + 1)) <= us) ++ bucket;
+        ++ s.buckets_[bucket];
+
+        if (slow_us_ >= 0 && us >= slow_us_ && s.plan_.empty() && db)
+        {
+            try
+            {
+                wxSQLite3ResultSet q = db->ExecuteQuery("EXPLAIN QUERY PLAN " + (sql.empty() ? shape : sql));
+                while (q.NextRow())
+                    s.plan_ += (s.plan_.empty() ? "" : "; ") + q.GetAsString(q.GetColumnCount() - 1);
+                q.Finalize();
+            }
+            catch(const wxSQLite3Exception &e) 
+            { 
+                s.plan_ = e.GetMessage();
+            }
+        }
+    }
+
+    /** Return the statistics sorted by total time as a json string */
+    wxString to_json()
+    {
+        wxMutexLocker lock(mutex_);
+        std::vector<std::pair<wxString, const DB_Query_Stats*> > sorted;
+        for (const auto& item : stats_) sorted.push_back(std::make_pair(item.first, &item.second));
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<wxString, const DB_Query_Stats*>& x, const std::pair<wxString, const DB_Query_Stats*>& y)
+        {
+            return x.second->total_us_ > y.second->total_us_;
+        });
+
+        StringBuffer json_buffer;
+        PrettyWriter<StringBuffer> json_writer(json_buffer);
+        json_writer.StartArray();
+        for (const auto& item : sorted)
+        {
+            const DB_Query_Stats& s = *item.second;
+            json_writer.StartObject();
+            json_writer.Key("sql");
+            json_writer.String(item.first.utf8_str());
+            json_writer.Key("calls");
+            json_writer.Uint64(s.calls_);
+            json_writer.Key("rows");
+            json_writer.Uint64(s.rows_);
+            json_writer.Key("total_ms");
+            json_writer.Double(s.total_us_ / 1000.0);
+            json_writer.Key("avg_ms");
+            json_writer.Double(s.calls_ ? s.total_us_ / 1000.0 / s.calls_ : 0.0);
+            json_writer.Key("p50_ms");
+            json_writer.Double(s.percentile(50) / 1000.0);
+            json_writer.Key("p95_ms");
+            json_writer.Double(s.percentile(95) / 1000.0);
+            json_writer.Key("p99_ms");
+            json_writer.Double(s.percentile(99) / 1000.0);
+            json_writer.Key("max_ms");
+            json_writer.Double(s.max_us_ / 1000.0);
+            if (!s.plan_.empty())
+            {
+                json_writer.Key("plan");
+                json_writer.String(s.plan_.utf8_str());
+            }
+            json_writer.EndObject();
+        }
+        json_writer.EndArray();
+
+        return wxString::FromUTF8(json_buffer.GetString());
+    }
+
+private:
+    std::map<wxString, DB_Query_Stats> stats_;
+    wxLongLong_t slow_us_;
+    wxMutex mutex_;
+};
+
+/** Times a statement for the profiler, the statistics are recorded when it goes out of scope */
+struct DB_Query_Timer
+{
+    DB_Query_Timer(const wxString& shape, wxSQLite3Database* db): shape_(shape), db_(db), rows_(0), start_(wxGetUTCTimeUSec()) {}
+    ~DB_Query_Timer()
+    {
+        DB_Profiler::instance().record(shape_, db_, (wxGetUTCTimeUSec() - start_).GetValue(), rows_, sql_);
+    }
+    wxString shape_, sql_;
+    wxSQLite3Database* db_;
+    size_t rows_;
+    wxLongLong start_;
+};
+
 struct DB_Table
 {
     DB_Table(): hit_(0), miss_(0), skip_(0) {};
@@ -908,14 +1407,220 @@ void bind(wxSQLite3Statement& stmt, int index, const Arg1& arg1, const Args&...
     bind(stmt, index+1, args...);
 }
 
-template<typename TABLE, typename... Args>
-const typename TABLE::Data_Set find_by(TABLE* table, wxSQLite3Database* db, bool op_and, const Args&... args)
+/** The SET list of a set-based UPDATE, e.g. Model_Checking::assign(Model_Checking::PAYEEID(2)) */
+template<typename... Cols>
+struct DB_Assign
+{
+    void sql(wxString& /*out*/) const {}
+    int bind(wxSQLite3Statement& /*stmt*/, int index) const { return index; }
+    template<class DATA> void apply(DATA* /*data*/) const {}
+};
+
+template<typename Col, typename... Cols>
+struct DB_Assign<Col, Cols...> : public DB_Assign<Cols...>
+{
+    explicit DB_Assign(const Col& col, const Cols&... cols): DB_Assign<Cols...>(cols...), col_(col) {}
+    Col col_;
+
+    void sql(wxString& out) const
+    {
+        out += (out.empty() ? "" : ", ") + Col::name() + " = ?";
+        DB_Assign<Cols...>::sql(out);
+    }
+    /** Bind the new values from index on, return the next free index */
+    int bind(wxSQLite3Statement& stmt, int index) const
+    {
+        stmt.Bind(index, col_.v_);
+        return DB_Assign<Cols...>::bind(stmt, index + 1);
+    }
+    /** Patch a cached record with the new values */
+    template<class DATA> void apply(DATA* data) const
+    {
+        data->set(col_);
+        DB_Assign<Cols...>::apply(data);
+    }
+};
+
+/**
+* Index of the cached records by id. Ids up to DENSE_LIMIT, i.e. the small
+* autoincrement ids of accounts, currencies, payees and categories, are also
+* kept in a vector indexed by id so that lookup() is a bounds check and a
+* load. Larger ids are only kept in the map, which also gives the ordered
+* iteration used by get_one().
+*/
+template<class DATA>
+class DB_Id_Index
+{
+public:
+    typedef std::map<int, DATA*> Map;
+    typedef typename Map::iterator iterator;
+    typedef typename Map::const_iterator const_iterator;
+    enum { DENSE_LIMIT = 1 << 16 };
+
+    DATA* lookup(int id) const
+    {
+        if (static_cast<unsigned>(id) < dense_.size()) return dense_[id];
+        if (id < DENSE_LIMIT) return 0;
+        const_iterator it = map_.find(id);
+        return it == map_.end() ? 0 : it->second;
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<int, DATA*>& item)
+    {
+        std::pair<iterator, bool> result = map_.insert(item);
+        if (result.second && item.first >= 0 && item.first < DENSE_LIMIT)
+        {
+            if (static_cast<size_t>(item.first) >= dense_.size())
+                dense_.resize(item.first + 1, 0);
+            dense_[item.first] = item.second;
+        }
+        return result;
+    }
+    size_t erase(int id)
+    {
+        if (static_cast<unsigned>(id) < dense_.size()) dense_[id] = 0;
+        return map_.erase(id);
+    }
+    void clear()
+    {
+        map_.clear();
+        dense_.clear();
+    }
+
+    iterator find(int id) { return map_.find(id); }
+    size_t count(int id) const { return lookup(id) ? 1 : 0; }
+    size_t size() const { return map_.size(); }
+    bool empty() const { return map_.empty(); }
+    iterator begin() { return map_.begin(); }
+    iterator end() { return map_.end(); }
+    const_iterator begin() const { return map_.begin(); }
+    const_iterator end() const { return map_.end(); }
+
+private:
+    Map map_;
+    std::vector<DATA*> dense_;
+};
+
+/** Return the cached record with the given id, 0 when it is not cached */
+template<class DATA>
+DATA* index_lookup(const std::map<int, DATA*>& index, int id)
+{
+    typename std::map<int, DATA*>::const_iterator it = index.find(id);
+    return it == index.end() ? 0 : it->second;
+}
+
+template<class DATA>
+DATA* index_lookup(const DB_Id_Index<DATA>& index, int id)
+{
+    return index.lookup(id);
+}
+
+/**
+* Rows of a query result kept in blocks that are never moved: the row objects
+* are allocated a block at a time, each row is constructed in place once and
+* all rows are released together. Filling a Data_Set by push_back copies every
+* row each time the vector grows; an arena does not. The wxString columns of a
+* row still allocate their own buffers.
+*/
+template<class DATA>
+class DB_Arena
+{
+public:
+    template<class V>
+    struct basic_iterator
+    {
+        typedef std::forward_iterator_tag iterator_category;
+        typedef DATA value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        DATA* const* blocks_;
+        size_t block_rows_;
+        size_t i_;
+
+        V& operator*() const { return blocks_[i_ / block_rows_][i_ % block_rows_]; }
+        V* operator->() const { return &**this; }
+        basic_iterator& operator++() { ++i_; return *this; }
+        bool operator==(const basic_iterator& other) const { return i_ == other.i_; }
+        bool operator!=(const basic_iterator& other) const { return i_ != other.i_; }
+    };
+    typedef basic_iterator<DATA> iterator;
+    typedef basic_iterator<const DATA> const_iterator;
+
+    explicit DB_Arena(size_t block_rows = 256): block_rows_(block_rows), size_(0) {}
+    DB_Arena(DB_Arena&& other): blocks_(std::move(other.blocks_)), block_rows_(other.block_rows_), size_(other.size_)
+    {
+        other.blocks_.clear();
+        other.size_ = 0;
+    }
+    ~DB_Arena() { clear(); }
+    DB_Arena& operator=(DB_Arena&& other)
+    {
+        if (this == &other) return *this;
+        clear();
+        blocks_.swap(other.blocks_);
+        block_rows_ = other.block_rows_;
+        size_ = other.size_;
+        other.size_ = 0;
+        return *this;
+    }
+
+    template<typename... Args>
+    DATA& emplace_back(Args&&... args)
+    {
+        if (size_ == blocks_.size() * block_rows_)
+            blocks_.push_back(static_cast<DATA*>(::operator new(sizeof(DATA) * block_rows_)));
+        DATA* row = blocks_[size_ / block_rows_] + size_ % block_rows_;
+        new (row) DATA(std::forward<Args>(args)...);
+        ++size_;
+        return *row;
+    }
+
+    /** Destroy all rows and release the blocks */
+    void clear()
+    {
+        for (size_t i = 0; i < size_; ++i)
+            (*this)[i].~DATA();
+        for (auto block : blocks_)
+            ::operator delete(block);
+        blocks_.clear();
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    DATA& operator[](size_t i) { return blocks_[i / block_rows_][i % block_rows_]; }
+    const DATA& operator[](size_t i) const { return blocks_[i / block_rows_][i % block_rows_]; }
+
+    iterator begin() { iterator it = { blocks_.data(), block_rows_, 0 }; return it; }
+    iterator end() { iterator it = { blocks_.data(), block_rows_, size_ }; return it; }
+    const_iterator begin() const { const_iterator it = { blocks_.data(), block_rows_, 0 }; return it; }
+    const_iterator end() const { const_iterator it = { blocks_.data(), block_rows_, size_ }; return it; }
+
+    /** Number of heap allocations made for the rows, the strings of a row allocate on their own */
+    size_t allocations() const { return blocks_.size(); }
+    /** Bytes reserved for rows */
+    size_t capacity_bytes() const { return blocks_.size() * block_rows_ * sizeof(DATA); }
+
+private:
+    DB_Arena(const DB_Arena&);
+    DB_Arena& operator=(const DB_Arena&);
+
+    std::vector<DATA*> blocks_;
+    size_t block_rows_;
+    size_t size_;
+};
+
+/** Append the matching records to result, a Data_Set or a Data_Arena */
+template<typename RESULT, typename TABLE, typename... Args>
+void find_into(RESULT& result, TABLE* table, wxSQLite3Database* db, bool op_and, const Args&... args)
 {
-    typename TABLE::Data_Set result;
     try
     {
         wxString query = table->query() + " WHERE ";
         condition(query, op_and, args...);
+        DB_Query_Timer timer(query, db);
         wxSQLite3Statement stmt = db->PrepareStatement(query);
         bind(stmt, 1, args...);
 
@@ -923,20 +1628,162 @@ const typename TABLE::Data_Set find_by(TABLE* table, wxSQLite3Database* db, bool
 
         while(q.NextRow())
         {
-            typename TABLE::Data entity(q, table);
-            result.push_back(std::move(entity));
+            result.emplace_back(q, table);
         }
 
         q.Finalize();
+        timer.rows_ = result.size();
     }
     catch(const wxSQLite3Exception &e) 
     { 
         wxLogError("%s: Exception %s", table->name().utf8_str(), e.GetMessage().utf8_str());
     }
- 
+}
+
+template<typename TABLE, typename... Args>
+const typename TABLE::Data_Set find_by(TABLE* table, wxSQLite3Database* db, bool op_and, const Args&... args)
+{
+    typename TABLE::Data_Set result;
+    find_into(result, table, db, op_and, args...);
     return result;
 }
 
+/**
+* Forward only scan of a query result: the rows are read one at a time into
+* the same Data record, so the scan needs constant memory whatever the number
+* of rows. The record is overwritten by the next row, copy what must be kept.
+* Usage: for (const auto& r : DB_Cursor<TABLE>(table, db, true, conditions...))
+*/
+template<class TABLE>
+class DB_Cursor
+{
+public:
+    typedef typename TABLE::Data Data;
+
+    struct iterator
+    {
+        DB_Cursor* cursor_;
+
+        const Data& operator*() const { return cursor_->row_; }
+        const Data* operator->() const { return &cursor_->row_; }
+        iterator& operator++()
+        {
+            if (!cursor_->next()) cursor_ = nullptr;
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return cursor_ == other.cursor_; }
+        bool operator!=(const iterator& other) const { return cursor_ != other.cursor_; }
+    };
+
+    template<typename... Args>
+    DB_Cursor(TABLE* table, wxSQLite3Database* db, bool op_and, const Args&... args)
+        : table_(table), row_(table), timer_(table->query() + where(op_and, args...), db), done_(false)
+    {
+        try
+        {
+            stmt_ = db->PrepareStatement(timer_.shape_);
+            bind_all(stmt_, args...);
+            q_ = stmt_.ExecuteQuery();
+        }
+        catch (const wxSQLite3Exception &e)
+        {
+            wxLogError("%s: Exception %s", table_->name().utf8_str(), e.GetMessage().utf8_str());
+            done_ = true;
+        }
+    }
+    ~DB_Cursor()
+    {
+        if (q_.IsOk()) q_.Finalize();
+    }
+
+    /** Read the next row, false at the end of the result */
+    bool next()
+    {
+        if (done_) return false;
+        try
+        {
+            if (q_.NextRow())
+            {
+                row_.fetch(q_);
+                ++timer_.rows_;
+                return true;
+            }
+        }
+        catch (const wxSQLite3Exception &e)
+        {
+            wxLogError("%s: Exception %s", table_->name().utf8_str(), e.GetMessage().utf8_str());
+        }
+        done_ = true;
+        return false;
+    }
+
+    /** Iterating starts the scan, a cursor can be iterated once */
+    iterator begin()
+    {
+        iterator it = { next() ? this : nullptr };
+        return it;
+    }
+    iterator end() { iterator it = { nullptr }; return it; }
+
+private:
+    DB_Cursor(const DB_Cursor&);
+    DB_Cursor& operator=(const DB_Cursor&);
+
+    static wxString where(bool /*op_and*/) { return ""; }
+    template<typename... Args>
+    static wxString where(bool op_and, const Args&... args)
+    {
+        wxString out = " WHERE ";
+        condition(out, op_and, args...);
+        return out;
+    }
+    static void bind_all(wxSQLite3Statement& /*stmt*/) {}
+    template<typename... Args>
+    static void bind_all(wxSQLite3Statement& stmt, const Args&... args)
+    {
+        bind(stmt, 1, args...);
+    }
+
+    TABLE* table_;
+    Data row_;
+    DB_Query_Timer timer_;
+    wxSQLite3Statement stmt_;
+    wxSQLite3ResultSet q_;
+    bool done_;
+};
+
+/** Call fn(r), true to go on with the scan. fn returning void always goes on. */
+template<typename FN, typename DATA>
+bool call_each(FN& fn, const DATA& r, std::true_type /*void*/)
+{
+    fn(r);
+    return true;
+}
+
+template<typename FN, typename DATA>
+bool call_each(FN& fn, const DATA& r, std::false_type /*bool*/)
+{
+    return fn(r);
+}
+
+/**
+* Call fn with each matching record, read through a DB_Cursor. The scan stops
+* when fn returns false, the rest of the result is not read. Returns the number
+* of records passed to fn.
+*/
+template<typename TABLE, typename FN, typename... Args>
+size_t for_each_by(TABLE* table, wxSQLite3Database* db, FN fn, bool op_and, const Args&... args)
+{
+    size_t rows = 0;
+    for (const auto& r : DB_Cursor<TABLE>(table, db, op_and, args...))
+    {
+        ++rows;
+        if (!call_each(fn, r, std::is_void<decltype(fn(r))>()))
+            break;
+    }
+    return rows;
+}
+
 template<class DATA, typename Arg1>
 bool match(const DATA* data, const Arg1& arg1)
 {
@@ -1028,7 +1875,8 @@ if __name__ == '__main__':
         fields = get_table_info(cur, table)
         index = get_index_list(cur, table)
         data = get_data_initializer_list(cur, table)
-        table = DB_Table(table, fields, index, data)
+        trigger = get_trigger_list(cur, table)
+        table = DB_Table(table, fields, index, data, trigger)
         table.generate_class(header, sql)
         table.generate_unicode_currency_upgrade_patch()
         table.generate_currency_upgrade_patch()